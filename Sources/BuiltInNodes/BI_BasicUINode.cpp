@@ -50,6 +50,7 @@ const NUIE::IconId& BasicUINode::GetIconId () const
 
 void BasicUINode::SetIconId (const NUIE::IconId& newIconId)
 {
+	BeforeChange ();
 	iconId = newIconId;
 }
 
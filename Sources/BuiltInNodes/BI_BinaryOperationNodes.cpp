@@ -7,6 +7,10 @@
 namespace BI
 {
 
+static const NE::SlotId ASlotId ("a");
+static const NE::SlotId BSlotId ("b");
+static const NE::SlotId ResultSlotId ("result");
+
 SERIALIZATION_INFO (BinaryOperationNode, 1);
 DYNAMIC_SERIALIZATION_INFO (AdditionNode, 1, "{1A72C230-3D90-42AD-835A-43306E641EA2}");
 DYNAMIC_SERIALIZATION_INFO (SubtractionNode, 1, "{80CACB59-C3E6-441B-B60C-37A6F2611FC2}");
@@ -31,16 +35,16 @@ BinaryOperationNode::~BinaryOperationNode ()
 
 void BinaryOperationNode::Initialize ()
 {
-	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("a"), NE::LocString (L"A"), NE::ValuePtr (new NE::DoubleValue (0.0)), NE::OutputSlotConnectionMode::Single)));
-	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("b"), NE::LocString (L"B"), NE::ValuePtr (new NE::DoubleValue (0.0)), NE::OutputSlotConnectionMode::Single)));
-	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (NE::SlotId ("result"), NE::LocString (L"Result"))));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (ASlotId, NE::LocString (L"A"), NE::ValuePtr (new NE::DoubleValue (0.0)), NE::OutputSlotConnectionMode::Single)));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (BSlotId, NE::LocString (L"B"), NE::ValuePtr (new NE::DoubleValue (0.0)), NE::OutputSlotConnectionMode::Single)));
+	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (ResultSlotId, NE::LocString (L"Result"))));
 	RegisterFeature (NodeFeaturePtr (new ValueCombinationFeature (NE::ValueCombinationMode::Longest)));
 }
 
 NE::ValueConstPtr BinaryOperationNode::Calculate (NE::EvaluationEnv& env) const
 {
-	NE::ValueConstPtr aValue = EvaluateInputSlot (NE::SlotId ("a"), env);
-	NE::ValueConstPtr bValue = EvaluateInputSlot (NE::SlotId ("b"), env);
+	NE::ValueConstPtr aValue = EvaluateInputSlot (ASlotId, env);
+	NE::ValueConstPtr bValue = EvaluateInputSlot (BSlotId, env);
 	if (!NE::IsComplexType<NE::NumberValue> (aValue) || !NE::IsComplexType<NE::NumberValue> (bValue)) {
 		return nullptr;
 	}
@@ -68,8 +72,8 @@ NE::ValueConstPtr BinaryOperationNode::Calculate (NE::EvaluationEnv& env) const
 void BinaryOperationNode::RegisterParameters (NUIE::NodeParameterList& parameterList) const
 {
 	BasicUINode::RegisterParameters (parameterList);
-	NUIE::RegisterSlotDefaultValueNodeParameter<BinaryOperationNode, NE::DoubleValue> (parameterList, NE::SlotId ("a"), NE::LocString (L"A"), NUIE::ParameterType::Double);
-	NUIE::RegisterSlotDefaultValueNodeParameter<BinaryOperationNode, NE::DoubleValue> (parameterList, NE::SlotId ("b"), NE::LocString (L"B"), NUIE::ParameterType::Double);
+	NUIE::RegisterSlotDefaultValueNodeParameter<BinaryOperationNode, NE::DoubleValue> (parameterList, ASlotId, NE::LocString (L"A"), NUIE::ParameterType::Double);
+	NUIE::RegisterSlotDefaultValueNodeParameter<BinaryOperationNode, NE::DoubleValue> (parameterList, BSlotId, NE::LocString (L"B"), NUIE::ParameterType::Double);
 }
 
 bool BinaryOperationNode::IsForceCalculated () const
@@ -119,6 +123,11 @@ AdditionNode::~AdditionNode ()
 
 }
 
+NE::NodePtr AdditionNode::CloneNode () const
+{
+	return NE::CopyDynamicObject<NE::Node> (this);
+}
+
 double AdditionNode::DoOperation (double a, double b) const
 {
 	return a + b;
@@ -141,6 +150,11 @@ SubtractionNode::~SubtractionNode ()
 
 }
 
+NE::NodePtr SubtractionNode::CloneNode () const
+{
+	return NE::CopyDynamicObject<NE::Node> (this);
+}
+
 double SubtractionNode::DoOperation (double a, double b) const
 {
 	return a - b;
@@ -163,6 +177,11 @@ MultiplicationNode::~MultiplicationNode ()
 
 }
 
+NE::NodePtr MultiplicationNode::CloneNode () const
+{
+	return NE::CopyDynamicObject<NE::Node> (this);
+}
+
 double MultiplicationNode::DoOperation (double a, double b) const
 {
 	return a * b;
@@ -185,6 +204,11 @@ DivisionNode::~DivisionNode ()
 
 }
 
+NE::NodePtr DivisionNode::CloneNode () const
+{
+	return NE::CopyDynamicObject<NE::Node> (this);
+}
+
 double DivisionNode::DoOperation (double a, double b) const
 {
 	return a / b;
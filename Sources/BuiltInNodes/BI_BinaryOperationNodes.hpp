@@ -40,6 +40,8 @@ public:
 	AdditionNode (const NE::LocString& name, const NUIE::Point& position);
 	virtual ~AdditionNode ();
 
+	virtual NE::NodePtr CloneNode () const override;
+
 private:
 	virtual double DoOperation (double a, double b) const override;
 };
@@ -53,6 +55,8 @@ public:
 	SubtractionNode (const NE::LocString& name, const NUIE::Point& position);
 	virtual ~SubtractionNode ();
 
+	virtual NE::NodePtr CloneNode () const override;
+
 private:
 	virtual double DoOperation (double a, double b) const override;
 };
@@ -66,6 +70,8 @@ public:
 	MultiplicationNode (const NE::LocString& name, const NUIE::Point& position);
 	virtual ~MultiplicationNode ();
 
+	virtual NE::NodePtr CloneNode () const override;
+
 private:
 	virtual double DoOperation (double a, double b) const override;
 };
@@ -79,6 +85,8 @@ public:
 	DivisionNode (const NE::LocString& name, const NUIE::Point& position);
 	virtual ~DivisionNode ();
 
+	virtual NE::NodePtr CloneNode () const override;
+
 private:
 	virtual double DoOperation (double a, double b) const override;
 };
@@ -23,6 +23,7 @@ static void EnableDisableNode (EnableDisableFeature::State state, EnableDisableF
 	if (DBGERROR (enableDisableFeature == nullptr)) {
 		return;
 	}
+	uiNode->BeforeChange ();
 	enableDisableFeature->SetState (state);
 	uiNode->OnFeatureChange (EnableDisableFeatureId, env);
 	if (mode == EnableDisableFeature::Mode::Invalidate) {
@@ -146,6 +147,11 @@ void EnableDisableFeature::DrawInplace (NUIE::NodeUIDrawingEnvironment& env, con
 	}
 }
 
+NodeFeaturePtr EnableDisableFeature::Clone () const
+{
+	return NE::CopyDynamicObject<NodeFeature> (this);
+}
+
 NE::Stream::Status EnableDisableFeature::Read (NE::InputStream & inputStream)
 {
 	NE::ObjectHeader header (inputStream);
@@ -170,6 +176,7 @@ static void SetNodeValueCombination (NE::ValueCombinationMode valueCombination,
 	if (DBGERROR (valueCombinationFeature == nullptr)) {
 		return;
 	}
+	uiNode->BeforeChange ();
 	valueCombinationFeature->SetValueCombinationMode (valueCombination);
 	uiNode->OnFeatureChange (ValueCombinationFeatureId, env);
 	invalidator.InvalidateValueAndDrawing ();
@@ -275,6 +282,11 @@ void ValueCombinationFeature::RegisterParameters (NUIE::NodeParameterList& param
 	parameterList.AddParameter (NUIE::NodeParameterPtr (new ValueCombinationParameter ()));
 }
 
+NodeFeaturePtr ValueCombinationFeature::Clone () const
+{
+	return NE::CopyDynamicObject<NodeFeature> (this);
+}
+
 NE::Stream::Status ValueCombinationFeature::Read (NE::InputStream& inputStream)
 {
 	NE::ObjectHeader header (inputStream);
@@ -39,6 +39,7 @@ public:
 
 	virtual void				RegisterCommands (NUIE::NodeCommandRegistrator& commandRegistrator) const override;
 	virtual void				RegisterParameters (NUIE::NodeParameterList& parameterList) const override;
+	virtual NodeFeaturePtr		Clone () const override;
 
 	virtual NE::Stream::Status	Read (NE::InputStream& inputStream) override;
 	virtual NE::Stream::Status	Write (NE::OutputStream& outputStream) const override;
@@ -63,6 +64,7 @@ public:
 
 	virtual void				RegisterCommands (NUIE::NodeCommandRegistrator& commandRegistrator) const override;
 	virtual void				RegisterParameters (NUIE::NodeParameterList& parameterList) const override;
+	virtual NodeFeaturePtr		Clone () const override;
 
 	virtual NE::Stream::Status	Read (NE::InputStream& inputStream) override;
 	virtual NE::Stream::Status	Write (NE::OutputStream& outputStream) const override;
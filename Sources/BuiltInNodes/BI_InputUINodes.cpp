@@ -12,6 +12,13 @@
 namespace BI
 {
 
+static const NE::SlotId InSlotId ("in");
+static const NE::SlotId OutSlotId ("out");
+static const NE::SlotId StartSlotId ("start");
+static const NE::SlotId StepSlotId ("step");
+static const NE::SlotId EndSlotId ("end");
+static const NE::SlotId CountSlotId ("count");
+
 DYNAMIC_SERIALIZATION_INFO (BooleanNode, 1, "{72E14D86-E5DC-4AD6-A7E4-F60D47BFB114}");
 
 SERIALIZATION_INFO (NumericUpDownNode, 1);
@@ -100,9 +107,14 @@ BooleanNode::~BooleanNode ()
 
 }
 
+NE::NodePtr BooleanNode::CloneNode () const
+{
+	return NE::CopyDynamicObject<NE::Node> (this);
+}
+
 void BooleanNode::Initialize ()
 {
-	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (NE::SlotId ("out"), NE::LocString (L"Output"))));
+	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (OutSlotId, NE::LocString (L"Output"))));
 }
 
 bool BooleanNode::IsForceCalculated () const
@@ -166,6 +178,7 @@ bool BooleanNode::GetValue () const
 
 void BooleanNode::SetValue (bool newVal)
 {
+	BeforeChange ();
 	val = newVal;
 }
 
@@ -236,7 +249,7 @@ NumericUpDownNode::~NumericUpDownNode ()
 
 void NumericUpDownNode::Initialize ()
 {
-	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (NE::SlotId ("out"), NE::LocString (L"Output"))));
+	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (OutSlotId, NE::LocString (L"Output"))));
 }
 
 bool NumericUpDownNode::IsForceCalculated () const
@@ -277,6 +290,11 @@ IntegerUpDownNode::~IntegerUpDownNode ()
 
 }
 
+NE::NodePtr IntegerUpDownNode::CloneNode () const
+{
+	return NE::CopyDynamicObject<NE::Node> (this);
+}
+
 NE::ValueConstPtr IntegerUpDownNode::Calculate (NE::EvaluationEnv&) const
 {
 	return NE::ValueConstPtr (new NE::IntValue (val));
@@ -368,6 +386,7 @@ int IntegerUpDownNode::GetValue () const
 
 void IntegerUpDownNode::SetValue (int newValue)
 {
+	BeforeChange ();
 	val = newValue;
 }
 
@@ -378,6 +397,7 @@ int IntegerUpDownNode::GetStep () const
 
 void IntegerUpDownNode::SetStep (int newStep)
 {
+	BeforeChange ();
 	step = newStep;
 }
 
@@ -400,6 +420,11 @@ DoubleUpDownNode::~DoubleUpDownNode ()
 
 }
 
+NE::NodePtr DoubleUpDownNode::CloneNode () const
+{
+	return NE::CopyDynamicObject<NE::Node> (this);
+}
+
 NE::ValueConstPtr DoubleUpDownNode::Calculate (NE::EvaluationEnv&) const
 {
 	return NE::ValueConstPtr (new NE::DoubleValue (val));
@@ -491,6 +516,7 @@ double DoubleUpDownNode::GetValue () const
 
 void DoubleUpDownNode::SetValue (double newValue)
 {
+	BeforeChange ();
 	val = newValue;
 }
 
@@ -501,6 +527,7 @@ double DoubleUpDownNode::GetStep () const
 
 void DoubleUpDownNode::SetStep (double newStep)
 {
+	BeforeChange ();
 	step = newStep;
 }
 
@@ -557,19 +584,24 @@ IntegerIncrementedNode::~IntegerIncrementedNode ()
 
 }
 
+NE::NodePtr IntegerIncrementedNode::CloneNode () const
+{
+	return NE::CopyDynamicObject<NE::Node> (this);
+}
+
 void IntegerIncrementedNode::Initialize ()
 {
-	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("start"), NE::LocString (L"Start"), NE::ValuePtr (new NE::IntValue (0)), NE::OutputSlotConnectionMode::Single)));
-	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("step"), NE::LocString (L"Step"), NE::ValuePtr (new NE::IntValue (1)), NE::OutputSlotConnectionMode::Single)));
-	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("count"), NE::LocString (L"Count"), NE::ValuePtr (new NE::IntValue (10)), NE::OutputSlotConnectionMode::Single)));
-	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (NE::SlotId ("out"), NE::LocString (L"List"))));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (StartSlotId, NE::LocString (L"Start"), NE::ValuePtr (new NE::IntValue (0)), NE::OutputSlotConnectionMode::Single)));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (StepSlotId, NE::LocString (L"Step"), NE::ValuePtr (new NE::IntValue (1)), NE::OutputSlotConnectionMode::Single)));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (CountSlotId, NE::LocString (L"Count"), NE::ValuePtr (new NE::IntValue (10)), NE::OutputSlotConnectionMode::Single)));
+	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (OutSlotId, NE::LocString (L"List"))));
 }
 
 NE::ValueConstPtr IntegerIncrementedNode::Calculate (NE::EvaluationEnv& env) const
 {
-	NE::ValueConstPtr start = EvaluateInputSlot (NE::SlotId ("start"), env);
-	NE::ValueConstPtr step = EvaluateInputSlot (NE::SlotId ("step"), env);
-	NE::ValueConstPtr count = EvaluateInputSlot (NE::SlotId ("count"), env);
+	NE::ValueConstPtr start = EvaluateInputSlot (StartSlotId, env);
+	NE::ValueConstPtr step = EvaluateInputSlot (StepSlotId, env);
+	NE::ValueConstPtr count = EvaluateInputSlot (CountSlotId, env);
 	if (!NE::IsSingleType<NE::NumberValue> (start) || !NE::IsSingleType<NE::NumberValue> (step) || !NE::IsSingleType<NE::NumberValue> (count)) {
 		return nullptr;
 	}
@@ -592,9 +624,9 @@ NE::ValueConstPtr IntegerIncrementedNode::Calculate (NE::EvaluationEnv& env) con
 void IntegerIncrementedNode::RegisterParameters (NUIE::NodeParameterList& parameterList) const
 {
 	BasicUINode::RegisterParameters (parameterList);
-	NUIE::RegisterSlotDefaultValueNodeParameter<IntegerIncrementedNode, NE::IntValue> (parameterList, NE::SlotId ("start"), NE::LocString (L"Start"), NUIE::ParameterType::Integer);
-	NUIE::RegisterSlotDefaultValueNodeParameter<IntegerIncrementedNode, NE::IntValue> (parameterList, NE::SlotId ("step"), NE::LocString (L"Step"), NUIE::ParameterType::Integer);
-	parameterList.AddParameter (NUIE::NodeParameterPtr (new MinValueIntegerParameter<IntegerIncrementedNode> (NE::SlotId ("count"), NE::LocString (L"Count"), NUIE::ParameterType::Integer, 0)));
+	NUIE::RegisterSlotDefaultValueNodeParameter<IntegerIncrementedNode, NE::IntValue> (parameterList, StartSlotId, NE::LocString (L"Start"), NUIE::ParameterType::Integer);
+	NUIE::RegisterSlotDefaultValueNodeParameter<IntegerIncrementedNode, NE::IntValue> (parameterList, StepSlotId, NE::LocString (L"Step"), NUIE::ParameterType::Integer);
+	parameterList.AddParameter (NUIE::NodeParameterPtr (new MinValueIntegerParameter<IntegerIncrementedNode> (CountSlotId, NE::LocString (L"Count"), NUIE::ParameterType::Integer, 0)));
 }
 
 NE::Stream::Status IntegerIncrementedNode::Read (NE::InputStream& inputStream)
@@ -628,19 +660,24 @@ DoubleIncrementedNode::~DoubleIncrementedNode ()
 
 }
 
+NE::NodePtr DoubleIncrementedNode::CloneNode () const
+{
+	return NE::CopyDynamicObject<NE::Node> (this);
+}
+
 void DoubleIncrementedNode::Initialize ()
 {
-	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("start"), NE::LocString (L"Start"), NE::ValuePtr (new NE::DoubleValue (0.0)), NE::OutputSlotConnectionMode::Single)));
-	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("step"), NE::LocString (L"Step"), NE::ValuePtr (new NE::DoubleValue (1.0)), NE::OutputSlotConnectionMode::Single)));
-	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("count"), NE::LocString (L"Count"), NE::ValuePtr (new NE::IntValue (10)), NE::OutputSlotConnectionMode::Single)));
-	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (NE::SlotId ("out"), NE::LocString (L"List"))));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (StartSlotId, NE::LocString (L"Start"), NE::ValuePtr (new NE::DoubleValue (0.0)), NE::OutputSlotConnectionMode::Single)));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (StepSlotId, NE::LocString (L"Step"), NE::ValuePtr (new NE::DoubleValue (1.0)), NE::OutputSlotConnectionMode::Single)));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (CountSlotId, NE::LocString (L"Count"), NE::ValuePtr (new NE::IntValue (10)), NE::OutputSlotConnectionMode::Single)));
+	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (OutSlotId, NE::LocString (L"List"))));
 }
 
 NE::ValueConstPtr DoubleIncrementedNode::Calculate (NE::EvaluationEnv& env) const
 {
-	NE::ValueConstPtr start = EvaluateInputSlot (NE::SlotId ("start"), env);
-	NE::ValueConstPtr step = EvaluateInputSlot (NE::SlotId ("step"), env);
-	NE::ValueConstPtr count = EvaluateInputSlot (NE::SlotId ("count"), env);
+	NE::ValueConstPtr start = EvaluateInputSlot (StartSlotId, env);
+	NE::ValueConstPtr step = EvaluateInputSlot (StepSlotId, env);
+	NE::ValueConstPtr count = EvaluateInputSlot (CountSlotId, env);
 	if (!NE::IsSingleType<NE::NumberValue> (start) || !NE::IsSingleType<NE::NumberValue> (step) || !NE::IsSingleType<NE::NumberValue> (count)) {
 		return nullptr;
 	}
@@ -663,9 +700,9 @@ NE::ValueConstPtr DoubleIncrementedNode::Calculate (NE::EvaluationEnv& env) cons
 void DoubleIncrementedNode::RegisterParameters (NUIE::NodeParameterList& parameterList) const
 {
 	BasicUINode::RegisterParameters (parameterList);
-	NUIE::RegisterSlotDefaultValueNodeParameter<DoubleIncrementedNode, NE::DoubleValue> (parameterList, NE::SlotId ("start"), NE::LocString (L"Start"), NUIE::ParameterType::Double);
-	NUIE::RegisterSlotDefaultValueNodeParameter<DoubleIncrementedNode, NE::DoubleValue> (parameterList, NE::SlotId ("step"), NE::LocString (L"Step"), NUIE::ParameterType::Double);
-	parameterList.AddParameter (NUIE::NodeParameterPtr (new MinValueIntegerParameter<DoubleIncrementedNode> (NE::SlotId ("count"), NE::LocString (L"Count"), NUIE::ParameterType::Integer, 0)));
+	NUIE::RegisterSlotDefaultValueNodeParameter<DoubleIncrementedNode, NE::DoubleValue> (parameterList, StartSlotId, NE::LocString (L"Start"), NUIE::ParameterType::Double);
+	NUIE::RegisterSlotDefaultValueNodeParameter<DoubleIncrementedNode, NE::DoubleValue> (parameterList, StepSlotId, NE::LocString (L"Step"), NUIE::ParameterType::Double);
+	parameterList.AddParameter (NUIE::NodeParameterPtr (new MinValueIntegerParameter<DoubleIncrementedNode> (CountSlotId, NE::LocString (L"Count"), NUIE::ParameterType::Integer, 0)));
 }
 
 NE::Stream::Status DoubleIncrementedNode::Read (NE::InputStream& inputStream)
@@ -699,19 +736,24 @@ DoubleDistributedNode::~DoubleDistributedNode ()
 
 }
 
+NE::NodePtr DoubleDistributedNode::CloneNode () const
+{
+	return NE::CopyDynamicObject<NE::Node> (this);
+}
+
 void DoubleDistributedNode::Initialize ()
 {
-	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("start"), NE::LocString (L"Start"), NE::ValuePtr (new NE::DoubleValue (0.0)), NE::OutputSlotConnectionMode::Single)));
-	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("end"), NE::LocString (L"End"), NE::ValuePtr (new NE::DoubleValue (1.0)), NE::OutputSlotConnectionMode::Single)));
-	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("count"), NE::LocString (L"Count"), NE::ValuePtr (new NE::IntValue (10)), NE::OutputSlotConnectionMode::Single)));
-	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (NE::SlotId ("out"), NE::LocString (L"List"))));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (StartSlotId, NE::LocString (L"Start"), NE::ValuePtr (new NE::DoubleValue (0.0)), NE::OutputSlotConnectionMode::Single)));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (EndSlotId, NE::LocString (L"End"), NE::ValuePtr (new NE::DoubleValue (1.0)), NE::OutputSlotConnectionMode::Single)));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (CountSlotId, NE::LocString (L"Count"), NE::ValuePtr (new NE::IntValue (10)), NE::OutputSlotConnectionMode::Single)));
+	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (OutSlotId, NE::LocString (L"List"))));
 }
 
 NE::ValueConstPtr DoubleDistributedNode::Calculate (NE::EvaluationEnv& env) const
 {
-	NE::ValueConstPtr start = EvaluateInputSlot (NE::SlotId ("start"), env);
-	NE::ValueConstPtr end = EvaluateInputSlot (NE::SlotId ("end"), env);
-	NE::ValueConstPtr count = EvaluateInputSlot (NE::SlotId ("count"), env);
+	NE::ValueConstPtr start = EvaluateInputSlot (StartSlotId, env);
+	NE::ValueConstPtr end = EvaluateInputSlot (EndSlotId, env);
+	NE::ValueConstPtr count = EvaluateInputSlot (CountSlotId, env);
 	if (!NE::IsSingleType<NE::NumberValue> (start) || !NE::IsSingleType<NE::NumberValue> (end) || !NE::IsSingleType<NE::NumberValue> (count)) {
 		return nullptr;
 	}
@@ -735,9 +777,9 @@ NE::ValueConstPtr DoubleDistributedNode::Calculate (NE::EvaluationEnv& env) cons
 void DoubleDistributedNode::RegisterParameters (NUIE::NodeParameterList& parameterList) const
 {
 	BasicUINode::RegisterParameters (parameterList);
-	NUIE::RegisterSlotDefaultValueNodeParameter<DoubleDistributedNode, NE::DoubleValue> (parameterList, NE::SlotId ("start"), NE::LocString (L"Start"), NUIE::ParameterType::Double);
-	NUIE::RegisterSlotDefaultValueNodeParameter<DoubleDistributedNode, NE::DoubleValue> (parameterList, NE::SlotId ("end"), NE::LocString (L"End"), NUIE::ParameterType::Double);
-	parameterList.AddParameter (NUIE::NodeParameterPtr (new MinValueIntegerParameter<DoubleDistributedNode> (NE::SlotId ("count"), NE::LocString (L"Count"), NUIE::ParameterType::Integer, 2)));
+	NUIE::RegisterSlotDefaultValueNodeParameter<DoubleDistributedNode, NE::DoubleValue> (parameterList, StartSlotId, NE::LocString (L"Start"), NUIE::ParameterType::Double);
+	NUIE::RegisterSlotDefaultValueNodeParameter<DoubleDistributedNode, NE::DoubleValue> (parameterList, EndSlotId, NE::LocString (L"End"), NUIE::ParameterType::Double);
+	parameterList.AddParameter (NUIE::NodeParameterPtr (new MinValueIntegerParameter<DoubleDistributedNode> (CountSlotId, NE::LocString (L"Count"), NUIE::ParameterType::Integer, 2)));
 }
 
 NE::Stream::Status DoubleDistributedNode::Read (NE::InputStream& inputStream)
@@ -771,15 +813,20 @@ ListBuilderNode::~ListBuilderNode ()
 
 }
 
+NE::NodePtr ListBuilderNode::CloneNode () const
+{
+	return NE::CopyDynamicObject<NE::Node> (this);
+}
+
 void ListBuilderNode::Initialize ()
 {
-	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("in"), NE::LocString (L"Input"), nullptr, NE::OutputSlotConnectionMode::Multiple)));
-	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (NE::SlotId ("out"), NE::LocString (L"Output"))));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (InSlotId, NE::LocString (L"Input"), nullptr, NE::OutputSlotConnectionMode::Multiple)));
+	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (OutSlotId, NE::LocString (L"Output"))));
 }
 
 NE::ValueConstPtr ListBuilderNode::Calculate (NE::EvaluationEnv& env) const
 {
-	NE::ValueConstPtr in = EvaluateInputSlot (NE::SlotId ("in"), env);
+	NE::ValueConstPtr in = EvaluateInputSlot (InSlotId, env);
 	if (in == nullptr) {
 		return nullptr;
 	}
@@ -36,6 +36,7 @@ public:
 
 	virtual NE::Stream::Status			Read (NE::InputStream& inputStream) override;
 	virtual NE::Stream::Status			Write (NE::OutputStream& outputStream) const override;
+	virtual NE::NodePtr					CloneNode () const override;
 
 	bool								GetValue () const;
 	void								SetValue (bool newVal);
@@ -90,6 +91,7 @@ public:
 
 	virtual NE::Stream::Status			Read (NE::InputStream& inputStream) override;
 	virtual NE::Stream::Status			Write (NE::OutputStream& outputStream) const override;
+	virtual NE::NodePtr					CloneNode () const override;
 
 	virtual void						Increase () override;
 	virtual void						Decrease () override;
@@ -119,6 +121,7 @@ public:
 
 	virtual NE::Stream::Status			Read (NE::InputStream& inputStream) override;
 	virtual NE::Stream::Status			Write (NE::OutputStream& outputStream) const override;
+	virtual NE::NodePtr					CloneNode () const override;
 
 	virtual void						Increase () override;
 	virtual void						Decrease () override;
@@ -164,6 +167,7 @@ public:
 
 	virtual NE::Stream::Status	Read (NE::InputStream& inputStream) override;
 	virtual NE::Stream::Status	Write (NE::OutputStream& outputStream) const override;
+	virtual NE::NodePtr			CloneNode () const override;
 };
 
 class DoubleIncrementedNode : public NumericRangeNode
@@ -181,6 +185,7 @@ public:
 
 	virtual NE::Stream::Status	Read (NE::InputStream& inputStream) override;
 	virtual NE::Stream::Status	Write (NE::OutputStream& outputStream) const override;
+	virtual NE::NodePtr			CloneNode () const override;
 };
 
 class DoubleDistributedNode : public NumericRangeNode
@@ -198,6 +203,7 @@ public:
 
 	virtual NE::Stream::Status	Read (NE::InputStream& inputStream) override;
 	virtual NE::Stream::Status	Write (NE::OutputStream& outputStream) const override;
+	virtual NE::NodePtr			CloneNode () const override;
 };
 
 class ListBuilderNode : public BasicUINode
@@ -214,6 +220,7 @@ public:
 
 	virtual NE::Stream::Status			Read (NE::InputStream& inputStream) override;
 	virtual NE::Stream::Status			Write (NE::OutputStream& outputStream) const override;
+	virtual NE::NodePtr					CloneNode () const override;
 };
 
 }
@@ -89,6 +89,11 @@ NE::Stream::Status NodeFeature::Read (NE::InputStream& inputStream)
 	return inputStream.GetStatus ();
 }
 
+NodeFeaturePtr NodeFeature::Clone () const
+{
+	return nullptr;
+}
+
 NE::Stream::Status NodeFeature::Write (NE::OutputStream& outputStream) const
 {
 	NE::ObjectHeader header (outputStream, serializationInfo);
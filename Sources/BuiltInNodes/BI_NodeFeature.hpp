@@ -52,6 +52,7 @@ public:
 
 	virtual void				RegisterCommands (NUIE::NodeCommandRegistrator& commandRegistrator) const = 0;
 	virtual void				RegisterParameters (NUIE::NodeParameterList& parameterList) const = 0;
+	virtual NodeFeaturePtr		Clone () const;
 
 	virtual NE::Stream::Status	Read (NE::InputStream& inputStream) override;
 	virtual NE::Stream::Status	Write (NE::OutputStream& outputStream) const override;
@@ -10,6 +10,19 @@ NodeFeatureSet::NodeFeatureSet ()
 
 }
 
+NodeFeatureSet::NodeFeatureSet (const NodeFeatureSet& src) :
+	features (),
+	idToIndex (src.idToIndex)
+{
+	for (const NodeFeaturePtr& feature : src.features) {
+		NodeFeaturePtr clonedFeature = feature->Clone ();
+		if (clonedFeature == nullptr) {
+			clonedFeature = NE::CloneDynamicObject<NodeFeature> (feature.get ());
+		}
+		features.push_back (clonedFeature);
+	}
+}
+
 NodeFeatureSet::~NodeFeatureSet ()
 {
 
@@ -49,6 +62,8 @@ void NodeFeatureSet::RegisterParameters (NUIE::NodeParameterList& parameterList)
 NE::Stream::Status NodeFeatureSet::Read (NE::InputStream& inputStream)
 {
 	NE::ObjectHeader header (inputStream);
+	features.clear ();
+	idToIndex.clear ();
 	size_t featureCount = 0;
 	inputStream.Read (featureCount);
 	for (size_t i = 0; i < featureCount; i++) {
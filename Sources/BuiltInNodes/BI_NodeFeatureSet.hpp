@@ -15,6 +15,7 @@ class NodeFeatureSet
 
 public:
 	NodeFeatureSet ();
+	NodeFeatureSet (const NodeFeatureSet& src);
 	~NodeFeatureSet ();
 
 	void						AddFeature (const FeatureId& featureId, const NodeFeaturePtr& feature);
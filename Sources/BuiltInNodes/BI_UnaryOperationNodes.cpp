@@ -7,6 +7,9 @@
 namespace BI
 {
 
+static const NE::SlotId ASlotId ("a");
+static const NE::SlotId ResultSlotId ("result");
+
 SERIALIZATION_INFO (UnaryOperationNode, 1);
 DYNAMIC_SERIALIZATION_INFO (AbsNode, 1, "{125E8E5E-F1CB-4AE4-8EA9-53343ACD193B}");
 DYNAMIC_SERIALIZATION_INFO (FloorNode, 1, "{0DB3D5E3-8B32-43A4-82D2-F5B816AB5CC1}");
@@ -32,13 +35,13 @@ UnaryOperationNode::~UnaryOperationNode ()
 
 void UnaryOperationNode::Initialize ()
 {
-	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("a"), NE::LocString (L"A"), NE::ValuePtr (new NE::DoubleValue (0.0)), NE::OutputSlotConnectionMode::Single)));
-	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (NE::SlotId ("result"), NE::LocString (L"Result"))));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (ASlotId, NE::LocString (L"A"), NE::ValuePtr (new NE::DoubleValue (0.0)), NE::OutputSlotConnectionMode::Single)));
+	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (ResultSlotId, NE::LocString (L"Result"))));
 }
 
 NE::ValueConstPtr UnaryOperationNode::Calculate (NE::EvaluationEnv& env) const
 {
-	NE::ValueConstPtr aValue = EvaluateInputSlot (NE::SlotId ("a"), env);
+	NE::ValueConstPtr aValue = EvaluateInputSlot (ASlotId, env);
 	if (!NE::IsComplexType<NE::NumberValue> (aValue)) {
 		return nullptr;
 	}
@@ -65,7 +68,7 @@ NE::ValueConstPtr UnaryOperationNode::Calculate (NE::EvaluationEnv& env) const
 void UnaryOperationNode::RegisterParameters (NUIE::NodeParameterList& parameterList) const
 {
 	BasicUINode::RegisterParameters (parameterList);
-	NUIE::RegisterSlotDefaultValueNodeParameter<UnaryOperationNode, NE::DoubleValue> (parameterList, NE::SlotId ("a"), NE::LocString (L"A"), NUIE::ParameterType::Double);
+	NUIE::RegisterSlotDefaultValueNodeParameter<UnaryOperationNode, NE::DoubleValue> (parameterList, ASlotId, NE::LocString (L"A"), NUIE::ParameterType::Double);
 }
 
 bool UnaryOperationNode::IsForceCalculated () const
@@ -122,6 +125,11 @@ AbsNode::~AbsNode ()
 
 }
 
+NE::NodePtr AbsNode::CloneNode () const
+{
+	return NE::CopyDynamicObject<NE::Node> (this);
+}
+
 double AbsNode::DoOperation (double a) const
 {
 	return std::abs (a);
@@ -144,6 +152,11 @@ FloorNode::~FloorNode ()
 
 }
 
+NE::NodePtr FloorNode::CloneNode () const
+{
+	return NE::CopyDynamicObject<NE::Node> (this);
+}
+
 double FloorNode::DoOperation (double a) const
 {
 	return std::floor (a);
@@ -166,6 +179,11 @@ CeilNode::~CeilNode ()
 
 }
 
+NE::NodePtr CeilNode::CloneNode () const
+{
+	return NE::CopyDynamicObject<NE::Node> (this);
+}
+
 double CeilNode::DoOperation (double a) const
 {
 	return std::ceil (a);
@@ -188,6 +206,11 @@ NegativeNode::~NegativeNode ()
 
 }
 
+NE::NodePtr NegativeNode::CloneNode () const
+{
+	return NE::CopyDynamicObject<NE::Node> (this);
+}
+
 double NegativeNode::DoOperation (double a) const
 {
 	return a * -1.0;
@@ -210,6 +233,11 @@ SqrtNode::~SqrtNode ()
 
 }
 
+NE::NodePtr SqrtNode::CloneNode () const
+{
+	return NE::CopyDynamicObject<NE::Node> (this);
+}
+
 bool SqrtNode::IsValidInput (double a) const
 {
 	return a >= 0.0;
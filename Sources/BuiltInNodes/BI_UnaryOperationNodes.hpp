@@ -41,6 +41,8 @@ public:
 	AbsNode (const NE::LocString& name, const NUIE::Point& position);
 	virtual ~AbsNode ();
 
+	virtual NE::NodePtr CloneNode () const override;
+
 private:
 	virtual double DoOperation (double a) const override;
 };
@@ -54,6 +56,8 @@ public:
 	FloorNode (const NE::LocString& name, const NUIE::Point& position);
 	virtual ~FloorNode ();
 
+	virtual NE::NodePtr CloneNode () const override;
+
 private:
 	virtual double DoOperation (double a) const override;
 };
@@ -67,6 +71,8 @@ public:
 	CeilNode (const NE::LocString& name, const NUIE::Point& position);
 	virtual ~CeilNode ();
 
+	virtual NE::NodePtr CloneNode () const override;
+
 private:
 	virtual double DoOperation (double a) const override;
 };
@@ -80,6 +86,8 @@ public:
 	NegativeNode (const NE::LocString& name, const NUIE::Point& position);
 	virtual ~NegativeNode ();
 
+	virtual NE::NodePtr CloneNode () const override;
+
 private:
 	virtual double DoOperation (double a) const override;
 };
@@ -93,6 +101,8 @@ public:
 	SqrtNode (const NE::LocString& name, const NUIE::Point& position);
 	virtual ~SqrtNode ();
 
+	virtual NE::NodePtr CloneNode () const override;
+
 private:
 	virtual bool	IsValidInput (double a) const override;
 	virtual double	DoOperation (double a) const override;
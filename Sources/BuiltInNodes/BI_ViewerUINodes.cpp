@@ -9,6 +9,9 @@
 namespace BI
 {
 
+static const NE::SlotId InSlotId ("in");
+static const NE::SlotId OutSlotId ("out");
+
 DYNAMIC_SERIALIZATION_INFO (ViewerNode, 1, "{417392AA-F72D-4E84-8F58-766D0AAC07FC}");
 DYNAMIC_SERIALIZATION_INFO (MultiLineViewerNode, 1, "{2BACB82D-84A6-4472-82CB-786C98A50EF0}");
 
@@ -46,10 +49,15 @@ ViewerNode::~ViewerNode ()
 
 }
 
+NE::NodePtr ViewerNode::CloneNode () const
+{
+	return NE::CopyDynamicObject<NE::Node> (this);
+}
+
 void ViewerNode::Initialize ()
 {
-	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("in"), NE::LocString (L"Input"), nullptr, NE::OutputSlotConnectionMode::Single)));
-	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (NE::SlotId ("out"), NE::LocString (L"Output"))));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (InSlotId, NE::LocString (L"Input"), nullptr, NE::OutputSlotConnectionMode::Single)));
+	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (OutSlotId, NE::LocString (L"Output"))));
 }
 
 bool ViewerNode::IsForceCalculated () const
@@ -59,7 +67,7 @@ bool ViewerNode::IsForceCalculated () const
 
 NE::ValueConstPtr ViewerNode::Calculate (NE::EvaluationEnv& env) const
 {
-	NE::ValueConstPtr val = EvaluateInputSlot (NE::SlotId ("in"), env);
+	NE::ValueConstPtr val = EvaluateInputSlot (InSlotId, env);
 	if (val == nullptr) {
 		return nullptr;
 	}
@@ -130,15 +138,20 @@ MultiLineViewerNode::~MultiLineViewerNode ()
 
 }
 
+NE::NodePtr MultiLineViewerNode::CloneNode () const
+{
+	return NE::CopyDynamicObject<NE::Node> (this);
+}
+
 void MultiLineViewerNode::Initialize ()
 {
-	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (NE::SlotId ("in"), NE::LocString (L"Input"), nullptr, NE::OutputSlotConnectionMode::Single)));
-	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (NE::SlotId ("out"), NE::LocString (L"Output"))));
+	RegisterUIInputSlot (NUIE::UIInputSlotPtr (new NUIE::UIInputSlot (InSlotId, NE::LocString (L"Input"), nullptr, NE::OutputSlotConnectionMode::Single)));
+	RegisterUIOutputSlot (NUIE::UIOutputSlotPtr (new NUIE::UIOutputSlot (OutSlotId, NE::LocString (L"Output"))));
 }
 
 NE::ValueConstPtr MultiLineViewerNode::Calculate (NE::EvaluationEnv& env) const
 {
-	return EvaluateInputSlot (NE::SlotId ("in"), env);
+	return EvaluateInputSlot (InSlotId, env);
 }
 
 void MultiLineViewerNode::RegisterParameters (NUIE::NodeParameterList& parameterList) const
@@ -197,6 +210,7 @@ size_t MultiLineViewerNode::GetTextsPerPage () const
 
 void MultiLineViewerNode::SetTextsPerPage (size_t newTextsPerPage)
 {
+	BeforeChange ();
 	textsPerPage = newTextsPerPage;
 }
 
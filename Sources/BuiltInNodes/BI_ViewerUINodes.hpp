@@ -33,6 +33,7 @@ public:
 
 	virtual NE::Stream::Status			Read (NE::InputStream& inputStream) override;
 	virtual NE::Stream::Status			Write (NE::OutputStream& outputStream) const override;
+	virtual NE::NodePtr					CloneNode () const override;
 };
 
 class MultiLineViewerNode : public BasicUINode
@@ -66,6 +67,7 @@ public:
 
 	virtual NE::Stream::Status			Read (NE::InputStream& inputStream) override;
 	virtual NE::Stream::Status			Write (NE::OutputStream& outputStream) const override;
+	virtual NE::NodePtr					CloneNode () const override;
 
 	size_t								GetTextsPerPage () const;
 	void								SetTextsPerPage (size_t newTextsPerPage);
@@ -4,6 +4,7 @@
 #include "NUIE_DrawingContext.hpp"
 #include "NUIE_Drawing.hpp"
 #include "NUIE_DrawingCacheKeys.hpp"
+#include "NUIE_TextMeasureCache.hpp"
 #include "MAS_NSImageLoader.hpp"
 
 #include <unordered_map>
@@ -62,6 +63,7 @@ protected:
 	NSImageLoaderPtr			imageLoader;
 	
 	std::unordered_map<NUIE::FontCacheKey, NSFont*>		fontCache;
+	NUIE::TextMeasureCache								textMeasureCache;
 };
 
 }
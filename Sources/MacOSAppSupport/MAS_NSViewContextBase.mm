@@ -39,7 +39,8 @@ NSViewContextBase::NSViewContextBase (const NSImageLoaderPtr& imageLoader) :
 	width (0),
 	height (0),
 	imageLoader (imageLoader),
-	fontCache ()
+	fontCache (),
+	textMeasureCache ()
 {
 
 }
@@ -204,17 +205,19 @@ void NSViewContextBase::DrawFormattedText (const NUIE::Rect& rect, const NUIE::F
 
 NUIE::Size NSViewContextBase::MeasureText (const NUIE::Font& font, const std::wstring& text)
 {
-	@autoreleasepool {
-		@try {
-			NSString* nsText = StdWStringToNSString (text);
-			NSDictionary* attributes = @{NSFontAttributeName: GetFont (font)};
-			NSSize size = [nsText sizeWithAttributes : attributes];
-			return NUIE::Size (size.width * SafetyTextRatio, size.height * SafetyTextRatio);
-		} @catch (NSException*) {
+	return textMeasureCache.Measure (font, text, [&] (const NUIE::Font& measuredFont, const std::wstring& measuredText) {
+		@autoreleasepool {
+			@try {
+				NSString* nsText = StdWStringToNSString (measuredText);
+				NSDictionary* attributes = @{NSFontAttributeName: GetFont (measuredFont)};
+				NSSize size = [nsText sizeWithAttributes : attributes];
+				return NUIE::Size (size.width * SafetyTextRatio, size.height * SafetyTextRatio);
+			} @catch (NSException*) {
 
+			}
 		}
-	}
-	return NUIE::Size ();
+		return NUIE::Size ();
+	});
 }
 
 bool NSViewContextBase::CanDrawIcon ()
@@ -122,8 +122,10 @@ const ValueType& Cache<KeyType, ValueType>::Get (const KeyType& key)
 	if (controller != nullptr && !Contains (key)) {
 		Add (key, controller->CreateValue (key));
 	}
-	const KeyValuePair& pair = *valueMap.at (key);
-	return pair.second;
+	// the accessed value is moved to the end of the list, so the least recently used one is dropped first
+	KeyValuePairIterator found = valueMap.at (key);
+	valueList.splice (valueList.end (), valueList, found);
+	return found->second;
 }
 
 }
@@ -86,6 +86,11 @@ ConnectionInfo::ConnectionInfo (const SlotInfo& outputSlotInfo, const SlotInfo&
 
 }
 
+size_t ConnectionInfo::GenerateHashValue () const
+{
+	return outputSlotInfo.GenerateHashValue () + 49157 * inputSlotInfo.GenerateHashValue ();
+}
+
 const SlotInfo& ConnectionInfo::GetOutputSlotInfo () const
 {
 	return outputSlotInfo;
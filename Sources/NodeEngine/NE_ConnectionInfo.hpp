@@ -42,6 +42,8 @@ public:
 	ConnectionInfo ();
 	ConnectionInfo (const SlotInfo& outputSlotInfo, const SlotInfo& inputSlotInfo);
 
+	size_t				GenerateHashValue () const;
+
 	const SlotInfo&		GetOutputSlotInfo () const;
 	const SlotInfo&		GetInputSlotInfo () const;
 
@@ -75,6 +77,15 @@ namespace std
 			return info.GenerateHashValue ();
 		}
 	};
+
+	template <>
+	struct hash<NE::ConnectionInfo>
+	{
+		size_t operator() (const NE::ConnectionInfo& info) const noexcept
+		{
+			return info.GenerateHashValue ();
+		}
+	};
 }
 
 #endif
@@ -25,8 +25,12 @@ public:
 	bool	HasConnection (const BegSlotType& begSlot, const EndSlotType& endSlot) const;
 	void	EnumerateConnections (const BegSlotType& begSlot, const std::function<void (const EndSlotType&)>& processor) const;
 
+	template <class Processor>
+	void	EnumerateConnections (const BegSlotType& begSlot, const Processor& processor) const;
+
 	void	AddConnection (const BegSlotType& begSlot, const EndSlotType& endSlot);
 	void	DeleteConnection (const BegSlotType& begSlot, const EndSlotType& endSlot);
+	void	ReorderConnections (const BegSlotType& begSlot, const std::vector<EndSlotType>& orderedEndSlots);
 
 private:
 	std::unordered_map<BegSlotType, std::vector<EndSlotType>> connections;
@@ -93,6 +97,13 @@ bool ConnectionList<BegSlotType, EndSlotType>::HasConnection (const BegSlotType&
 
 template <class BegSlotType, class EndSlotType>
 void ConnectionList<BegSlotType, EndSlotType>::EnumerateConnections (const BegSlotType& begSlot, const std::function<void (const EndSlotType&)>& processor) const
+{
+	EnumerateConnections<std::function<void (const EndSlotType&)>> (begSlot, processor);
+}
+
+template <class BegSlotType, class EndSlotType>
+template <class Processor>
+void ConnectionList<BegSlotType, EndSlotType>::EnumerateConnections (const BegSlotType& begSlot, const Processor& processor) const
 {
 	auto foundEndSlots = connections.find (begSlot);
 	if (foundEndSlots == connections.end ()) {
@@ -133,6 +144,32 @@ void ConnectionList<BegSlotType, EndSlotType>::DeleteConnection (const BegSlotTy
 	}
 }
 
+template <class BegSlotType, class EndSlotType>
+void ConnectionList<BegSlotType, EndSlotType>::ReorderConnections (const BegSlotType& begSlot, const std::vector<EndSlotType>& orderedEndSlots)
+{
+	auto foundEndSlots = connections.find (begSlot);
+	if (foundEndSlots == connections.end ()) {
+		return;
+	}
+
+	// slots missing from the given order keep their relative order at the end
+	std::vector<EndSlotType>& endSlots = foundEndSlots->second;
+	std::vector<EndSlotType> newEndSlots;
+	newEndSlots.reserve (endSlots.size ());
+	for (const EndSlotType& endSlot : orderedEndSlots) {
+		if (std::find (endSlots.begin (), endSlots.end (), endSlot) != endSlots.end ()) {
+			newEndSlots.push_back (endSlot);
+		}
+	}
+	for (const EndSlotType& endSlot : endSlots) {
+		if (std::find (orderedEndSlots.begin (), orderedEndSlots.end (), endSlot) == orderedEndSlots.end ()) {
+			newEndSlots.push_back (endSlot);
+		}
+	}
+	DBGASSERT (newEndSlots.size () == endSlots.size ());
+	endSlots = newEndSlots;
+}
+
 }
 
 #endif
@@ -172,4 +172,12 @@ bool ConnectionManager::DisconnectAllInputSlotsFromOutputSlot (const OutputSlotC
 	return true;
 }
 
+void ConnectionManager::ReorderConnectedInputSlots (const OutputSlotConstPtr& outputSlot, const std::vector<InputSlotConstPtr>& inputSlots)
+{
+	if (DBGERROR (outputSlot == nullptr)) {
+		return;
+	}
+	outputToInputConnections.ReorderConnections (outputSlot, inputSlots);
+}
+
 }
@@ -28,6 +28,12 @@ public:
 	void	EnumerateConnectedOutputSlots (const InputSlotConstPtr& inputSlot, const std::function<void (const OutputSlotConstPtr&)>& processor) const;
 	void	EnumerateConnectedInputSlots (const OutputSlotConstPtr& outputSlot, const std::function<void (const InputSlotConstPtr&)>& processor) const;
 
+	template <class Processor>
+	void	EnumerateConnectedOutputSlots (const InputSlotConstPtr& inputSlot, const Processor& processor) const;
+
+	template <class Processor>
+	void	EnumerateConnectedInputSlots (const OutputSlotConstPtr& outputSlot, const Processor& processor) const;
+
 	bool	IsOutputSlotConnectedToInputSlot (const OutputSlotConstPtr& outputSlot, const InputSlotConstPtr& inputSlot) const;
 	bool	CanConnectOutputSlotToInputSlot (const InputSlotConstPtr& inputSlot) const;
 	bool	CanConnectOutputSlotToInputSlot (const OutputSlotConstPtr& outputSlot, const InputSlotConstPtr& inputSlot) const;
@@ -37,11 +43,25 @@ public:
 	bool	DisconnectAllOutputSlotsFromInputSlot (const InputSlotConstPtr& inputSlot);
 	bool	DisconnectAllInputSlotsFromOutputSlot (const OutputSlotConstPtr& outputSlot);
 
+	void	ReorderConnectedInputSlots (const OutputSlotConstPtr& outputSlot, const std::vector<InputSlotConstPtr>& inputSlots);
+
 private:
 	ConnectionList<OutputSlotConstPtr, InputSlotConstPtr>	outputToInputConnections;
 	ConnectionList<InputSlotConstPtr, OutputSlotConstPtr>	inputToOutputConnections;
 };
 
+template <class Processor>
+void ConnectionManager::EnumerateConnectedOutputSlots (const InputSlotConstPtr& inputSlot, const Processor& processor) const
+{
+	inputToOutputConnections.EnumerateConnections (inputSlot, processor);
+}
+
+template <class Processor>
+void ConnectionManager::EnumerateConnectedInputSlots (const OutputSlotConstPtr& outputSlot, const Processor& processor) const
+{
+	outputToInputConnections.EnumerateConnections (outputSlot, processor);
+}
+
 }
 
 #endif
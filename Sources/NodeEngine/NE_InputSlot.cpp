@@ -40,12 +40,20 @@ ValueConstPtr InputSlot::GetDefaultValue () const
 
 void InputSlot::SetDefaultValue (const ValueConstPtr& newDefaultValue)
 {
+	if (ownerNode != nullptr) {
+		ownerNode->BeforeChange ();
+	}
 	defaultValue = newDefaultValue;
 	if (ownerNode != nullptr) {
 		ownerNode->InvalidateValue ();
 	}
 }
 
+InputSlotPtr InputSlot::Clone () const
+{
+	return CopyDynamicObject<InputSlot> (this);
+}
+
 Stream::Status InputSlot::Read (InputStream& inputStream)
 {
 	ObjectHeader header (inputStream);
@@ -26,6 +26,8 @@ public:
 	OutputSlotConnectionMode	GetOutputSlotConnectionMode () const;
 	ValueConstPtr				GetDefaultValue () const;
 	void						SetDefaultValue (const ValueConstPtr& newDefaultValue);
+
+	virtual InputSlotPtr		Clone () const;
 	
 	virtual Stream::Status		Read (InputStream& inputStream) override;
 	virtual Stream::Status		Write (OutputStream& outputStream) const override;
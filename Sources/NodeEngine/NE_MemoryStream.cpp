@@ -32,12 +32,11 @@ static Stream::Status ReadString (MemoryInputStream& stream, std::string& val)
 		return stream.GetStatus ();
 	}
 
-	char* str = new char[count + 1];
-	stream.Read ((char*) str, count * sizeof (char));
-	str[count] = 0;
-
-	val = str;
-	delete[] str;
+	// the string may contain binary data, so it is read with its length
+	val.assign (count, 0);
+	if (count > 0) {
+		stream.Read (&val[0], count * sizeof (char));
+	}
 
 	return stream.GetStatus ();
 }
@@ -69,7 +68,20 @@ static Stream::Status WriteString (MemoryOutputStream& stream, const std::wstrin
 
 MemoryInputStream::MemoryInputStream (const std::vector<char>& buffer) :
 	InputStream (),
-	buffer (buffer),
+	ownedBuffer (buffer),
+	data (ownedBuffer.data ()),
+	size (ownedBuffer.size ()),
+	position (0)
+{
+	
+}
+
+// the data is not copied, so it must outlive the stream
+MemoryInputStream::MemoryInputStream (const char* data, size_t size) :
+	InputStream (),
+	ownedBuffer (),
+	data (data),
+	size (size),
 	position (0)
 {
 	
@@ -145,11 +157,11 @@ void MemoryInputStream::Read (char* dest, size_t size)
 	if (status != Status::NoError) {
 		return;
 	}
-	if (DBGERROR (position + size > buffer.size ())) {
+	if (DBGERROR (position + size > this->size)) {
 		status = Status::Error;
 		return;
 	}
-	std::copy (buffer.begin () + position, buffer.begin () + position + size, dest);
+	std::copy (data + position, data + position + size, dest);
 	position += size;
 }
 
@@ -11,8 +11,12 @@ class MemoryInputStream : public InputStream
 {
 public:
 	MemoryInputStream (const std::vector<char>& buffer);
+	MemoryInputStream (const char* data, size_t size);
+	MemoryInputStream (const MemoryInputStream& rhs) = delete;
 	virtual ~MemoryInputStream ();
 
+	MemoryInputStream&	operator= (const MemoryInputStream& rhs) = delete;
+
 	virtual Status		Read (bool& val) override;
 	virtual Status		Read (char& val) override;
 	virtual Status		Read (unsigned char& val) override;
@@ -27,7 +31,9 @@ public:
 	void				Read (char* dest, size_t size);
 
 private:
-	std::vector<char>	buffer;
+	std::vector<char>	ownedBuffer;
+	const char*			data;
+	size_t				size;
 	size_t				position;
 };
 
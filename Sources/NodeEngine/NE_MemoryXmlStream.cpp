@@ -1,6 +1,8 @@
 #include "NE_MemoryXmlStream.hpp"
 
 #include <string>
+#include <cwchar>
+#include <cwctype>
 
 namespace NE
 {
@@ -19,14 +21,26 @@ static const std::wstring WStringTag	= L"WString";
 static const std::wstring TrueString	= L"True";
 static const std::wstring FalseString	= L"False";
 
-static std::wstring GetBeginTag (const std::wstring& tag)
+static const size_t MaxFormattedValueLength = 512;
+
+static bool IsTagAtPosition (const std::wstring& xmlText, size_t position, const std::wstring& tag, bool isEndTag)
 {
-	return L"<" + tag + L">";
+	size_t tagNamePosition = position + (isEndTag ? 2 : 1);
+	size_t tagClosePosition = tagNamePosition + tag.length ();
+	if (tagClosePosition >= xmlText.length ()) {
+		return false;
+	}
+	if (xmlText[position] != L'<' || (isEndTag && xmlText[position + 1] != L'/')) {
+		return false;
+	}
+	return xmlText.compare (tagNamePosition, tag.length (), tag) == 0 && xmlText[tagClosePosition] == L'>';
 }
 
-static std::wstring GetEndTag (const std::wstring& tag)
+template <typename ValueType>
+static size_t FormatValue (wchar_t* buffer, const wchar_t* format, ValueType val)
 {
-	return L"</" + tag + L">";
+	int length = std::swprintf (buffer, MaxFormattedValueLength, format, val);
+	return length > 0 ? (size_t) length : 0;
 }
 
 MemoryXmlInputStream::MemoryXmlInputStream (const std::wstring& xmlText) :
@@ -37,6 +51,14 @@ MemoryXmlInputStream::MemoryXmlInputStream (const std::wstring& xmlText) :
 	
 }
 
+MemoryXmlInputStream::MemoryXmlInputStream (std::wstring&& xmlText) :
+	InputStream (),
+	xmlText (std::move (xmlText)),
+	position (0)
+{
+
+}
+
 MemoryXmlInputStream::~MemoryXmlInputStream ()
 {
 	
@@ -44,74 +66,80 @@ MemoryXmlInputStream::~MemoryXmlInputStream ()
 
 Stream::Status MemoryXmlInputStream::Read (bool& val)
 {
-	std::wstring valStr;
-	Read (BoolTag, valStr);
-	val = (valStr == TrueString ? true : false);
+	size_t textBegin = 0;
+	size_t textEnd = 0;
+	if (ReadText (BoolTag, textBegin, textEnd)) {
+		val = (xmlText.compare (textBegin, textEnd - textBegin, TrueString) == 0);
+	}
 	return GetStatus ();
 }
 
 Stream::Status MemoryXmlInputStream::Read (char& val)
 {
-	std::wstring valStr;
-	Read (CharTag, valStr);
-	val = (char) std::stoi (valStr);
+	long long intVal = 0;
+	if (ReadInteger (CharTag, intVal)) {
+		val = (char) intVal;
+	}
 	return GetStatus ();
 }
 
 Stream::Status MemoryXmlInputStream::Read (unsigned char& val)
 {
-	std::wstring valStr;
-	Read (UCharTag, valStr);
-	val = (unsigned char) std::stoi (valStr);
+	long long intVal = 0;
+	if (ReadInteger (UCharTag, intVal)) {
+		val = (unsigned char) intVal;
+	}
 	return GetStatus ();
 }
 
 Stream::Status MemoryXmlInputStream::Read (short& val)
 {
-	std::wstring valStr;
-	Read (ShortTag, valStr);
-	val = (short) std::stoi (valStr);
+	long long intVal = 0;
+	if (ReadInteger (ShortTag, intVal)) {
+		val = (short) intVal;
+	}
 	return GetStatus ();
 }
 
 Stream::Status MemoryXmlInputStream::Read (size_t& val)
 {
-	std::wstring valStr;
-	Read (SizeTag, valStr);
-	val = (size_t) std::stoul (valStr);
+	unsigned long long unsignedVal = 0;
+	if (ReadUnsigned (SizeTag, unsignedVal)) {
+		val = (size_t) unsignedVal;
+	}
 	return GetStatus ();
 }
 
 Stream::Status MemoryXmlInputStream::Read (int& val)
 {
-	std::wstring valStr;
-	Read (IntTag, valStr);
-	val = std::stoi (valStr);
+	long long intVal = 0;
+	if (ReadInteger (IntTag, intVal)) {
+		val = (int) intVal;
+	}
 	return GetStatus ();
 }
 
 Stream::Status MemoryXmlInputStream::Read (float& val)
 {
-	std::wstring valStr;
-	Read (FloatTag, valStr);
-	val = std::stof (valStr);
+	ReadFloat (FloatTag, val);
 	return GetStatus ();
 }
 
 Stream::Status MemoryXmlInputStream::Read (double& val)
 {
-	std::wstring valStr;
-	Read (DoubleTag, valStr);
-	val = std::stod (valStr);
+	ReadDouble (DoubleTag, val);
 	return GetStatus ();
 }
 
 Stream::Status MemoryXmlInputStream::Read (std::string& val)
 {
-	std::wstring valStr;
-	Read (StringTag, valStr);
-	for (wchar_t wch : valStr) {
-		val += (char) wch;
+	size_t textBegin = 0;
+	size_t textEnd = 0;
+	if (ReadText (StringTag, textBegin, textEnd)) {
+		val.resize (textEnd - textBegin);
+		for (size_t i = textBegin; i < textEnd; i++) {
+			val[i - textBegin] = (char) xmlText[i];
+		}
 	}
 	return GetStatus ();
 }
@@ -123,23 +151,110 @@ Stream::Status MemoryXmlInputStream::Read (std::wstring& val)
 }
 
 void MemoryXmlInputStream::Read (const std::wstring& tag, std::wstring& text)
+{
+	size_t textBegin = 0;
+	size_t textEnd = 0;
+	if (ReadText (tag, textBegin, textEnd)) {
+		text.assign (xmlText, textBegin, textEnd - textBegin);
+	}
+}
+
+bool MemoryXmlInputStream::ReadText (const std::wstring& tag, size_t& textBegin, size_t& textEnd)
 {
 	if (status != Status::NoError) {
-		return;
+		return false;
 	}
 
-	std::wstring beginTag = GetBeginTag (tag);
-	std::wstring endTag = GetEndTag (tag);
-	size_t beginTagPosition = xmlText.find (beginTag, position);
-	size_t endTagPosition = xmlText.find (endTag, position);
-	if (beginTagPosition == std::wstring::npos || endTagPosition == std::wstring::npos) {
+	// the next element must start at the current position, only whitespaces are skipped before it
+	while (position < xmlText.length () && std::iswspace (xmlText[position])) {
+		position++;
+	}
+	if (!IsTagAtPosition (xmlText, position, tag, false)) {
 		status = Status::Error;
-		return;
+		return false;
+	}
+
+	textBegin = position + tag.length () + 2;
+	size_t endTagPosition = textBegin;
+	while (true) {
+		endTagPosition = xmlText.find (L"</", endTagPosition);
+		if (endTagPosition == std::wstring::npos) {
+			status = Status::Error;
+			return false;
+		}
+		if (IsTagAtPosition (xmlText, endTagPosition, tag, true)) {
+			break;
+		}
+		endTagPosition += 2;
 	}
-	size_t textStartPosition = beginTagPosition + beginTag.length ();
-	size_t textEndPosition = endTagPosition;
-	text = xmlText.substr (textStartPosition, textEndPosition - textStartPosition);
-	position = endTagPosition + endTag.length ();
+
+	textEnd = endTagPosition;
+	position = endTagPosition + tag.length () + 3;
+	return true;
+}
+
+bool MemoryXmlInputStream::ReadInteger (const std::wstring& tag, long long& val)
+{
+	size_t textBegin = 0;
+	size_t textEnd = 0;
+	if (!ReadText (tag, textBegin, textEnd)) {
+		return false;
+	}
+	wchar_t* parseEnd = nullptr;
+	val = std::wcstoll (xmlText.c_str () + textBegin, &parseEnd, 10);
+	if (textBegin == textEnd || parseEnd != xmlText.c_str () + textEnd) {
+		status = Status::Error;
+		return false;
+	}
+	return true;
+}
+
+bool MemoryXmlInputStream::ReadUnsigned (const std::wstring& tag, unsigned long long& val)
+{
+	size_t textBegin = 0;
+	size_t textEnd = 0;
+	if (!ReadText (tag, textBegin, textEnd)) {
+		return false;
+	}
+	wchar_t* parseEnd = nullptr;
+	val = std::wcstoull (xmlText.c_str () + textBegin, &parseEnd, 10);
+	if (textBegin == textEnd || parseEnd != xmlText.c_str () + textEnd) {
+		status = Status::Error;
+		return false;
+	}
+	return true;
+}
+
+bool MemoryXmlInputStream::ReadFloat (const std::wstring& tag, float& val)
+{
+	size_t textBegin = 0;
+	size_t textEnd = 0;
+	if (!ReadText (tag, textBegin, textEnd)) {
+		return false;
+	}
+	wchar_t* parseEnd = nullptr;
+	val = std::wcstof (xmlText.c_str () + textBegin, &parseEnd);
+	if (textBegin == textEnd || parseEnd != xmlText.c_str () + textEnd) {
+		status = Status::Error;
+		return false;
+	}
+	return true;
+}
+
+bool MemoryXmlInputStream::ReadDouble (const std::wstring& tag, double& val)
+{
+	size_t textBegin = 0;
+	size_t textEnd = 0;
+	if (!ReadText (tag, textBegin, textEnd)) {
+		return false;
+	}
+	wchar_t* parseEnd = nullptr;
+	val = std::wcstod (xmlText.c_str () + textBegin, &parseEnd);
+	if (textBegin == textEnd || parseEnd != xmlText.c_str () + textEnd) {
+		status = Status::Error;
+		return false;
+	}
+	return true;
 }
 
 MemoryXmlOutputStream::MemoryXmlOutputStream () :
@@ -149,6 +264,13 @@ MemoryXmlOutputStream::MemoryXmlOutputStream () :
 	
 }
 
+MemoryXmlOutputStream::MemoryXmlOutputStream (size_t reservedSize) :
+	OutputStream (),
+	xmlText ()
+{
+	xmlText.reserve (reservedSize);
+}
+
 MemoryXmlOutputStream::~MemoryXmlOutputStream ()
 {
 	
@@ -167,43 +289,50 @@ Stream::Status MemoryXmlOutputStream::Write (const bool& val)
 
 Stream::Status MemoryXmlOutputStream::Write (const char& val)
 {
-	Write (CharTag, std::to_wstring (val));
+	wchar_t valStr[MaxFormattedValueLength];
+	Write (CharTag, valStr, FormatValue (valStr, L"%d", (int) val));
 	return GetStatus ();
 }
 
 Stream::Status MemoryXmlOutputStream::Write (const unsigned char& val)
 {
-	Write (UCharTag, std::to_wstring (val));
+	wchar_t valStr[MaxFormattedValueLength];
+	Write (UCharTag, valStr, FormatValue (valStr, L"%d", (int) val));
 	return GetStatus ();
 }
 
 Stream::Status MemoryXmlOutputStream::Write (const short& val)
 {
-	Write (ShortTag, std::to_wstring (val));
+	wchar_t valStr[MaxFormattedValueLength];
+	Write (ShortTag, valStr, FormatValue (valStr, L"%d", (int) val));
 	return GetStatus ();
 }
 
 Stream::Status MemoryXmlOutputStream::Write (const size_t& val)
 {
-	Write (SizeTag, std::to_wstring (val));
+	wchar_t valStr[MaxFormattedValueLength];
+	Write (SizeTag, valStr, FormatValue (valStr, L"%llu", (unsigned long long) val));
 	return GetStatus ();
 }
 
 Stream::Status MemoryXmlOutputStream::Write (const int& val)
 {
-	Write (IntTag, std::to_wstring (val));
+	wchar_t valStr[MaxFormattedValueLength];
+	Write (IntTag, valStr, FormatValue (valStr, L"%d", val));
 	return GetStatus ();
 }
 
 Stream::Status MemoryXmlOutputStream::Write (const float& val)
 {
-	Write (FloatTag, std::to_wstring (val));
+	wchar_t valStr[MaxFormattedValueLength];
+	Write (FloatTag, valStr, FormatValue (valStr, L"%f", (double) val));
 	return GetStatus ();
 }
 
 Stream::Status MemoryXmlOutputStream::Write (const double& val)
 {
-	Write (DoubleTag, std::to_wstring (val));
+	wchar_t valStr[MaxFormattedValueLength];
+	Write (DoubleTag, valStr, FormatValue (valStr, L"%f", val));
 	return GetStatus ();
 }
 
@@ -222,9 +351,18 @@ Stream::Status MemoryXmlOutputStream::Write (const std::wstring& val)
 
 void MemoryXmlOutputStream::Write (const std::wstring& tag, const std::wstring& text)
 {
-	std::wstring beginTag = GetBeginTag (tag);
-	std::wstring endTag = GetEndTag (tag);
-	xmlText += beginTag + text + endTag + L"\n";
+	Write (tag, text.c_str (), text.length ());
+}
+
+void MemoryXmlOutputStream::Write (const std::wstring& tag, const wchar_t* text, size_t length)
+{
+	xmlText += L'<';
+	xmlText += tag;
+	xmlText += L'>';
+	xmlText.append (text, length);
+	xmlText += L"</";
+	xmlText += tag;
+	xmlText += L">\n";
 }
 
 }
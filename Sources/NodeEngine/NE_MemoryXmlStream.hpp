@@ -11,6 +11,7 @@ class MemoryXmlInputStream : public InputStream
 {
 public:
 	MemoryXmlInputStream (const std::wstring& xmlText);
+	MemoryXmlInputStream (std::wstring&& xmlText);
 	virtual ~MemoryXmlInputStream ();
 
 	virtual Status		Read (bool& val) override;
@@ -27,6 +28,12 @@ public:
 	void				Read (const std::wstring& tag, std::wstring& text);
 
 private:
+	bool				ReadText (const std::wstring& tag, size_t& textBegin, size_t& textEnd);
+	bool				ReadInteger (const std::wstring& tag, long long& val);
+	bool				ReadUnsigned (const std::wstring& tag, unsigned long long& val);
+	bool				ReadFloat (const std::wstring& tag, float& val);
+	bool				ReadDouble (const std::wstring& tag, double& val);
+
 	std::wstring		xmlText;
 	size_t				position;
 };
@@ -35,6 +42,7 @@ class MemoryXmlOutputStream : public OutputStream
 {
 public:
 	MemoryXmlOutputStream ();
+	MemoryXmlOutputStream (size_t reservedSize);
 	virtual ~MemoryXmlOutputStream ();
 
 	const std::wstring&			GetXmlText () const;
@@ -53,6 +61,8 @@ public:
 	void						Write (const std::wstring& tag, const std::wstring& text);
 
 private:
+	void						Write (const std::wstring& tag, const wchar_t* text, size_t length);
+
 	std::wstring				xmlText;
 };
 
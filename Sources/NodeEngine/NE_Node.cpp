@@ -9,6 +9,41 @@ namespace NE
 
 SERIALIZATION_INFO (Node, 1);
 
+template <class SlotType>
+static bool HasSameSlots (const SlotList<SlotType>& aSlots, const SlotList<SlotType>& bSlots)
+{
+	if (aSlots.Count () != bSlots.Count ()) {
+		return false;
+	}
+	bool hasSameSlots = true;
+	aSlots.Enumerate ([&] (const std::shared_ptr<const SlotType>& slot) {
+		hasSameSlots = bSlots.Contains (slot->GetId ());
+		return hasSameSlots;
+	});
+	return hasSameSlots;
+}
+
+template <class SlotType>
+static bool RestoreSlots (SlotList<SlotType>& originalSlots, SlotList<SlotType>& slots)
+{
+	// the state of the newly read slots is copied to the original slot objects
+	bool success = true;
+	SlotList<SlotType> restoredSlots;
+	slots.Enumerate ([&] (const std::shared_ptr<SlotType>& readSlot) {
+		std::shared_ptr<SlotType> originalSlot = originalSlots.Get (readSlot->GetId ());
+		MemoryOutputStream outputStream;
+		readSlot->Write (outputStream);
+		MemoryInputStream inputStream (outputStream.GetBuffer ());
+		if (DBGERROR (originalSlot->Read (inputStream) != Stream::Status::NoError)) {
+			success = false;
+		}
+		restoredSlots.Insert (originalSlot);
+		return success;
+	});
+	slots = restoredSlots;
+	return success;
+}
+
 NodeEvaluator::NodeEvaluator ()
 {
 
@@ -28,6 +63,31 @@ Node::Node () :
 
 }
 
+Node::Node (const Node& src) :
+	DynamicSerializable (),
+	nodeId (src.nodeId),
+	inputSlots (),
+	outputSlots (),
+	nodeEvaluator (nullptr)
+{
+	src.inputSlots.Enumerate ([&] (const InputSlotConstPtr& inputSlot) {
+		InputSlotPtr clonedInputSlot = inputSlot->Clone ();
+		if (clonedInputSlot == nullptr) {
+			clonedInputSlot = CloneDynamicObject (inputSlot.get ());
+		}
+		DBGVERIFY (RegisterInputSlot (clonedInputSlot));
+		return true;
+	});
+	src.outputSlots.Enumerate ([&] (const OutputSlotConstPtr& outputSlot) {
+		OutputSlotPtr clonedOutputSlot = outputSlot->Clone ();
+		if (clonedOutputSlot == nullptr) {
+			clonedOutputSlot = CloneDynamicObject (outputSlot.get ());
+		}
+		DBGVERIFY (RegisterOutputSlot (clonedOutputSlot));
+		return true;
+	});
+}
+
 Node::~Node ()
 {
 
@@ -173,6 +233,15 @@ void Node::InvalidateValue () const
 	nodeEvaluator->InvalidateNodeValue (GetId ());	
 }
 
+void Node::BeforeChange () const
+{
+	// nodes outside of a node manager have nobody to report to
+	if (nodeEvaluator == nullptr) {
+		return;
+	}
+	nodeEvaluator->BeforeNodeChange (GetId ());
+}
+
 Stream::Status Node::Read (InputStream& inputStream)
 {
 	if (DBGERROR (!IsEmpty ())) {
@@ -310,6 +379,36 @@ void Node::ClearEvaluator ()
 	nodeEvaluator = nullptr;
 }
 
+bool Node::RestoreState (const NodeConstPtr& savedState)
+{
+	// the node is read again from the saved state, but the slot objects are kept,
+	// because connections refer to them
+	if (DBGERROR (savedState->nodeId != nodeId)) {
+		return false;
+	}
+	if (DBGERROR (!HasSameSlots (savedState->inputSlots, inputSlots) || !HasSameSlots (savedState->outputSlots, outputSlots))) {
+		return false;
+	}
+
+	MemoryOutputStream outputStream;
+	if (DBGERROR (savedState->Write (outputStream) != Stream::Status::NoError)) {
+		return false;
+	}
+
+	SlotList<InputSlot> originalInputSlots = inputSlots;
+	SlotList<OutputSlot> originalOutputSlots = outputSlots;
+	nodeId = NullNodeId;
+	inputSlots = SlotList<InputSlot> ();
+	outputSlots = SlotList<OutputSlot> ();
+
+	MemoryInputStream inputStream (outputStream.GetBuffer ());
+	bool success = (Read (inputStream) == Stream::Status::NoError);
+	success = RestoreSlots (originalInputSlots, inputSlots) && success;
+	success = RestoreSlots (originalOutputSlots, outputSlots) && success;
+	DBGASSERT (success);
+	return success;
+}
+
 bool Node::IsForceCalculated () const
 {
 	return false;
@@ -351,15 +450,19 @@ ValueConstPtr Node::EvaluateInputSlot (const InputSlotConstPtr& inputSlot, Evalu
 	return nullptr;
 }
 
+NodePtr Node::CloneNode () const
+{
+	return nullptr;
+}
+
 NodePtr Node::Clone (const NodeConstPtr& node)
 {
-	MemoryOutputStream outputStream;
-	if (DBGERROR (!WriteDynamicObject (outputStream, node.get ()))) {
-		return nullptr;
+	// nodes without direct cloning support are cloned through serialization
+	NodePtr result = node->CloneNode ();
+	if (result == nullptr) {
+		result = CloneDynamicObject (node.get ());
 	}
 
-	MemoryInputStream inputStream (outputStream.GetBuffer ());
-	NodePtr result (ReadDynamicObject<Node> (inputStream));
 	if (DBGERROR (result == nullptr)) {
 		return nullptr;
 	}
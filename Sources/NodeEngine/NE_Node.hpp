@@ -25,6 +25,7 @@ public:
 	virtual ~NodeEvaluator ();
 
 	virtual void			InvalidateNodeValue (const NodeId& nodeId) const = 0;
+	virtual void			BeforeNodeChange (const NodeId& nodeId) const = 0;
 	virtual bool			HasConnectedOutputSlots (const InputSlotConstPtr& inputSlot) const = 0;
 	virtual void			EnumerateConnectedOutputSlots (const InputSlotConstPtr& inputSlot, const std::function<void (const OutputSlotConstPtr&)>& processor) const = 0;
 
@@ -51,7 +52,6 @@ public:
 	};
 
 	Node ();
-	Node (const Node& src) = delete;
 	virtual ~Node ();
 
 	bool					IsEmpty () const;
@@ -73,17 +73,31 @@ public:
 	void					EnumerateInputSlots (const std::function<bool (InputSlotConstPtr)>& processor) const;
 	void					EnumerateOutputSlots (const std::function<bool (OutputSlotConstPtr)>& processor) const;
 
+	template <class Processor>
+	void					EnumerateInputSlots (const Processor& processor);
+
+	template <class Processor>
+	void					EnumerateOutputSlots (const Processor& processor);
+
+	template <class Processor>
+	void					EnumerateInputSlots (const Processor& processor) const;
+
+	template <class Processor>
+	void					EnumerateOutputSlots (const Processor& processor) const;
+
 	ValueConstPtr			Evaluate (EvaluationEnv& env) const;
 	ValueConstPtr			GetCalculatedValue () const;
 	bool					HasCalculatedValue () const;
 	CalculationStatus		GetCalculationStatus () const;
 	void					InvalidateValue () const;
+	void					BeforeChange () const;
 
 	ValueConstPtr			GetInputSlotDefaultValue (const SlotId& slotId) const;
 	void					SetInputSlotDefaultValue (const SlotId& slotId, const ValueConstPtr& newDefaultValue);
 
 	virtual Stream::Status	Read (InputStream& inputStream) override;
 	virtual Stream::Status	Write (OutputStream& outputStream) const override;
+	virtual NodePtr			CloneNode () const;
 
 	static NodePtr			Clone (const NodeConstPtr& node);
 	static bool				IsEqual (const NodeConstPtr& aNode, const NodeConstPtr& bNode);
@@ -107,6 +121,8 @@ public:
 	static std::shared_ptr<const Type> CastConst (const NodeConstPtr& node);
 
 protected:
+	Node (const Node& src);
+
 	bool					RegisterInputSlot (const InputSlotPtr& newInputSlot);
 	bool					RegisterOutputSlot (const OutputSlotPtr& newOutputSlot);
 	ValueConstPtr			EvaluateInputSlot (const SlotId& slotId, EvaluationEnv& env) const;
@@ -116,6 +132,7 @@ private:
 	void					SetEvaluator (const NodeEvaluatorConstPtr& newNodeEvaluator);
 	bool					IsEvaluatorSet () const;
 	void					ClearEvaluator ();
+	bool					RestoreState (const NodeConstPtr& savedState);
 
 	virtual void			Initialize () = 0;
 	virtual ValueConstPtr	Calculate (EvaluationEnv& env) const = 0;
@@ -144,6 +161,30 @@ bool Node::IsType (const NodePtr& node)
 	return dynamic_cast<Type*> (node.get ()) != nullptr;
 }
 
+template <class Processor>
+void Node::EnumerateInputSlots (const Processor& processor)
+{
+	inputSlots.Enumerate (processor);
+}
+
+template <class Processor>
+void Node::EnumerateOutputSlots (const Processor& processor)
+{
+	outputSlots.Enumerate (processor);
+}
+
+template <class Processor>
+void Node::EnumerateInputSlots (const Processor& processor) const
+{
+	inputSlots.Enumerate (processor);
+}
+
+template <class Processor>
+void Node::EnumerateOutputSlots (const Processor& processor) const
+{
+	outputSlots.Enumerate (processor);
+}
+
 template <class Type>
 bool Node::IsTypeConst (const NodeConstPtr& node)
 {
@@ -0,0 +1,80 @@
+#include "NE_NodeAdjacency.hpp"
+#include "NE_Node.hpp"
+#include "NE_InputSlot.hpp"
+#include "NE_OutputSlot.hpp"
+#include "NE_Debug.hpp"
+
+namespace NE
+{
+
+NodeAdjacency::NodeAdjacency (const NodeList& nodeList, const ConnectionManager& connectionManager) :
+	nodeIds (),
+	nodeIdToIndex (),
+	dependentOffsets (),
+	dependentNodes ()
+{
+	nodeIds.reserve (nodeList.Count ());
+	nodeIdToIndex.reserve (nodeList.Count ());
+	nodeList.Enumerate ([&] (const NodeConstPtr& node) {
+		nodeIdToIndex.insert ({ node->GetId (), nodeIds.size () });
+		nodeIds.push_back (node->GetId ());
+		return true;
+	});
+
+	dependentOffsets.reserve (nodeIds.size () + 1);
+	dependentNodes.reserve (connectionManager.GetConnectionCount ());
+	nodeList.Enumerate ([&] (const NodeConstPtr& node) {
+		dependentOffsets.push_back (dependentNodes.size ());
+		node->EnumerateOutputSlots ([&] (const OutputSlotConstPtr& outputSlot) {
+			connectionManager.EnumerateConnectedInputSlots (outputSlot, [&] (const InputSlotConstPtr& inputSlot) {
+				dependentNodes.push_back (nodeIdToIndex.at (inputSlot->GetOwnerNodeId ()));
+			});
+			return true;
+		});
+		return true;
+	});
+	dependentOffsets.push_back (dependentNodes.size ());
+}
+
+NodeAdjacency::~NodeAdjacency ()
+{
+
+}
+
+size_t NodeAdjacency::GetNodeCount () const
+{
+	return nodeIds.size ();
+}
+
+bool NodeAdjacency::ContainsNode (const NodeId& nodeId) const
+{
+	return nodeIdToIndex.find (nodeId) != nodeIdToIndex.end ();
+}
+
+size_t NodeAdjacency::GetNodeIndex (const NodeId& nodeId) const
+{
+	return nodeIdToIndex.at (nodeId);
+}
+
+const NodeId& NodeAdjacency::GetNodeId (size_t nodeIndex) const
+{
+	return nodeIds[nodeIndex];
+}
+
+size_t NodeAdjacency::GetDependentNodeCount (size_t nodeIndex) const
+{
+	return dependentOffsets[nodeIndex + 1] - dependentOffsets[nodeIndex];
+}
+
+size_t NodeAdjacency::GetDependentNode (size_t nodeIndex, size_t dependentIndex) const
+{
+	DBGASSERT (dependentIndex < GetDependentNodeCount (nodeIndex));
+	return dependentNodes[dependentOffsets[nodeIndex] + dependentIndex];
+}
+
+void NodeAdjacency::EnumerateDependentNodes (size_t nodeIndex, const std::function<void (size_t)>& processor) const
+{
+	EnumerateDependentNodes<std::function<void (size_t)>> (nodeIndex, processor);
+}
+
+}
@@ -0,0 +1,52 @@
+#ifndef NE_NODEADJACENCY_HPP
+#define NE_NODEADJACENCY_HPP
+
+#include "NE_NodeId.hpp"
+#include "NE_NodeList.hpp"
+#include "NE_ConnectionManager.hpp"
+
+#include <vector>
+#include <unordered_map>
+#include <functional>
+
+namespace NE
+{
+
+// node level dependency graph in compressed sparse row format, nodes are
+// addressed by their index in the node list, it must be rebuilt on change
+class NodeAdjacency
+{
+public:
+	NodeAdjacency (const NodeList& nodeList, const ConnectionManager& connectionManager);
+	~NodeAdjacency ();
+
+	size_t			GetNodeCount () const;
+	bool			ContainsNode (const NodeId& nodeId) const;
+	size_t			GetNodeIndex (const NodeId& nodeId) const;
+	const NodeId&	GetNodeId (size_t nodeIndex) const;
+
+	size_t			GetDependentNodeCount (size_t nodeIndex) const;
+	size_t			GetDependentNode (size_t nodeIndex, size_t dependentIndex) const;
+	void			EnumerateDependentNodes (size_t nodeIndex, const std::function<void (size_t)>& processor) const;
+
+	template <class Processor>
+	void			EnumerateDependentNodes (size_t nodeIndex, const Processor& processor) const;
+
+private:
+	std::vector<NodeId>						nodeIds;
+	std::unordered_map<NodeId, size_t>		nodeIdToIndex;
+	std::vector<size_t>						dependentOffsets;
+	std::vector<size_t>						dependentNodes;
+};
+
+template <class Processor>
+void NodeAdjacency::EnumerateDependentNodes (size_t nodeIndex, const Processor& processor) const
+{
+	for (size_t i = dependentOffsets[nodeIndex]; i < dependentOffsets[nodeIndex + 1]; i++) {
+		processor (dependentNodes[i]);
+	}
+}
+
+}
+
+#endif
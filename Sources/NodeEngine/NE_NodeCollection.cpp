@@ -1,18 +1,22 @@
 #include "NE_NodeCollection.hpp"
 
-#include <algorithm>
-
 namespace NE
 {
 
 SERIALIZATION_INFO (NodeCollection, 1);
 
-NodeCollection::NodeCollection ()
+NodeCollection::NodeCollection () :
+	nodes (),
+	nodeToIndex (),
+	erasedCount (0)
 {
 
 }
 
-NodeCollection::NodeCollection (const std::vector<NodeId>& nodeIds)
+NodeCollection::NodeCollection (const std::vector<NodeId>& nodeIds) :
+	nodes (),
+	nodeToIndex (),
+	erasedCount (0)
 {
 	for (const NodeId& nodeId : nodeIds) {
 		Insert (nodeId);
@@ -26,28 +30,45 @@ NodeCollection::~NodeCollection ()
 
 bool NodeCollection::IsEmpty () const
 {
-	DBGASSERT (nodes.empty () == nodeSet.empty ());
-	return nodes.empty ();
+	return nodeToIndex.empty ();
 }
 
 bool NodeCollection::Contains (const NodeId& nodeId) const
 {
-	return nodeSet.find (nodeId) != nodeSet.end ();
+	return nodeToIndex.find (nodeId) != nodeToIndex.end ();
 }
 
 size_t NodeCollection::Count () const
 {
-	return nodes.size ();
+	DBGASSERT (nodes.size () - erasedCount == nodeToIndex.size ());
+	return nodeToIndex.size ();
 }
 
 const NodeId& NodeCollection::Get (size_t index) const
 {
-	return nodes[index];
+	if (erasedCount == 0) {
+		return nodes[index];
+	}
+	size_t nodeIndex = 0;
+	for (const NodeId& nodeId : nodes) {
+		if (nodeId == NullNodeId) {
+			continue;
+		}
+		if (nodeIndex == index) {
+			return nodeId;
+		}
+		nodeIndex++;
+	}
+	DBGBREAK ();
+	return NullNodeId;
 }
 
 void NodeCollection::Enumerate (const std::function<bool (const NodeId&)>& processor) const
 {
 	for (const NodeId& nodeId : nodes) {
+		if (nodeId == NullNodeId) {
+			continue;
+		}
 		if (!processor (nodeId)) {
 			return;
 		}
@@ -56,27 +77,94 @@ void NodeCollection::Enumerate (const std::function<bool (const NodeId&)>& proce
 
 void NodeCollection::Insert (const NodeId& nodeId)
 {
+	if (DBGERROR (nodeId == NullNodeId)) {
+		return;
+	}
+	if (Contains (nodeId)) {
+		return;
+	}
+	nodeToIndex.insert ({ nodeId, nodes.size () });
 	nodes.push_back (nodeId);
-	nodeSet.insert (nodeId);
 }
 
 void NodeCollection::Erase (const NodeId& nodeId)
 {
-	if (Contains (nodeId)) {
-		nodes.erase (std::find (nodes.begin (), nodes.end (), nodeId));
-		nodeSet.erase (nodeId);
+	auto found = nodeToIndex.find (nodeId);
+	if (found == nodeToIndex.end ()) {
+		return;
 	}
+	nodes[found->second] = NullNodeId;
+	nodeToIndex.erase (found);
+	erasedCount++;
+	CompactIfNeeded ();
 }
 
 void NodeCollection::Clear ()
 {
 	nodes.clear ();
-	nodeSet.clear ();
+	nodeToIndex.clear ();
+	erasedCount = 0;
+}
+
+void NodeCollection::Union (const NodeCollection& rhs)
+{
+	// the collection can't be modified while it is enumerated
+	if (&rhs == this) {
+		return;
+	}
+	rhs.Enumerate ([&] (const NodeId& nodeId) {
+		Insert (nodeId);
+		return true;
+	});
+}
+
+void NodeCollection::Difference (const NodeCollection& rhs)
+{
+	if (&rhs == this) {
+		Clear ();
+		return;
+	}
+	rhs.Enumerate ([&] (const NodeId& nodeId) {
+		Erase (nodeId);
+		return true;
+	});
+}
+
+void NodeCollection::SymmetricDifference (const NodeCollection& rhs)
+{
+	if (&rhs == this) {
+		Clear ();
+		return;
+	}
+	rhs.Enumerate ([&] (const NodeId& nodeId) {
+		if (Contains (nodeId)) {
+			Erase (nodeId);
+		} else {
+			Insert (nodeId);
+		}
+		return true;
+	});
 }
 
 bool NodeCollection::operator== (const NodeCollection& rhs) const
 {
-	return nodes == rhs.nodes && nodeSet == rhs.nodeSet;
+	if (Count () != rhs.Count ()) {
+		return false;
+	}
+	size_t rhsIndex = 0;
+	for (const NodeId& nodeId : nodes) {
+		if (nodeId == NullNodeId) {
+			continue;
+		}
+		while (rhs.nodes[rhsIndex] == NullNodeId) {
+			rhsIndex++;
+		}
+		if (nodeId != rhs.nodes[rhsIndex]) {
+			return false;
+		}
+		rhsIndex++;
+	}
+	return true;
 }
 
 bool NodeCollection::operator!= (const NodeCollection& rhs) const
@@ -101,13 +189,32 @@ Stream::Status NodeCollection::Read (InputStream& inputStream)
 Stream::Status NodeCollection::Write (OutputStream& outputStream) const
 {
 	ObjectHeader header (outputStream, serializationInfo);
-	outputStream.Write (nodes.size ());
-	for (const NodeId& nodeId : nodes) {
+	outputStream.Write (Count ());
+	Enumerate ([&] (const NodeId& nodeId) {
 		nodeId.Write (outputStream);
-	}
+		return true;
+	});
 	return outputStream.GetStatus ();
 }
 
+void NodeCollection::CompactIfNeeded ()
+{
+	if (erasedCount == 0 || erasedCount < nodes.size () / 2) {
+		return;
+	}
+	size_t newIndex = 0;
+	for (size_t i = 0; i < nodes.size (); i++) {
+		if (nodes[i] == NullNodeId) {
+			continue;
+		}
+		nodes[newIndex] = nodes[i];
+		nodeToIndex[nodes[i]] = newIndex;
+		newIndex++;
+	}
+	nodes.resize (newIndex);
+	erasedCount = 0;
+}
+
 const NodeCollection EmptyNodeCollection;
 
 }
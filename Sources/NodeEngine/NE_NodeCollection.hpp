@@ -4,11 +4,15 @@
 #include "NE_NodeId.hpp"
 
 #include <vector>
-#include <unordered_set>
+#include <unordered_map>
+#include <functional>
 
 namespace NE
 {
 
+// node ids are stored in insertion order, erased ids leave a null id behind
+// which is removed by the next compaction, so erase does not shift the vector,
+// positional access is linear until the next compaction if there are erased ids
 class NodeCollection
 {
 	SERIALIZABLE;
@@ -28,6 +32,10 @@ public:
 	void				Erase (const NodeId& nodeId);
 	void				Clear ();
 
+	void				Union (const NodeCollection& rhs);
+	void				Difference (const NodeCollection& rhs);
+	void				SymmetricDifference (const NodeCollection& rhs);
+
 	bool				operator== (const NodeCollection& rhs) const;
 	bool				operator!= (const NodeCollection& rhs) const;
 
@@ -35,8 +43,11 @@ public:
 	Stream::Status		Write (OutputStream& outputStream) const;
 
 private:
-	std::vector<NodeId>			nodes;
-	std::unordered_set<NodeId>	nodeSet;
+	void				CompactIfNeeded ();
+
+	std::vector<NodeId>					nodes;
+	std::unordered_map<NodeId, size_t>	nodeToIndex;
+	size_t								erasedCount;
 };
 
 extern const NodeCollection EmptyNodeCollection;
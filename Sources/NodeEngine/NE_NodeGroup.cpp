@@ -1,13 +1,33 @@
 #include "NE_NodeGroup.hpp"
 #include "NE_MemoryStream.hpp"
+#include "NE_Debug.hpp"
 
 namespace NE
 {
 
 SERIALIZATION_INFO (NodeGroup, 2);
 
+NodeGroupChangeHandler::NodeGroupChangeHandler ()
+{
+
+}
+
+NodeGroupChangeHandler::~NodeGroupChangeHandler ()
+{
+
+}
+
 NodeGroup::NodeGroup () :
-	id (NullNodeGroupId)
+	id (NullNodeGroupId),
+	changeHandler (nullptr)
+{
+
+}
+
+NodeGroup::NodeGroup (const NodeGroup& src) :
+	DynamicSerializable (),
+	id (src.id),
+	changeHandler (nullptr)
 {
 
 }
@@ -22,6 +42,14 @@ const NodeGroupId& NodeGroup::GetId () const
 	return id;
 }
 
+void NodeGroup::BeforeChange () const
+{
+	if (changeHandler == nullptr) {
+		return;
+	}
+	changeHandler->BeforeNodeGroupChange (id);
+}
+
 Stream::Status NodeGroup::Read (InputStream& inputStream)
 {
 	ObjectHeader header (inputStream);
@@ -38,15 +66,19 @@ Stream::Status NodeGroup::Write (OutputStream& outputStream) const
 	return outputStream.GetStatus ();
 }
 
+NodeGroupPtr NodeGroup::CloneGroup () const
+{
+	return nullptr;
+}
+
 NodeGroupPtr NodeGroup::Clone (const NodeGroupConstPtr& nodeGroup)
 {
-	MemoryOutputStream outputStream;
-	if (DBGERROR (!WriteDynamicObject (outputStream, nodeGroup.get ()))) {
-		return nullptr;
+	// groups without direct cloning support are cloned through serialization
+	NodeGroupPtr result = nodeGroup->CloneGroup ();
+	if (result == nullptr) {
+		result = CloneDynamicObject (nodeGroup.get ());
 	}
 
-	MemoryInputStream inputStream (outputStream.GetBuffer ());
-	NodeGroupPtr result (ReadDynamicObject<NodeGroup> (inputStream));
 	if (DBGERROR (result == nullptr)) {
 		return nullptr;
 	}
@@ -59,4 +91,35 @@ void NodeGroup::SetId (const NodeGroupId& newId)
 	id = newId;
 }
 
+void NodeGroup::SetChangeHandler (const NodeGroupChangeHandlerConstPtr& newChangeHandler)
+{
+	changeHandler = newChangeHandler;
+}
+
+void NodeGroup::ClearChangeHandler ()
+{
+	changeHandler = nullptr;
+}
+
+bool NodeGroup::RestoreState (const NodeGroupConstPtr& savedState)
+{
+	MemoryOutputStream outputStream;
+	if (DBGERROR (savedState->Write (outputStream) != Stream::Status::NoError)) {
+		return false;
+	}
+	MemoryInputStream inputStream (outputStream.GetBuffer ());
+	return Read (inputStream) == Stream::Status::NoError;
+}
+
+bool NodeGroup::IsEqual (const NodeGroupConstPtr& aNodeGroup, const NodeGroupConstPtr& bNodeGroup)
+{
+	MemoryOutputStream aStream;
+	MemoryOutputStream bStream;
+
+	aNodeGroup->Write (aStream);
+	bNodeGroup->Write (bStream);
+
+	return aStream.GetBuffer () == bStream.GetBuffer ();
+}
+
 }
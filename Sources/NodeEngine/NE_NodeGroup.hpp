@@ -11,6 +11,17 @@
 namespace NE
 {
 
+class NodeGroupChangeHandler
+{
+public:
+	NodeGroupChangeHandler ();
+	virtual ~NodeGroupChangeHandler ();
+
+	virtual void	BeforeNodeGroupChange (const NodeGroupId& groupId) const = 0;
+};
+
+using NodeGroupChangeHandlerConstPtr = std::shared_ptr<const NodeGroupChangeHandler>;
+
 class NodeGroup : public DynamicSerializable
 {
 	SERIALIZABLE;
@@ -21,16 +32,26 @@ public:
 	~NodeGroup ();
 
 	const NodeGroupId&		GetId () const;
+	void					BeforeChange () const;
 
 	virtual Stream::Status	Read (InputStream& inputStream) override;
 	virtual Stream::Status	Write (OutputStream& outputStream) const override;
+	virtual NodeGroupPtr	CloneGroup () const;
 
 	static NodeGroupPtr		Clone (const NodeGroupConstPtr& nodeGroup);
+	static bool				IsEqual (const NodeGroupConstPtr& aNodeGroup, const NodeGroupConstPtr& bNodeGroup);
+
+protected:
+	NodeGroup (const NodeGroup& src);
 
 private:
 	void					SetId (const NodeGroupId& newId);
+	void					SetChangeHandler (const NodeGroupChangeHandlerConstPtr& newChangeHandler);
+	void					ClearChangeHandler ();
+	bool					RestoreState (const NodeGroupConstPtr& savedState);
 
-	NodeGroupId				id;
+	NodeGroupId						id;
+	NodeGroupChangeHandlerConstPtr	changeHandler;
 };
 
 }
@@ -29,10 +29,32 @@ public:
 	void			Enumerate (const std::function<bool (NodePtr)>& processor);
 	void			Enumerate (const std::function<bool (NodeConstPtr)>& processor) const;
 
+	template <class Processor>
+	void			Enumerate (const Processor& processor);
+
+	template <class Processor>
+	void			Enumerate (const Processor& processor) const;
+
 private:
 	OrderedMap<NodeId, NodePtr>		nodes;
 };
 
+template <class Processor>
+void NodeList::Enumerate (const Processor& processor)
+{
+	nodes.Enumerate ([&] (NodePtr& node) {
+		return processor (node);
+	});
+}
+
+template <class Processor>
+void NodeList::Enumerate (const Processor& processor) const
+{
+	nodes.Enumerate ([&] (const NodePtr& node) {
+		return processor (NodeConstPtr (node));
+	});
+}
+
 }
 
 #endif
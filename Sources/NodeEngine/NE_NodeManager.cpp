@@ -7,10 +7,13 @@
 #include "NE_MemoryStream.hpp"
 #include "NE_NodeManagerSerialization.hpp"
 
+#include <unordered_set>
+#include <unordered_map>
+
 namespace NE
 {
 
-SERIALIZATION_INFO (NodeManager, 4);
+SERIALIZATION_INFO (NodeManager, 5);
 
 template <typename SlotListType, typename SlotType>
 static bool HasDuplicates (const SlotListType& slots)
@@ -27,6 +30,57 @@ static bool HasDuplicates (const SlotListType& slots)
 	return hasDuplicates;
 }
 
+static bool WillCreateCycle (const NodeManager& nodeManager, const std::vector<SlotConnection>& connections, const std::unordered_set<InputSlotConstPtr>& replacedInputSlots)
+{
+	// build the node dependency graph as it would be after the connections,
+	// and check if it can be sorted topologically
+	std::unordered_map<NodeId, size_t> nodeIdToIndex;
+	nodeManager.EnumerateNodes ([&] (NodeConstPtr node) {
+		nodeIdToIndex.insert ({ node->GetId (), nodeIdToIndex.size () });
+		return true;
+	});
+
+	std::vector<std::vector<size_t>> dependentNodes (nodeIdToIndex.size ());
+	std::vector<size_t> inDegrees (nodeIdToIndex.size (), 0);
+	auto addEdge = [&] (const OutputSlotConstPtr& outputSlot, const InputSlotConstPtr& inputSlot) {
+		size_t outputNodeIndex = nodeIdToIndex.at (outputSlot->GetOwnerNodeId ());
+		size_t inputNodeIndex = nodeIdToIndex.at (inputSlot->GetOwnerNodeId ());
+		dependentNodes[outputNodeIndex].push_back (inputNodeIndex);
+		inDegrees[inputNodeIndex] += 1;
+	};
+
+	nodeManager.EnumerateConnections ([&] (const OutputSlotConstPtr& outputSlot, const InputSlotConstPtr& inputSlot) {
+		if (replacedInputSlots.find (inputSlot) == replacedInputSlots.end ()) {
+			addEdge (outputSlot, inputSlot);
+		}
+	});
+	for (const SlotConnection& connection : connections) {
+		addEdge (connection.first, connection.second);
+	}
+
+	std::vector<size_t> nodesToProcess;
+	for (size_t i = 0; i < inDegrees.size (); i++) {
+		if (inDegrees[i] == 0) {
+			nodesToProcess.push_back (i);
+		}
+	}
+
+	size_t processedNodeCount = 0;
+	while (!nodesToProcess.empty ()) {
+		size_t nodeIndex = nodesToProcess.back ();
+		nodesToProcess.pop_back ();
+		processedNodeCount += 1;
+		for (size_t dependentNodeIndex : dependentNodes[nodeIndex]) {
+			inDegrees[dependentNodeIndex] -= 1;
+			if (inDegrees[dependentNodeIndex] == 0) {
+				nodesToProcess.push_back (dependentNodeIndex);
+			}
+		}
+	}
+
+	return processedNodeCount != inDegrees.size ();
+}
+
 class NodeManagerNodeEvaluator : public NodeEvaluator
 {
 public:
@@ -42,6 +96,11 @@ public:
 		nodeManager.InvalidateNodeValue (nodeId);
 	}
 
+	virtual void BeforeNodeChange (const NodeId& nodeId) const override
+	{
+		nodeManager.BeforeNodeChange (nodeId);
+	}
+
 	virtual bool HasConnectedOutputSlots (const InputSlotConstPtr& inputSlot) const override
 	{
 		return nodeManager.HasConnectedOutputSlots (inputSlot);
@@ -77,6 +136,97 @@ private:
 	NodeValueCache&		nodeValueCache;
 };
 
+class NodeManagerNodeGroupChangeHandler : public NodeGroupChangeHandler
+{
+public:
+	NodeManagerNodeGroupChangeHandler (NodeManager& nodeManager) :
+		nodeManager (nodeManager)
+	{
+
+	}
+
+	virtual void BeforeNodeGroupChange (const NodeGroupId& groupId) const override
+	{
+		nodeManager.BeforeNodeGroupChange (groupId);
+	}
+
+private:
+	NodeManager&	nodeManager;
+};
+
+// everything is recorded before its first change in the batch, so a rollback restores only the changed parts,
+// and the node, slot and group objects that existed before the batch remain the same objects
+class NodeManagerBatchLog
+{
+public:
+	using DeletedNode = std::pair<NodeId, NodePtr>;
+	using SlotConnections = std::pair<SlotInfo, std::vector<SlotInfo>>;
+	using GroupNodes = std::pair<NodeGroupConstPtr, NodeCollection>;
+	using GroupState = std::pair<NodeGroupPtr, GroupNodes>;
+
+	NodeManagerBatchLog () :
+		addedNodes (),
+		deletedNodes (),
+		nodeStates (),
+		savedInputSlots (),
+		savedOutputSlots (),
+		inputSlotConnections (),
+		outputSlotConnections (),
+		addedGroups (),
+		groupStates ()
+	{
+
+	}
+
+	bool SaveInputSlot (const ConnectionManager& connectionManager, const InputSlotConstPtr& inputSlot)
+	{
+		SlotInfo inputSlotInfo (inputSlot->GetOwnerNodeId (), inputSlot->GetId ());
+		if (!savedInputSlots.insert (inputSlotInfo).second) {
+			return false;
+		}
+		std::vector<SlotInfo> outputSlots;
+		connectionManager.EnumerateConnectedOutputSlots (inputSlot, [&] (const OutputSlotConstPtr& outputSlot) {
+			outputSlots.push_back (SlotInfo (outputSlot->GetOwnerNodeId (), outputSlot->GetId ()));
+		});
+		inputSlotConnections.push_back ({ inputSlotInfo, outputSlots });
+		return true;
+	}
+
+	bool SaveOutputSlot (const ConnectionManager& connectionManager, const OutputSlotConstPtr& outputSlot)
+	{
+		SlotInfo outputSlotInfo (outputSlot->GetOwnerNodeId (), outputSlot->GetId ());
+		if (!savedOutputSlots.insert (outputSlotInfo).second) {
+			return false;
+		}
+		std::vector<SlotInfo> inputSlots;
+		connectionManager.EnumerateConnectedInputSlots (outputSlot, [&] (const InputSlotConstPtr& inputSlot) {
+			inputSlots.push_back (SlotInfo (inputSlot->GetOwnerNodeId (), inputSlot->GetId ()));
+		});
+		outputSlotConnections.push_back ({ outputSlotInfo, inputSlots });
+		return true;
+	}
+
+	NodeCollection									addedNodes;
+	std::vector<DeletedNode>						deletedNodes;
+	std::unordered_map<NodeId, NodeConstPtr>		nodeStates;
+	std::unordered_set<SlotInfo>					savedInputSlots;
+	std::unordered_set<SlotInfo>					savedOutputSlots;
+	std::vector<SlotConnections>					inputSlotConnections;
+	std::vector<SlotConnections>					outputSlotConnections;
+	std::unordered_set<NodeGroupId>					addedGroups;
+	std::unordered_map<NodeGroupId, GroupState>		groupStates;
+};
+
+NodeManagerChangeHandler::NodeManagerChangeHandler ()
+{
+
+}
+
+NodeManagerChangeHandler::~NodeManagerChangeHandler ()
+{
+
+}
+
 OutputSlotList::OutputSlotList ()
 {
 
@@ -113,11 +263,18 @@ NodeManager::NodeManager () :
 	connectionManager (),
 	nodeGroupList (),
 	updateMode (UpdateMode::Automatic),
+	nodeAdjacency (nullptr),
+	batchDepth (0),
+	batchLog (nullptr),
+	batchChangedNodes (),
 	nodeValueCache (),
 	nodeEvaluator (nullptr),
+	nodeGroupChangeHandler (nullptr),
+	changeHandler (nullptr),
 	isForceCalculate (false)
 {
 	nodeEvaluator.reset (new NodeManagerNodeEvaluator (*this, nodeValueCache));
+	nodeGroupChangeHandler.reset (new NodeManagerNodeGroupChangeHandler (*this));
 }
 
 NodeManager::~NodeManager ()
@@ -130,11 +287,20 @@ void NodeManager::Clear ()
 	idGenerator.Clear ();
 	nodeList.Clear ();
 	connectionManager.Clear ();
+	nodeGroupList.Enumerate ([&] (const NodeGroupPtr& group) {
+		group->ClearChangeHandler ();
+		return true;
+	});
 	nodeGroupList.Clear ();
+	nodeAdjacency.reset ();
+	batchDepth = 0;
+	batchLog.reset ();
+	batchChangedNodes.Clear ();
 	updateMode = UpdateMode::Automatic;
 
 	nodeValueCache.Clear ();
 	nodeEvaluator.reset (new NodeManagerNodeEvaluator (*this, nodeValueCache));
+	nodeGroupChangeHandler.reset (new NodeManagerNodeGroupChangeHandler (*this));
 	isForceCalculate = false;
 }
 
@@ -143,6 +309,56 @@ bool NodeManager::IsEmpty () const
 	return nodeList.IsEmpty () && nodeGroupList.IsEmpty () && connectionManager.IsEmpty ();
 }
 
+void NodeManager::SetChangeHandler (NodeManagerChangeHandler* newChangeHandler)
+{
+	changeHandler = newChangeHandler;
+}
+
+void NodeManager::BeginBatch ()
+{
+	if (batchDepth == 0) {
+		batchLog.reset (new NodeManagerBatchLog ());
+	}
+	batchDepth += 1;
+}
+
+bool NodeManager::EndBatch ()
+{
+	if (DBGERROR (batchDepth == 0)) {
+		return false;
+	}
+
+	batchDepth -= 1;
+	if (batchDepth > 0) {
+		return true;
+	}
+
+	// connections were not checked for cycles inside the batch
+	bool isValid = !WillCreateCycle (*this, {}, {});
+	if (!isValid) {
+		RollbackBatch ();
+	}
+
+	NodeCollection changedNodes;
+	batchChangedNodes.Enumerate ([&] (const NodeId& nodeId) {
+		if (ContainsNode (nodeId)) {
+			changedNodes.Insert (nodeId);
+		}
+		return true;
+	});
+
+	batchLog.reset ();
+	batchChangedNodes.Clear ();
+
+	InvalidateNodeValues (changedNodes);
+	return isValid;
+}
+
+bool NodeManager::IsInBatch () const
+{
+	return batchDepth > 0;
+}
+
 size_t NodeManager::GetNodeCount () const
 {
 	return nodeList.Count ();
@@ -206,20 +422,36 @@ bool NodeManager::DeleteNode (const NodePtr& node)
 		return false;
 	}
 
-	nodeGroupList.RemoveNodeFromGroup (node->GetId ());
+	if (IsInBatch ()) {
+		node->EnumerateInputSlots ([&] (InputSlotConstPtr inputSlot) {
+			SaveBatchConnections (inputSlot);
+			return true;
+		});
+		node->EnumerateOutputSlots ([&] (OutputSlotConstPtr outputSlot) {
+			SaveBatchConnections (outputSlot);
+			return true;
+		});
+		if (batchLog->addedNodes.Contains (node->GetId ())) {
+			batchLog->addedNodes.Erase (node->GetId ());
+		} else {
+			batchLog->deletedNodes.push_back ({ node->GetId (), node });
+		}
+	}
+
+	RemoveNodeFromNodeGroupList (node->GetId ());
 	node->InvalidateValue ();
 
 	node->EnumerateInputSlots ([&] (InputSlotConstPtr inputSlot) {
-		connectionManager.DisconnectAllOutputSlotsFromInputSlot (inputSlot);
+		ModifyConnections ().DisconnectAllOutputSlotsFromInputSlot (inputSlot);
 		return true;
 	});
 
 	node->EnumerateOutputSlots ([&] (OutputSlotConstPtr outputSlot) {
-		connectionManager.DisconnectAllInputSlotsFromOutputSlot (outputSlot);
+		ModifyConnections ().DisconnectAllInputSlotsFromOutputSlot (outputSlot);
 		return true;
 	});
 
-	nodeList.DeleteNode (node->GetId ());
+	ModifyNodeList ().DeleteNode (node->GetId ());
 	node->ClearEvaluator ();
 
 	return true;
@@ -254,18 +486,7 @@ bool NodeManager::CanConnectOutputSlotToInputSlot (const OutputSlotConstPtr& out
 		return false;
 	}
 
-	bool willCreateCycle = false;
-	if (outputNode == inputNode) {
-		willCreateCycle = true;
-	} else {
-		EnumerateDependentNodesRecursive (inputNode, [&] (const NodeConstPtr& dependentNode) {
-			if (outputNode == dependentNode) {
-				willCreateCycle = true;
-			}
-		});
-	}
-
-	if (willCreateCycle) {
+	if (outputNode == inputNode || IsDependentNode (inputNode->GetId (), outputNode->GetId ())) {
 		return false;
 	}
 
@@ -318,14 +539,58 @@ bool NodeManager::CanConnectOutputSlotToInputSlots (const OutputSlotConstPtr& ou
 	return canConnect;
 }
 
+bool NodeManager::CanConnectOutputSlotsToInputSlots (const std::vector<SlotConnection>& connections) const
+{
+	std::unordered_map<InputSlotConstPtr, std::unordered_set<OutputSlotConstPtr>> connectionsByInputSlot;
+	std::unordered_set<InputSlotConstPtr> replacedInputSlots;
+	for (const SlotConnection& connection : connections) {
+		const OutputSlotConstPtr& outputSlot = connection.first;
+		const InputSlotConstPtr& inputSlot = connection.second;
+		if (DBGERROR (outputSlot == nullptr || inputSlot == nullptr)) {
+			return false;
+		}
+		if (DBGERROR (!ContainsNode (outputSlot->GetOwnerNodeId ()) || !ContainsNode (inputSlot->GetOwnerNodeId ()))) {
+			return false;
+		}
+		if (!connectionManager.CanConnectOutputSlotToInputSlot (outputSlot, inputSlot)) {
+			return false;
+		}
+		std::unordered_set<OutputSlotConstPtr>& outputSlots = connectionsByInputSlot[inputSlot];
+		if (outputSlots.find (outputSlot) != outputSlots.end ()) {
+			return false;
+		}
+		outputSlots.insert (outputSlot);
+		if (inputSlot->GetOutputSlotConnectionMode () == OutputSlotConnectionMode::Single) {
+			if (outputSlots.size () > 1) {
+				return false;
+			}
+			replacedInputSlots.insert (inputSlot);
+		}
+	}
+
+	if (WillCreateCycle (*this, connections, replacedInputSlots)) {
+		return false;
+	}
+
+	return true;
+}
+
 bool NodeManager::ConnectOutputSlotToInputSlot (const OutputSlotConstPtr& outputSlot, const InputSlotConstPtr& inputSlot)
 {
-	if (DBGERROR (!CanConnectOutputSlotToInputSlot (outputSlot, inputSlot))) {
+	if (IsInBatch ()) {
+		if (DBGERROR (outputSlot == nullptr || inputSlot == nullptr)) {
+			return false;
+		}
+		if (DBGERROR (!connectionManager.CanConnectOutputSlotToInputSlot (outputSlot, inputSlot))) {
+			return false;
+		}
+	} else if (DBGERROR (!CanConnectOutputSlotToInputSlot (outputSlot, inputSlot))) {
 		return false;
 	}
 
+	SaveBatchConnections (outputSlot, inputSlot);
 	InvalidateNodeValue (GetNode (inputSlot->GetOwnerNodeId ()));
-	return connectionManager.ConnectOutputSlotToInputSlot (outputSlot, inputSlot);
+	return ModifyConnections ().ConnectOutputSlotToInputSlot (outputSlot, inputSlot);
 }
 
 bool NodeManager::ConnectOutputSlotsToInputSlot (const OutputSlotList& outputSlots, const InputSlotConstPtr& inputSlot)
@@ -362,6 +627,32 @@ bool NodeManager::ConnectOutputSlotToInputSlots (const OutputSlotConstPtr& outpu
 	return success;
 }
 
+bool NodeManager::ConnectOutputSlotsToInputSlots (const std::vector<SlotConnection>& connections)
+{
+	if (connections.empty ()) {
+		return true;
+	}
+
+	if (DBGERROR (!CanConnectOutputSlotsToInputSlots (connections))) {
+		return false;
+	}
+
+	NodeCollection changedNodes;
+	for (const SlotConnection& connection : connections) {
+		SaveBatchConnections (connection.first, connection.second);
+		if (DBGERROR (!ModifyConnections ().ConnectOutputSlotToInputSlot (connection.first, connection.second))) {
+			return false;
+		}
+		NodeId inputNodeId = connection.second->GetOwnerNodeId ();
+		if (!changedNodes.Contains (inputNodeId)) {
+			changedNodes.Insert (inputNodeId);
+		}
+	}
+
+	InvalidateNodeValues (changedNodes);
+	return true;
+}
+
 bool NodeManager::DisconnectOutputSlotFromInputSlot (const OutputSlotConstPtr& outputSlot, const InputSlotConstPtr& inputSlot)
 {
 	if (DBGERROR (outputSlot == nullptr || inputSlot == nullptr)) {
@@ -372,8 +663,9 @@ bool NodeManager::DisconnectOutputSlotFromInputSlot (const OutputSlotConstPtr& o
 		return false;
 	}
 
+	SaveBatchConnections (outputSlot, inputSlot);
 	InvalidateNodeValue (GetNode (inputSlot->GetOwnerNodeId ()));
-	return connectionManager.DisconnectOutputSlotFromInputSlot (outputSlot, inputSlot);
+	return ModifyConnections ().DisconnectOutputSlotFromInputSlot (outputSlot, inputSlot);
 }
 
 bool NodeManager::DisconnectOutputSlotsFromInputSlot (const OutputSlotList& outputSlots, const InputSlotConstPtr& inputSlot)
@@ -444,14 +736,16 @@ bool NodeManager::DisconnectOutputSlotFromInputSlots (const OutputSlotConstPtr&
 
 bool NodeManager::DisconnectAllInputSlotsFromOutputSlot (const OutputSlotConstPtr& outputSlot)
 {
+	SaveBatchConnections (outputSlot);
 	InvalidateNodeValue (GetNode (outputSlot->GetOwnerNodeId ()));
-	return connectionManager.DisconnectAllInputSlotsFromOutputSlot (outputSlot);
+	return ModifyConnections ().DisconnectAllInputSlotsFromOutputSlot (outputSlot);
 }
 
 bool NodeManager::DisconnectAllOutputSlotsFromInputSlot (const InputSlotConstPtr& inputSlot)
 {
+	SaveBatchConnections (inputSlot);
 	InvalidateNodeValue (GetNode (inputSlot->GetOwnerNodeId ()));
-	return connectionManager.DisconnectAllOutputSlotsFromInputSlot (inputSlot);
+	return ModifyConnections ().DisconnectAllOutputSlotsFromInputSlot (inputSlot);
 }
 
 bool NodeManager::HasConnectedOutputSlots (const InputSlotConstPtr& inputSlot) const
@@ -486,15 +780,7 @@ void NodeManager::EnumerateConnectedInputSlots (const OutputSlotConstPtr& output
 
 void NodeManager::EnumerateConnections (const std::function<void (const OutputSlotConstPtr&, const InputSlotConstPtr&)>& processor) const
 {
-	nodeList.Enumerate ([&] (const NodeConstPtr& node) {
-		node->EnumerateOutputSlots ([&] (OutputSlotConstPtr outputSlot) {
-			connectionManager.EnumerateConnectedInputSlots (outputSlot, [&] (const InputSlotConstPtr& inputSlot) {
-				processor (outputSlot, inputSlot);
-			});
-			return true;
-		});
-		return true;
-	});
+	EnumerateConnections<std::function<void (const OutputSlotConstPtr&, const InputSlotConstPtr&)>> (processor);
 }
 
 void NodeManager::EnumerateConnections (const NodeCollection& nodes, const std::function<void (const OutputSlotConstPtr&, const InputSlotConstPtr&)>& processor) const
@@ -539,6 +825,30 @@ void NodeManager::ForceEvaluateAllNodes (EvaluationEnv& env) const
 	EvaluateAllNodes (env);
 }
 
+static void PushDependentNodes (const NodeAdjacency& adjacency, size_t nodeIndex, std::vector<size_t>& nodesToVisit)
+{
+	// pushed in reverse order, so the first dependent is visited first
+	size_t dependentCount = adjacency.GetDependentNodeCount (nodeIndex);
+	for (size_t i = dependentCount; i > 0; i--) {
+		nodesToVisit.push_back (adjacency.GetDependentNode (nodeIndex, i - 1));
+	}
+}
+
+template <class Processor>
+static void EnumerateReachableNodes (const NodeAdjacency& adjacency, std::vector<bool>& visitedNodes, std::vector<size_t>& nodesToVisit, const Processor& processor)
+{
+	while (!nodesToVisit.empty ()) {
+		size_t nodeIndex = nodesToVisit.back ();
+		nodesToVisit.pop_back ();
+		if (visitedNodes[nodeIndex]) {
+			continue;
+		}
+		visitedNodes[nodeIndex] = true;
+		processor (nodeIndex);
+		PushDependentNodes (adjacency, nodeIndex, nodesToVisit);
+	}
+}
+
 void NodeManager::InvalidateNodeValue (const NodeId& nodeId) const
 {
 	NodeConstPtr node = GetNode (nodeId);
@@ -551,29 +861,95 @@ void NodeManager::InvalidateNodeValue (const NodeConstPtr& node) const
 	if (nodeValueCache.Contains (nodeId)) {
 		nodeValueCache.Remove (nodeId);
 	}
-	EnumerateDependentNodes (node, [&] (const NodeConstPtr& dependentNode) {
-		InvalidateNodeValue (dependentNode);
+	if (IsInBatch ()) {
+		// the graph may contain cycles here, dependents are invalidated at the end of the batch
+		auto addChangedNode = [&] (const NodeId& changedNodeId) {
+			if (!batchChangedNodes.Contains (changedNodeId)) {
+				batchChangedNodes.Insert (changedNodeId);
+			}
+		};
+		addChangedNode (nodeId);
+		EnumerateDependentNodeIds (node, addChangedNode);
+		return;
+	}
+
+	// the adjacency may be out of date here, so the dependents are collected by id without rebuilding it
+	std::unordered_set<NodeId> visitedNodes;
+	std::vector<NodeId> nodesToInvalidate;
+	visitedNodes.insert (nodeId);
+	EnumerateDependentNodeIds (node, [&] (const NodeId& dependentNodeId) {
+		nodesToInvalidate.push_back (dependentNodeId);
 	});
+
+	while (!nodesToInvalidate.empty ()) {
+		NodeId dependentNodeId = nodesToInvalidate.back ();
+		nodesToInvalidate.pop_back ();
+		if (!visitedNodes.insert (dependentNodeId).second) {
+			continue;
+		}
+		if (nodeValueCache.Contains (dependentNodeId)) {
+			nodeValueCache.Remove (dependentNodeId);
+		}
+		EnumerateDependentNodeIds (GetNode (dependentNodeId), [&] (const NodeId& nextNodeId) {
+			nodesToInvalidate.push_back (nextNodeId);
+		});
+	}
 }
 
-void NodeManager::EnumerateDependentNodes (const NodeConstPtr& node, const std::function<void (const NodeId&)>& processor) const
+void NodeManager::InvalidateNodeValues (const NodeCollection& nodes) const
 {
-	node->EnumerateOutputSlots ([&] (OutputSlotConstPtr outputSlot) {
-		if (connectionManager.HasConnectedInputSlots (outputSlot)) {
-			connectionManager.EnumerateConnectedInputSlots (outputSlot, [&] (const InputSlotConstPtr& inputSlot) {
-				processor (inputSlot->GetOwnerNodeId ());
-			});
-		}
+	if (IsInBatch ()) {
+		nodes.Enumerate ([&] (const NodeId& nodeId) {
+			InvalidateNodeValue (nodeId);
+			return true;
+		});
+		return;
+	}
+
+	const NodeAdjacency& adjacency = GetNodeAdjacency ();
+	std::vector<bool> visitedNodes (adjacency.GetNodeCount (), false);
+	std::vector<size_t> nodesToInvalidate;
+	nodes.Enumerate ([&] (const NodeId& nodeId) {
+		nodesToInvalidate.push_back (adjacency.GetNodeIndex (nodeId));
 		return true;
 	});
+
+	EnumerateReachableNodes (adjacency, visitedNodes, nodesToInvalidate, [&] (size_t nodeIndex) {
+		const NodeId& nodeId = adjacency.GetNodeId (nodeIndex);
+		if (nodeValueCache.Contains (nodeId)) {
+			nodeValueCache.Remove (nodeId);
+		}
+	});
+}
+
+const NodeAdjacency& NodeManager::GetNodeAdjacency () const
+{
+	if (nodeAdjacency == nullptr) {
+		nodeAdjacency.reset (new NodeAdjacency (nodeList, connectionManager));
+	}
+	return *nodeAdjacency;
+}
+
+void NodeManager::EnumerateDependentNodes (const NodeConstPtr& node, const std::function<void (const NodeId&)>& processor) const
+{
+	EnumerateDependentNodeIds (node, processor);
 }
 
 void NodeManager::EnumerateDependentNodesRecursive (const NodeConstPtr& node, const std::function<void (const NodeId&)>& processor) const
 {
-	EnumerateDependentNodes (node, [&] (const NodeId& dependentNodeId) {
-		NodeConstPtr dependentNode = GetNode (dependentNodeId);
-		processor (dependentNodeId);
-		EnumerateDependentNodesRecursive (dependentNode, processor);
+	const NodeAdjacency& adjacency = GetNodeAdjacency ();
+	if (DBGERROR (!adjacency.ContainsNode (node->GetId ()))) {
+		return;
+	}
+
+	size_t nodeIndex = adjacency.GetNodeIndex (node->GetId ());
+	std::vector<bool> visitedNodes (adjacency.GetNodeCount (), false);
+	std::vector<size_t> nodesToEnumerate;
+	visitedNodes[nodeIndex] = true;
+	PushDependentNodes (adjacency, nodeIndex, nodesToEnumerate);
+
+	EnumerateReachableNodes (adjacency, visitedNodes, nodesToEnumerate, [&] (size_t dependentNodeIndex) {
+		processor (adjacency.GetNodeId (dependentNodeIndex));
 	});
 }
 
@@ -617,24 +993,215 @@ NodeGroupPtr NodeManager::AddNodeGroup (const NodeGroupPtr& group)
 
 void NodeManager::MakeNodesAndGroupsSorted ()
 {
-	nodeList.MakeSorted ();
+	ModifyNodeList ().MakeSorted ();
 	nodeGroupList.MakeSorted ();
 }
 
+bool NodeManager::IsDependentNode (const NodeId& nodeId, const NodeId& dependentNodeId) const
+{
+	std::unordered_set<NodeId> visitedNodes;
+	std::vector<NodeId> nodesToProcess = { nodeId };
+	while (!nodesToProcess.empty ()) {
+		NodeId currentNodeId = nodesToProcess.back ();
+		nodesToProcess.pop_back ();
+		if (currentNodeId == dependentNodeId) {
+			return true;
+		}
+		if (visitedNodes.find (currentNodeId) != visitedNodes.end ()) {
+			continue;
+		}
+		visitedNodes.insert (currentNodeId);
+		EnumerateDependentNodes (GetNode (currentNodeId), [&] (const NodeId& nextNodeId) {
+			nodesToProcess.push_back (nextNodeId);
+		});
+	}
+	return false;
+}
+
+void NodeManager::RollbackBatch ()
+{
+	// added nodes are deleted first, so the deleted ones can be added back with their original ids,
+	// the id generator is kept to avoid reusing ids
+	batchLog->addedNodes.Enumerate ([&] (const NodeId& nodeId) {
+		if (ContainsNode (nodeId)) {
+			DeleteNode (GetNode (nodeId));
+		}
+		return true;
+	});
+	for (const NodeManagerBatchLog::DeletedNode& deletedNode : batchLog->deletedNodes) {
+		deletedNode.second->SetId (deletedNode.first);
+		DBGVERIFY (AddNode (deletedNode.second, IdPolicy::KeepOriginal, InitPolicy::DoNotInitialize) != nullptr);
+		batchChangedNodes.Insert (deletedNode.first);
+	}
+	for (const auto& nodeState : batchLog->nodeStates) {
+		NodePtr node = GetNode (nodeState.first);
+		DBGVERIFY (node->RestoreState (nodeState.second));
+		batchChangedNodes.Insert (nodeState.first);
+	}
+
+	// the saved graph was valid, so connections are restored without checks
+	for (const NodeManagerBatchLog::SlotConnections& inputSlotConnections : batchLog->inputSlotConnections) {
+		const SlotInfo& inputSlotInfo = inputSlotConnections.first;
+		if (!ContainsNode (inputSlotInfo.GetNodeId ())) {
+			continue;
+		}
+		InputSlotConstPtr inputSlot = GetNode (inputSlotInfo.GetNodeId ())->GetInputSlot (inputSlotInfo.GetSlotId ());
+		ModifyConnections ().DisconnectAllOutputSlotsFromInputSlot (inputSlot);
+		for (const SlotInfo& outputSlotInfo : inputSlotConnections.second) {
+			OutputSlotConstPtr outputSlot = GetNode (outputSlotInfo.GetNodeId ())->GetOutputSlot (outputSlotInfo.GetSlotId ());
+			DBGVERIFY (ModifyConnections ().ConnectOutputSlotToInputSlot (outputSlot, inputSlot));
+		}
+		batchChangedNodes.Insert (inputSlotInfo.GetNodeId ());
+	}
+	for (const NodeManagerBatchLog::SlotConnections& outputSlotConnections : batchLog->outputSlotConnections) {
+		const SlotInfo& outputSlotInfo = outputSlotConnections.first;
+		if (!ContainsNode (outputSlotInfo.GetNodeId ())) {
+			continue;
+		}
+		OutputSlotConstPtr outputSlot = GetNode (outputSlotInfo.GetNodeId ())->GetOutputSlot (outputSlotInfo.GetSlotId ());
+		std::vector<InputSlotConstPtr> inputSlots;
+		for (const SlotInfo& inputSlotInfo : outputSlotConnections.second) {
+			inputSlots.push_back (GetNode (inputSlotInfo.GetNodeId ())->GetInputSlot (inputSlotInfo.GetSlotId ()));
+		}
+		ModifyConnections ().ReorderConnectedInputSlots (outputSlot, inputSlots);
+	}
+
+	// the changed groups are removed, and their saved objects are added back with their saved members
+	auto removeGroup = [&] (const NodeGroupId& groupId) {
+		if (nodeGroupList.Contains (groupId)) {
+			nodeGroupList.GetGroup (groupId)->ClearChangeHandler ();
+			nodeGroupList.DeleteGroup (groupId);
+		}
+	};
+	for (const NodeGroupId& groupId : batchLog->addedGroups) {
+		removeGroup (groupId);
+	}
+	for (const auto& groupState : batchLog->groupStates) {
+		removeGroup (groupState.first);
+	}
+	for (const auto& groupState : batchLog->groupStates) {
+		const NodeGroupPtr& group = groupState.second.first;
+		const NodeManagerBatchLog::GroupNodes& groupNodes = groupState.second.second;
+		DBGVERIFY (group->RestoreState (groupNodes.first));
+		DBGVERIFY (nodeGroupList.AddGroup (group));
+		group->SetChangeHandler (nodeGroupChangeHandler);
+		groupNodes.second.Enumerate ([&] (const NodeId& nodeId) {
+			nodeGroupList.AddNodeToGroup (groupState.first, nodeId);
+			return true;
+		});
+	}
+
+	MakeNodesAndGroupsSorted ();
+}
+
+void NodeManager::SaveBatchConnections (const InputSlotConstPtr& inputSlot)
+{
+	// reconnecting the input slot on rollback changes the order of connections on its output slots, too
+	if (!IsInBatch ()) {
+		return;
+	}
+	if (batchLog->SaveInputSlot (connectionManager, inputSlot)) {
+		connectionManager.EnumerateConnectedOutputSlots (inputSlot, [&] (const OutputSlotConstPtr& outputSlot) {
+			batchLog->SaveOutputSlot (connectionManager, outputSlot);
+		});
+	}
+}
+
+void NodeManager::SaveBatchConnections (const OutputSlotConstPtr& outputSlot)
+{
+	if (!IsInBatch ()) {
+		return;
+	}
+	batchLog->SaveOutputSlot (connectionManager, outputSlot);
+	connectionManager.EnumerateConnectedInputSlots (outputSlot, [&] (const InputSlotConstPtr& inputSlot) {
+		SaveBatchConnections (inputSlot);
+	});
+}
+
+void NodeManager::SaveBatchConnections (const OutputSlotConstPtr& outputSlot, const InputSlotConstPtr& inputSlot)
+{
+	if (!IsInBatch ()) {
+		return;
+	}
+	SaveBatchConnections (inputSlot);
+	batchLog->SaveOutputSlot (connectionManager, outputSlot);
+}
+
+void NodeManager::RemoveNodeFromNodeGroupList (const NodeId& nodeId)
+{
+	NodeGroupId groupId = nodeGroupList.GetNodeGroupId (nodeId);
+	if (groupId == NullNodeGroupId) {
+		return;
+	}
+
+	// the group is deleted with its last node
+	BeforeNodeGroupChange (groupId);
+	NodeGroupPtr group = nodeGroupList.GetGroup (groupId);
+	nodeGroupList.RemoveNodeFromGroup (nodeId);
+	if (!nodeGroupList.Contains (groupId)) {
+		group->ClearChangeHandler ();
+	}
+}
+
+void NodeManager::BeforeNodeChange (const NodeId& nodeId) const
+{
+	if (IsInBatch () && !batchLog->addedNodes.Contains (nodeId) && batchLog->nodeStates.find (nodeId) == batchLog->nodeStates.end ()) {
+		batchLog->nodeStates.insert ({ nodeId, Node::Clone (GetNode (nodeId)) });
+	}
+	if (changeHandler != nullptr) {
+		changeHandler->BeforeNodeChange (nodeId);
+	}
+}
+
+void NodeManager::BeforeNodeGroupChange (const NodeGroupId& groupId)
+{
+	if (IsInBatch () && batchLog->addedGroups.find (groupId) == batchLog->addedGroups.end () && batchLog->groupStates.find (groupId) == batchLog->groupStates.end ()) {
+		NodeGroupPtr group = nodeGroupList.GetGroup (groupId);
+		NodeManagerBatchLog::GroupNodes groupNodes (NodeGroup::Clone (group), nodeGroupList.GetGroupNodes (groupId));
+		batchLog->groupStates.insert ({ groupId, { group, groupNodes } });
+	}
+	if (changeHandler != nullptr) {
+		changeHandler->BeforeNodeGroupChange (groupId);
+	}
+}
+
+NodeList& NodeManager::ModifyNodeList ()
+{
+	nodeAdjacency.reset ();
+	return nodeList;
+}
+
+ConnectionManager& NodeManager::ModifyConnections ()
+{
+	nodeAdjacency.reset ();
+	return connectionManager;
+}
+
 void NodeManager::DeleteNodeGroup (const NodeGroupId& groupId)
 {
-	return nodeGroupList.DeleteGroup (groupId);
+	NodeGroupPtr group = nodeGroupList.GetGroup (groupId);
+	if (group == nullptr) {
+		return;
+	}
+	BeforeNodeGroupChange (groupId);
+	group->ClearChangeHandler ();
+	nodeGroupList.DeleteGroup (groupId);
 }
 
 void NodeManager::AddNodeToGroup (const NodeGroupId& groupId, const NodeId& nodeId)
 {
 	DBGASSERT (ContainsNode (nodeId));
+	if (nodeGroupList.GetNodeGroupId (nodeId) == groupId) {
+		return;
+	}
+	RemoveNodeFromNodeGroupList (nodeId);
+	BeforeNodeGroupChange (groupId);
 	nodeGroupList.AddNodeToGroup (groupId, nodeId);
 }
 
 void NodeManager::RemoveNodeFromGroup (const NodeId& nodeId)
 {
-	nodeGroupList.RemoveNodeFromGroup (nodeId);
+	RemoveNodeFromNodeGroupList (nodeId);
 }
 
 NodeGroupConstPtr NodeManager::GetNodeGroup (const NodeId& nodeId) const
@@ -659,6 +1226,11 @@ void NodeManager::EnumerateNodeGroups (const std::function<bool (NodeGroupPtr)>&
 
 void NodeManager::DeleteAllNodeGroups ()
 {
+	nodeGroupList.Enumerate ([&] (const NodeGroupPtr& group) {
+		BeforeNodeGroupChange (group->GetId ());
+		group->ClearChangeHandler ();
+		return true;
+	});
 	nodeGroupList.Clear ();
 }
 
@@ -684,7 +1256,12 @@ Stream::Status NodeManager::Read (InputStream& inputStream)
 
 Stream::Status NodeManager::Write (OutputStream& outputStream) const
 {
-	return NodeManagerSerialization::Write (*this, outputStream);
+	return Write (outputStream, NodeRecordMode::Inline);
+}
+
+Stream::Status NodeManager::Write (OutputStream& outputStream, NodeRecordMode recordMode) const
+{
+	return NodeManagerSerialization::Write (*this, outputStream, recordMode);
 }
 
 bool NodeManager::Clone (const NodeManager& source, NodeManager& target)
@@ -693,16 +1270,58 @@ bool NodeManager::Clone (const NodeManager& source, NodeManager& target)
 		return false;
 	}
 
-	MemoryOutputStream outputStream;
-	if (DBGERROR (source.Write (outputStream) != Stream::Status::NoError)) {
+	target.idGenerator = source.idGenerator;
+
+	bool success = true;
+	source.nodeList.Enumerate ([&] (const NodeConstPtr& sourceNode) {
+		NodePtr targetNode = Node::Clone (sourceNode);
+		if (DBGERROR (targetNode == nullptr)) {
+			success = false;
+			return false;
+		}
+		if (DBGERROR (target.AddNode (targetNode, IdPolicy::KeepOriginal, InitPolicy::DoNotInitialize) == nullptr)) {
+			success = false;
+			return false;
+		}
+		return true;
+	});
+	if (!success) {
 		return false;
 	}
 
-	MemoryInputStream inputStream (outputStream.GetBuffer ());
-	if (DBGERROR (target.Read (inputStream) != Stream::Status::NoError)) {
+	// the source graph is already valid, so connections are inserted without checks
+	source.EnumerateConnections ([&] (const OutputSlotConstPtr& sourceOutputSlot, const InputSlotConstPtr& sourceInputSlot) {
+		NodeConstPtr outputNode = target.GetNode (sourceOutputSlot->GetOwnerNodeId ());
+		NodeConstPtr inputNode = target.GetNode (sourceInputSlot->GetOwnerNodeId ());
+		OutputSlotConstPtr outputSlot = outputNode->GetOutputSlot (sourceOutputSlot->GetId ());
+		InputSlotConstPtr inputSlot = inputNode->GetInputSlot (sourceInputSlot->GetId ());
+		if (DBGERROR (!target.ModifyConnections ().ConnectOutputSlotToInputSlot (outputSlot, inputSlot))) {
+			success = false;
+		}
+	});
+	if (!success) {
 		return false;
 	}
 
+	source.EnumerateNodeGroups ([&] (NodeGroupConstPtr sourceGroup) {
+		NodeGroupPtr targetGroup = NodeGroup::Clone (sourceGroup);
+		if (DBGERROR (targetGroup == nullptr)) {
+			success = false;
+			return false;
+		}
+		target.AddNodeGroup (targetGroup, IdPolicy::KeepOriginal);
+		const NodeCollection& groupNodes = source.GetGroupNodes (sourceGroup->GetId ());
+		groupNodes.Enumerate ([&] (const NodeId& nodeId) {
+			target.AddNodeToGroup (targetGroup->GetId (), nodeId);
+			return true;
+		});
+		return true;
+	});
+	if (!success) {
+		return false;
+	}
+
+	target.updateMode = source.updateMode;
 	return true;
 }
 
@@ -718,7 +1337,7 @@ bool NodeManager::ReadFromBuffer (NodeManager& nodeManager, const std::vector<ch
 bool NodeManager::WriteToBuffer (const NodeManager& nodeManager, std::vector<char>& buffer)
 {
 	MemoryOutputStream outputStream;
-	if (DBGERROR (nodeManager.Write (outputStream) != Stream::Status::NoError)) {
+	if (DBGERROR (nodeManager.Write (outputStream, NodeRecordMode::LengthPrefixed) != Stream::Status::NoError)) {
 		return false;
 	}
 	buffer = outputStream.GetBuffer ();
@@ -745,13 +1364,17 @@ NE::NodePtr NodeManager::AddNode (const NodePtr& node, IdPolicy idPolicy, InitPo
 		return nullptr;
 	}
 
+	if (IsInBatch ()) {
+		batchLog->addedNodes.Insert (nodeId);
+	}
+
 	node->SetId (nodeId);
 	node->SetEvaluator (nodeEvaluator);
 	if (initPolicy == InitPolicy::Initialize) {
 		node->Initialize ();
 	}
 
-	if (DBGERROR (!nodeList.AddNode (node->GetId (), node))) {
+	if (DBGERROR (!ModifyNodeList ().AddNode (node->GetId (), node))) {
 		return nullptr;
 	}
 
@@ -778,11 +1401,17 @@ NE::NodeGroupPtr NodeManager::AddNodeGroup (const NodeGroupPtr& group, IdPolicy
 		return nullptr;
 	}
 
+	if (IsInBatch () && batchLog->groupStates.find (groupId) == batchLog->groupStates.end ()) {
+		batchLog->addedGroups.insert (groupId);
+	}
+
 	group->SetId (groupId);
 	if (DBGERROR (!nodeGroupList.AddGroup (group))) {
 		return nullptr;
 	}
 
+	group->SetChangeHandler (nodeGroupChangeHandler);
+	BeforeNodeGroupChange (groupId);
 	return group;
 }
 
@@ -11,9 +11,12 @@
 #include "NE_ConnectionManager.hpp"
 #include "NE_NodeList.hpp"
 #include "NE_NodeGroupList.hpp"
+#include "NE_NodeAdjacency.hpp"
 #include "NE_NodeValueCache.hpp"
 #include "NE_UniqueIdGenerator.hpp"
 #include <functional>
+#include <vector>
+#include <utility>
 
 namespace NE
 {
@@ -40,11 +43,29 @@ public:
 	virtual void	Enumerate (const std::function<bool (InputSlotConstPtr)>& processor) const = 0;
 };
 
+using SlotConnection = std::pair<OutputSlotConstPtr, InputSlotConstPtr>;
+
+class NodeManagerBatchLog;
+
+// reports changes of nodes and groups to the owner of the node manager,
+// nodes report their own changes, so changes made directly on a node are reported, too
+class NodeManagerChangeHandler
+{
+public:
+	NodeManagerChangeHandler ();
+	virtual ~NodeManagerChangeHandler ();
+
+	virtual void	BeforeNodeChange (const NodeId& nodeId) = 0;
+	virtual void	BeforeNodeGroupChange (const NodeGroupId& groupId) = 0;
+};
+
 class NodeManager
 {
 	SERIALIZABLE;
 	friend class NodeManagerMerge;
 	friend class NodeManagerSerialization;
+	friend class NodeManagerNodeEvaluator;
+	friend class NodeManagerNodeGroupChangeHandler;
 
 public:
 	enum class UpdateMode
@@ -53,6 +74,12 @@ public:
 		Manual		= 1
 	};
 
+	enum class NodeRecordMode
+	{
+		Inline			= 0,
+		LengthPrefixed	= 1
+	};
+
 	NodeManager ();
 	NodeManager (const NodeManager& src) = delete;
 	NodeManager (NodeManager&& src) = delete;
@@ -63,6 +90,13 @@ public:
 
 	void					Clear ();
 	bool					IsEmpty () const;
+
+	void					SetChangeHandler (NodeManagerChangeHandler* newChangeHandler);
+
+	void					BeginBatch ();
+	bool					EndBatch ();
+	bool					IsInBatch () const;
+
 	size_t					GetNodeCount () const;
 	size_t					GetNodeGroupCount () const;
 	size_t					GetConnectionCount () const;
@@ -70,6 +104,12 @@ public:
 	void					EnumerateNodes (const std::function<bool (NodePtr)>& processor);
 	void					EnumerateNodes (const std::function<bool (NodeConstPtr)>& processor) const;
 
+	template <class Processor>
+	void					EnumerateNodes (const Processor& processor);
+
+	template <class Processor>
+	void					EnumerateNodes (const Processor& processor) const;
+
 	bool					ContainsNode (const NodeId& id) const;
 	NodeConstPtr			GetNode (const NodeId& id) const;
 
@@ -83,10 +123,12 @@ public:
 	bool					CanConnectOutputSlotToInputSlot (const OutputSlotConstPtr& outputSlot, const InputSlotConstPtr& inputSlot) const;
 	bool					CanConnectOutputSlotsToInputSlot (const OutputSlotList& outputSlots, const InputSlotConstPtr& inputSlot) const;
 	bool					CanConnectOutputSlotToInputSlots (const OutputSlotConstPtr& outputSlot, const InputSlotList& inputSlots) const;
+	bool					CanConnectOutputSlotsToInputSlots (const std::vector<SlotConnection>& connections) const;
 
 	bool					ConnectOutputSlotToInputSlot (const OutputSlotConstPtr& outputSlot, const InputSlotConstPtr& inputSlot);
 	bool					ConnectOutputSlotsToInputSlot (const OutputSlotList& outputSlots, const InputSlotConstPtr& inputSlot);
 	bool					ConnectOutputSlotToInputSlots (const OutputSlotConstPtr& outputSlot, const InputSlotList& inputSlots);
+	bool					ConnectOutputSlotsToInputSlots (const std::vector<SlotConnection>& connections);
 	bool					DisconnectOutputSlotFromInputSlot (const OutputSlotConstPtr& outputSlot, const InputSlotConstPtr& inputSlot);
 	bool					DisconnectOutputSlotsFromInputSlot (const OutputSlotList& outputSlots, const InputSlotConstPtr& inputSlot);
 	bool					DisconnectOutputSlotFromInputSlots (const OutputSlotConstPtr& outputSlot, const InputSlotList& inputSlots);
@@ -102,11 +144,23 @@ public:
 	void					EnumerateConnections (const std::function<void (const OutputSlotConstPtr&, const InputSlotConstPtr&)>& processor) const;
 	void					EnumerateConnections (const NodeCollection& nodes, const std::function<void (const OutputSlotConstPtr&, const InputSlotConstPtr&)>& processor) const;
 
+	template <class Processor>
+	void					EnumerateConnectedOutputSlots (const InputSlotConstPtr& inputSlot, const Processor& processor) const;
+
+	template <class Processor>
+	void					EnumerateConnectedInputSlots (const OutputSlotConstPtr& outputSlot, const Processor& processor) const;
+
+	template <class Processor>
+	void					EnumerateConnections (const Processor& processor) const;
+
 	void					EvaluateAllNodes (EvaluationEnv& env) const;
 	void					ForceEvaluateAllNodes (EvaluationEnv& env) const;
 	void					InvalidateNodeValue (const NodeId& nodeId) const;
 	void					InvalidateNodeValue (const NodeConstPtr& node) const;
+	void					InvalidateNodeValues (const NodeCollection& nodes) const;
 	
+	// built on first use, the returned reference is invalidated by the next node or connection change
+	const NodeAdjacency&	GetNodeAdjacency () const;
 	void					EnumerateDependentNodes (const NodeConstPtr& node, const std::function<void (const NodeId&)>& processor) const;
 	void					EnumerateDependentNodesRecursive (const NodeConstPtr& node, const std::function<void (const NodeId&)>& processor) const;
 
@@ -136,6 +190,7 @@ public:
 
 	Stream::Status			Read (InputStream& inputStream);
 	Stream::Status			Write (OutputStream& outputStream) const;
+	Stream::Status			Write (OutputStream& outputStream, NodeRecordMode recordMode) const;
 
 	static bool				Clone (const NodeManager& source, NodeManager& target);
 	static bool				ReadFromBuffer (NodeManager& nodeManager, const std::vector<char>& buffer);
@@ -157,18 +212,98 @@ private:
 	NodePtr				AddNode (const NodePtr& node, IdPolicy idHandling, InitPolicy initPolicy);
 	NodeGroupPtr		AddNodeGroup (const NodeGroupPtr& group, IdPolicy idHandling);
 	void				MakeNodesAndGroupsSorted ();
+	bool				IsDependentNode (const NodeId& nodeId, const NodeId& dependentNodeId) const;
+
+	template <class Processor>
+	void				EnumerateDependentNodeIds (const NodeConstPtr& node, const Processor& processor) const;
+	void				RollbackBatch ();
+	void				SaveBatchConnections (const InputSlotConstPtr& inputSlot);
+	void				SaveBatchConnections (const OutputSlotConstPtr& outputSlot);
+	void				SaveBatchConnections (const OutputSlotConstPtr& outputSlot, const InputSlotConstPtr& inputSlot);
+
+	void				RemoveNodeFromNodeGroupList (const NodeId& nodeId);
+	void				BeforeNodeChange (const NodeId& nodeId) const;
+	void				BeforeNodeGroupChange (const NodeGroupId& groupId);
+
+	NodeList&			ModifyNodeList ();
+	ConnectionManager&	ModifyConnections ();
 
 	UniqueIdGenerator						idGenerator;
 	NodeList								nodeList;
 	ConnectionManager						connectionManager;
 	NodeGroupList							nodeGroupList;
 	UpdateMode								updateMode;
+	mutable std::shared_ptr<NodeAdjacency>	nodeAdjacency;
+
+	size_t									batchDepth;
+	std::shared_ptr<NodeManagerBatchLog>	batchLog;
+	mutable NodeCollection					batchChangedNodes;
 
 	mutable NodeValueCache					nodeValueCache;
 	mutable NodeEvaluatorConstPtr			nodeEvaluator;
+	NodeGroupChangeHandlerConstPtr			nodeGroupChangeHandler;
+	NodeManagerChangeHandler*				changeHandler;
 	mutable bool							isForceCalculate;
 };
 
+template <class Processor>
+void NodeManager::EnumerateNodes (const Processor& processor)
+{
+	nodeList.Enumerate (processor);
+}
+
+template <class Processor>
+void NodeManager::EnumerateNodes (const Processor& processor) const
+{
+	nodeList.Enumerate (processor);
+}
+
+template <class Processor>
+void NodeManager::EnumerateConnectedOutputSlots (const InputSlotConstPtr& inputSlot, const Processor& processor) const
+{
+	connectionManager.EnumerateConnectedOutputSlots (inputSlot, processor);
+}
+
+template <class Processor>
+void NodeManager::EnumerateConnectedInputSlots (const OutputSlotConstPtr& outputSlot, const Processor& processor) const
+{
+	connectionManager.EnumerateConnectedInputSlots (outputSlot, processor);
+}
+
+template <class Processor>
+void NodeManager::EnumerateDependentNodeIds (const NodeConstPtr& node, const Processor& processor) const
+{
+	// the adjacency is used only if it is up to date, a single level query is not worth a rebuild
+	if (nodeAdjacency != nullptr && nodeAdjacency->ContainsNode (node->GetId ())) {
+		size_t nodeIndex = nodeAdjacency->GetNodeIndex (node->GetId ());
+		nodeAdjacency->EnumerateDependentNodes (nodeIndex, [&] (size_t dependentNodeIndex) {
+			processor (nodeAdjacency->GetNodeId (dependentNodeIndex));
+		});
+		return;
+	}
+
+	node->EnumerateOutputSlots ([&] (const OutputSlotConstPtr& outputSlot) {
+		connectionManager.EnumerateConnectedInputSlots (outputSlot, [&] (const InputSlotConstPtr& inputSlot) {
+			processor (inputSlot->GetOwnerNodeId ());
+		});
+		return true;
+	});
+}
+
+template <class Processor>
+void NodeManager::EnumerateConnections (const Processor& processor) const
+{
+	nodeList.Enumerate ([&] (const NodeConstPtr& node) {
+		node->EnumerateOutputSlots ([&] (const OutputSlotConstPtr& outputSlot) {
+			connectionManager.EnumerateConnectedInputSlots (outputSlot, [&] (const InputSlotConstPtr& inputSlot) {
+				processor (outputSlot, inputSlot);
+			});
+			return true;
+		});
+		return true;
+	});
+}
+
 }
 
 #endif
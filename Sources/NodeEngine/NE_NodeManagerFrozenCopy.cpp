@@ -0,0 +1,214 @@
+#include "NE_NodeManagerFrozenCopy.hpp"
+#include "NE_Debug.hpp"
+#include "NE_InputSlot.hpp"
+#include "NE_OutputSlot.hpp"
+
+namespace NE
+{
+
+NodeManagerFrozenCopy::NodeManagerFrozenCopy () :
+	nodeManager (new NodeManager ())
+{
+
+}
+
+NodeManagerFrozenCopy::NodeManagerFrozenCopy (const NodeManager& source) :
+	nodeManager (nullptr)
+{
+	// nodes and groups are modified in place through pointers, so sharing them would not freeze anything
+	std::shared_ptr<NodeManager> frozenNodeManager (new NodeManager ());
+	DBGVERIFY (NodeManager::Clone (source, *frozenNodeManager));
+	// the copy is never modified, so the adjacency is built here instead of lazily in a const query
+	frozenNodeManager->GetNodeAdjacency ();
+	nodeManager = frozenNodeManager;
+}
+
+NodeManagerFrozenCopy::~NodeManagerFrozenCopy ()
+{
+
+}
+
+bool NodeManagerFrozenCopy::IsEmpty () const
+{
+	return nodeManager->IsEmpty ();
+}
+
+size_t NodeManagerFrozenCopy::GetNodeCount () const
+{
+	return nodeManager->GetNodeCount ();
+}
+
+size_t NodeManagerFrozenCopy::GetNodeGroupCount () const
+{
+	return nodeManager->GetNodeGroupCount ();
+}
+
+size_t NodeManagerFrozenCopy::GetConnectionCount () const
+{
+	return nodeManager->GetConnectionCount ();
+}
+
+void NodeManagerFrozenCopy::EnumerateNodes (const std::function<bool (NodeConstPtr)>& processor) const
+{
+	nodeManager->EnumerateNodes (processor);
+}
+
+bool NodeManagerFrozenCopy::ContainsNode (const NodeId& id) const
+{
+	return nodeManager->ContainsNode (id);
+}
+
+NodeConstPtr NodeManagerFrozenCopy::GetNode (const NodeId& id) const
+{
+	return nodeManager->GetNode (id);
+}
+
+bool NodeManagerFrozenCopy::IsOutputSlotConnectedToInputSlot (const OutputSlotConstPtr& outputSlot, const InputSlotConstPtr& inputSlot) const
+{
+	OutputSlotConstPtr frozenOutputSlot = GetFrozenSlot (outputSlot);
+	InputSlotConstPtr frozenInputSlot = GetFrozenSlot (inputSlot);
+	if (frozenOutputSlot == nullptr || frozenInputSlot == nullptr) {
+		return false;
+	}
+	return nodeManager->IsOutputSlotConnectedToInputSlot (frozenOutputSlot, frozenInputSlot);
+}
+
+bool NodeManagerFrozenCopy::HasConnectedOutputSlots (const InputSlotConstPtr& inputSlot) const
+{
+	InputSlotConstPtr frozenSlot = GetFrozenSlot (inputSlot);
+	if (frozenSlot == nullptr) {
+		return false;
+	}
+	return nodeManager->HasConnectedOutputSlots (frozenSlot);
+}
+
+bool NodeManagerFrozenCopy::HasConnectedInputSlots (const OutputSlotConstPtr& outputSlot) const
+{
+	OutputSlotConstPtr frozenSlot = GetFrozenSlot (outputSlot);
+	if (frozenSlot == nullptr) {
+		return false;
+	}
+	return nodeManager->HasConnectedInputSlots (frozenSlot);
+}
+
+size_t NodeManagerFrozenCopy::GetConnectedOutputSlotCount (const InputSlotConstPtr& inputSlot) const
+{
+	InputSlotConstPtr frozenSlot = GetFrozenSlot (inputSlot);
+	if (frozenSlot == nullptr) {
+		return 0;
+	}
+	return nodeManager->GetConnectedOutputSlotCount (frozenSlot);
+}
+
+size_t NodeManagerFrozenCopy::GetConnectedInputSlotCount (const OutputSlotConstPtr& outputSlot) const
+{
+	OutputSlotConstPtr frozenSlot = GetFrozenSlot (outputSlot);
+	if (frozenSlot == nullptr) {
+		return 0;
+	}
+	return nodeManager->GetConnectedInputSlotCount (frozenSlot);
+}
+
+void NodeManagerFrozenCopy::EnumerateConnectedOutputSlots (const InputSlotConstPtr& inputSlot, const std::function<void (const OutputSlotConstPtr&)>& processor) const
+{
+	InputSlotConstPtr frozenSlot = GetFrozenSlot (inputSlot);
+	if (frozenSlot == nullptr) {
+		return;
+	}
+	nodeManager->EnumerateConnectedOutputSlots (frozenSlot, processor);
+}
+
+void NodeManagerFrozenCopy::EnumerateConnectedInputSlots (const OutputSlotConstPtr& outputSlot, const std::function<void (const InputSlotConstPtr&)>& processor) const
+{
+	OutputSlotConstPtr frozenSlot = GetFrozenSlot (outputSlot);
+	if (frozenSlot == nullptr) {
+		return;
+	}
+	nodeManager->EnumerateConnectedInputSlots (frozenSlot, processor);
+}
+
+void NodeManagerFrozenCopy::EnumerateConnections (const std::function<void (const OutputSlotConstPtr&, const InputSlotConstPtr&)>& processor) const
+{
+	nodeManager->EnumerateConnections (processor);
+}
+
+void NodeManagerFrozenCopy::EnumerateConnections (const NodeCollection& nodes, const std::function<void (const OutputSlotConstPtr&, const InputSlotConstPtr&)>& processor) const
+{
+	nodeManager->EnumerateConnections (nodes, processor);
+}
+
+void NodeManagerFrozenCopy::EnumerateDependentNodes (const NodeConstPtr& node, const std::function<void (const NodeId&)>& processor) const
+{
+	NodeConstPtr frozenNode = GetFrozenNode (node->GetId ());
+	if (frozenNode == nullptr) {
+		return;
+	}
+	nodeManager->EnumerateDependentNodes (frozenNode, processor);
+}
+
+void NodeManagerFrozenCopy::EnumerateDependentNodesRecursive (const NodeConstPtr& node, const std::function<void (const NodeId&)>& processor) const
+{
+	NodeConstPtr frozenNode = GetFrozenNode (node->GetId ());
+	if (frozenNode == nullptr) {
+		return;
+	}
+	nodeManager->EnumerateDependentNodesRecursive (frozenNode, processor);
+}
+
+bool NodeManagerFrozenCopy::ContainsNodeGroup (const NodeGroupId& groupId) const
+{
+	return nodeManager->ContainsNodeGroup (groupId);
+}
+
+NodeGroupConstPtr NodeManagerFrozenCopy::GetNodeGroup (const NodeId& nodeId) const
+{
+	return nodeManager->GetNodeGroup (nodeId);
+}
+
+const NodeCollection& NodeManagerFrozenCopy::GetGroupNodes (const NodeGroupId& groupId) const
+{
+	return nodeManager->GetGroupNodes (groupId);
+}
+
+void NodeManagerFrozenCopy::EnumerateNodeGroups (const std::function<bool (NodeGroupConstPtr)>& processor) const
+{
+	nodeManager->EnumerateNodeGroups (processor);
+}
+
+bool NodeManagerFrozenCopy::IsCalculationEnabled () const
+{
+	return nodeManager->IsCalculationEnabled ();
+}
+
+NodeManager::UpdateMode NodeManagerFrozenCopy::GetUpdateMode () const
+{
+	return nodeManager->GetUpdateMode ();
+}
+
+NodeConstPtr NodeManagerFrozenCopy::GetFrozenNode (const NodeId& nodeId) const
+{
+	if (!nodeManager->ContainsNode (nodeId)) {
+		return nullptr;
+	}
+	return nodeManager->GetNode (nodeId);
+}
+
+InputSlotConstPtr NodeManagerFrozenCopy::GetFrozenSlot (const InputSlotConstPtr& inputSlot) const
+{
+	NodeConstPtr frozenNode = GetFrozenNode (inputSlot->GetOwnerNodeId ());
+	if (frozenNode == nullptr || !frozenNode->HasInputSlot (inputSlot->GetId ())) {
+		return nullptr;
+	}
+	return frozenNode->GetInputSlot (inputSlot->GetId ());
+}
+
+OutputSlotConstPtr NodeManagerFrozenCopy::GetFrozenSlot (const OutputSlotConstPtr& outputSlot) const
+{
+	NodeConstPtr frozenNode = GetFrozenNode (outputSlot->GetOwnerNodeId ());
+	if (frozenNode == nullptr || !frozenNode->HasOutputSlot (outputSlot->GetId ())) {
+		return nullptr;
+	}
+	return frozenNode->GetOutputSlot (outputSlot->GetId ());
+}
+
+}
@@ -0,0 +1,60 @@
+#ifndef NE_NODEMANAGERFROZENCOPY_HPP
+#define NE_NODEMANAGERFROZENCOPY_HPP
+
+#include "NE_NodeManager.hpp"
+#include <memory>
+
+namespace NE
+{
+
+// frozen read-only copy of a node manager, every node and group is cloned when it is created,
+// so it costs as much as a clone, and later modifications of the manager are not visible in it;
+// queries accept nodes and slots of the manager, too, they are looked up by id in the copy
+class NodeManagerFrozenCopy
+{
+public:
+	NodeManagerFrozenCopy ();
+	NodeManagerFrozenCopy (const NodeManager& nodeManager);
+	~NodeManagerFrozenCopy ();
+
+	bool							IsEmpty () const;
+	size_t							GetNodeCount () const;
+	size_t							GetNodeGroupCount () const;
+	size_t							GetConnectionCount () const;
+
+	void							EnumerateNodes (const std::function<bool (NodeConstPtr)>& processor) const;
+	bool							ContainsNode (const NodeId& id) const;
+	NodeConstPtr					GetNode (const NodeId& id) const;
+
+	bool							IsOutputSlotConnectedToInputSlot (const OutputSlotConstPtr& outputSlot, const InputSlotConstPtr& inputSlot) const;
+	bool							HasConnectedOutputSlots (const InputSlotConstPtr& inputSlot) const;
+	bool							HasConnectedInputSlots (const OutputSlotConstPtr& outputSlot) const;
+	size_t							GetConnectedOutputSlotCount (const InputSlotConstPtr& inputSlot) const;
+	size_t							GetConnectedInputSlotCount (const OutputSlotConstPtr& outputSlot) const;
+	void							EnumerateConnectedOutputSlots (const InputSlotConstPtr& inputSlot, const std::function<void (const OutputSlotConstPtr&)>& processor) const;
+	void							EnumerateConnectedInputSlots (const OutputSlotConstPtr& outputSlot, const std::function<void (const InputSlotConstPtr&)>& processor) const;
+	void							EnumerateConnections (const std::function<void (const OutputSlotConstPtr&, const InputSlotConstPtr&)>& processor) const;
+	void							EnumerateConnections (const NodeCollection& nodes, const std::function<void (const OutputSlotConstPtr&, const InputSlotConstPtr&)>& processor) const;
+
+	void							EnumerateDependentNodes (const NodeConstPtr& node, const std::function<void (const NodeId&)>& processor) const;
+	void							EnumerateDependentNodesRecursive (const NodeConstPtr& node, const std::function<void (const NodeId&)>& processor) const;
+
+	bool							ContainsNodeGroup (const NodeGroupId& groupId) const;
+	NodeGroupConstPtr				GetNodeGroup (const NodeId& nodeId) const;
+	const NodeCollection&			GetGroupNodes (const NodeGroupId& groupId) const;
+	void							EnumerateNodeGroups (const std::function<bool (NodeGroupConstPtr)>& processor) const;
+
+	bool							IsCalculationEnabled () const;
+	NodeManager::UpdateMode			GetUpdateMode () const;
+
+private:
+	NodeConstPtr					GetFrozenNode (const NodeId& nodeId) const;
+	InputSlotConstPtr				GetFrozenSlot (const InputSlotConstPtr& inputSlot) const;
+	OutputSlotConstPtr				GetFrozenSlot (const OutputSlotConstPtr& outputSlot) const;
+
+	std::shared_ptr<const NodeManager>	nodeManager;
+};
+
+}
+
+#endif
@@ -1,9 +1,14 @@
 #include "NE_NodeManagerMerge.hpp"
 #include "NE_MemoryStream.hpp"
 
+#include <unordered_set>
+#include <unordered_map>
+
 namespace NE
 {
 
+SERIALIZATION_INFO (NodeManagerRegion, 1);
+
 NodeFilter::NodeFilter ()
 {
 
@@ -116,12 +121,156 @@ void EmptyUpdateEventHandler::BeforeNodeDelete (const NodeId&)
 
 }
 
-static std::vector<SlotInfo> GetConnectedOutputSlots (const NodeManager& nodeManager, const InputSlotConstPtr& inputSlot)
+NodeManagerRegion::NodeManagerRegion () :
+	nodes (),
+	nodeStates (),
+	inputSlotConnections (),
+	outputSlotConnections (),
+	groupMode (GroupMode::Memberships),
+	groupMemberships (),
+	groups ()
 {
-	std::vector<SlotInfo> result;
+
+}
+
+NodeManagerRegion::~NodeManagerRegion ()
+{
+
+}
+
+const NodeCollection& NodeManagerRegion::GetNodes () const
+{
+	return nodes;
+}
+
+NodeManagerRegion::GroupMode NodeManagerRegion::GetGroupMode () const
+{
+	return groupMode;
+}
+
+size_t NodeManagerRegion::GetObjectCount () const
+{
+	return nodeStates.size () + groups.size ();
+}
+
+static void ReadSlotConnections (InputStream& inputStream, std::vector<std::pair<SlotInfo, std::vector<SlotInfo>>>& slotConnections)
+{
+	size_t slotCount = 0;
+	inputStream.Read (slotCount);
+	for (size_t i = 0; i < slotCount && inputStream.GetStatus () == Stream::Status::NoError; i++) {
+		SlotInfo slotInfo;
+		slotInfo.Read (inputStream);
+		size_t connectionCount = 0;
+		inputStream.Read (connectionCount);
+		std::vector<SlotInfo> connectedSlots;
+		for (size_t j = 0; j < connectionCount && inputStream.GetStatus () == Stream::Status::NoError; j++) {
+			SlotInfo connectedSlotInfo;
+			connectedSlotInfo.Read (inputStream);
+			connectedSlots.push_back (connectedSlotInfo);
+		}
+		slotConnections.push_back ({ slotInfo, connectedSlots });
+	}
+}
+
+static void WriteSlotConnections (OutputStream& outputStream, const std::vector<std::pair<SlotInfo, std::vector<SlotInfo>>>& slotConnections)
+{
+	outputStream.Write (slotConnections.size ());
+	for (const auto& it : slotConnections) {
+		it.first.Write (outputStream);
+		outputStream.Write (it.second.size ());
+		for (const SlotInfo& connectedSlotInfo : it.second) {
+			connectedSlotInfo.Write (outputStream);
+		}
+	}
+}
+
+Stream::Status NodeManagerRegion::Read (InputStream& inputStream)
+{
+	*this = NodeManagerRegion ();
+
+	ObjectHeader header (inputStream);
+	nodes.Read (inputStream);
+
+	size_t nodeCount = 0;
+	inputStream.Read (nodeCount);
+	for (size_t i = 0; i < nodeCount; i++) {
+		NodePtr node (ReadDynamicObject<Node> (inputStream));
+		if (DBGERROR (node == nullptr)) {
+			return Stream::Status::Error;
+		}
+		nodeStates.push_back (node);
+	}
+
+	ReadSlotConnections (inputStream, inputSlotConnections);
+	ReadSlotConnections (inputStream, outputSlotConnections);
+	ReadEnum (inputStream, groupMode);
+
+	size_t membershipCount = 0;
+	inputStream.Read (membershipCount);
+	for (size_t i = 0; i < membershipCount && inputStream.GetStatus () == Stream::Status::NoError; i++) {
+		NodeId nodeId;
+		NodeGroupId groupId;
+		nodeId.Read (inputStream);
+		groupId.Read (inputStream);
+		groupMemberships.push_back ({ nodeId, groupId });
+	}
+
+	size_t groupCount = 0;
+	inputStream.Read (groupCount);
+	for (size_t i = 0; i < groupCount; i++) {
+		NodeGroupPtr group (ReadDynamicObject<NodeGroup> (inputStream));
+		if (DBGERROR (group == nullptr)) {
+			return Stream::Status::Error;
+		}
+		NodeCollection groupNodes;
+		groupNodes.Read (inputStream);
+		groups.push_back ({ group, groupNodes });
+	}
+
+	return inputStream.GetStatus ();
+}
+
+Stream::Status NodeManagerRegion::Write (OutputStream& outputStream) const
+{
+	ObjectHeader header (outputStream, serializationInfo);
+	nodes.Write (outputStream);
+
+	outputStream.Write (nodeStates.size ());
+	for (const NodeConstPtr& node : nodeStates) {
+		WriteDynamicObject (outputStream, node.get ());
+	}
+
+	WriteSlotConnections (outputStream, inputSlotConnections);
+	WriteSlotConnections (outputStream, outputSlotConnections);
+	WriteEnum (outputStream, groupMode);
+
+	outputStream.Write (groupMemberships.size ());
+	for (const GroupMembership& membership : groupMemberships) {
+		membership.first.Write (outputStream);
+		membership.second.Write (outputStream);
+	}
+
+	outputStream.Write (groups.size ());
+	for (const GroupNodes& groupNodes : groups) {
+		WriteDynamicObject (outputStream, groupNodes.first.get ());
+		groupNodes.second.Write (outputStream);
+	}
+
+	return outputStream.GetStatus ();
+}
+
+static void CollectConnectedOutputSlots (const NodeManager& nodeManager, const InputSlotConstPtr& inputSlot, std::vector<SlotInfo>& result)
+{
+	result.clear ();
 	nodeManager.EnumerateConnectedOutputSlots (inputSlot, [&] (const OutputSlotConstPtr& outputSlot) {
 		result.push_back (SlotInfo (outputSlot->GetOwnerNodeId (), outputSlot->GetId ()));
 	});
+}
+
+static std::vector<SlotInfo> GetConnectedOutputSlots (const NodeManager& nodeManager, const InputSlotConstPtr& inputSlot)
+{
+	std::vector<SlotInfo> result;
+	CollectConnectedOutputSlots (nodeManager, inputSlot, result);
 	return result;
 }
 
@@ -151,6 +300,7 @@ bool NodeManagerMerge::AppendNodeManager (const NodeManager& source, NodeManager
 
 	// maintain connections between added nodes
 	bool success = true;
+	std::vector<SlotConnection> connections;
 	source.EnumerateConnections (nodesToClone, [&] (const OutputSlotConstPtr& oldOutputSlot, const InputSlotConstPtr& oldInputSlot) {
 		NodeConstPtr outputNode = target.GetNode (oldToNewNodeIdTable[oldOutputSlot->GetOwnerNodeId ()]);
 		NodeConstPtr inputNode = target.GetNode (oldToNewNodeIdTable[oldInputSlot->GetOwnerNodeId ()]);
@@ -164,13 +314,18 @@ bool NodeManagerMerge::AppendNodeManager (const NodeManager& source, NodeManager
 			success = false;
 			return;
 		}
-		if (DBGERROR (!target.ConnectOutputSlotToInputSlot (outputSlot, inputSlot))) {
-			success = false;
-			return;
-		}
+		connections.push_back (SlotConnection (outputSlot, inputSlot));
 	});
 
-	return success;
+	if (DBGERROR (!success)) {
+		return false;
+	}
+
+	if (DBGERROR (!target.ConnectOutputSlotsToInputSlots (connections))) {
+		return false;
+	}
+
+	return true;
 }
 
 bool NodeManagerMerge::UpdateNodeManager (const NodeManager& source, NodeManager& target, UpdateEventHandler& eventHandler)
@@ -207,8 +362,11 @@ bool NodeManagerMerge::UpdateNodeManager (const NodeManager& source, NodeManager
 		target.AddNode (cloned, NodeManager::IdPolicy::KeepOriginal, NodeManager::InitPolicy::DoNotInitialize);
 	}
 
-	// collect input slots with changed connections
+	// collect input slots with changed connections, slots without connections on both sides are skipped,
+	// and the connection lists of the other slots are collected into reused buffers
 	std::unordered_map<InputSlotConstPtr, std::vector<SlotInfo>> inputSlotsToReconnect;
+	std::vector<SlotInfo> sourceOutputSlots;
+	std::vector<SlotInfo> targetOutputSlots;
 	target.EnumerateNodes ([&] (NodeConstPtr targetNode) {
 		if (!source.ContainsNode (targetNode->GetId ())) {
 			return true;
@@ -219,8 +377,13 @@ bool NodeManagerMerge::UpdateNodeManager (const NodeManager& source, NodeManager
 				return true;
 			}
 			InputSlotConstPtr sourceInputSlot = sourceNode->GetInputSlot (targetInputSlot->GetId ());
-			std::vector<SlotInfo> sourceOutputSlots = GetConnectedOutputSlots (source, sourceInputSlot);
-			std::vector<SlotInfo> targetOutputSlots = GetConnectedOutputSlots (target, targetInputSlot);
+			size_t sourceConnectionCount = source.GetConnectedOutputSlotCount (sourceInputSlot);
+			size_t targetConnectionCount = target.GetConnectedOutputSlotCount (targetInputSlot);
+			if (sourceConnectionCount == 0 && targetConnectionCount == 0) {
+				return true;
+			}
+			CollectConnectedOutputSlots (source, sourceInputSlot, sourceOutputSlots);
+			CollectConnectedOutputSlots (target, targetInputSlot, targetOutputSlots);
 			if (sourceOutputSlots != targetOutputSlots) {
 				inputSlotsToReconnect.insert ({ targetInputSlot, sourceOutputSlots });
 			}
@@ -230,6 +393,7 @@ bool NodeManagerMerge::UpdateNodeManager (const NodeManager& source, NodeManager
 	});
 
 	// reconnect changed input slots
+	std::vector<SlotConnection> connections;
 	for (const auto& inputSlotData : inputSlotsToReconnect) {
 		const InputSlotConstPtr& inputSlot = inputSlotData.first;
 		const std::vector<SlotInfo>& outputSlots = inputSlotData.second;
@@ -237,9 +401,10 @@ bool NodeManagerMerge::UpdateNodeManager (const NodeManager& source, NodeManager
 		for (const SlotInfo& slotInfo : outputSlots) {
 			NodeConstPtr outputNode = target.GetNode (slotInfo.GetNodeId ());
 			OutputSlotConstPtr outputSlot = outputNode->GetOutputSlot (slotInfo.GetSlotId ());
-			target.ConnectOutputSlotToInputSlot (outputSlot, inputSlot);
+			connections.push_back (SlotConnection (outputSlot, inputSlot));
 		}
 	}
+	DBGVERIFY (target.ConnectOutputSlotsToInputSlots (connections));
 
 	// recreate groups in target
 	target.DeleteAllNodeGroups ();
@@ -260,4 +425,207 @@ bool NodeManagerMerge::UpdateNodeManager (const NodeManager& source, NodeManager
 	return true;
 }
 
+void NodeManagerMerge::SaveRegion (const NodeManager& source, const NodeCollection& nodes, NodeManagerRegion::GroupMode groupMode, NodeManagerRegion& region)
+{
+	region = NodeManagerRegion ();
+	region.nodes = nodes;
+	region.groupMode = groupMode;
+
+	// the whole ordered connection list is saved for every slot connected to the region,
+	// output slot lists are needed only to restore the enumeration order of connections
+	std::unordered_set<InputSlotConstPtr> savedInputSlots;
+	std::unordered_set<OutputSlotConstPtr> savedOutputSlots;
+	auto saveInputSlot = [&] (const InputSlotConstPtr& inputSlot) {
+		if (savedInputSlots.find (inputSlot) != savedInputSlots.end ()) {
+			return;
+		}
+		savedInputSlots.insert (inputSlot);
+		std::vector<SlotInfo> outputSlots = GetConnectedOutputSlots (source, inputSlot);
+		if (!outputSlots.empty ()) {
+			SlotInfo inputSlotInfo (inputSlot->GetOwnerNodeId (), inputSlot->GetId ());
+			region.inputSlotConnections.push_back ({ inputSlotInfo, outputSlots });
+		}
+	};
+	auto saveOutputSlot = [&] (const OutputSlotConstPtr& outputSlot) {
+		if (savedOutputSlots.find (outputSlot) != savedOutputSlots.end ()) {
+			return;
+		}
+		savedOutputSlots.insert (outputSlot);
+		std::vector<SlotInfo> inputSlots;
+		source.EnumerateConnectedInputSlots (outputSlot, [&] (const InputSlotConstPtr& inputSlot) {
+			inputSlots.push_back (SlotInfo (inputSlot->GetOwnerNodeId (), inputSlot->GetId ()));
+		});
+		if (!inputSlots.empty ()) {
+			SlotInfo outputSlotInfo (outputSlot->GetOwnerNodeId (), outputSlot->GetId ());
+			region.outputSlotConnections.push_back ({ outputSlotInfo, inputSlots });
+		}
+	};
+
+	nodes.Enumerate ([&] (const NodeId& nodeId) {
+		if (!source.ContainsNode (nodeId)) {
+			return true;
+		}
+		NodeConstPtr node = source.GetNode (nodeId);
+		region.nodeStates.push_back (Node::Clone (node));
+		node->EnumerateInputSlots ([&] (InputSlotConstPtr inputSlot) {
+			saveInputSlot (inputSlot);
+			source.EnumerateConnectedOutputSlots (inputSlot, [&] (const OutputSlotConstPtr& outputSlot) {
+				saveOutputSlot (outputSlot);
+			});
+			return true;
+		});
+		node->EnumerateOutputSlots ([&] (OutputSlotConstPtr outputSlot) {
+			saveOutputSlot (outputSlot);
+			source.EnumerateConnectedInputSlots (outputSlot, [&] (const InputSlotConstPtr& inputSlot) {
+				saveInputSlot (inputSlot);
+			});
+			return true;
+		});
+		if (groupMode == NodeManagerRegion::GroupMode::Memberships) {
+			NodeGroupConstPtr group = source.GetNodeGroup (nodeId);
+			if (group != nullptr) {
+				region.groupMemberships.push_back ({ nodeId, group->GetId () });
+			}
+		}
+		return true;
+	});
+
+	if (groupMode == NodeManagerRegion::GroupMode::AllGroups) {
+		source.EnumerateNodeGroups ([&] (NodeGroupConstPtr group) {
+			region.groups.push_back ({ NodeGroup::Clone (group), source.GetGroupNodes (group->GetId ()) });
+			return true;
+		});
+	}
+}
+
+bool NodeManagerMerge::RestoreRegion (const NodeManagerRegion& region, NodeManager& target, UpdateEventHandler& eventHandler)
+{
+	// a group is deleted with its last node, so groups are kept aside to restore memberships
+	std::unordered_map<NodeGroupId, NodeGroupPtr> removedGroups;
+	region.nodes.Enumerate ([&] (const NodeId& nodeId) {
+		if (region.groupMode == NodeManagerRegion::GroupMode::Memberships && target.ContainsNode (nodeId)) {
+			NodeGroupConstPtr group = target.GetNodeGroup (nodeId);
+			if (group != nullptr) {
+				removedGroups.insert ({ group->GetId (), target.nodeGroupList.GetGroup (group->GetId ()) });
+			}
+		}
+		return true;
+	});
+
+	// replace the nodes of the region
+	region.nodes.Enumerate ([&] (const NodeId& nodeId) {
+		if (target.ContainsNode (nodeId)) {
+			eventHandler.BeforeNodeDelete (nodeId);
+			target.DeleteNode (nodeId);
+		}
+		return true;
+	});
+	for (const NodeConstPtr& nodeState : region.nodeStates) {
+		NodePtr node = Node::Clone (nodeState);
+		if (DBGERROR (target.AddNode (node, NodeManager::IdPolicy::KeepOriginal, NodeManager::InitPolicy::DoNotInitialize) == nullptr)) {
+			return false;
+		}
+	}
+
+	// restore connection lists, the saved state was valid so there is no need to check for cycles
+	for (const auto& inputSlotConnections : region.inputSlotConnections) {
+		const SlotInfo& inputSlotInfo = inputSlotConnections.first;
+		NodeConstPtr inputNode = target.GetNode (inputSlotInfo.GetNodeId ());
+		if (DBGERROR (inputNode == nullptr)) {
+			return false;
+		}
+		InputSlotConstPtr inputSlot = inputNode->GetInputSlot (inputSlotInfo.GetSlotId ());
+		if (DBGERROR (inputSlot == nullptr)) {
+			return false;
+		}
+		target.ModifyConnections ().DisconnectAllOutputSlotsFromInputSlot (inputSlot);
+		for (const SlotInfo& outputSlotInfo : inputSlotConnections.second) {
+			NodeConstPtr outputNode = target.GetNode (outputSlotInfo.GetNodeId ());
+			if (DBGERROR (outputNode == nullptr)) {
+				return false;
+			}
+			OutputSlotConstPtr outputSlot = outputNode->GetOutputSlot (outputSlotInfo.GetSlotId ());
+			if (DBGERROR (outputSlot == nullptr || !target.ModifyConnections ().ConnectOutputSlotToInputSlot (outputSlot, inputSlot))) {
+				return false;
+			}
+		}
+		target.InvalidateNodeValue (inputNode);
+	}
+	for (const auto& outputSlotConnections : region.outputSlotConnections) {
+		const SlotInfo& outputSlotInfo = outputSlotConnections.first;
+		NodeConstPtr outputNode = target.GetNode (outputSlotInfo.GetNodeId ());
+		if (DBGERROR (outputNode == nullptr)) {
+			return false;
+		}
+		OutputSlotConstPtr outputSlot = outputNode->GetOutputSlot (outputSlotInfo.GetSlotId ());
+		if (DBGERROR (outputSlot == nullptr)) {
+			return false;
+		}
+		std::vector<InputSlotConstPtr> inputSlots;
+		for (const SlotInfo& inputSlotInfo : outputSlotConnections.second) {
+			NodeConstPtr inputNode = target.GetNode (inputSlotInfo.GetNodeId ());
+			if (DBGERROR (inputNode == nullptr)) {
+				return false;
+			}
+			inputSlots.push_back (inputNode->GetInputSlot (inputSlotInfo.GetSlotId ()));
+		}
+		target.ModifyConnections ().ReorderConnectedInputSlots (outputSlot, inputSlots);
+	}
+
+	// restore groups
+	if (region.groupMode == NodeManagerRegion::GroupMode::AllGroups) {
+		target.DeleteAllNodeGroups ();
+		for (const auto& groupNodes : region.groups) {
+			NodeGroupPtr targetGroup = NodeGroup::Clone (groupNodes.first);
+			target.AddNodeGroup (targetGroup, NodeManager::IdPolicy::KeepOriginal);
+			groupNodes.second.Enumerate ([&] (const NodeId& nodeId) {
+				if (target.ContainsNode (nodeId)) {
+					target.AddNodeToGroup (targetGroup->GetId (), nodeId);
+				}
+				return true;
+			});
+		}
+	} else {
+		for (const auto& groupMembership : region.groupMemberships) {
+			auto removedGroup = removedGroups.find (groupMembership.second);
+			if (!target.ContainsNodeGroup (groupMembership.second) && removedGroup != removedGroups.end ()) {
+				target.AddNodeGroup (removedGroup->second, NodeManager::IdPolicy::KeepOriginal);
+			}
+			if (target.ContainsNodeGroup (groupMembership.second)) {
+				target.AddNodeToGroup (groupMembership.second, groupMembership.first);
+			}
+		}
+	}
+
+	target.MakeNodesAndGroupsSorted ();
+	return true;
+}
+
+bool NodeManagerMerge::IsEqualNodeGroups (const NodeManager& aNodeManager, const NodeManager& bNodeManager)
+{
+	if (aNodeManager.GetNodeGroupCount () != bNodeManager.GetNodeGroupCount ()) {
+		return false;
+	}
+
+	std::vector<NodeGroupConstPtr> aGroups;
+	aNodeManager.EnumerateNodeGroups ([&] (NodeGroupConstPtr group) {
+		aGroups.push_back (group);
+		return true;
+	});
+
+	size_t groupIndex = 0;
+	bool isEqual = true;
+	bNodeManager.EnumerateNodeGroups ([&] (NodeGroupConstPtr bGroup) {
+		NodeGroupConstPtr aGroup = aGroups[groupIndex++];
+		if (aGroup->GetId () != bGroup->GetId () || !NodeGroup::IsEqual (aGroup, bGroup)) {
+			isEqual = false;
+		} else if (aNodeManager.GetGroupNodes (aGroup->GetId ()) != bNodeManager.GetGroupNodes (bGroup->GetId ())) {
+			isEqual = false;
+		}
+		return isEqual;
+	});
+
+	return isEqual;
+}
+
 }
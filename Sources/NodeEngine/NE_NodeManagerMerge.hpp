@@ -85,11 +85,51 @@ public:
 	virtual void BeforeNodeDelete (const NodeId& nodeId) override;
 };
 
+class NodeManagerRegion
+{
+	SERIALIZABLE;
+	friend class NodeManagerMerge;
+
+public:
+	enum class GroupMode
+	{
+		Memberships,
+		AllGroups
+	};
+
+	NodeManagerRegion ();
+	~NodeManagerRegion ();
+
+	const NodeCollection&	GetNodes () const;
+	GroupMode				GetGroupMode () const;
+	size_t					GetObjectCount () const;
+
+	Stream::Status			Read (InputStream& inputStream);
+	Stream::Status			Write (OutputStream& outputStream) const;
+
+private:
+	using SlotConnections = std::pair<SlotInfo, std::vector<SlotInfo>>;
+	using GroupMembership = std::pair<NodeId, NodeGroupId>;
+	using GroupNodes = std::pair<NodeGroupConstPtr, NodeCollection>;
+
+	NodeCollection						nodes;
+	std::vector<NodeConstPtr>			nodeStates;
+	std::vector<SlotConnections>		inputSlotConnections;
+	std::vector<SlotConnections>		outputSlotConnections;
+	GroupMode							groupMode;
+	std::vector<GroupMembership>		groupMemberships;
+	std::vector<GroupNodes>				groups;
+};
+
 class NodeManagerMerge
 {
 public:
 	static bool AppendNodeManager (const NodeManager& source, NodeManager& target, const NodeFilter& nodeFilter, AppendEventHandler& eventHandler);
 	static bool UpdateNodeManager (const NodeManager& source, NodeManager& target, UpdateEventHandler& eventHandler);
+
+	static void SaveRegion (const NodeManager& source, const NodeCollection& nodes, NodeManagerRegion::GroupMode groupMode, NodeManagerRegion& region);
+	static bool RestoreRegion (const NodeManagerRegion& region, NodeManager& target, UpdateEventHandler& eventHandler);
+	static bool IsEqualNodeGroups (const NodeManager& aNodeManager, const NodeManager& bNodeManager);
 };
 
 }
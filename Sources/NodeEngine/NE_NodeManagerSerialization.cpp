@@ -1,8 +1,50 @@
 #include "NE_NodeManagerSerialization.hpp"
+#include "NE_MemoryStream.hpp"
+
+#include <thread>
+#include <algorithm>
 
 namespace NE
 {
 
+static const size_t MinNodeRecordsPerThread = 256;
+
+static void ParseNodeRecords (const std::vector<std::string>& records, size_t beginIndex, size_t endIndex, std::vector<NodePtr>& nodes)
+{
+	for (size_t i = beginIndex; i < endIndex; i++) {
+		const std::string& record = records[i];
+		MemoryInputStream recordStream (record.data (), record.size ());
+		nodes[i].reset (ReadDynamicObject<Node> (recordStream));
+		if (recordStream.GetStatus () != Stream::Status::NoError) {
+			nodes[i] = nullptr;
+		}
+	}
+}
+
+static void ParseNodeRecordsParallel (const std::vector<std::string>& records, std::vector<NodePtr>& nodes)
+{
+	size_t recordCount = records.size ();
+	size_t threadCount = std::thread::hardware_concurrency ();
+	threadCount = std::min (threadCount, recordCount / MinNodeRecordsPerThread);
+	if (threadCount < 2) {
+		ParseNodeRecords (records, 0, recordCount, nodes);
+		return;
+	}
+
+	// every thread writes only its own range of the result vector,
+	// nodes are inserted into the node manager after all threads are finished
+	std::vector<std::thread> threads;
+	size_t recordsPerThread = recordCount / threadCount;
+	for (size_t i = 0; i < threadCount; i++) {
+		size_t beginIndex = i * recordsPerThread;
+		size_t endIndex = (i == threadCount - 1) ? recordCount : beginIndex + recordsPerThread;
+		threads.push_back (std::thread (ParseNodeRecords, std::cref (records), beginIndex, endIndex, std::ref (nodes)));
+	}
+	for (std::thread& thread : threads) {
+		thread.join ();
+	}
+}
+
 Stream::Status NodeManagerSerialization::Read (NodeManager& nodeManager, InputStream& inputStream)
 {
 	if (DBGERROR (!nodeManager.IsEmpty ())) {
@@ -36,12 +78,12 @@ Stream::Status NodeManagerSerialization::Read (NodeManager& nodeManager, InputSt
 	return inputStream.GetStatus ();
 }
 
-Stream::Status NodeManagerSerialization::Write (const NodeManager& nodeManager, OutputStream& outputStream)
+Stream::Status NodeManagerSerialization::Write (const NodeManager& nodeManager, OutputStream& outputStream, NodeManager::NodeRecordMode recordMode)
 {
 	ObjectHeader header (outputStream, nodeManager.serializationInfo);
 	nodeManager.idGenerator.Write (outputStream);
 
-	Stream::Status nodeStatus = WriteNodes (nodeManager, outputStream);
+	Stream::Status nodeStatus = WriteNodes (nodeManager, outputStream, recordMode);
 	if (DBGERROR (nodeStatus != Stream::Status::NoError)) {
 		return nodeStatus;
 	}
@@ -61,18 +103,64 @@ Stream::Status NodeManagerSerialization::Write (const NodeManager& nodeManager,
 	return outputStream.GetStatus ();
 }
 
-Stream::Status NodeManagerSerialization::ReadNodes (NodeManager& nodeManager, InputStream& inputStream, const ObjectVersion&)
+Stream::Status NodeManagerSerialization::ReadNodes (NodeManager& nodeManager, InputStream& inputStream, const ObjectVersion& version)
 {
 	DBGASSERT (nodeManager.GetNodeCount () == 0);
 
+	NodeManager::NodeRecordMode recordMode = NodeManager::NodeRecordMode::Inline;
+	if (version >= 5) {
+		ReadEnum (inputStream, recordMode);
+	}
+
+	switch (recordMode) {
+		case NodeManager::NodeRecordMode::Inline:
+			return ReadInlineNodes (nodeManager, inputStream);
+		case NodeManager::NodeRecordMode::LengthPrefixed:
+			return ReadLengthPrefixedNodes (nodeManager, inputStream);
+	}
+
+	DBGBREAK ();
+	return Stream::Status::Error;
+}
+
+Stream::Status NodeManagerSerialization::ReadInlineNodes (NodeManager& nodeManager, InputStream& inputStream)
+{
 	size_t nodeCount = 0;
 	inputStream.Read (nodeCount);
 	for (size_t i = 0; i < nodeCount; ++i) {
 		NodePtr node (ReadDynamicObject<Node> (inputStream));
-		NodeId oldNodeId = node->GetId ();
-		NodePtr addedNode = nodeManager.AddNode (node, NodeManager::IdPolicy::KeepOriginal, NodeManager::InitPolicy::DoNotInitialize);
-		DBGASSERT (oldNodeId == addedNode->GetId ());
-		if (DBGERROR (addedNode == nullptr)) {
+		if (DBGERROR (AddReadNode (nodeManager, node) != Stream::Status::NoError)) {
+			return Stream::Status::Error;
+		}
+	}
+
+	return inputStream.GetStatus ();
+}
+
+Stream::Status NodeManagerSerialization::ReadLengthPrefixedNodes (NodeManager& nodeManager, InputStream& inputStream)
+{
+	size_t nodeCount = 0;
+	inputStream.Read (nodeCount);
+	if (inputStream.GetStatus () != Stream::Status::NoError) {
+		return inputStream.GetStatus ();
+	}
+
+	// records are parsed in place, the streams read directly from these strings
+	std::vector<std::string> records;
+	records.reserve (nodeCount);
+	for (size_t i = 0; i < nodeCount; ++i) {
+		std::string record;
+		if (inputStream.Read (record) != Stream::Status::NoError) {
+			return inputStream.GetStatus ();
+		}
+		records.push_back (std::move (record));
+	}
+
+	std::vector<NodePtr> nodes (nodeCount);
+	ParseNodeRecordsParallel (records, nodes);
+
+	for (const NodePtr& node : nodes) {
+		if (DBGERROR (AddReadNode (nodeManager, node) != Stream::Status::NoError)) {
 			return Stream::Status::Error;
 		}
 	}
@@ -80,12 +168,28 @@ Stream::Status NodeManagerSerialization::ReadNodes (NodeManager& nodeManager, In
 	return inputStream.GetStatus ();
 }
 
+Stream::Status NodeManagerSerialization::AddReadNode (NodeManager& nodeManager, const NodePtr& node)
+{
+	if (DBGERROR (node == nullptr)) {
+		return Stream::Status::Error;
+	}
+	NodeId oldNodeId = node->GetId ();
+	NodePtr addedNode = nodeManager.AddNode (node, NodeManager::IdPolicy::KeepOriginal, NodeManager::InitPolicy::DoNotInitialize);
+	if (DBGERROR (addedNode == nullptr)) {
+		return Stream::Status::Error;
+	}
+	DBGASSERT (oldNodeId == addedNode->GetId ());
+	return Stream::Status::NoError;
+}
+
 Stream::Status NodeManagerSerialization::ReadConnections (NodeManager& nodeManager, InputStream& inputStream, const ObjectVersion& version)
 {
 	DBGASSERT (nodeManager.GetConnectionCount () == 0);
 
 	size_t connectionCount = 0;
 	inputStream.Read (connectionCount);
+	std::vector<SlotConnection> connections;
+	connections.reserve (connectionCount);
 	for (size_t i = 0; i < connectionCount; ++i) {
 		ConnectionInfo connection;
 		if (version < 3) {
@@ -113,9 +217,11 @@ Stream::Status NodeManagerSerialization::ReadConnections (NodeManager& nodeManag
 		}
 		OutputSlotConstPtr outputSlot = outputNode->GetOutputSlot (connection.GetOutputSlotId ());
 		InputSlotConstPtr inputSlot = inputNode->GetInputSlot (connection.GetInputSlotId ());
-		if (DBGERROR (!nodeManager.ConnectOutputSlotToInputSlot (outputSlot, inputSlot))) {
-			return Stream::Status::Error;
-		}
+		connections.push_back (SlotConnection (outputSlot, inputSlot));
+	}
+
+	if (DBGERROR (!nodeManager.ConnectOutputSlotsToInputSlots (connections))) {
+		return Stream::Status::Error;
 	}
 
 	return inputStream.GetStatus ();
@@ -153,11 +259,19 @@ Stream::Status NodeManagerSerialization::ReadGroups (NodeManager& nodeManager, I
 	return inputStream.GetStatus ();
 }
 
-Stream::Status NodeManagerSerialization::WriteNodes (const NodeManager& nodeManager, OutputStream& outputStream)
+Stream::Status NodeManagerSerialization::WriteNodes (const NodeManager& nodeManager, OutputStream& outputStream, NodeManager::NodeRecordMode recordMode)
 {
+	WriteEnum (outputStream, recordMode);
 	outputStream.Write (nodeManager.GetNodeCount ());
 	nodeManager.EnumerateNodes ([&] (NodeConstPtr node) {
-		WriteDynamicObject (outputStream, node.get ());
+		if (recordMode == NodeManager::NodeRecordMode::LengthPrefixed) {
+			MemoryOutputStream recordStream;
+			WriteDynamicObject (recordStream, node.get ());
+			const std::vector<char>& recordBuffer = recordStream.GetBuffer ();
+			outputStream.Write (std::string (recordBuffer.begin (), recordBuffer.end ()));
+		} else {
+			WriteDynamicObject (outputStream, node.get ());
+		}
 		return true;
 	});
 
@@ -10,13 +10,16 @@ class NodeManagerSerialization
 {
 public:
 	static Stream::Status	Read (NodeManager& nodeManager, InputStream& inputStream);
-	static Stream::Status	Write (const NodeManager& nodeManager, OutputStream& outputStream);
+	static Stream::Status	Write (const NodeManager& nodeManager, OutputStream& outputStream, NodeManager::NodeRecordMode recordMode);
 
 private:
 	static Stream::Status	ReadNodes (NodeManager& nodeManager, InputStream& inputStream, const ObjectVersion& version);
+	static Stream::Status	ReadInlineNodes (NodeManager& nodeManager, InputStream& inputStream);
+	static Stream::Status	ReadLengthPrefixedNodes (NodeManager& nodeManager, InputStream& inputStream);
+	static Stream::Status	AddReadNode (NodeManager& nodeManager, const NodePtr& node);
 	static Stream::Status	ReadConnections (NodeManager& nodeManager, InputStream& inputStream, const ObjectVersion& version);
 	static Stream::Status	ReadGroups (NodeManager& nodeManager, InputStream& inputStream, const ObjectVersion& version);
-	static Stream::Status	WriteNodes (const NodeManager& nodeManager, OutputStream& outputStream);
+	static Stream::Status	WriteNodes (const NodeManager& nodeManager, OutputStream& outputStream, NodeManager::NodeRecordMode recordMode);
 	static Stream::Status	WriteConnections (const NodeManager& nodeManager, OutputStream& outputStream);
 	static Stream::Status	WriteGroups (const NodeManager& nodeManager, OutputStream& outputStream);
 };
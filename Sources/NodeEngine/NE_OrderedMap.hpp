@@ -4,7 +4,7 @@
 #include "NE_Debug.hpp"
 
 #include <utility>
-#include <list>
+#include <vector>
 #include <unordered_map>
 #include <functional>
 #include <algorithm>
@@ -12,6 +12,11 @@
 namespace NE
 {
 
+// values are stored in insertion order in a vector, erased values leave a tombstone
+// behind which is removed by the next compaction, so enumeration is a linear scan,
+// InsertBefore and InsertAfter shift the following entries and rebuild their index, so they are O(n),
+// values can be erased and inserted during enumeration, but compaction is deferred until no enumeration
+// is running, InsertBefore, InsertAfter and MakeSorted are not allowed during enumeration
 template <typename Key, typename Value>
 class OrderedMap
 {
@@ -41,40 +46,83 @@ public:
 	void			Enumerate (const std::function<bool (Value&)>& processor);
 	void			Enumerate (const std::function<bool (const Value&)>& processor) const;
 
-private:
-	using KeyValue	= std::pair<Key, Value>;
-	using List		= std::list<KeyValue>;
-	using Iterator	= typename List::iterator;
+	template <class Processor>
+	void			Enumerate (const Processor& processor);
+
+	template <class Processor>
+	void			Enumerate (const Processor& processor) const;
 
-	List								valueList;
-	std::unordered_map<Key, Iterator>	keyToValueMap;
+private:
+	struct Entry
+	{
+		Key		key;
+		Value	value;
+		bool	isErased;
+	};
+
+	class EnumerationScope
+	{
+	public:
+		EnumerationScope (const OrderedMap& map);
+		~EnumerationScope ();
+
+	private:
+		const OrderedMap& map;
+	};
+
+	bool			InsertAt (const Key& key, const Value& value, size_t index);
+	void			Compact ();
+	void			CompactIfNeeded ();
+	void			RebuildIndex (size_t firstIndex);
+
+	std::vector<Entry>					entries;
+	std::unordered_map<Key, size_t>		keyToIndexMap;
+	size_t								erasedCount;
+	mutable size_t						enumerationDepth;
 };
 
+template <typename Key, typename Value>
+OrderedMap<Key, Value>::EnumerationScope::EnumerationScope (const OrderedMap& map) :
+	map (map)
+{
+	map.enumerationDepth++;
+}
+
+template <typename Key, typename Value>
+OrderedMap<Key, Value>::EnumerationScope::~EnumerationScope ()
+{
+	map.enumerationDepth--;
+}
+
 template <typename Key, typename Value>
 OrderedMap<Key, Value>::OrderedMap () :
-	valueList (),
-	keyToValueMap ()
+	entries (),
+	keyToIndexMap (),
+	erasedCount (0),
+	enumerationDepth (0)
 {
 
 }
 
 template <typename Key, typename Value>
 OrderedMap<Key, Value>::OrderedMap (const OrderedMap& rhs) :
-	valueList (rhs.valueList),
-	keyToValueMap ()
+	entries (),
+	keyToIndexMap (),
+	erasedCount (0),
+	enumerationDepth (0)
 {
-	for (auto it = valueList.begin (); it != valueList.end (); ++it) {
-		const KeyValue& keyValue = *it;
-		keyToValueMap.insert ({ keyValue.first, it });
-	}
+	*this = rhs;
 }
 
 template <typename Key, typename Value>
 OrderedMap<Key, Value>::OrderedMap (OrderedMap&& rhs) :
-	valueList (std::move (rhs.valueList)),
-	keyToValueMap (std::move (rhs.keyToValueMap))
+	entries (std::move (rhs.entries)),
+	keyToIndexMap (std::move (rhs.keyToIndexMap)),
+	erasedCount (rhs.erasedCount),
+	enumerationDepth (0)
 {
-	
+	DBGASSERT (rhs.enumerationDepth == 0);
+	rhs.erasedCount = 0;
 }
 
 template <typename Key, typename Value>
@@ -86,13 +134,18 @@ OrderedMap<Key, Value>::~OrderedMap ()
 template <typename Key, typename Value>
 OrderedMap<Key, Value>& OrderedMap<Key, Value>::operator= (const OrderedMap& rhs)
 {
+	DBGASSERT (enumerationDepth == 0);
 	if (this != &rhs) {
-		valueList = rhs.valueList;
-		keyToValueMap.clear ();
-		for (auto it = valueList.begin (); it != valueList.end (); ++it) {
-			const KeyValue& keyValue = *it;
-			keyToValueMap.insert ({ keyValue.first, it });
+		entries.clear ();
+		entries.reserve (rhs.Count ());
+		for (const Entry& entry : rhs.entries) {
+			if (!entry.isErased) {
+				entries.push_back (entry);
+			}
 		}
+		erasedCount = 0;
+		keyToIndexMap.clear ();
+		RebuildIndex (0);
 	}
 	return *this;
 }
@@ -100,9 +153,12 @@ OrderedMap<Key, Value>& OrderedMap<Key, Value>::operator= (const OrderedMap& rhs
 template <typename Key, typename Value>
 OrderedMap<Key, Value>& OrderedMap<Key, Value>::operator= (OrderedMap&& rhs)
 {
+	DBGASSERT (enumerationDepth == 0 && rhs.enumerationDepth == 0);
 	if (this != &rhs) {
-		valueList = std::move (rhs.valueList);
-		keyToValueMap = std::move (rhs.keyToValueMap);
+		entries = std::move (rhs.entries);
+		keyToIndexMap = std::move (rhs.keyToIndexMap);
+		erasedCount = rhs.erasedCount;
+		rhs.erasedCount = 0;
 	}
 	return *this;
 }
@@ -110,131 +166,198 @@ OrderedMap<Key, Value>& OrderedMap<Key, Value>::operator= (OrderedMap&& rhs)
 template <typename Key, typename Value>
 bool OrderedMap<Key, Value>::IsEmpty () const
 {
-	return keyToValueMap.empty ();
+	return keyToIndexMap.empty ();
 }
 
 template <typename Key, typename Value>
 bool OrderedMap<Key, Value>::Contains (const Key& key) const
 {
-	return keyToValueMap.find (key) != keyToValueMap.end ();
+	return keyToIndexMap.find (key) != keyToIndexMap.end ();
 }
 
 template <typename Key, typename Value>
 size_t OrderedMap<Key, Value>::Count () const
 {
-	return keyToValueMap.size ();
+	return keyToIndexMap.size ();
 }
 
 template <typename Key, typename Value>
 Value& OrderedMap<Key, Value>::GetValue (const Key& key)
 {
-	Iterator& iterator = keyToValueMap.at (key);
-	KeyValue& keyValue = *iterator;
-	return keyValue.second;
+	return entries[keyToIndexMap.at (key)].value;
 }
 
 template <typename Key, typename Value>
 const Value& OrderedMap<Key, Value>::GetValue (const Key& key) const
 {
-	const Iterator& iterator = keyToValueMap.at (key);
-	const KeyValue& keyValue = *iterator;
-	return keyValue.second;
+	return entries[keyToIndexMap.at (key)].value;
 }
 
 template <typename Key, typename Value>
 bool OrderedMap<Key, Value>::Insert (const Key& key, const Value& value)
 {
-	if (DBGERROR (keyToValueMap.find (key) != keyToValueMap.end ())) {
+	if (DBGERROR (keyToIndexMap.find (key) != keyToIndexMap.end ())) {
 		return false;
 	}
 
-	auto inserted = valueList.insert (valueList.end (), { key, value } );
-	keyToValueMap.insert ({ key, inserted });
+	// compaction would move the entries under a running enumeration
+	if (enumerationDepth == 0) {
+		CompactIfNeeded ();
+	}
+	keyToIndexMap.insert ({ key, entries.size () });
+	entries.push_back ({ key, value, false });
 	return true;
 }
 
 template <typename Key, typename Value>
 bool OrderedMap<Key, Value>::InsertBefore (const Key& key, const Value& value, const Key& nextKey)
 {
-	if (DBGERROR (keyToValueMap.find (key) != keyToValueMap.end ())) {
+	if (DBGERROR (keyToIndexMap.find (key) != keyToIndexMap.end ())) {
 		return false;
 	}
 
-	auto foundNextValue = keyToValueMap.find (nextKey);
-	if (DBGERROR (foundNextValue == keyToValueMap.end ())) {
+	auto foundNextValue = keyToIndexMap.find (nextKey);
+	if (DBGERROR (foundNextValue == keyToIndexMap.end ())) {
 		return false;
 	}
-	
-	auto inserted = valueList.insert (foundNextValue->second, { key, value });
-	keyToValueMap.insert ({ key, inserted });
-	return true;
+
+	return InsertAt (key, value, foundNextValue->second);
 }
 
 template <typename Key, typename Value>
 bool OrderedMap<Key, Value>::InsertAfter (const Key& key, const Value& value, const Key& prevKey)
 {
-	if (DBGERROR (keyToValueMap.find (key) != keyToValueMap.end ())) {
+	if (DBGERROR (keyToIndexMap.find (key) != keyToIndexMap.end ())) {
 		return false;
 	}
 
-	auto foundPrevValue = keyToValueMap.find (prevKey);
-	if (DBGERROR (foundPrevValue == keyToValueMap.end ())) {
+	auto foundPrevValue = keyToIndexMap.find (prevKey);
+	if (DBGERROR (foundPrevValue == keyToIndexMap.end ())) {
 		return false;
 	}
 
-	auto inserted = valueList.insert (std::next (foundPrevValue->second), { key, value });
-	keyToValueMap.insert ({ key, inserted });
-	return true;
+	return InsertAt (key, value, foundPrevValue->second + 1);
 }
 
 template <typename Key, typename Value>
 void OrderedMap<Key, Value>::MakeSorted ()
 {
-	valueList.sort ([&] (const KeyValue& a, const KeyValue& b) {
-		return a.first < b.first;
+	DBGASSERT (enumerationDepth == 0);
+	Compact ();
+	std::sort (entries.begin (), entries.end (), [&] (const Entry& a, const Entry& b) {
+		return a.key < b.key;
 	});
+	RebuildIndex (0);
 }
 
 template <typename Key, typename Value>
 bool OrderedMap<Key, Value>::Erase (const Key& key)
 {
-	auto foundInMap = keyToValueMap.find (key);
-	if (DBGERROR (foundInMap == keyToValueMap.end ())) {
+	auto foundInMap = keyToIndexMap.find (key);
+	if (DBGERROR (foundInMap == keyToIndexMap.end ())) {
 		return false;
 	}
 
-	valueList.erase (foundInMap->second);
-	keyToValueMap.erase (key);
+	// the entry is not moved, so erasing during enumeration is safe
+	Entry& entry = entries[foundInMap->second];
+	entry.value = Value ();
+	entry.isErased = true;
+	erasedCount += 1;
+	keyToIndexMap.erase (foundInMap);
 	return true;
 }
 
 template <typename Key, typename Value>
 void OrderedMap<Key, Value>::Clear ()
 {
-	valueList.clear ();
-	keyToValueMap.clear ();
+	entries.clear ();
+	keyToIndexMap.clear ();
+	erasedCount = 0;
 }
 
 template <typename Key, typename Value>
 void OrderedMap<Key, Value>::Enumerate (const std::function<bool (Value&)>& processor)
 {
-	for (KeyValue& keyValue : valueList) {
-		if (!processor (keyValue.second)) {
+	Enumerate<std::function<bool (Value&)>> (processor);
+}
+
+template <typename Key, typename Value>
+void OrderedMap<Key, Value>::Enumerate (const std::function<bool (const Value&)>& processor) const
+{
+	Enumerate<std::function<bool (const Value&)>> (processor);
+}
+
+template <typename Key, typename Value>
+template <class Processor>
+void OrderedMap<Key, Value>::Enumerate (const Processor& processor)
+{
+	EnumerationScope scope (*this);
+	for (size_t i = 0; i < entries.size (); i++) {
+		if (entries[i].isErased) {
+			continue;
+		}
+		if (!processor (entries[i].value)) {
 			break;
 		}
 	}
 }
 
 template <typename Key, typename Value>
-void OrderedMap<Key, Value>::Enumerate (const std::function<bool (const Value&)>& processor) const
+template <class Processor>
+void OrderedMap<Key, Value>::Enumerate (const Processor& processor) const
 {
-	for (const KeyValue& keyValue : valueList) {
-		if (!processor (keyValue.second)) {
+	EnumerationScope scope (*this);
+	for (size_t i = 0; i < entries.size (); i++) {
+		if (entries[i].isErased) {
+			continue;
+		}
+		if (!processor (entries[i].value)) {
 			break;
 		}
 	}
 }
 
+template <typename Key, typename Value>
+bool OrderedMap<Key, Value>::InsertAt (const Key& key, const Value& value, size_t index)
+{
+	DBGASSERT (enumerationDepth == 0);
+	entries.insert (entries.begin () + index, { key, value, false });
+	RebuildIndex (index);
+	return true;
+}
+
+template <typename Key, typename Value>
+void OrderedMap<Key, Value>::Compact ()
+{
+	if (erasedCount == 0) {
+		return;
+	}
+	entries.erase (std::remove_if (entries.begin (), entries.end (), [&] (const Entry& entry) {
+		return entry.isErased;
+	}), entries.end ());
+	erasedCount = 0;
+	RebuildIndex (0);
+}
+
+template <typename Key, typename Value>
+void OrderedMap<Key, Value>::CompactIfNeeded ()
+{
+	if (erasedCount > 0 && erasedCount >= entries.size () / 2) {
+		Compact ();
+	}
+}
+
+template <typename Key, typename Value>
+void OrderedMap<Key, Value>::RebuildIndex (size_t firstIndex)
+{
+	for (size_t i = firstIndex; i < entries.size (); i++) {
+		const Entry& entry = entries[i];
+		if (!entry.isErased) {
+			keyToIndexMap[entry.key] = i;
+		}
+	}
+}
+
 }
 
 #endif
@@ -30,6 +30,11 @@ ValueConstPtr OutputSlot::Evaluate (EvaluationEnv& env) const
 	return EvaluateOwnerNode (env);
 }
 
+OutputSlotPtr OutputSlot::Clone () const
+{
+	return CopyDynamicObject<OutputSlot> (this);
+}
+
 Stream::Status OutputSlot::Read (InputStream& inputStream)
 {
 	ObjectHeader header (inputStream);
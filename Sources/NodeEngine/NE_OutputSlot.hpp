@@ -17,6 +17,7 @@ public:
 	virtual ~OutputSlot ();
 
 	virtual ValueConstPtr	Evaluate (EvaluationEnv& env) const;
+	virtual OutputSlotPtr	Clone () const;
 
 	virtual Stream::Status	Read (InputStream& inputStream) override;
 	virtual Stream::Status	Write (OutputStream& outputStream) const override;
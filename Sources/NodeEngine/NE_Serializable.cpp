@@ -24,12 +24,15 @@ public:
 		objectMap.insert ({ objectId, serializationInfo });
 	}
 
-	const DynamicSerializationInfo* GetSerializationInfo (const ObjectId& objectId)
+	// objects are registered during static initialization, after that the
+	// registry is read only, so it is safe to query it from multiple threads
+	const DynamicSerializationInfo* GetSerializationInfo (const ObjectId& objectId) const
 	{
-		if (DBGERROR (objectMap.find (objectId) == objectMap.end ())) {
+		auto found = objectMap.find (objectId);
+		if (DBGERROR (found == objectMap.end ())) {
 			return nullptr;
 		}
-		return objectMap[objectId];
+		return found->second;
 	}
 
 private:
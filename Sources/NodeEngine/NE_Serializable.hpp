@@ -2,8 +2,12 @@
 #define NE_SERIALIZABLE_HPP
 
 #include "NE_Stream.hpp"
+#include "NE_MemoryStream.hpp"
 #include "NE_Debug.hpp"
 
+#include <memory>
+#include <typeinfo>
+
 namespace NE
 {
 
@@ -119,6 +123,33 @@ ObjectType* ReadDynamicObject (InputStream& inputStream)
 	return typedObj;
 }
 
+template <class ResultType, class ObjectType>
+std::shared_ptr<ResultType> CopyDynamicObject (const ObjectType* obj)
+{
+	// a derived class can have members that the copy constructor doesn't know about
+	if (typeid (*obj) != typeid (ObjectType)) {
+		return nullptr;
+	}
+	return std::shared_ptr<ResultType> (new ObjectType (*obj));
+}
+
+template <class ObjectType>
+std::shared_ptr<ObjectType> CloneDynamicObject (const ObjectType* obj)
+{
+	MemoryOutputStream outputStream;
+	if (DBGERROR (!WriteDynamicObject (outputStream, obj))) {
+		return nullptr;
+	}
+
+	MemoryInputStream inputStream (outputStream.GetBuffer ());
+	std::shared_ptr<ObjectType> result (ReadDynamicObject<ObjectType> (inputStream));
+	if (DBGERROR (result == nullptr)) {
+		return nullptr;
+	}
+
+	return result;
+}
+
 }
 
 namespace std
@@ -21,6 +21,14 @@ Slot::Slot (const SlotId& slotId) :
 
 }
 
+Slot::Slot (const Slot& src) :
+	DynamicSerializable (),
+	slotId (src.slotId),
+	ownerNode (nullptr)
+{
+
+}
+
 Slot::~Slot ()
 {
 
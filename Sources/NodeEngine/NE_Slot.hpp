@@ -17,7 +17,6 @@ class Slot : public DynamicSerializable
 public:
 	Slot ();
 	Slot (const SlotId& slotId);
-	Slot (const Slot& src) = delete;
 	virtual ~Slot ();
 
 	const SlotId&			GetId () const;
@@ -30,6 +29,8 @@ public:
 	virtual Stream::Status	Write (OutputStream& outputStream) const override;
 
 protected:
+	Slot (const Slot& src);
+
 	SlotId	slotId;
 	Node*	ownerNode;
 };
@@ -1,18 +1,130 @@
 #include "NE_SlotId.hpp"
 
+#include <unordered_set>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+
 namespace NE
 {
 
 SERIALIZATION_INFO (SlotId, 1);
 
+// slot ids are interned in a table that can be read without locking,
+// only threads that insert a new id take the lock
+class SlotIdAtomTable
+{
+public:
+	SlotIdAtomTable ();
+
+	const std::string*	Intern (const std::string& id);
+
+private:
+	class Buckets
+	{
+	public:
+		Buckets (size_t size);
+
+		const std::string*	Find (const std::string& id, size_t hash) const;
+		void				Insert (const std::string* atom, size_t hash);
+
+		size_t													size;
+		std::unique_ptr<std::atomic<const std::string*>[]>		slots;
+	};
+
+	// elements of an unordered_set never move, so the returned pointers stay valid
+	std::unordered_set<std::string>			atoms;
+	std::atomic<const Buckets*>				currentBuckets;
+	std::vector<std::unique_ptr<Buckets>>	allBuckets;
+	std::mutex								insertMutex;
+};
+
+SlotIdAtomTable::Buckets::Buckets (size_t size) :
+	size (size),
+	slots (new std::atomic<const std::string*>[size])
+{
+	for (size_t i = 0; i < size; i++) {
+		slots[i].store (nullptr, std::memory_order_relaxed);
+	}
+}
+
+const std::string* SlotIdAtomTable::Buckets::Find (const std::string& id, size_t hash) const
+{
+	for (size_t i = hash & (size - 1); ; i = (i + 1) & (size - 1)) {
+		const std::string* atom = slots[i].load (std::memory_order_acquire);
+		if (atom == nullptr || *atom == id) {
+			return atom;
+		}
+	}
+}
+
+void SlotIdAtomTable::Buckets::Insert (const std::string* atom, size_t hash)
+{
+	for (size_t i = hash & (size - 1); ; i = (i + 1) & (size - 1)) {
+		if (slots[i].load (std::memory_order_relaxed) == nullptr) {
+			slots[i].store (atom, std::memory_order_release);
+			return;
+		}
+	}
+}
+
+SlotIdAtomTable::SlotIdAtomTable () :
+	atoms (),
+	currentBuckets (nullptr),
+	allBuckets (),
+	insertMutex ()
+{
+	allBuckets.push_back (std::unique_ptr<Buckets> (new Buckets (256)));
+	currentBuckets.store (allBuckets.back ().get ());
+}
+
+const std::string* SlotIdAtomTable::Intern (const std::string& id)
+{
+	size_t hash = std::hash<std::string> {} (id);
+	const std::string* atom = currentBuckets.load (std::memory_order_acquire)->Find (id, hash);
+	if (atom != nullptr) {
+		return atom;
+	}
+
+	std::lock_guard<std::mutex> lock (insertMutex);
+	auto inserted = atoms.insert (id);
+	atom = &*inserted.first;
+	if (!inserted.second) {
+		return atom;
+	}
+
+	// the table is kept at most half full, so a lookup always finds an empty slot,
+	// replaced buckets are kept, because readers may still use them
+	const Buckets* buckets = currentBuckets.load (std::memory_order_relaxed);
+	if (atoms.size () * 2 > buckets->size) {
+		Buckets* newBuckets = new Buckets (buckets->size * 2);
+		allBuckets.push_back (std::unique_ptr<Buckets> (newBuckets));
+		for (const std::string& oldAtom : atoms) {
+			newBuckets->Insert (&oldAtom, std::hash<std::string> {} (oldAtom));
+		}
+		currentBuckets.store (newBuckets, std::memory_order_release);
+	} else {
+		allBuckets.back ()->Insert (atom, hash);
+	}
+
+	return atom;
+}
+
+static const std::string* InternSlotId (const std::string& id)
+{
+	static SlotIdAtomTable atomTable;
+	return atomTable.Intern (id);
+}
+
 SlotId::SlotId () :
-	id ()
+	id (InternSlotId (std::string ()))
 {
 
 }
 
 SlotId::SlotId (const std::string& id) :
-	id (id)
+	id (InternSlotId (id))
 {
 
 }
@@ -24,17 +136,17 @@ SlotId::~SlotId ()
 
 size_t SlotId::GenerateHashValue () const
 {
-	return std::hash<std::string> {} (id);
+	return std::hash<const std::string*> {} (id);
 }
 
 bool SlotId::operator< (const SlotId& rhs) const
 {
-	return id < rhs.id;
+	return *id < *rhs.id;
 }
 
 bool SlotId::operator> (const SlotId& rhs) const
 {
-	return id > rhs.id;
+	return *id > *rhs.id;
 }
 
 bool SlotId::operator== (const SlotId& rhs) const
@@ -50,14 +162,16 @@ bool SlotId::operator!= (const SlotId& rhs) const
 Stream::Status SlotId::Read (InputStream& inputStream)
 {
 	ObjectHeader header (inputStream);
-	inputStream.Read (id);
+	std::string idString;
+	inputStream.Read (idString);
+	id = InternSlotId (idString);
 	return inputStream.GetStatus ();
 }
 
 Stream::Status SlotId::Write (OutputStream& outputStream) const
 {
 	ObjectHeader header (outputStream, serializationInfo);
-	outputStream.Write (id);
+	outputStream.Write (*id);
 	return outputStream.GetStatus ();
 }
 
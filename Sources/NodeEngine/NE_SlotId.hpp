@@ -28,7 +28,8 @@ public:
 	Stream::Status	Write (OutputStream& outputStream) const;
 
 private:
-	std::string id;
+	// interned string, equal ids always point to the same string
+	const std::string* id;
 };
 
 extern const SlotId NullSlotId;
@@ -34,6 +34,12 @@ public:
 	void								Enumerate (const std::function<bool (std::shared_ptr<SlotType>&)>& processor);
 	void								Enumerate (const std::function<bool (const std::shared_ptr<const SlotType>&)>& processor) const;
 
+	template <class Processor>
+	void								Enumerate (const Processor& processor);
+
+	template <class Processor>
+	void								Enumerate (const Processor& processor) const;
+
 private:
 	OrderedMap<SlotId, std::shared_ptr<SlotType>>	slots;
 };
@@ -101,6 +107,19 @@ bool SlotList<SlotType>::IsEmpty () const
 
 template <class SlotType>
 void SlotList<SlotType>::Enumerate (const std::function<bool (std::shared_ptr<SlotType>&)>& processor)
+{
+	Enumerate<std::function<bool (std::shared_ptr<SlotType>&)>> (processor);
+}
+
+template <class SlotType>
+void SlotList<SlotType>::Enumerate (const std::function<bool (const std::shared_ptr<const SlotType>&)>& processor) const
+{
+	Enumerate<std::function<bool (const std::shared_ptr<const SlotType>&)>> (processor);
+}
+
+template <class SlotType>
+template <class Processor>
+void SlotList<SlotType>::Enumerate (const Processor& processor)
 {
 	slots.Enumerate ([&] (std::shared_ptr<SlotType>& slot) {
 		return processor (slot);
@@ -108,10 +127,11 @@ void SlotList<SlotType>::Enumerate (const std::function<bool (std::shared_ptr<Sl
 }
 
 template <class SlotType>
-void SlotList<SlotType>::Enumerate (const std::function<bool (const std::shared_ptr<const SlotType>&)>& processor) const
+template <class Processor>
+void SlotList<SlotType>::Enumerate (const Processor& processor) const
 {
 	slots.Enumerate ([&] (const std::shared_ptr<SlotType>& slot) {
-		return processor (slot);
+		return processor (std::shared_ptr<const SlotType> (slot));
 	});
 }
 
@@ -17,6 +17,13 @@ UniqueIdGenerator::~UniqueIdGenerator ()
 
 }
 
+UniqueIdGenerator& UniqueIdGenerator::operator= (const UniqueIdGenerator& rhs)
+{
+	nextNodeId = rhs.nextNodeId.load ();
+	nextNodeGroupId = rhs.nextNodeGroupId.load ();
+	return *this;
+}
+
 void UniqueIdGenerator::Clear ()
 {
 	nextNodeId = 1;
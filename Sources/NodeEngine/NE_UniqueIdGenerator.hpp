@@ -20,6 +20,8 @@ public:
 	UniqueIdGenerator ();
 	~UniqueIdGenerator ();
 
+	UniqueIdGenerator&		operator= (const UniqueIdGenerator& rhs);
+
 	void					Clear ();
 	NodeId					GenerateNodeId ();
 	NodeGroupId				GenerateNodeGroupId ();
@@ -0,0 +1,285 @@
+#include "BenchmarkEnvironment.hpp"
+
+namespace Benchmark
+{
+
+CountingDrawingContext::Counters::Counters () :
+	lines (0),
+	beziers (0),
+	rects (0),
+	ellipses (0),
+	texts (0),
+	icons (0),
+	measuredTexts (0)
+{
+
+}
+
+size_t CountingDrawingContext::Counters::GetPrimitiveCount () const
+{
+	return lines + beziers + rects + ellipses + texts + icons;
+}
+
+CountingDrawingContext::CountingDrawingContext (int width, int height) :
+	NUIE::DrawingContext (),
+	width (width),
+	height (height),
+	counters ()
+{
+
+}
+
+CountingDrawingContext::~CountingDrawingContext ()
+{
+
+}
+
+const CountingDrawingContext::Counters& CountingDrawingContext::GetCounters () const
+{
+	return counters;
+}
+
+void CountingDrawingContext::ResetCounters ()
+{
+	counters = Counters ();
+}
+
+void CountingDrawingContext::Resize (int newWidth, int newHeight)
+{
+	width = newWidth;
+	height = newHeight;
+}
+
+int CountingDrawingContext::GetWidth () const
+{
+	return width;
+}
+
+int CountingDrawingContext::GetHeight () const
+{
+	return height;
+}
+
+void CountingDrawingContext::BeginDraw ()
+{
+
+}
+
+void CountingDrawingContext::EndDraw ()
+{
+
+}
+
+bool CountingDrawingContext::NeedToDraw (ItemPreviewMode)
+{
+	return true;
+}
+
+void CountingDrawingContext::DrawLine (const NUIE::Point&, const NUIE::Point&, const NUIE::Pen&)
+{
+	counters.lines++;
+}
+
+void CountingDrawingContext::DrawBezier (const NUIE::Point&, const NUIE::Point&, const NUIE::Point&, const NUIE::Point&, const NUIE::Pen&)
+{
+	counters.beziers++;
+}
+
+void CountingDrawingContext::DrawRect (const NUIE::Rect&, const NUIE::Pen&)
+{
+	counters.rects++;
+}
+
+void CountingDrawingContext::FillRect (const NUIE::Rect&, const NUIE::Color&)
+{
+	counters.rects++;
+}
+
+void CountingDrawingContext::DrawEllipse (const NUIE::Rect&, const NUIE::Pen&)
+{
+	counters.ellipses++;
+}
+
+void CountingDrawingContext::FillEllipse (const NUIE::Rect&, const NUIE::Color&)
+{
+	counters.ellipses++;
+}
+
+void CountingDrawingContext::DrawFormattedText (const NUIE::Rect&, const NUIE::Font&, const std::wstring&, NUIE::HorizontalAnchor, NUIE::VerticalAnchor, const NUIE::Color&)
+{
+	counters.texts++;
+}
+
+NUIE::Size CountingDrawingContext::MeasureText (const NUIE::Font& font, const std::wstring& text)
+{
+	// rough estimation of an average proportional font, so node layouts get realistic sizes
+	counters.measuredTexts++;
+	double fontSize = font.GetSize ();
+	return NUIE::Size (text.length () * fontSize * 0.6, fontSize * 1.5);
+}
+
+bool CountingDrawingContext::CanDrawIcon ()
+{
+	return false;
+}
+
+void CountingDrawingContext::DrawIcon (const NUIE::Rect&, const NUIE::IconId&)
+{
+	counters.icons++;
+}
+
+bool CountingDrawingContext::CanClip ()
+{
+	// clipping is accepted, so partial redraws are measured with their culled item set
+	return true;
+}
+
+void CountingDrawingContext::SetClipRect (const NUIE::Rect&)
+{
+
+}
+
+void CountingDrawingContext::ResetClipRect ()
+{
+
+}
+
+BenchmarkUIEnvironment::BenchmarkUIEnvironment (int width, int height) :
+	NUIE::NodeUIEnvironment (),
+	stringConverter (NE::GetDefaultStringConverter ()),
+	skinParams (NUIE::GetDefaultSkinParams ()),
+	drawingContext (width, height),
+	eventHandler (),
+	clipboardHandler (),
+	evaluationEnv (nullptr)
+{
+
+}
+
+BenchmarkUIEnvironment::~BenchmarkUIEnvironment ()
+{
+
+}
+
+CountingDrawingContext& BenchmarkUIEnvironment::GetCountingContext ()
+{
+	return drawingContext;
+}
+
+const NE::StringConverter& BenchmarkUIEnvironment::GetStringConverter ()
+{
+	return stringConverter;
+}
+
+const NUIE::SkinParams& BenchmarkUIEnvironment::GetSkinParams ()
+{
+	return skinParams;
+}
+
+NUIE::DrawingContext& BenchmarkUIEnvironment::GetDrawingContext ()
+{
+	return drawingContext;
+}
+
+double BenchmarkUIEnvironment::GetWindowScale ()
+{
+	return 1.0;
+}
+
+NE::EvaluationEnv& BenchmarkUIEnvironment::GetEvaluationEnv ()
+{
+	return evaluationEnv;
+}
+
+void BenchmarkUIEnvironment::OnEvaluationBegin ()
+{
+
+}
+
+void BenchmarkUIEnvironment::OnEvaluationEnd ()
+{
+
+}
+
+void BenchmarkUIEnvironment::OnValuesRecalculated ()
+{
+
+}
+
+void BenchmarkUIEnvironment::OnRedrawRequested ()
+{
+
+}
+
+NUIE::EventHandler& BenchmarkUIEnvironment::GetEventHandler ()
+{
+	return eventHandler;
+}
+
+NUIE::ClipboardHandler& BenchmarkUIEnvironment::GetClipboardHandler ()
+{
+	return clipboardHandler;
+}
+
+void BenchmarkUIEnvironment::OnSelectionChanged (const NUIE::Selection&)
+{
+
+}
+
+void BenchmarkUIEnvironment::OnUndoStateChanged (const NUIE::UndoState&)
+{
+
+}
+
+void BenchmarkUIEnvironment::OnClipboardStateChanged (const NUIE::ClipboardState&)
+{
+
+}
+
+void BenchmarkUIEnvironment::OnIncompatibleVersionPasted (const NUIE::Version&)
+{
+
+}
+
+EmptyDrawingModifier::EmptyDrawingModifier () :
+	NUIE::NodeDrawingModifier ()
+{
+
+}
+
+EmptyDrawingModifier::~EmptyDrawingModifier ()
+{
+
+}
+
+void EmptyDrawingModifier::EnumerateSelectionRectangles (const std::function<void (const NUIE::Rect&)>&) const
+{
+
+}
+
+void EmptyDrawingModifier::EnumerateTemporaryConnections (const std::function<void (const NUIE::Point&, const NUIE::Point&, Direction)>&) const
+{
+
+}
+
+void EmptyDrawingModifier::EnumerateDuplicatedNodes (const std::function<void (const NE::NodeId&, const NUIE::Point&)>&) const
+{
+
+}
+
+bool EmptyDrawingModifier::NeedToDrawConnection (const NE::NodeId&, const NE::SlotId&, const NE::NodeId&, const NE::SlotId&) const
+{
+	return true;
+}
+
+NUIE::Point EmptyDrawingModifier::GetNodeOffset (const NE::NodeId&) const
+{
+	return NUIE::Point (0.0, 0.0);
+}
+
+void EmptyDrawingModifier::EnumerateOffsetNodes (const std::function<void (const NE::NodeId&)>&) const
+{
+
+}
+
+}
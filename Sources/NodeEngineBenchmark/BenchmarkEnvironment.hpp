@@ -0,0 +1,126 @@
+#ifndef BENCHMARKENVIRONMENT_HPP
+#define BENCHMARKENVIRONMENT_HPP
+
+#include "NE_StringConverter.hpp"
+#include "NUIE_NodeUIEnvironment.hpp"
+#include "NUIE_NodeDrawingModifier.hpp"
+#include "NUIE_DrawingContext.hpp"
+#include "NUIE_SkinParams.hpp"
+#include "NUIE_EventHandler.hpp"
+#include "NUIE_ClipboardHandler.hpp"
+
+namespace Benchmark
+{
+
+// drawing context that doesn't draw anything, only counts the primitives it receives
+class CountingDrawingContext : public NUIE::DrawingContext
+{
+public:
+	struct Counters
+	{
+		Counters ();
+
+		size_t	GetPrimitiveCount () const;
+
+		size_t	lines;
+		size_t	beziers;
+		size_t	rects;
+		size_t	ellipses;
+		size_t	texts;
+		size_t	icons;
+		size_t	measuredTexts;
+	};
+
+	CountingDrawingContext (int width, int height);
+	virtual ~CountingDrawingContext ();
+
+	const Counters&		GetCounters () const;
+	void				ResetCounters ();
+
+	virtual void		Resize (int newWidth, int newHeight) override;
+
+	virtual int			GetWidth () const override;
+	virtual int			GetHeight () const override;
+
+	virtual void		BeginDraw () override;
+	virtual void		EndDraw () override;
+
+	virtual bool		NeedToDraw (ItemPreviewMode mode) override;
+
+	virtual void		DrawLine (const NUIE::Point& beg, const NUIE::Point& end, const NUIE::Pen& pen) override;
+	virtual void		DrawBezier (const NUIE::Point& p1, const NUIE::Point& p2, const NUIE::Point& p3, const NUIE::Point& p4, const NUIE::Pen& pen) override;
+
+	virtual void		DrawRect (const NUIE::Rect& rect, const NUIE::Pen& pen) override;
+	virtual void		FillRect (const NUIE::Rect& rect, const NUIE::Color& color) override;
+
+	virtual void		DrawEllipse (const NUIE::Rect& rect, const NUIE::Pen& pen) override;
+	virtual void		FillEllipse (const NUIE::Rect& rect, const NUIE::Color& color) override;
+
+	virtual void		DrawFormattedText (const NUIE::Rect& rect, const NUIE::Font& font, const std::wstring& text, NUIE::HorizontalAnchor hAnchor, NUIE::VerticalAnchor vAnchor, const NUIE::Color& textColor) override;
+	virtual NUIE::Size	MeasureText (const NUIE::Font& font, const std::wstring& text) override;
+
+	virtual bool		CanDrawIcon () override;
+	virtual void		DrawIcon (const NUIE::Rect& rect, const NUIE::IconId& iconId) override;
+
+	virtual bool		CanClip () override;
+	virtual void		SetClipRect (const NUIE::Rect& rect) override;
+	virtual void		ResetClipRect () override;
+
+private:
+	int			width;
+	int			height;
+	Counters	counters;
+};
+
+class BenchmarkUIEnvironment : public NUIE::NodeUIEnvironment
+{
+public:
+	BenchmarkUIEnvironment (int width, int height);
+	virtual ~BenchmarkUIEnvironment ();
+
+	CountingDrawingContext&				GetCountingContext ();
+
+	virtual const NE::StringConverter&	GetStringConverter () override;
+	virtual const NUIE::SkinParams&		GetSkinParams () override;
+	virtual NUIE::DrawingContext&		GetDrawingContext () override;
+	virtual double						GetWindowScale () override;
+
+	virtual NE::EvaluationEnv&			GetEvaluationEnv () override;
+	virtual void						OnEvaluationBegin () override;
+	virtual void						OnEvaluationEnd () override;
+	virtual void						OnValuesRecalculated () override;
+	virtual void						OnRedrawRequested () override;
+
+	virtual NUIE::EventHandler&			GetEventHandler () override;
+	virtual NUIE::ClipboardHandler&		GetClipboardHandler () override;
+	virtual void						OnSelectionChanged (const NUIE::Selection& selection) override;
+	virtual void						OnUndoStateChanged (const NUIE::UndoState& undoState) override;
+	virtual void						OnClipboardStateChanged (const NUIE::ClipboardState& clipboardState) override;
+	virtual void						OnIncompatibleVersionPasted (const NUIE::Version& version) override;
+
+private:
+	NE::BasicStringConverter		stringConverter;
+	NUIE::BasicSkinParams			skinParams;
+	CountingDrawingContext			drawingContext;
+	NUIE::NullEventHandler			eventHandler;
+	NUIE::MemoryClipboardHandler	clipboardHandler;
+	NE::EvaluationEnv				evaluationEnv;
+};
+
+class EmptyDrawingModifier : public NUIE::NodeDrawingModifier
+{
+public:
+	EmptyDrawingModifier ();
+	virtual ~EmptyDrawingModifier ();
+
+	virtual void		EnumerateSelectionRectangles (const std::function<void (const NUIE::Rect&)>& processor) const override;
+	virtual void		EnumerateTemporaryConnections (const std::function<void (const NUIE::Point&, const NUIE::Point&, Direction)>& processor) const override;
+	virtual void		EnumerateDuplicatedNodes (const std::function<void (const NE::NodeId&, const NUIE::Point&)>& processor) const override;
+	virtual bool		NeedToDrawConnection (const NE::NodeId& outputNodeId, const NE::SlotId& outputSlotId, const NE::NodeId& inputNodeId, const NE::SlotId& inputSlotId) const override;
+	virtual NUIE::Point	GetNodeOffset (const NE::NodeId& nodeId) const override;
+	virtual void		EnumerateOffsetNodes (const std::function<void (const NE::NodeId&)>& processor) const override;
+};
+
+}
+
+#endif
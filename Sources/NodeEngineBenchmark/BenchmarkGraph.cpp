@@ -0,0 +1,140 @@
+#include "BenchmarkGraph.hpp"
+#include "NUIE_UINodeGroup.hpp"
+#include "BI_InputUINodes.hpp"
+#include "BI_BinaryOperationNodes.hpp"
+#include "BI_UnaryOperationNodes.hpp"
+#include "BI_ViewerUINodes.hpp"
+
+#include <vector>
+#include <random>
+#include <cmath>
+#include <algorithm>
+
+namespace Benchmark
+{
+
+static const double		ColumnDistance = 250.0;
+static const double		RowDistance = 120.0;
+static const size_t		GroupSize = 16;
+static const size_t		GroupedColumnFrequency = 3;
+static const int		MaxConnectionRowDistance = 2;
+static const NE::SlotId	OutSlotId ("out");
+static const NE::SlotId	ResultSlotId ("result");
+
+static NUIE::UINodePtr CreateInputNode (const NUIE::Point& position, size_t row, std::mt19937& generator)
+{
+	std::uniform_int_distribution<int> valueDistribution (-100, 100);
+	if (row % 2 == 0) {
+		return NUIE::UINodePtr (new BI::IntegerUpDownNode (NE::LocString (L"Integer"), position, valueDistribution (generator), 1));
+	} else {
+		return NUIE::UINodePtr (new BI::DoubleUpDownNode (NE::LocString (L"Number"), position, valueDistribution (generator) / 10.0, 1.0));
+	}
+}
+
+static NUIE::UINodePtr CreateOperationNode (const NUIE::Point& position, std::mt19937& generator)
+{
+	std::uniform_int_distribution<int> typeDistribution (0, 7);
+	switch (typeDistribution (generator)) {
+		case 0:
+		case 1:
+			return NUIE::UINodePtr (new BI::AdditionNode (NE::LocString (L"Addition"), position));
+		case 2:
+			return NUIE::UINodePtr (new BI::SubtractionNode (NE::LocString (L"Subtraction"), position));
+		case 3:
+			return NUIE::UINodePtr (new BI::MultiplicationNode (NE::LocString (L"Multiplication"), position));
+		case 4:
+			return NUIE::UINodePtr (new BI::DivisionNode (NE::LocString (L"Division"), position));
+		case 5:
+			return NUIE::UINodePtr (new BI::AbsNode (NE::LocString (L"Abs"), position));
+		case 6:
+			return NUIE::UINodePtr (new BI::NegativeNode (NE::LocString (L"Negative"), position));
+		default:
+			return NUIE::UINodePtr (new BI::SqrtNode (NE::LocString (L"Sqrt"), position));
+	}
+}
+
+static NUIE::UIOutputSlotConstPtr GetOutputSlot (const NUIE::UINodePtr& uiNode)
+{
+	if (uiNode->HasOutputSlot (OutSlotId)) {
+		return uiNode->GetUIOutputSlot (OutSlotId);
+	}
+	return uiNode->GetUIOutputSlot (ResultSlotId);
+}
+
+GraphStatistics::GraphStatistics () :
+	nodeCount (0),
+	connectionCount (0),
+	groupCount (0)
+{
+
+}
+
+GraphStatistics GenerateGraph (NUIE::NodeUIManager& uiManager, size_t nodeCount, unsigned int seed)
+{
+	GraphStatistics statistics;
+	if (nodeCount == 0) {
+		return statistics;
+	}
+
+	std::mt19937 generator (seed);
+	std::uniform_int_distribution<int> rowOffsetDistribution (-MaxConnectionRowDistance, MaxConnectionRowDistance);
+
+	size_t rowCount = (size_t) std::ceil (std::sqrt ((double) nodeCount));
+	size_t columnCount = (nodeCount + rowCount - 1) / rowCount;
+
+	std::vector<NUIE::UINodePtr> prevColumn;
+	std::vector<NUIE::UINodePtr> currColumn;
+	for (size_t column = 0; column < columnCount; column++) {
+		size_t columnRowCount = std::min (rowCount, nodeCount - column * rowCount);
+		bool isFirstColumn = (column == 0);
+		bool isLastColumn = (column > 0 && column == columnCount - 1);
+
+		currColumn.clear ();
+		for (size_t row = 0; row < columnRowCount; row++) {
+			NUIE::Point position (column * ColumnDistance, row * RowDistance);
+			NUIE::UINodePtr uiNode = nullptr;
+			if (isFirstColumn) {
+				uiNode = CreateInputNode (position, row, generator);
+			} else if (isLastColumn) {
+				uiNode = NUIE::UINodePtr (new BI::ViewerNode (NE::LocString (L"Viewer"), position));
+			} else {
+				uiNode = CreateOperationNode (position, generator);
+			}
+			uiManager.AddNode (uiNode);
+			currColumn.push_back (uiNode);
+			statistics.nodeCount++;
+
+			if (isFirstColumn) {
+				continue;
+			}
+			uiNode->EnumerateUIInputSlots ([&] (const NUIE::UIInputSlotConstPtr& inputSlot) {
+				int sourceRow = (int) row + rowOffsetDistribution (generator);
+				sourceRow = std::max (0, std::min (sourceRow, (int) prevColumn.size () - 1));
+				NUIE::UIOutputSlotConstPtr outputSlot = GetOutputSlot (prevColumn[sourceRow]);
+				if (uiManager.ConnectOutputSlotToInputSlot (outputSlot, inputSlot)) {
+					statistics.connectionCount++;
+				}
+				return true;
+			});
+		}
+
+		if (column % GroupedColumnFrequency == 1) {
+			for (size_t groupStart = 0; groupStart < currColumn.size (); groupStart += GroupSize) {
+				NE::NodeCollection groupNodes;
+				for (size_t i = groupStart; i < std::min (groupStart + GroupSize, currColumn.size ()); i++) {
+					groupNodes.Insert (currColumn[i]->GetId ());
+				}
+				NUIE::UINodeGroupPtr group (new NUIE::UINodeGroup (NE::LocString (L"Group")));
+				uiManager.AddNodeGroup (group);
+				uiManager.AddNodesToGroup (group, groupNodes);
+				statistics.groupCount++;
+			}
+		}
+
+		prevColumn.swap (currColumn);
+	}
+
+	return statistics;
+}
+
+}
@@ -0,0 +1,24 @@
+#ifndef BENCHMARKGRAPH_HPP
+#define BENCHMARKGRAPH_HPP
+
+#include "NUIE_NodeUIManager.hpp"
+
+namespace Benchmark
+{
+
+struct GraphStatistics
+{
+	GraphStatistics ();
+
+	size_t	nodeCount;
+	size_t	connectionCount;
+	size_t	groupCount;
+};
+
+// generates a deterministic document of built-in nodes laid out in columns, the first column contains
+// input nodes, the last one viewers, and every other node is connected to its neighbors in the previous column
+GraphStatistics GenerateGraph (NUIE::NodeUIManager& uiManager, size_t nodeCount, unsigned int seed);
+
+}
+
+#endif
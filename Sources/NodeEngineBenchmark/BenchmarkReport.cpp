@@ -0,0 +1,120 @@
+#include "BenchmarkReport.hpp"
+
+#include <chrono>
+#include <limits>
+#include <iomanip>
+#include <algorithm>
+
+namespace Benchmark
+{
+
+Measurement::Measurement () :
+	Measurement (std::string ())
+{
+
+}
+
+Measurement::Measurement (const std::string& name) :
+	name (name),
+	repeatCount (0),
+	averageMilliseconds (0.0),
+	minMilliseconds (0.0)
+{
+
+}
+
+GraphResult::GraphResult () :
+	statistics (),
+	measurements (),
+	counters ()
+{
+
+}
+
+ContainerResult::ContainerResult () :
+	name (),
+	elementCount (0),
+	measurements (),
+	counters ()
+{
+
+}
+
+static void WriteMeasurements (std::ostream& stream, const std::vector<Measurement>& measurements)
+{
+	stream << "\t\t\t\"measurements\": {" << std::endl;
+	for (size_t j = 0; j < measurements.size (); j++) {
+		const Measurement& measurement = measurements[j];
+		stream << "\t\t\t\t\"" << measurement.name << "\": { ";
+		stream << "\"repeatCount\": " << measurement.repeatCount << ", ";
+		stream << "\"averageMs\": " << measurement.averageMilliseconds << ", ";
+		stream << "\"minMs\": " << measurement.minMilliseconds << " }";
+		stream << (j + 1 < measurements.size () ? "," : "") << std::endl;
+	}
+	stream << "\t\t\t}," << std::endl;
+}
+
+static void WriteCounters (std::ostream& stream, const std::vector<std::pair<std::string, size_t>>& counters)
+{
+	stream << "\t\t\t\"counters\": {" << std::endl;
+	for (size_t j = 0; j < counters.size (); j++) {
+		const std::pair<std::string, size_t>& counter = counters[j];
+		stream << "\t\t\t\t\"" << counter.first << "\": " << counter.second;
+		stream << (j + 1 < counters.size () ? "," : "") << std::endl;
+	}
+	stream << "\t\t\t}" << std::endl;
+}
+
+Measurement Measure (const std::string& name, size_t repeatCount, const std::function<void ()>& operation)
+{
+	Measurement measurement (name);
+	double sumMilliseconds = 0.0;
+	double minMilliseconds = std::numeric_limits<double>::max ();
+	for (size_t i = 0; i < repeatCount; i++) {
+		std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now ();
+		operation ();
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now ();
+		double milliseconds = std::chrono::duration<double, std::milli> (end - begin).count ();
+		sumMilliseconds += milliseconds;
+		minMilliseconds = std::min (minMilliseconds, milliseconds);
+	}
+	if (repeatCount > 0) {
+		measurement.repeatCount = repeatCount;
+		measurement.averageMilliseconds = sumMilliseconds / repeatCount;
+		measurement.minMilliseconds = minMilliseconds;
+	}
+	return measurement;
+}
+
+void WriteReport (std::ostream& stream, unsigned int seed, const std::vector<GraphResult>& results, const std::vector<ContainerResult>& containerResults)
+{
+	stream << std::fixed << std::setprecision (3);
+	stream << "{" << std::endl;
+	stream << "\t\"seed\": " << seed << "," << std::endl;
+	stream << "\t\"graphs\": [" << std::endl;
+	for (size_t i = 0; i < results.size (); i++) {
+		const GraphResult& result = results[i];
+		stream << "\t\t{" << std::endl;
+		stream << "\t\t\t\"nodeCount\": " << result.statistics.nodeCount << "," << std::endl;
+		stream << "\t\t\t\"connectionCount\": " << result.statistics.connectionCount << "," << std::endl;
+		stream << "\t\t\t\"groupCount\": " << result.statistics.groupCount << "," << std::endl;
+		WriteMeasurements (stream, result.measurements);
+		WriteCounters (stream, result.counters);
+		stream << "\t\t}" << (i + 1 < results.size () ? "," : "") << std::endl;
+	}
+	stream << "\t]," << std::endl;
+	stream << "\t\"containers\": [" << std::endl;
+	for (size_t i = 0; i < containerResults.size (); i++) {
+		const ContainerResult& result = containerResults[i];
+		stream << "\t\t{" << std::endl;
+		stream << "\t\t\t\"name\": \"" << result.name << "\"," << std::endl;
+		stream << "\t\t\t\"elementCount\": " << result.elementCount << "," << std::endl;
+		WriteMeasurements (stream, result.measurements);
+		WriteCounters (stream, result.counters);
+		stream << "\t\t}" << (i + 1 < containerResults.size () ? "," : "") << std::endl;
+	}
+	stream << "\t]" << std::endl;
+	stream << "}" << std::endl;
+}
+
+}
@@ -0,0 +1,50 @@
+#ifndef BENCHMARKREPORT_HPP
+#define BENCHMARKREPORT_HPP
+
+#include "BenchmarkGraph.hpp"
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <functional>
+#include <ostream>
+
+namespace Benchmark
+{
+
+struct Measurement
+{
+	Measurement ();
+	Measurement (const std::string& name);
+
+	std::string		name;
+	size_t			repeatCount;
+	double			averageMilliseconds;
+	double			minMilliseconds;
+};
+
+struct GraphResult
+{
+	GraphResult ();
+
+	GraphStatistics										statistics;
+	std::vector<Measurement>							measurements;
+	std::vector<std::pair<std::string, size_t>>			counters;
+};
+
+struct ContainerResult
+{
+	ContainerResult ();
+
+	std::string											name;
+	size_t												elementCount;
+	std::vector<Measurement>							measurements;
+	std::vector<std::pair<std::string, size_t>>			counters;
+};
+
+Measurement		Measure (const std::string& name, size_t repeatCount, const std::function<void ()>& operation);
+void			WriteReport (std::ostream& stream, unsigned int seed, const std::vector<GraphResult>& results, const std::vector<ContainerResult>& containerResults);
+
+}
+
+#endif
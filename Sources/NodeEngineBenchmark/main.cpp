@@ -0,0 +1,320 @@
+#include "BenchmarkEnvironment.hpp"
+#include "BenchmarkGraph.hpp"
+#include "BenchmarkReport.hpp"
+#include "NUIE_NodeUIManager.hpp"
+#include "NUIE_NodeUIManagerCommands.hpp"
+#include "NUIE_UIItemFinder.hpp"
+#include "NUIE_Selection.hpp"
+#include "NE_OrderedMap.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <random>
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstdlib>
+
+using namespace Benchmark;
+
+static const int			ViewWidth = 1920;
+static const int			ViewHeight = 1080;
+static const size_t			HitTestQueryCount = 1000;
+static const unsigned int	DefaultSeed = 20240101;
+static const size_t			DefaultRepeatCount = 5;
+
+struct Settings
+{
+	Settings () :
+		sizes ({ 1000, 10000, 50000, 200000 }),
+		containerSizes ({ 1000, 100000, 1000000 }),
+		repeatCount (DefaultRepeatCount),
+		seed (DefaultSeed),
+		outputFile ()
+	{
+
+	}
+
+	std::vector<size_t>		sizes;
+	std::vector<size_t>		containerSizes;
+	size_t					repeatCount;
+	unsigned int			seed;
+	std::string				outputFile;
+};
+
+static bool ParseSizes (const std::string& text, std::vector<size_t>& sizes)
+{
+	sizes.clear ();
+	std::istringstream stream (text);
+	std::string item;
+	while (std::getline (stream, item, ',')) {
+		long long size = std::atoll (item.c_str ());
+		if (size <= 0) {
+			return false;
+		}
+		sizes.push_back ((size_t) size);
+	}
+	return !sizes.empty ();
+}
+
+static bool ParseSettings (int argc, char* argv[], Settings& settings)
+{
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		if (i + 1 >= argc) {
+			return false;
+		}
+		std::string value = argv[++i];
+		if (arg == "--sizes") {
+			if (!ParseSizes (value, settings.sizes)) {
+				return false;
+			}
+		} else if (arg == "--container-sizes") {
+			if (!ParseSizes (value, settings.containerSizes)) {
+				return false;
+			}
+		} else if (arg == "--repeat") {
+			int repeatCount = std::atoi (value.c_str ());
+			if (repeatCount <= 0) {
+				return false;
+			}
+			settings.repeatCount = (size_t) repeatCount;
+		} else if (arg == "--seed") {
+			settings.seed = (unsigned int) std::strtoul (value.c_str (), nullptr, 10);
+		} else if (arg == "--output") {
+			settings.outputFile = value;
+		} else {
+			return false;
+		}
+	}
+	return true;
+}
+
+static void AddDrawCounters (const std::string& prefix, const CountingDrawingContext::Counters& counters, GraphResult& result)
+{
+	result.counters.push_back ({ prefix + "Primitives", counters.GetPrimitiveCount () });
+	result.counters.push_back ({ prefix + "Texts", counters.texts });
+	result.counters.push_back ({ prefix + "Beziers", counters.beziers });
+}
+
+static GraphResult RunGraphBenchmark (size_t nodeCount, const Settings& settings)
+{
+	GraphResult result;
+	BenchmarkUIEnvironment env (ViewWidth, ViewHeight);
+	CountingDrawingContext& context = env.GetCountingContext ();
+	NUIE::NodeUIManager uiManager (env);
+	EmptyDrawingModifier drawingModifier;
+
+	result.measurements.push_back (Measure ("generate", 1, [&] () {
+		result.statistics = GenerateGraph (uiManager, nodeCount, settings.seed);
+	}));
+	result.measurements.push_back (Measure ("update", 1, [&] () {
+		uiManager.Update (env);
+	}));
+
+	// the same enumeration through the std::function overloads and through the template overloads
+	size_t functionConnectionCount = 0;
+	result.measurements.push_back (Measure ("enumerateConnectionsFunction", settings.repeatCount, [&] () {
+		functionConnectionCount = 0;
+		const NUIE::NodeUIManager& constUIManager = uiManager;
+		std::function<void (NUIE::UIInputSlotConstPtr)> inputSlotProcessor = [&] (const NUIE::UIInputSlotConstPtr&) {
+			functionConnectionCount++;
+		};
+		std::function<bool (NUIE::UIOutputSlotConstPtr)> outputSlotProcessor = [&] (const NUIE::UIOutputSlotConstPtr& outputSlot) {
+			constUIManager.EnumerateConnectedUIInputSlots (outputSlot, inputSlotProcessor);
+			return true;
+		};
+		std::function<bool (NUIE::UINodeConstPtr)> nodeProcessor = [&] (const NUIE::UINodeConstPtr& uiNode) {
+			uiNode->EnumerateUIOutputSlots (outputSlotProcessor);
+			return true;
+		};
+		constUIManager.EnumerateNodes (nodeProcessor);
+	}));
+
+	size_t templateConnectionCount = 0;
+	result.measurements.push_back (Measure ("enumerateConnectionsTemplate", settings.repeatCount, [&] () {
+		templateConnectionCount = 0;
+		const NUIE::NodeUIManager& constUIManager = uiManager;
+		constUIManager.EnumerateNodes ([&] (const NUIE::UINodeConstPtr& uiNode) {
+			uiNode->EnumerateUIOutputSlots ([&] (const NUIE::UIOutputSlotConstPtr& outputSlot) {
+				constUIManager.EnumerateConnectedUIInputSlots (outputSlot, [&] (const NUIE::UIInputSlotConstPtr&) {
+					templateConnectionCount++;
+				});
+				return true;
+			});
+			return true;
+		});
+	}));
+	result.counters.push_back ({ "enumeratedConnectionsFunction", functionConnectionCount });
+	result.counters.push_back ({ "enumeratedConnectionsTemplate", templateConnectionCount });
+
+	result.measurements.push_back (Measure ("rebuildDrawingImages", settings.repeatCount, [&] () {
+		uiManager.InvalidateAllNodesDrawing ();
+		uiManager.EnumerateNodes ([&] (const NUIE::UINodeConstPtr& uiNode) {
+			uiNode->GetRect (env);
+			return true;
+		});
+	}));
+
+	result.measurements.push_back (Measure ("fitToWindow", settings.repeatCount, [&] () {
+		uiManager.FitToWindow (env);
+	}));
+
+	result.measurements.push_back (Measure ("drawFitToWindow", settings.repeatCount, [&] () {
+		context.ResetCounters ();
+		uiManager.Draw (env, &drawingModifier);
+	}));
+	AddDrawCounters ("drawFitToWindow", context.GetCounters (), result);
+
+	NUIE::Rect selectionViewRect (ViewWidth / 4.0, ViewHeight / 4.0, ViewWidth / 2.0, ViewHeight / 2.0);
+	size_t selectedNodeCount = 0;
+	result.measurements.push_back (Measure ("selectionRect", settings.repeatCount, [&] () {
+		NUIE::Rect modelSelectionRect = uiManager.GetViewBox ().ViewToModel (selectionViewRect);
+		NE::NodeCollection nodesInRect;
+		uiManager.EnumerateNodesInRect (env, modelSelectionRect, [&] (const NUIE::UINodeConstPtr& uiNode) {
+			if (modelSelectionRect.Contains (uiNode->GetRect (env))) {
+				nodesInRect.Insert (uiNode->GetId ());
+			}
+			return true;
+		});
+		NUIE::Selection selection;
+		selection.SetNodes (nodesInRect);
+		uiManager.SetSelection (selection, env);
+		uiManager.SetSelection (NUIE::Selection (), env);
+		selectedNodeCount = nodesInRect.Count ();
+	}));
+	result.counters.push_back ({ "selectionRectNodes", selectedNodeCount });
+
+	uiManager.SetViewBox (NUIE::ViewBox (NUIE::Point (0.0, 0.0), 1.0));
+	result.measurements.push_back (Measure ("drawActualSize", settings.repeatCount, [&] () {
+		context.ResetCounters ();
+		uiManager.Draw (env, &drawingModifier);
+	}));
+	AddDrawCounters ("drawActualSize", context.GetCounters (), result);
+
+	NUIE::Rect dirtyViewRect (ViewWidth / 2.0, ViewHeight / 2.0, 200.0, 200.0);
+	result.measurements.push_back (Measure ("drawDirtyRegion", settings.repeatCount, [&] () {
+		context.ResetCounters ();
+		uiManager.Draw (env, &drawingModifier, dirtyViewRect);
+	}));
+	AddDrawCounters ("drawDirtyRegion", context.GetCounters (), result);
+
+	std::mt19937 generator (settings.seed);
+	std::uniform_real_distribution<double> xDistribution (0.0, ViewWidth);
+	std::uniform_real_distribution<double> yDistribution (0.0, ViewHeight);
+	std::vector<NUIE::Point> hitTestPositions;
+	for (size_t i = 0; i < HitTestQueryCount; i++) {
+		hitTestPositions.push_back (NUIE::Point (xDistribution (generator), yDistribution (generator)));
+	}
+	size_t hitCount = 0;
+	result.measurements.push_back (Measure ("hitTest", settings.repeatCount, [&] () {
+		hitCount = 0;
+		for (const NUIE::Point& position : hitTestPositions) {
+			if (NUIE::FindNodeUnderPosition (uiManager, env, position) != nullptr) {
+				hitCount++;
+			}
+		}
+	}));
+	result.counters.push_back ({ "hitTestQueries", HitTestQueryCount });
+	result.counters.push_back ({ "hitTestHits", hitCount });
+
+	// a change of a single node should cost the same regardless of the size of the document
+	NE::NodeCollection movedNodes;
+	uiManager.EnumerateNodes ([&] (const NUIE::UINodeConstPtr& uiNode) {
+		movedNodes.Insert (uiNode->GetId ());
+		return false;
+	});
+	result.measurements.push_back (Measure ("singleNodeChange", settings.repeatCount, [&] () {
+		NUIE::MoveNodesCommand command (movedNodes, NUIE::Point (10.0, 0.0));
+		uiManager.ExecuteCommand (command, env);
+	}));
+	result.measurements.push_back (Measure ("singleNodeUndoRedo", settings.repeatCount, [&] () {
+		uiManager.Undo (env.GetEvaluationEnv (), env);
+		uiManager.Redo (env.GetEvaluationEnv (), env);
+	}));
+
+	return result;
+}
+
+static ContainerResult RunOrderedMapBenchmark (size_t elementCount, const Settings& settings)
+{
+	ContainerResult result;
+	result.name = "orderedMap";
+	result.elementCount = elementCount;
+
+	NE::OrderedMap<size_t, size_t> orderedMap;
+	result.measurements.push_back (Measure ("build", settings.repeatCount, [&] () {
+		orderedMap.Clear ();
+		for (size_t i = 0; i < elementCount; i++) {
+			orderedMap.Insert (i, i * 2);
+		}
+	}));
+	size_t enumeratedSum = 0;
+	result.measurements.push_back (Measure ("enumerate", settings.repeatCount, [&] () {
+		enumeratedSum = 0;
+		orderedMap.Enumerate ([&] (const size_t& value) {
+			enumeratedSum += value;
+			return true;
+		});
+	}));
+	result.counters.push_back ({ "enumeratedSum", enumeratedSum });
+
+	size_t foundCount = 0;
+	result.measurements.push_back (Measure ("lookup", settings.repeatCount, [&] () {
+		foundCount = 0;
+		for (size_t i = 0; i < elementCount; i++) {
+			if (orderedMap.Contains (i * 2)) {
+				foundCount++;
+			}
+		}
+	}));
+	result.counters.push_back ({ "foundCount", foundCount });
+
+	// erasing every second element leaves tombstones, the inserts after it trigger compaction
+	result.measurements.push_back (Measure ("eraseAndInsert", 1, [&] () {
+		for (size_t i = 0; i < elementCount; i += 2) {
+			orderedMap.Erase (i);
+		}
+		for (size_t i = 0; i < elementCount; i += 2) {
+			orderedMap.Insert (elementCount + i, i);
+		}
+	}));
+	result.counters.push_back ({ "count", orderedMap.Count () });
+
+	return result;
+}
+
+int main (int argc, char* argv[])
+{
+	Settings settings;
+	if (!ParseSettings (argc, argv, settings)) {
+		std::cerr << "usage: NodeEngineBenchmark [--sizes 1000,10000] [--container-sizes 1000,100000] [--repeat 5] [--seed 1] [--output result.json]" << std::endl;
+		return 1;
+	}
+
+	std::vector<GraphResult> results;
+	for (size_t nodeCount : settings.sizes) {
+		std::cerr << "running benchmark with " << nodeCount << " nodes" << std::endl;
+		results.push_back (RunGraphBenchmark (nodeCount, settings));
+	}
+
+	std::vector<ContainerResult> containerResults;
+	for (size_t elementCount : settings.containerSizes) {
+		std::cerr << "running container benchmark with " << elementCount << " elements" << std::endl;
+		containerResults.push_back (RunOrderedMapBenchmark (elementCount, settings));
+	}
+
+	if (settings.outputFile.empty ()) {
+		WriteReport (std::cout, settings.seed, results, containerResults);
+	} else {
+		std::ofstream file (settings.outputFile);
+		if (!file.is_open ()) {
+			std::cerr << "failed to open " << settings.outputFile << std::endl;
+			return 1;
+		}
+		WriteReport (file, settings.seed, results, containerResults);
+	}
+
+	return 0;
+}
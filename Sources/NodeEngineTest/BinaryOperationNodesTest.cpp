@@ -2,6 +2,7 @@
 #include "NUIE_NodeUIManager.hpp"
 #include "BI_BinaryOperationNodes.hpp"
 #include "BI_InputUINodes.hpp"
+#include "BI_BuiltInFeatures.hpp"
 #include "TestUtils.hpp"
 
 using namespace NE;
@@ -80,4 +81,30 @@ TEST (TestDivisionNode)
 	ASSERT (IsEqual (result, 2.0 / 3.0));
 }
 
+TEST (TestCloneAdditionNode)
+{
+	NodeManager source;
+	NodePtr val1 = source.AddNode (NodePtr (new DoubleUpDownNode (LocString (L"Value1"), Point (0, 0), 2.0, 1.0)));
+	NodePtr val2 = source.AddNode (NodePtr (new DoubleUpDownNode (LocString (L"Value2"), Point (0, 0), 3.0, 1.0)));
+	NodePtr op = source.AddNode (NodePtr (new AdditionNode (LocString (L"Addition"), Point (0, 0))));
+	source.ConnectOutputSlotToInputSlot (val1->GetOutputSlot (SlotId ("out")), op->GetInputSlot (SlotId ("a")));
+	source.ConnectOutputSlotToInputSlot (val2->GetOutputSlot (SlotId ("out")), op->GetInputSlot (SlotId ("b")));
+
+	NodeManager target;
+	ASSERT (NodeManager::Clone (source, target));
+	NodePtr targetVal1 = target.GetNode (val1->GetId ());
+	NodePtr targetOp = target.GetNode (op->GetId ());
+	ASSERT (Node::IsType<DoubleUpDownNode> (targetVal1));
+	ASSERT (Node::IsType<AdditionNode> (targetOp));
+	ASSERT (Node::IsEqual (op, targetOp));
+	ASSERT (IsEqual (DoubleValue::Get (targetOp->Evaluate (EmptyEvaluationEnv)), 5.0));
+
+	Node::Cast<DoubleUpDownNode> (targetVal1)->SetValue (10.0);
+	ASSERT (IsEqual (Node::Cast<DoubleUpDownNode> (val1)->GetValue (), 2.0));
+
+	GetValueCombinationFeature (Node::Cast<BasicUINode> (targetOp))->SetValueCombinationMode (ValueCombinationMode::Shortest);
+	ASSERT (GetValueCombinationFeature (Node::Cast<BasicUINode> (op))->GetValueCombinationMode () == ValueCombinationMode::Longest);
+	ASSERT (!Node::IsEqual (op, targetOp));
+}
+
 }
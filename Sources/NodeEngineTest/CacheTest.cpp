@@ -1,9 +1,11 @@
 #include "SimpleTest.hpp"
 #include "NE_Cache.hpp"
+#include "NUIE_TextMeasureCache.hpp"
 
 #include <string>
 
 using namespace NE;
+using namespace NUIE;
 
 namespace CacheTest
 {
@@ -108,4 +110,47 @@ TEST (CacheWithControllerLarge)
 	ASSERT (controller.disposeCount == 100);
 }
 
+TEST (CacheLeastRecentlyUsedTest)
+{
+	Cache<int, std::string> cache (3);
+	ASSERT (cache.Add (1, "1"));
+	ASSERT (cache.Add (2, "2"));
+	ASSERT (cache.Add (3, "3"));
+	ASSERT (cache.Get (1) == "1");
+	ASSERT (cache.Add (4, "4"));
+	ASSERT (cache.Contains (1));
+	ASSERT (!cache.Contains (2));
+	ASSERT (cache.Contains (3));
+	ASSERT (cache.Contains (4));
+}
+
+TEST (TextMeasureCacheTest)
+{
+	size_t measureCount = 0;
+	auto measurer = [&] (const Font& font, const std::wstring& text) {
+		measureCount++;
+		return Size (text.length () * font.GetSize (), font.GetSize ());
+	};
+
+	TextMeasureCache cache (2);
+	Font font (L"Arial", 10.0);
+	ASSERT (cache.Measure (font, L"a", measurer) == Size (10.0, 10.0));
+	ASSERT (cache.Measure (font, L"a", measurer) == Size (10.0, 10.0));
+	ASSERT (cache.Measure (Font (L"Arial", 12.0), L"a", measurer) == Size (12.0, 12.0));
+	ASSERT (cache.Measure (Font (L"Arial", 10.5), L"a", measurer) == Size (10.5, 10.5));
+	ASSERT (measureCount == 3);
+	ASSERT (cache.GetHitCount () == 1);
+	ASSERT (cache.GetMissCount () == 3);
+	ASSERT (IsEqual (cache.GetHitRate (), 0.25));
+
+	ASSERT (cache.Measure (font, L"a", measurer) == Size (10.0, 10.0));
+	ASSERT (measureCount == 4);
+
+	cache.Clear ();
+	ASSERT (cache.GetHitCount () == 0);
+	ASSERT (cache.GetMissCount () == 0);
+	ASSERT (cache.Measure (font, L"ab", measurer) == Size (20.0, 10.0));
+	ASSERT (measureCount == 5);
+}
+
 }
@@ -0,0 +1,169 @@
+#include "SimpleTest.hpp"
+#include "NUIE_DrawingImage.hpp"
+#include "NUIE_ContextDecorators.hpp"
+#include "NUIE_ViewBox.hpp"
+#include "SvgDrawingContext.hpp"
+
+using namespace NUIE;
+
+namespace DisplayListTest
+{
+
+class BatchCounterContext : public NullDrawingContext
+{
+public:
+	BatchCounterContext () :
+		NullDrawingContext (),
+		batchCount (0),
+		itemCount (0)
+	{
+
+	}
+
+	virtual bool NeedToDraw (ItemPreviewMode) override
+	{
+		return true;
+	}
+
+	virtual void DrawLines (const std::vector<Point>&, const Pen&) override
+	{
+		batchCount++;
+	}
+
+	virtual void DrawRects (const std::vector<Rect>&, const Pen&) override
+	{
+		batchCount++;
+	}
+
+	virtual void FillRects (const std::vector<Rect>&, const Color&) override
+	{
+		batchCount++;
+	}
+
+	virtual void DrawFormattedText (const Rect&, const Font&, const std::wstring&, HorizontalAnchor, VerticalAnchor, const Color&) override
+	{
+		itemCount++;
+	}
+
+	size_t	batchCount;
+	size_t	itemCount;
+};
+
+static void AddGridItems (DrawingImage& image, size_t count)
+{
+	Color fillColor (200, 200, 200);
+	Pen linePen (Color (0, 0, 0), 1.0);
+	for (size_t i = 0; i < count; i++) {
+		image.AddItem (DrawingItemConstPtr (new DrawingFillRect (Rect::FromPositionAndSize (Point (i * 10.0, 0.0), Size (8.0, 8.0)), fillColor)));
+	}
+	for (size_t i = 0; i < count; i++) {
+		image.AddItem (DrawingItemConstPtr (new DrawingLine (Point (i * 10.0, 0.0), Point (i * 10.0, 8.0), linePen)));
+	}
+	image.AddItem (DrawingItemConstPtr (new DrawingText (Rect::FromPositionAndSize (Point (0.0, 10.0), Size (50.0, 10.0)), Font (L"Arial", 10.0), L"Text", HorizontalAnchor::Center, VerticalAnchor::Center, Color (0, 0, 0))), DrawingContext::ItemPreviewMode::HideInPreview);
+	image.AddItem (DrawingItemConstPtr (new DrawingFillRect (Rect::FromPositionAndSize (Point (0.0, 20.0), Size (8.0, 8.0)), fillColor)));
+}
+
+TEST (DisplayListBatchingTest)
+{
+	DrawingImage image;
+	AddGridItems (image, 100);
+	ASSERT (image.GetDisplayList ().GetBatchCount () == 4);
+
+	BatchCounterContext context;
+	image.Draw (context);
+	ASSERT (context.batchCount == 3);
+	ASSERT (context.itemCount == 1);
+
+	BatchCounterContext previewContext;
+	PreviewContextDecorator previewDecorator (previewContext, true);
+	image.Draw (previewDecorator);
+	ASSERT (previewContext.batchCount == 3);
+	ASSERT (previewContext.itemCount == 0);
+}
+
+TEST (DisplayListSameOutputTest)
+{
+	DrawingImage image;
+	MultiDrawingItem* multiItem = new MultiDrawingItem ();
+	multiItem->AddItem (DrawingItemConstPtr (new DrawingRect (Rect::FromPositionAndSize (Point (5.0, 5.0), Size (20.0, 20.0)), Pen (Color (0, 0, 0), 2.0))));
+	multiItem->AddItem (DrawingItemConstPtr (new DrawingEllipse (Rect::FromPositionAndSize (Point (5.0, 5.0), Size (20.0, 20.0)), Pen (Color (0, 0, 0), 2.0))));
+	DrawingItemConstPtr multiItemPtr (multiItem);
+	image.AddItem (multiItemPtr);
+	AddGridItems (image, 10);
+	image.AddItem (DrawingItemConstPtr (new DrawingBezier (Point (0.0, 0.0), Point (10.0, 0.0), Point (10.0, 10.0), Point (20.0, 10.0), Pen (Color (0, 0, 0), 1.0))));
+
+	ViewBox viewBox (Point (10.0, 20.0), 1.5);
+	SvgDrawingContext batchedContext (200, 100);
+	ViewBoxContextDecorator batchedDecorator (batchedContext, viewBox);
+	image.Draw (batchedDecorator);
+
+	SvgDrawingContext itemContext (200, 100);
+	ViewBoxContextDecorator itemDecorator (itemContext, viewBox);
+	multiItemPtr->Draw (itemDecorator);
+	for (size_t i = 0; i < 10; i++) {
+		itemDecorator.FillRect (Rect::FromPositionAndSize (Point (i * 10.0, 0.0), Size (8.0, 8.0)), Color (200, 200, 200));
+	}
+	for (size_t i = 0; i < 10; i++) {
+		itemDecorator.DrawLine (Point (i * 10.0, 0.0), Point (i * 10.0, 8.0), Pen (Color (0, 0, 0), 1.0));
+	}
+	itemDecorator.DrawFormattedText (Rect::FromPositionAndSize (Point (0.0, 10.0), Size (50.0, 10.0)), Font (L"Arial", 10.0), L"Text", HorizontalAnchor::Center, VerticalAnchor::Center, Color (0, 0, 0));
+	itemDecorator.FillRect (Rect::FromPositionAndSize (Point (0.0, 20.0), Size (8.0, 8.0)), Color (200, 200, 200));
+	itemDecorator.DrawBezier (Point (0.0, 0.0), Point (10.0, 0.0), Point (10.0, 10.0), Point (20.0, 10.0), Pen (Color (0, 0, 0), 1.0));
+
+	ASSERT (batchedContext.GetAsString () == itemContext.GetAsString ());
+
+	image.RemoveItem (multiItemPtr);
+	ASSERT (image.GetDisplayList ().GetBatchCount () == 4 + 1);
+	image.Clear ();
+	ASSERT (image.GetDisplayList ().IsEmpty ());
+}
+
+TEST (DisplayListRemoveMergedItemTest)
+{
+	Color fillColor (200, 200, 200);
+	Pen linePen (Color (0, 0, 0), 1.0);
+	std::vector<DrawingItemConstPtr> items = {
+		DrawingItemConstPtr (new DrawingFillRect (Rect::FromPositionAndSize (Point (0.0, 0.0), Size (8.0, 8.0)), fillColor)),
+		DrawingItemConstPtr (new DrawingFillRect (Rect::FromPositionAndSize (Point (10.0, 0.0), Size (8.0, 8.0)), fillColor)),
+		DrawingItemConstPtr (new DrawingFillRect (Rect::FromPositionAndSize (Point (20.0, 0.0), Size (8.0, 8.0)), fillColor)),
+		DrawingItemConstPtr (new DrawingText (Rect::FromPositionAndSize (Point (0.0, 10.0), Size (50.0, 10.0)), Font (L"Arial", 10.0), L"Text", HorizontalAnchor::Center, VerticalAnchor::Center, Color (0, 0, 0))),
+		DrawingItemConstPtr (new DrawingLine (Point (0.0, 0.0), Point (0.0, 8.0), linePen)),
+		DrawingItemConstPtr (new DrawingLine (Point (10.0, 0.0), Point (10.0, 8.0), linePen)),
+		DrawingItemConstPtr (new DrawingFillRect (Rect::FromPositionAndSize (Point (0.0, 20.0), Size (8.0, 8.0)), fillColor))
+	};
+
+	DrawingImage image;
+	for (const DrawingItemConstPtr& item : items) {
+		image.AddItem (item);
+	}
+	ASSERT (image.GetDisplayList ().GetBatchCount () == 4);
+
+	// the middle of a merged batch, a whole batch, and the end of a merged batch
+	image.RemoveItem (items[1]);
+	image.RemoveItem (items[3]);
+	image.RemoveItem (items[5]);
+	ASSERT (image.GetDisplayList ().GetItemCount () == 4);
+	ASSERT (image.GetDisplayList ().GetBatchCount () == 3);
+
+	DrawingImage expectedImage;
+	expectedImage.AddItem (items[0]);
+	expectedImage.AddItem (items[2]);
+	expectedImage.AddItem (items[4]);
+	expectedImage.AddItem (items[6]);
+
+	SvgDrawingContext context (100, 100);
+	image.Draw (context);
+	SvgDrawingContext expectedContext (100, 100);
+	expectedImage.Draw (expectedContext);
+	ASSERT (context.GetAsString () == expectedContext.GetAsString ());
+
+	image.RemoveItem (items[0]);
+	image.RemoveItem (items[2]);
+	image.RemoveItem (items[4]);
+	ASSERT (image.GetDisplayList ().GetBatchCount () == 1);
+	image.RemoveItem (items[6]);
+	ASSERT (image.IsEmpty ());
+	ASSERT (image.GetDisplayList ().IsEmpty ());
+}
+
+}
@@ -196,4 +196,38 @@ TEST (BoundingRectTest_FromRectAndPoint)
 	}
 }
 
+
+TEST (IncrementalBoundingRectTest)
+{
+	Rect rect1 = Rect::FromPositionAndSize (Point (0, 0), Size (100, 100));
+	Rect rect2 = Rect::FromPositionAndSize (Point (10, 10), Size (50, 50));
+	Rect rect3 = Rect::FromPositionAndSize (Point (-10, -10), Size (20, 20));
+
+	IncrementalBoundingRect boundingRect;
+	ASSERT (boundingRect.NeedToRecalculate ());
+	boundingRect.AddRect (rect1);
+	ASSERT (boundingRect.NeedToRecalculate ());
+
+	boundingRect.Reset ();
+	ASSERT (!boundingRect.NeedToRecalculate ());
+	ASSERT (!boundingRect.GetBoundingRect ().IsValid ());
+	boundingRect.AddRect (rect1);
+	boundingRect.AddRect (rect2);
+	boundingRect.AddRect (rect3);
+	ASSERT (IsEqual (boundingRect.GetBoundingRect ().GetRect (), Rect::FromPositionAndSize (Point (-10, -10), Size (110, 110))));
+
+	boundingRect.RemoveRect (rect2);
+	ASSERT (!boundingRect.NeedToRecalculate ());
+	ASSERT (IsEqual (boundingRect.GetBoundingRect ().GetRect (), Rect::FromPositionAndSize (Point (-10, -10), Size (110, 110))));
+
+	boundingRect.RemoveRect (rect3);
+	ASSERT (boundingRect.NeedToRecalculate ());
+
+	boundingRect.Reset ();
+	boundingRect.AddRect (rect1);
+	ASSERT (IsEqual (boundingRect.GetBoundingRect ().GetRect (), rect1));
+	boundingRect.Invalidate ();
+	ASSERT (boundingRect.NeedToRecalculate ());
+}
+
 }
@@ -0,0 +1,162 @@
+#include "SimpleTest.hpp"
+#include "NUIE_NodeUIManager.hpp"
+#include "BI_InputUINodes.hpp"
+#include "BI_ViewerUINodes.hpp"
+#include "TestUtils.hpp"
+
+#include <vector>
+
+using namespace NE;
+using namespace NUIE;
+using namespace BI;
+
+namespace GroupBoundingRectTest
+{
+
+class RectGetter : public NodeRectGetter
+{
+public:
+	RectGetter (const NodeUIManager& uiManager, NodeUIDrawingEnvironment& env) :
+		uiManager (uiManager),
+		env (env)
+	{
+
+	}
+
+	virtual Rect GetNodeRect (const NE::NodeId& nodeId) const override
+	{
+		return uiManager.GetNode (nodeId)->GetEstimatedRect (env);
+	}
+
+private:
+	const NodeUIManager&		uiManager;
+	NodeUIDrawingEnvironment&	env;
+};
+
+static Rect GetReferenceBoundingRect (const NodeUIManager& uiManager, NodeUIDrawingEnvironment& env)
+{
+	BoundingRect boundingRect;
+	uiManager.EnumerateNodes ([&] (UINodeConstPtr uiNode) {
+		boundingRect.AddRect (uiNode->GetEstimatedExtendedRect (env));
+		return true;
+	});
+	RectGetter rectGetter (uiManager, env);
+	uiManager.EnumerateNodeGroups ([&] (UINodeGroupConstPtr uiGroup) {
+		boundingRect.AddRect (uiGroup->GetRect (env, rectGetter, uiManager.GetGroupNodes (uiGroup)));
+		return true;
+	});
+	return boundingRect.GetRect ();
+}
+
+static bool IsBoundingRectValid (const NodeUIManager& uiManager, NodeUIDrawingEnvironment& env)
+{
+	Rect boundingRect;
+	if (!uiManager.GetBoundingRect (env, boundingRect)) {
+		return false;
+	}
+	return IsEqual (boundingRect, GetReferenceBoundingRect (uiManager, env));
+}
+
+TEST (GroupBoundingRectTest)
+{
+	TestUIEnvironment env;
+	NodeUIManager uiManager (env);
+
+	std::vector<UINodePtr> uiNodes;
+	for (size_t i = 0; i < 6; i++) {
+		uiNodes.push_back (uiManager.AddNode (UINodePtr (new IntegerUpDownNode (LocString (L"Integer"), Point (i * 200.0, 0.0), 0, 1))));
+	}
+	UINodePtr viewerNode = uiManager.AddNode (UINodePtr (new ViewerNode (LocString (L"Viewer"), Point (0.0, 300.0))));
+	uiManager.Update (env);
+
+	Rect boundingRect;
+	ASSERT (uiManager.GetBoundingRect (env, boundingRect));
+	ASSERT (IsBoundingRectValid (uiManager, env));
+
+	UINodeGroupPtr group1 (new UINodeGroup (LocString (L"Group 1")));
+	UINodeGroupPtr group2 (new UINodeGroup (LocString (L"Group 2")));
+	uiManager.AddNodeGroup (group1);
+	uiManager.AddNodeGroup (group2);
+	uiManager.AddNodesToGroup (group1, NodeCollection ({ uiNodes[0]->GetId (), uiNodes[1]->GetId () }));
+	uiManager.AddNodesToGroup (group2, NodeCollection ({ uiNodes[4]->GetId (), uiNodes[5]->GetId () }));
+	ASSERT (IsBoundingRectValid (uiManager, env));
+
+	uiNodes[0]->SetPosition (Point (-500.0, -200.0));
+	uiManager.InvalidateNodePosition (uiNodes[0]);
+	ASSERT (IsBoundingRectValid (uiManager, env));
+
+	uiNodes[0]->SetPosition (Point (0.0, 0.0));
+	uiManager.InvalidateNodePosition (uiNodes[0]);
+	ASSERT (IsBoundingRectValid (uiManager, env));
+
+	uiManager.AddNodesToGroup (group1, NodeCollection ({ viewerNode->GetId () }));
+	ASSERT (IsBoundingRectValid (uiManager, env));
+
+	uiManager.AddNodesToGroup (group2, NodeCollection ({ viewerNode->GetId () }));
+	ASSERT (IsBoundingRectValid (uiManager, env));
+
+	uiManager.RemoveNodesFromGroup (NodeCollection ({ viewerNode->GetId () }));
+	ASSERT (IsBoundingRectValid (uiManager, env));
+
+	ASSERT (uiManager.DeleteNode (uiNodes[5], env.GetEvaluationEnv (), env));
+	ASSERT (IsBoundingRectValid (uiManager, env));
+
+	uiManager.DeleteNode (viewerNode, env.GetEvaluationEnv (), env);
+	ASSERT (IsBoundingRectValid (uiManager, env));
+
+	uiManager.DeleteNodeGroup (group1);
+	ASSERT (IsBoundingRectValid (uiManager, env));
+
+	uiManager.InvalidateAllDrawings ();
+	ASSERT (IsBoundingRectValid (uiManager, env));
+}
+
+TEST (GroupBoundingRectIsolationTest)
+{
+	TestUIEnvironment env;
+	NodeUIManager uiManager (env);
+
+	std::vector<UINodePtr> uiNodes;
+	for (size_t i = 0; i < 6; i++) {
+		uiNodes.push_back (uiManager.AddNode (UINodePtr (new IntegerUpDownNode (LocString (L"Integer"), Point (i * 200.0, 0.0), 0, 1))));
+	}
+	UINodeGroupPtr group1 (new UINodeGroup (LocString (L"Group 1")));
+	UINodeGroupPtr group2 (new UINodeGroup (LocString (L"Group 2")));
+	uiManager.AddNodeGroup (group1);
+	uiManager.AddNodeGroup (group2);
+	uiManager.AddNodesToGroup (group1, NodeCollection ({ uiNodes[0]->GetId (), uiNodes[1]->GetId () }));
+	uiManager.AddNodesToGroup (group2, NodeCollection ({ uiNodes[3]->GetId (), uiNodes[4]->GetId () }));
+	uiManager.Update (env);
+
+	Rect boundingRect;
+	Rect groupRect;
+	ASSERT (uiManager.GetBoundingRect (env, boundingRect));
+	ASSERT (group1->GetCachedRect (groupRect));
+	ASSERT (group2->GetCachedRect (groupRect));
+
+	uiManager.AddNodesToGroup (group1, NodeCollection ({ uiNodes[2]->GetId () }));
+	ASSERT (!group1->GetCachedRect (groupRect));
+	ASSERT (group2->GetCachedRect (groupRect));
+	ASSERT (IsBoundingRectValid (uiManager, env));
+
+	uiNodes[5]->SetPosition (Point (1000.0, 500.0));
+	uiManager.InvalidateNodePosition (uiNodes[5]);
+	ASSERT (group1->GetCachedRect (groupRect));
+	ASSERT (group2->GetCachedRect (groupRect));
+	ASSERT (IsBoundingRectValid (uiManager, env));
+
+	uiNodes[4]->SetPosition (Point (800.0, 200.0));
+	uiManager.InvalidateNodePosition (uiNodes[4]);
+	ASSERT (group1->GetCachedRect (groupRect));
+	ASSERT (!group2->GetCachedRect (groupRect));
+	ASSERT (IsBoundingRectValid (uiManager, env));
+
+	UINodeGroupPtr group3 (new UINodeGroup (LocString (L"Group 3")));
+	uiManager.AddNodeGroup (group3);
+	uiManager.AddNodesToGroup (group3, NodeCollection ({ uiNodes[5]->GetId () }));
+	ASSERT (group1->GetCachedRect (groupRect));
+	ASSERT (!group3->GetCachedRect (groupRect));
+	ASSERT (IsBoundingRectValid (uiManager, env));
+}
+
+}
@@ -67,4 +67,17 @@ TEST (TypeTest)
 	ASSERT (enumVal == TestEnum::A);
 }
 
+TEST (BinaryStringTest)
+{
+	std::string binaryString ("a\0b\0", 4);
+	MemoryOutputStream outputStream;
+	ASSERT (outputStream.Write (binaryString) == Stream::Status::NoError);
+
+	std::string stringVal;
+	MemoryInputStream inputStream (outputStream.GetBuffer ());
+	ASSERT (inputStream.Read (stringVal) == Stream::Status::NoError);
+	ASSERT (stringVal.length () == 4);
+	ASSERT (stringVal == binaryString);
+}
+
 }
@@ -2,6 +2,7 @@
 #include "NE_MemoryXmlStream.hpp"
 
 #include <memory>
+#include <limits>
 
 using namespace NE;
 
@@ -70,4 +71,54 @@ TEST (TypeTest)
 	ASSERT (wStringValUnicode == L"unicode \u03c0");
 }
 
+TEST (IndentedTextTest)
+{
+	std::wstring xmlText;
+	xmlText += L"  <Int>42</Int>\n";
+	xmlText += L"\t<WString>a < b</WString>\n";
+	xmlText += L"\t<Double>-1.5</Double>";
+
+	int intVal = 0;
+	std::wstring wStringVal;
+	double doubleVal = 0.0;
+
+	MemoryXmlInputStream inputStream (std::move (xmlText));
+	ASSERT (inputStream.Read (intVal) == Stream::Status::NoError);
+	ASSERT (inputStream.Read (wStringVal) == Stream::Status::NoError);
+	ASSERT (inputStream.Read (doubleVal) == Stream::Status::NoError);
+	ASSERT (intVal == 42);
+	ASSERT (wStringVal == L"a < b");
+	ASSERT (doubleVal == -1.5);
+}
+
+TEST (InvalidTextTest)
+{
+	{
+		int intVal = 0;
+		MemoryXmlInputStream inputStream (L"<Size>1</Size>\n<Int>2</Int>\n");
+		ASSERT (inputStream.Read (intVal) == Stream::Status::Error);
+	}
+	{
+		int intVal = 0;
+		MemoryXmlInputStream inputStream (L"<Int>2a</Int>\n");
+		ASSERT (inputStream.Read (intVal) == Stream::Status::Error);
+	}
+	{
+		int intVal = 0;
+		MemoryXmlInputStream inputStream (L"<Int>2</Size>\n");
+		ASSERT (inputStream.Read (intVal) == Stream::Status::Error);
+	}
+}
+
+TEST (ReservedSizeTest)
+{
+	MemoryXmlOutputStream outputStream (1024);
+	ASSERT (outputStream.Write (std::numeric_limits<size_t>::max ()) == Stream::Status::NoError);
+
+	size_t sizeVal = 0;
+	MemoryXmlInputStream inputStream (outputStream.GetXmlText ());
+	ASSERT (inputStream.Read (sizeVal) == Stream::Status::NoError);
+	ASSERT (sizeVal == std::numeric_limits<size_t>::max ());
+}
+
 }
@@ -0,0 +1,144 @@
+#include "SimpleTest.hpp"
+#include "NE_NodeCollection.hpp"
+#include "NUIE_Selection.hpp"
+
+using namespace NE;
+using namespace NUIE;
+
+namespace NodeCollectionTest
+{
+
+static std::vector<NodeId> GetEnumeratedNodes (const NodeCollection& nodes)
+{
+	std::vector<NodeId> enumeratedNodes;
+	nodes.Enumerate ([&] (const NodeId& nodeId) {
+		enumeratedNodes.push_back (nodeId);
+		return true;
+	});
+	return enumeratedNodes;
+}
+
+static bool SelectAndDeselectLargeCollection (size_t count)
+{
+	NodeCollection rectNodes;
+	for (size_t i = 1; i <= count; i++) {
+		rectNodes.Insert (NodeId (i));
+	}
+
+	NodeCollection oddNodes;
+	for (size_t i = 1; i <= count; i += 2) {
+		oddNodes.Insert (NodeId (i));
+	}
+
+	Selection selection;
+	if (selection.AddNodes (rectNodes) != Selection::ChangeResult::Changed) {
+		return false;
+	}
+	if (selection.DeleteNodes (oddNodes) != Selection::ChangeResult::Changed) {
+		return false;
+	}
+	if (selection.GetNodes ().Count () != count / 2) {
+		return false;
+	}
+
+	selection.ToggleNodes (rectNodes);
+	if (selection.GetNodes () != oddNodes) {
+		return false;
+	}
+
+	selection.ToggleNodes (oddNodes);
+	return selection.IsEmpty ();
+}
+
+TEST (NodeCollectionEraseOrderTest)
+{
+	NodeCollection nodes ({ NodeId (1), NodeId (2), NodeId (3), NodeId (4) });
+	ASSERT (nodes.Count () == 4);
+	nodes.Insert (NodeId (2));
+	ASSERT (nodes.Count () == 4);
+
+	nodes.Erase (NodeId (2));
+	ASSERT (nodes.Count () == 3);
+	ASSERT (!nodes.Contains (NodeId (2)));
+	ASSERT (GetEnumeratedNodes (nodes) == std::vector<NodeId> ({ NodeId (1), NodeId (3), NodeId (4) }));
+
+	nodes.Erase (NodeId (4));
+	nodes.Erase (NodeId (1));
+	nodes.Insert (NodeId (2));
+	ASSERT (GetEnumeratedNodes (nodes) == std::vector<NodeId> ({ NodeId (3), NodeId (2) }));
+	ASSERT (nodes == NodeCollection ({ NodeId (3), NodeId (2) }));
+	ASSERT (nodes != NodeCollection ({ NodeId (2), NodeId (3) }));
+
+	nodes.Clear ();
+	ASSERT (nodes.IsEmpty ());
+	ASSERT (nodes.Count () == 0);
+}
+
+TEST (NodeCollectionSetOperationsTest)
+{
+	NodeCollection aNodes ({ NodeId (1), NodeId (2), NodeId (3) });
+	NodeCollection bNodes ({ NodeId (3), NodeId (4) });
+
+	NodeCollection unionNodes = aNodes;
+	unionNodes.Union (bNodes);
+	ASSERT (GetEnumeratedNodes (unionNodes) == std::vector<NodeId> ({ NodeId (1), NodeId (2), NodeId (3), NodeId (4) }));
+
+	NodeCollection differenceNodes = aNodes;
+	differenceNodes.Difference (bNodes);
+	ASSERT (GetEnumeratedNodes (differenceNodes) == std::vector<NodeId> ({ NodeId (1), NodeId (2) }));
+
+	NodeCollection symmetricDifferenceNodes = aNodes;
+	symmetricDifferenceNodes.SymmetricDifference (bNodes);
+	ASSERT (GetEnumeratedNodes (symmetricDifferenceNodes) == std::vector<NodeId> ({ NodeId (1), NodeId (2), NodeId (4) }));
+}
+
+TEST (NodeCollectionSelfUnionTest)
+{
+	NodeCollection nodes ({ NodeId (1), NodeId (2), NodeId (3) });
+	nodes.Union (nodes);
+	ASSERT (GetEnumeratedNodes (nodes) == std::vector<NodeId> ({ NodeId (1), NodeId (2), NodeId (3) }));
+}
+
+TEST (NodeCollectionSelfDifferenceTest)
+{
+	NodeCollection nodes;
+	for (size_t i = 1; i <= 1000; i++) {
+		nodes.Insert (NodeId (i));
+	}
+	nodes.Difference (nodes);
+	ASSERT (nodes.IsEmpty ());
+	nodes.Insert (NodeId (1));
+	ASSERT (GetEnumeratedNodes (nodes) == std::vector<NodeId> ({ NodeId (1) }));
+}
+
+TEST (NodeCollectionSelfSymmetricDifferenceTest)
+{
+	NodeCollection nodes;
+	for (size_t i = 1; i <= 1000; i++) {
+		nodes.Insert (NodeId (i));
+	}
+	nodes.SymmetricDifference (nodes);
+	ASSERT (nodes.IsEmpty ());
+	nodes.Insert (NodeId (1));
+	ASSERT (GetEnumeratedNodes (nodes) == std::vector<NodeId> ({ NodeId (1) }));
+}
+
+TEST (SelectionBulkOperationsTest)
+{
+	Selection selection;
+	ASSERT (selection.AddNodes (NodeCollection ({ NodeId (1), NodeId (2) })) == Selection::ChangeResult::Changed);
+	ASSERT (selection.AddNodes (NodeCollection ({ NodeId (2) })) == Selection::ChangeResult::NotChanged);
+	ASSERT (selection.DeleteNodes (NodeCollection ({ NodeId (3) })) == Selection::ChangeResult::NotChanged);
+	ASSERT (selection.ToggleNodes (NodeCollection ({ NodeId (1), NodeId (3) })) == Selection::ChangeResult::Changed);
+	ASSERT (selection.GetNodes () == NodeCollection ({ NodeId (2), NodeId (3) }));
+	ASSERT (selection.DeleteNodes (NodeCollection ({ NodeId (2), NodeId (3) })) == Selection::ChangeResult::Changed);
+	ASSERT (selection.IsEmpty ());
+}
+
+TEST (SelectionLargeCollectionTest)
+{
+	ASSERT (SelectAndDeselectLargeCollection (1000));
+	ASSERT (SelectAndDeselectLargeCollection (100000));
+}
+
+}
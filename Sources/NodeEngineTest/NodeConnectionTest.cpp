@@ -244,6 +244,11 @@ public:
 		InvalidateValue ();
 	}
 
+	virtual NodePtr CloneNode () const override
+	{
+		return NodePtr (new AdderInputOutputNode (*this));
+	}
+
 private:
 	int toAdd;
 };
@@ -690,4 +695,250 @@ TEST (HasConnectionTest)
 	ASSERT (!manager.IsOutputSlotConnectedToInputSlot (node1->GetOutputSlot (SlotId ("out")), node3->GetInputSlot (SlotId ("in"))));
 }
 
+TEST (BulkConnectionTest)
+{
+	NodeManager manager;
+
+	NodePtr node1 = manager.AddNode (NodePtr (new AdderInputOutputNode (1)));
+	NodePtr node2 = manager.AddNode (NodePtr (new AdderInputOutputNode (1)));
+	NodePtr node3 = manager.AddNode (NodePtr (new AdderInputOutputNode (1)));
+
+	ASSERT (IntValue::Get (node3->Evaluate (NE::EmptyEvaluationEnv)) == 1);
+
+	std::vector<SlotConnection> connections = {
+		SlotConnection (node2->GetOutputSlot (SlotId ("out")), node3->GetInputSlot (SlotId ("in"))),
+		SlotConnection (node1->GetOutputSlot (SlotId ("out")), node2->GetInputSlot (SlotId ("in")))
+	};
+	ASSERT (manager.CanConnectOutputSlotsToInputSlots (connections));
+	ASSERT (manager.ConnectOutputSlotsToInputSlots (connections));
+	ASSERT (manager.GetConnectionCount () == 2);
+	ASSERT (manager.IsOutputSlotConnectedToInputSlot (node1->GetOutputSlot (SlotId ("out")), node2->GetInputSlot (SlotId ("in"))));
+	ASSERT (manager.IsOutputSlotConnectedToInputSlot (node2->GetOutputSlot (SlotId ("out")), node3->GetInputSlot (SlotId ("in"))));
+	ASSERT (IntValue::Get (node3->Evaluate (NE::EmptyEvaluationEnv)) == 3);
+}
+
+TEST (BulkConnectionCycleDetectionTest)
+{
+	NodeManager manager;
+
+	NodePtr node1 = manager.AddNode (NodePtr (new AdderInputOutputNode (1)));
+	NodePtr node2 = manager.AddNode (NodePtr (new AdderInputOutputNode (1)));
+	NodePtr node3 = manager.AddNode (NodePtr (new AdderInputOutputNode (1)));
+
+	ASSERT (manager.ConnectOutputSlotToInputSlot (node1->GetOutputSlot (SlotId ("out")), node2->GetInputSlot (SlotId ("in"))));
+
+	std::vector<SlotConnection> connections = {
+		SlotConnection (node2->GetOutputSlot (SlotId ("out")), node3->GetInputSlot (SlotId ("in"))),
+		SlotConnection (node3->GetOutputSlot (SlotId ("out")), node1->GetInputSlot (SlotId ("in")))
+	};
+	ASSERT (!manager.CanConnectOutputSlotsToInputSlots (connections));
+	ASSERT (manager.GetConnectionCount () == 1);
+
+	std::vector<SlotConnection> selfConnection = {
+		SlotConnection (node3->GetOutputSlot (SlotId ("out")), node3->GetInputSlot (SlotId ("in")))
+	};
+	ASSERT (!manager.CanConnectOutputSlotsToInputSlots (selfConnection));
+}
+
+TEST (BulkConnectionReplaceSingleInputTest)
+{
+	NodeManager manager;
+
+	NodePtr node1 = manager.AddNode (NodePtr (new AdderInputOutputNode (1)));
+	NodePtr node2 = manager.AddNode (NodePtr (new AdderInputOutputNode (1)));
+	NodePtr node3 = manager.AddNode (NodePtr (new InputNode (5)));
+
+	ASSERT (manager.ConnectOutputSlotToInputSlot (node2->GetOutputSlot (SlotId ("out")), node1->GetInputSlot (SlotId ("in"))));
+
+	std::vector<SlotConnection> replaceConnections = {
+		SlotConnection (node1->GetOutputSlot (SlotId ("out")), node2->GetInputSlot (SlotId ("in"))),
+		SlotConnection (node3->GetOutputSlot (SlotId ("out")), node1->GetInputSlot (SlotId ("in")))
+	};
+	ASSERT (manager.ConnectOutputSlotsToInputSlots (replaceConnections));
+	ASSERT (manager.GetConnectionCount () == 2);
+	ASSERT (!manager.IsOutputSlotConnectedToInputSlot (node2->GetOutputSlot (SlotId ("out")), node1->GetInputSlot (SlotId ("in"))));
+
+	ASSERT (IntValue::Get (node2->Evaluate (NE::EmptyEvaluationEnv)) == 7);
+
+	std::vector<SlotConnection> duplicatedInputConnections = {
+		SlotConnection (node3->GetOutputSlot (SlotId ("out")), node2->GetInputSlot (SlotId ("in"))),
+		SlotConnection (node1->GetOutputSlot (SlotId ("out")), node2->GetInputSlot (SlotId ("in")))
+	};
+	ASSERT (!manager.CanConnectOutputSlotsToInputSlots (duplicatedInputConnections));
+}
+
+TEST (NodeAdjacencyTest)
+{
+	NodeManager manager;
+
+	NodePtr node1 = manager.AddNode (NodePtr (new InputNode2 ()));
+	NodePtr node2 = manager.AddNode (NodePtr (new AdderInputOutputNode ()));
+	NodePtr node3 = manager.AddNode (NodePtr (new AdderInputOutputNode ()));
+	NodePtr node4 = manager.AddNode (NodePtr (new MultiAdditionNode ()));
+
+	manager.ConnectOutputSlotToInputSlot (node1->GetOutputSlot (SlotId ("out1")), node2->GetInputSlot (SlotId ("in")));
+	manager.ConnectOutputSlotToInputSlot (node1->GetOutputSlot (SlotId ("out2")), node3->GetInputSlot (SlotId ("in")));
+	manager.ConnectOutputSlotToInputSlot (node2->GetOutputSlot (SlotId ("out")), node4->GetInputSlot (SlotId ("in")));
+
+	const NodeAdjacency& adjacency = manager.GetNodeAdjacency ();
+	ASSERT (adjacency.GetNodeCount () == 4);
+	size_t node1Index = adjacency.GetNodeIndex (node1->GetId ());
+	size_t node2Index = adjacency.GetNodeIndex (node2->GetId ());
+	size_t node3Index = adjacency.GetNodeIndex (node3->GetId ());
+	size_t node4Index = adjacency.GetNodeIndex (node4->GetId ());
+	ASSERT (adjacency.GetNodeId (node1Index) == node1->GetId ());
+	ASSERT (adjacency.GetDependentNodeCount (node1Index) == 2);
+	ASSERT (adjacency.GetDependentNode (node1Index, 0) == node2Index);
+	ASSERT (adjacency.GetDependentNode (node1Index, 1) == node3Index);
+	ASSERT (adjacency.GetDependentNodeCount (node2Index) == 1);
+	ASSERT (adjacency.GetDependentNode (node2Index, 0) == node4Index);
+	ASSERT (adjacency.GetDependentNodeCount (node3Index) == 0);
+	ASSERT (adjacency.GetDependentNodeCount (node4Index) == 0);
+
+	manager.ConnectOutputSlotToInputSlot (node3->GetOutputSlot (SlotId ("out")), node4->GetInputSlot (SlotId ("in")));
+	const NodeAdjacency& newAdjacency = manager.GetNodeAdjacency ();
+	ASSERT (newAdjacency.GetDependentNodeCount (newAdjacency.GetNodeIndex (node3->GetId ())) == 1);
+
+	std::vector<NodeId> dependentNodes;
+	manager.EnumerateDependentNodesRecursive (node1, [&] (const NodeId& nodeId) {
+		dependentNodes.push_back (nodeId);
+	});
+	ASSERT (dependentNodes == std::vector<NodeId> ({ node2->GetId (), node4->GetId (), node3->GetId () }));
+	ASSERT (!manager.CanConnectOutputSlotToInputSlot (node4->GetOutputSlot (SlotId ("out")), node2->GetInputSlot (SlotId ("in"))));
+
+	manager.DeleteNode (node3->GetId ());
+	ASSERT (manager.GetNodeAdjacency ().GetNodeCount () == 3);
+	ASSERT (!manager.GetNodeAdjacency ().ContainsNode (node3->GetId ()));
+}
+
+TEST (NodeManagerBatchTest)
+{
+	NodeManager manager;
+
+	std::vector<NodePtr> nodes;
+	for (size_t i = 0; i < 5; i++) {
+		nodes.push_back (manager.AddNode (NodePtr (new AdderInputOutputNode ())));
+	}
+	ASSERT (IntValue::Get (nodes[4]->Evaluate (NE::EmptyEvaluationEnv)) == 1);
+
+	manager.BeginBatch ();
+	ASSERT (manager.IsInBatch ());
+	for (size_t i = 0; i < nodes.size () - 1; i++) {
+		ASSERT (manager.ConnectOutputSlotToInputSlot (nodes[i]->GetOutputSlot (SlotId ("out")), nodes[i + 1]->GetInputSlot (SlotId ("in"))));
+	}
+	ASSERT (manager.EndBatch ());
+	ASSERT (!manager.IsInBatch ());
+
+	ASSERT (manager.GetConnectionCount () == 4);
+	ASSERT (IntValue::Get (nodes[4]->Evaluate (NE::EmptyEvaluationEnv)) == 5);
+}
+
+TEST (NodeManagerBatchRollbackTest)
+{
+	NodeManager manager;
+
+	NodePtr node1 = manager.AddNode (NodePtr (new AdderInputOutputNode ()));
+	NodePtr node2 = manager.AddNode (NodePtr (new AdderInputOutputNode ()));
+	NodePtr node3 = manager.AddNode (NodePtr (new AdderInputOutputNode ()));
+	NodeId node1Id = node1->GetId ();
+	NodeId node2Id = node2->GetId ();
+	NodeId node3Id = node3->GetId ();
+	ASSERT (manager.ConnectOutputSlotToInputSlot (node1->GetOutputSlot (SlotId ("out")), node2->GetInputSlot (SlotId ("in"))));
+	ASSERT (manager.ConnectOutputSlotToInputSlot (node1->GetOutputSlot (SlotId ("out")), node3->GetInputSlot (SlotId ("in"))));
+
+	manager.BeginBatch ();
+	NodePtr node4 = manager.AddNode (NodePtr (new AdderInputOutputNode ()));
+	node1->SetInputSlotDefaultValue (SlotId ("in"), ValuePtr (new IntValue (5)));
+	ASSERT (manager.DeleteNode (node3));
+	ASSERT (manager.ConnectOutputSlotToInputSlot (node2->GetOutputSlot (SlotId ("out")), node4->GetInputSlot (SlotId ("in"))));
+	ASSERT (manager.ConnectOutputSlotToInputSlot (node4->GetOutputSlot (SlotId ("out")), node1->GetInputSlot (SlotId ("in"))));
+	ASSERT (!manager.EndBatch ());
+
+	ASSERT (manager.GetNodeCount () == 3);
+	ASSERT (manager.GetConnectionCount () == 2);
+	ASSERT (node4->GetId () == NullNodeId);
+
+	// only the changes of the batch are undone, the original objects remain in the manager
+	ASSERT (manager.GetNode (node1Id) == node1);
+	ASSERT (manager.GetNode (node2Id) == node2);
+	ASSERT (manager.GetNode (node3Id) == node3);
+	ASSERT (node3->GetId () == node3Id);
+	ASSERT (IntValue::Get (node1->GetInputSlotDefaultValue (SlotId ("in"))) == 0);
+	ASSERT (!manager.HasConnectedOutputSlots (node1->GetInputSlot (SlotId ("in"))));
+	ASSERT (!manager.HasConnectedInputSlots (node2->GetOutputSlot (SlotId ("out"))));
+
+	std::vector<InputSlotConstPtr> connectedInputSlots;
+	manager.EnumerateConnectedInputSlots (node1->GetOutputSlot (SlotId ("out")), [&] (const InputSlotConstPtr& inputSlot) {
+		connectedInputSlots.push_back (inputSlot);
+	});
+	ASSERT (connectedInputSlots == std::vector<InputSlotConstPtr> ({ node2->GetInputSlot (SlotId ("in")), node3->GetInputSlot (SlotId ("in")) }));
+	ASSERT (IntValue::Get (node2->Evaluate (NE::EmptyEvaluationEnv)) == 2);
+	ASSERT (IntValue::Get (node3->Evaluate (NE::EmptyEvaluationEnv)) == 2);
+}
+
+static bool EnumerateLargeGraph (size_t nodeCount)
+{
+	NodeManager manager;
+	NodePtr prevNode = nullptr;
+	for (size_t i = 0; i < nodeCount; i++) {
+		NodePtr node = manager.AddNode (NodePtr (new AdditionNode ()));
+		if (prevNode != nullptr) {
+			manager.ConnectOutputSlotToInputSlot (prevNode->GetOutputSlot (SlotId ("out")), node->GetInputSlot (SlotId ("first")));
+		}
+		prevNode = node;
+	}
+
+	size_t slotCount = 0;
+	size_t connectionCount = 0;
+	const NodeManager& constManager = manager;
+	constManager.EnumerateNodes ([&] (const NodeConstPtr& node) {
+		node->EnumerateInputSlots ([&] (const InputSlotConstPtr&) {
+			slotCount++;
+			return true;
+		});
+		node->EnumerateOutputSlots ([&] (const OutputSlotConstPtr& outputSlot) {
+			slotCount++;
+			constManager.EnumerateConnectedInputSlots (outputSlot, [&] (const InputSlotConstPtr&) {
+				connectionCount++;
+			});
+			return true;
+		});
+		return true;
+	});
+
+	size_t functionSlotCount = 0;
+	size_t functionConnectionCount = 0;
+	std::function<void (const InputSlotConstPtr&)> inputSlotProcessor = [&] (const InputSlotConstPtr&) {
+		functionConnectionCount++;
+	};
+	std::function<bool (NodeConstPtr)> nodeProcessor = [&] (NodeConstPtr node) {
+		functionSlotCount += node->GetInputSlotCount () + node->GetOutputSlotCount ();
+		std::function<bool (OutputSlotConstPtr)> outputSlotProcessor = [&] (OutputSlotConstPtr outputSlot) {
+			constManager.EnumerateConnectedInputSlots (outputSlot, inputSlotProcessor);
+			return true;
+		};
+		node->EnumerateOutputSlots (outputSlotProcessor);
+		return true;
+	};
+	constManager.EnumerateNodes (nodeProcessor);
+
+	size_t enumeratedConnectionCount = 0;
+	manager.EnumerateConnections ([&] (const OutputSlotConstPtr&, const InputSlotConstPtr&) {
+		enumeratedConnectionCount++;
+	});
+
+	if (slotCount != nodeCount * 3 || functionSlotCount != slotCount) {
+		return false;
+	}
+	if (connectionCount != nodeCount - 1 || functionConnectionCount != connectionCount) {
+		return false;
+	}
+	return enumeratedConnectionCount == connectionCount && manager.GetConnectionCount () == connectionCount;
+}
+
+TEST (LargeGraphEnumerationTest)
+{
+	ASSERT (EnumerateLargeGraph (1000));
+}
+
 }
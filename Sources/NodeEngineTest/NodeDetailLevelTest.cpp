@@ -0,0 +1,143 @@
+#include "SimpleTest.hpp"
+#include "NE_SingleValues.hpp"
+#include "NUIE_NodeUIManager.hpp"
+#include "TestUtils.hpp"
+#include "TestNodes.hpp"
+
+using namespace NE;
+using namespace NUIE;
+
+namespace NodeDetailLevelTest
+{
+
+class PrimitiveCounterContext : public NullDrawingContext
+{
+public:
+	PrimitiveCounterContext () :
+		NullDrawingContext (),
+		rectCount (0),
+		textCount (0),
+		bezierCount (0),
+		lineCount (0)
+	{
+
+	}
+
+	virtual int GetWidth () const override
+	{
+		return 800;
+	}
+
+	virtual int GetHeight () const override
+	{
+		return 600;
+	}
+
+	virtual bool NeedToDraw (ItemPreviewMode) override
+	{
+		return true;
+	}
+
+	virtual Size MeasureText (const Font& font, const std::wstring& text) override
+	{
+		return Size (text.length () * font.GetSize () * 0.5, font.GetSize ());
+	}
+
+	virtual void DrawBezier (const Point&, const Point&, const Point&, const Point&, const Pen&) override
+	{
+		bezierCount++;
+	}
+
+	virtual void DrawLines (const std::vector<Point>& points, const Pen&) override
+	{
+		lineCount += points.size () / 2;
+	}
+
+	virtual void FillRect (const Rect&, const Color&) override
+	{
+		rectCount++;
+	}
+
+	virtual void DrawFormattedText (const Rect&, const Font&, const std::wstring&, HorizontalAnchor, VerticalAnchor, const Color&) override
+	{
+		textCount++;
+	}
+
+	void Reset ()
+	{
+		rectCount = 0;
+		textCount = 0;
+		bezierCount = 0;
+		lineCount = 0;
+	}
+
+	size_t	rectCount;
+	size_t	textCount;
+	size_t	bezierCount;
+	size_t	lineCount;
+};
+
+class CounterUIEnvironment : public TestUIEnvironment
+{
+public:
+	CounterUIEnvironment () :
+		TestUIEnvironment (),
+		context ()
+	{
+
+	}
+
+	virtual DrawingContext& GetDrawingContext () override
+	{
+		return context;
+	}
+
+	PrimitiveCounterContext context;
+};
+
+static void DrawWithScale (NodeUIManager& uiManager, CounterUIEnvironment& env, double scale)
+{
+	EmptyDrawingModifier drawModifier;
+	uiManager.SetViewBox (ViewBox (Point (0.0, 0.0), scale));
+	env.context.Reset ();
+	uiManager.Draw (env, &drawModifier);
+}
+
+TEST (NodeDetailLevelTest)
+{
+	CounterUIEnvironment env;
+	NodeUIManager uiManager (env);
+
+	const size_t nodeCount = 10;
+	std::vector<UINodePtr> nodes;
+	for (size_t i = 0; i < nodeCount; i++) {
+		nodes.push_back (uiManager.AddNode (UINodePtr (new FixedRectTestUINode (Point (i * 150.0, 0.0)))));
+	}
+	for (size_t i = 1; i < nodeCount; i++) {
+		uiManager.ConnectOutputSlotToInputSlot (nodes[i - 1]->GetUIOutputSlot (SlotId ("out")), nodes[i]->GetUIInputSlot (SlotId ("in")));
+	}
+
+	DrawWithScale (uiManager, env, 1.0);
+	ASSERT (uiManager.GetDetailLevel () == NodeDetailLevel::Full);
+	ASSERT (env.context.bezierCount == 5);
+	ASSERT (env.context.lineCount == 0);
+
+	DrawWithScale (uiManager, env, 0.1);
+	ASSERT (uiManager.GetDetailLevel () == NodeDetailLevel::Simplified);
+	ASSERT (env.context.bezierCount == nodeCount - 1);
+	ASSERT (env.context.textCount == nodeCount);
+
+	DrawWithScale (uiManager, env, 0.02);
+	ASSERT (uiManager.GetDetailLevel () == NodeDetailLevel::Minimal);
+	ASSERT (env.context.bezierCount == 0);
+	ASSERT (env.context.lineCount == nodeCount - 1);
+	ASSERT (env.context.textCount == 0);
+	ASSERT (env.context.rectCount == nodeCount + 1);
+
+	nodes[0]->SetName (L"Renamed");
+	nodes[0]->InvalidateDrawing ();
+	DrawWithScale (uiManager, env, 0.1);
+	ASSERT (env.context.textCount == nodeCount);
+}
+
+}
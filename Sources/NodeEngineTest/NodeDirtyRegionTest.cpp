@@ -0,0 +1,158 @@
+#include "SimpleTest.hpp"
+#include "NE_SingleValues.hpp"
+#include "NUIE_NodeUIManager.hpp"
+#include "TestUtils.hpp"
+#include "TestNodes.hpp"
+
+using namespace NE;
+using namespace NUIE;
+
+namespace NodeDirtyRegionTest
+{
+
+class ClippingContext : public NullDrawingContext
+{
+public:
+	ClippingContext () :
+		NullDrawingContext (),
+		textCount (0),
+		clipRectCount (0)
+	{
+
+	}
+
+	virtual int GetWidth () const override
+	{
+		return 800;
+	}
+
+	virtual int GetHeight () const override
+	{
+		return 600;
+	}
+
+	virtual bool NeedToDraw (ItemPreviewMode) override
+	{
+		return true;
+	}
+
+	virtual void DrawFormattedText (const Rect&, const Font&, const std::wstring&, HorizontalAnchor, VerticalAnchor, const Color&) override
+	{
+		textCount++;
+	}
+
+	virtual bool CanClip () override
+	{
+		return true;
+	}
+
+	virtual void SetClipRect (const Rect&) override
+	{
+		clipRectCount++;
+	}
+
+	size_t	textCount;
+	size_t	clipRectCount;
+};
+
+class DirtyRegionUIEnvironment : public TestUIEnvironment
+{
+public:
+	DirtyRegionUIEnvironment () :
+		TestUIEnvironment (),
+		context (),
+		redrawCount (0),
+		partialRedrawCount (0),
+		dirtyViewRect ()
+	{
+
+	}
+
+	virtual DrawingContext& GetDrawingContext () override
+	{
+		return context;
+	}
+
+	virtual void OnRedrawRequested () override
+	{
+		redrawCount++;
+	}
+
+	virtual void OnPartialRedrawRequested (const Rect& newDirtyViewRect) override
+	{
+		partialRedrawCount++;
+		dirtyViewRect = newDirtyViewRect;
+	}
+
+	void Reset ()
+	{
+		context.textCount = 0;
+		context.clipRectCount = 0;
+		redrawCount = 0;
+		partialRedrawCount = 0;
+	}
+
+	ClippingContext	context;
+	size_t			redrawCount;
+	size_t			partialRedrawCount;
+	Rect			dirtyViewRect;
+};
+
+TEST (NodeDirtyRegionTest)
+{
+	DirtyRegionUIEnvironment env;
+	NodeUIManager uiManager (env);
+	EmptyDrawingModifier drawModifier;
+
+	UINodePtr node1 = uiManager.AddNode (UINodePtr (new FixedRectTestUINode (Point (0.0, 0.0))));
+	UINodePtr node2 = uiManager.AddNode (UINodePtr (new FixedRectTestUINode (Point (400.0, 0.0))));
+	UINodePtr node3 = uiManager.AddNode (UINodePtr (new FixedRectTestUINode (Point (400.0, 300.0))));
+	uiManager.Update (env, env);
+	ASSERT (env.redrawCount == 1);
+	ASSERT (env.partialRedrawCount == 0);
+
+	uiManager.Draw (env, &drawModifier);
+	ASSERT (env.context.textCount == 3);
+	ASSERT (env.context.clipRectCount == 0);
+
+	env.Reset ();
+	uiManager.InvalidateNodeDrawing (node1);
+	uiManager.Update (env, env);
+	ASSERT (env.redrawCount == 0);
+	ASSERT (env.partialRedrawCount == 1);
+	ASSERT (env.dirtyViewRect.Contains (node1->GetRect (env)));
+	ASSERT (!Rect::IsOverlapping (env.dirtyViewRect, node2->GetRect (env)));
+
+	uiManager.Draw (env, &drawModifier, env.dirtyViewRect);
+	ASSERT (env.context.textCount == 1);
+	ASSERT (env.context.clipRectCount == 1);
+
+	env.Reset ();
+	Rect oldNodeRect = node3->GetRect (env);
+	node3->SetPosition (Point (600.0, 300.0));
+	uiManager.InvalidateNodePosition (node3);
+	uiManager.Update (env, env);
+	ASSERT (env.redrawCount == 0);
+	ASSERT (env.partialRedrawCount == 1);
+	ASSERT (env.dirtyViewRect.Contains (oldNodeRect));
+	ASSERT (env.dirtyViewRect.Contains (node3->GetRect (env)));
+	ASSERT (!Rect::IsOverlapping (env.dirtyViewRect, node1->GetRect (env)));
+
+	uiManager.Draw (env, &drawModifier, env.dirtyViewRect);
+	ASSERT (env.context.textCount == 1);
+
+	env.Reset ();
+	uiManager.InvalidateNodeDrawing (node1);
+	uiManager.SetViewBox (ViewBox (Point (10.0, 10.0), 1.0));
+	uiManager.Update (env, env);
+	ASSERT (env.redrawCount == 1);
+	ASSERT (env.partialRedrawCount == 0);
+
+	env.Reset ();
+	uiManager.InvalidateNodeDrawing (node2);
+	uiManager.Update (env);
+	ASSERT (env.redrawCount == 1);
+	ASSERT (env.partialRedrawCount == 0);
+}
+
+}
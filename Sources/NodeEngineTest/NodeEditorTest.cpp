@@ -11,6 +11,48 @@ using namespace BI;
 namespace NodeEditorTest
 {
 
+static const BasicSkinParams& GetSkinParamsWithLargeFonts ()
+{
+	static const BasicSkinParams largeFontsSkinParams (
+		/*backgroundColor*/ NUIE::Color (250, 250, 250),
+		/*connectionLinePen*/ NUIE::Pen (NUIE::Color (38, 50, 56), 1.0),
+		/*connectionMarker*/ NUIE::SkinParams::ConnectionMarker::None,
+		/*connectionMarkerSize*/ NUIE::Size (8.0, 8.0),
+		/*nodePadding*/ 5.0,
+		/*nodeBorderPen*/ NUIE::Pen (NUIE::Color (38, 50, 56), 1.0),
+		/*nodeHeaderTextFont*/ NUIE::Font (L"Arial", 24.0),
+		/*nodeHeaderTextColor*/ NUIE::Color (250, 250, 250),
+		/*nodeHeaderErrorTextColor*/ NUIE::Color (250, 250, 250),
+		/*nodeHeaderBackgroundColor*/ NUIE::Color (41, 127, 255),
+		/*nodeHeaderErrorBackgroundColor*/ NUIE::Color (199, 80, 80),
+		/*nodeContentTextFont*/ NUIE::Font (L"Arial", 20.0),
+		/*nodeContentTextColor*/ NUIE::Color (0, 0, 0),
+		/*nodeContentBackgroundColor*/ NUIE::Color (236, 236, 236),
+		/*slotTextColor*/ NUIE::Color (0, 0, 0),
+		/*slotTextBackgroundColor*/ NUIE::Color (246, 246, 246),
+		/*slotMarker*/ NUIE::SkinParams::SlotMarker::None,
+		/*hiddenSlotMarker*/ NUIE::SkinParams::HiddenSlotMarker::None,
+		/*slotMarkerSize*/ NUIE::Size (8.0, 8.0),
+		/*selectionBlendColor*/ NUIE::BlendColor (NUIE::Color (41, 127, 255), 0.25),
+		/*disabledBlendColor*/ NUIE::BlendColor (NUIE::Color (0, 138, 184), 0.2),
+		/*selectionRectPen*/ NUIE::Pen (NUIE::Color (41, 127, 255), 1.0),
+		/*nodeSelectionRectPen*/ NUIE::Pen (NUIE::Color (41, 127, 255), 3.0),
+		/*buttonBorderPen*/ NUIE::Pen (NUIE::Color (146, 152, 155), 1.0),
+		/*buttonBackgroundColor*/ NUIE::Color (217, 217, 217),
+		/*textPanelTextColor*/ NUIE::Color (0, 0, 0),
+		/*textPanelBackgroundColor*/ NUIE::Color (236, 236, 236),
+		/*groupNameFont*/ NUIE::Font (L"Arial", 16.0),
+		/*groupNameColor*/ NUIE::Color (0, 0, 0),
+		/*groupBackgroundColors*/ NUIE::NamedColorSet ({
+			{ NE::LocalizeString (L"Blue"), NUIE::Color (160, 200, 240) },
+			{ NE::LocalizeString (L"Green"), NUIE::Color (160, 239, 160) },
+			{ NE::LocalizeString (L"Red"), NUIE::Color (239, 189, 160) }
+		}),
+		/*groupPadding*/ 12.0
+	);
+	return largeFontsSkinParams;
+}
+
 TEST (NodeEditorNeedToSaveTest)
 {
 	NodeEditorTestEnv env (GetDefaultSkinParams ());
@@ -80,4 +122,124 @@ TEST (NodeEditorGetInfoTest)
 	ASSERT (info.groups[0].nodesInGroup[1] == NE::NodeId (3));
 }
 
+TEST (NodeEditorNodeRectIndexTest)
+{
+	NodeEditorTestEnv env (GetDefaultSkinParams ());
+	UINodePtr intNode (new IntegerUpDownNode (LocString (L"Integer"), Point (100.0, 100.0), 0, 1));
+	UINodePtr viewerNode (new MultiLineViewerNode (LocString (L"Viewer"), Point (10000.0, 10000.0), 5));
+	env.nodeEditor.AddNode (intNode);
+	env.nodeEditor.AddNode (viewerNode);
+	env.nodeEditor.ConnectOutputSlotToInputSlot (intNode->GetUIOutputSlot (SlotId ("out")), viewerNode->GetUIInputSlot (SlotId ("in")));
+	Rect intNodeRect = env.GetNodeRect (intNode);
+	Rect viewerNodeRect = env.GetNodeRect (viewerNode);
+
+	MemoryOutputStream outputStream;
+	ASSERT (env.nodeEditor.Save (outputStream));
+
+	NodeEditorTestEnv env2 (GetDefaultSkinParams ());
+	MemoryInputStream inputStream (outputStream.GetBuffer ());
+	ASSERT (env2.nodeEditor.Open (inputStream));
+
+	UINodeConstPtr openedIntNode = env2.GetNode (L"Integer");
+	UINodeConstPtr openedViewerNode = env2.GetNode (L"Viewer");
+	Rect nodeRect;
+	Rect extendedNodeRect;
+	ASSERT (openedViewerNode->GetLocalRects (nodeRect, extendedNodeRect));
+	ASSERT (openedIntNode->GetEstimatedRect (env2.uiEnvironment) == intNodeRect);
+	ASSERT (openedViewerNode->GetEstimatedRect (env2.uiEnvironment) == viewerNodeRect);
+
+	openedViewerNode->InvalidateDrawing ();
+	ASSERT (!openedViewerNode->GetLocalRects (nodeRect, extendedNodeRect));
+	ASSERT (openedViewerNode->GetEstimatedRect (env2.uiEnvironment) == viewerNodeRect);
+}
+
+TEST (NodeEditorNodeRectIndexSkinTest)
+{
+	NodeEditorTestEnv env (GetDefaultSkinParams ());
+	UINodePtr viewerNode (new MultiLineViewerNode (LocString (L"Viewer"), Point (10000.0, 10000.0), 5));
+	env.nodeEditor.AddNode (viewerNode);
+	Rect viewerNodeRect = env.GetNodeRect (viewerNode);
+
+	MemoryOutputStream outputStream;
+	ASSERT (env.nodeEditor.Save (outputStream));
+
+	// the stored rects are calculated with other fonts, so the rect comes from the drawing image
+	NodeEditorTestEnv env2 (GetSkinParamsWithLargeFonts ());
+	MemoryInputStream inputStream (outputStream.GetBuffer ());
+	ASSERT (env2.nodeEditor.Open (inputStream));
+
+	UINodeConstPtr openedViewerNode = env2.GetNode (L"Viewer");
+	Rect openedViewerNodeRect = openedViewerNode->GetEstimatedRect (env2.uiEnvironment);
+	ASSERT (!(openedViewerNodeRect == viewerNodeRect));
+	openedViewerNode->InvalidateDrawing ();
+	ASSERT (openedViewerNodeRect == env2.GetNodeRect (openedViewerNode));
+}
+
+TEST (NodeEditorBatchTest)
+{
+	NodeEditorTestEnv env (GetDefaultSkinParams ());
+
+	UINodePtr intNode (new IntegerUpDownNode (LocString (L"Integer"), Point (100.0, 100.0), 5, 1));
+	UINodePtr viewerNode (new MultiLineViewerNode (LocString (L"Viewer"), Point (200.0, 200.0), 5));
+	env.nodeEditor.BeginBatch ();
+	env.nodeEditor.AddNode (intNode);
+	env.nodeEditor.AddNode (viewerNode);
+	env.nodeEditor.ConnectOutputSlotToInputSlot (intNode->GetUIOutputSlot (SlotId ("out")), viewerNode->GetUIInputSlot (SlotId ("in")));
+	ASSERT (!viewerNode->HasCalculatedValue ());
+	ASSERT (env.nodeEditor.EndBatch ());
+	ASSERT (viewerNode->HasCalculatedValue ());
+
+	NodeEditorInfo info = env.nodeEditor.GetInfo ();
+	ASSERT (info.nodes.size () == 2);
+	ASSERT (info.connections.size () == 1);
+
+	env.nodeEditor.Undo ();
+	info = env.nodeEditor.GetInfo ();
+	ASSERT (info.nodes.size () == 0);
+	ASSERT (info.connections.size () == 0);
+}
+
+TEST (NodeEditorBatchRollbackTest)
+{
+	NodeEditorTestEnv env (GetDefaultSkinParams ());
+
+	UINodePtr intNode (new IntegerUpDownNode (LocString (L"Integer"), Point (100.0, 100.0), 5, 1));
+	UINodePtr additionNode1 (new AdditionNode (LocString (L"Addition1"), Point (300.0, 100.0)));
+	UINodePtr additionNode2 (new AdditionNode (LocString (L"Addition2"), Point (500.0, 100.0)));
+	env.nodeEditor.AddNode (intNode);
+	env.nodeEditor.AddNode (additionNode1);
+	env.nodeEditor.AddNode (additionNode2);
+	env.nodeEditor.ConnectOutputSlotToInputSlot (intNode->GetUIOutputSlot (SlotId ("out")), additionNode1->GetUIInputSlot (SlotId ("a")));
+	env.nodeEditor.ConnectOutputSlotToInputSlot (additionNode1->GetUIOutputSlot (SlotId ("result")), additionNode2->GetUIInputSlot (SlotId ("a")));
+
+	UINodePtr newNode (new IntegerUpDownNode (LocString (L"New"), Point (100.0, 300.0), 1, 1));
+	env.nodeEditor.BeginBatch ();
+	intNode->SetPosition (Point (700.0, 700.0));
+	intNode->SetName (L"Renamed");
+	std::static_pointer_cast<IntegerUpDownNode> (intNode)->SetValue (10);
+	env.nodeEditor.AddNode (newNode);
+	Selection selection;
+	selection.SetNodes (NE::NodeCollection ({ intNode->GetId (), newNode->GetId () }));
+	env.nodeEditor.SetSelection (selection);
+	env.nodeEditor.ConnectOutputSlotToInputSlot (additionNode2->GetUIOutputSlot (SlotId ("result")), additionNode1->GetUIInputSlot (SlotId ("b")));
+	ASSERT (!env.nodeEditor.EndBatch ());
+
+	// the nodes are restored to their state at the beginning of the batch
+	NodeEditorInfo info = env.nodeEditor.GetInfo ();
+	ASSERT (info.nodes.size () == 3);
+	ASSERT (info.connections.size () == 2);
+	UINodeConstPtr restoredIntNode = env.GetNode (L"Integer");
+	ASSERT (restoredIntNode == intNode);
+	ASSERT (restoredIntNode->GetPosition () == Point (100.0, 100.0));
+	ASSERT (std::static_pointer_cast<const IntegerUpDownNode> (restoredIntNode)->GetValue () == 5);
+	ASSERT (env.nodeEditor.GetSelection ().GetNodes ().Count () == 1);
+	ASSERT (env.nodeEditor.GetSelection ().ContainsNode (restoredIntNode->GetId ()));
+
+	// the failed batch leaves no undo step, so undo reverts the last command before it
+	env.nodeEditor.Undo ();
+	info = env.nodeEditor.GetInfo ();
+	ASSERT (info.nodes.size () == 3);
+	ASSERT (info.connections.size () == 1);
+}
+
 }
@@ -195,10 +195,11 @@ TEST (NodeGroupingTest)
 	}
 }
 
-TEST (UndoTest)
+static bool UndoTestSequence (NodeEditorTestEnv& env)
 {
-	NodeEditorTestEnv env (GetDefaultSkinParams ());
-	ASSERT (env.CheckReference (L"UndoTest_Empty.svg"));
+	if (!env.CheckReference (L"UndoTest_Empty.svg")) {
+		return false;
+	}
 
 	env.SetNextCommandName (L"Create Number Node");
 	env.RightClick (Point (100, 100));
@@ -220,7 +221,9 @@ TEST (UndoTest)
 	env.SetNextCommandName (L"Delete Nodes");
 	env.RightClick (Point (320, 180));
 
-	ASSERT (env.CheckReference (L"UndoTest_Initial.svg"));
+	if (!env.CheckReference (L"UndoTest_Initial.svg")) {
+		return false;
+	}
 
 	for (int i = 1; i <= 11; i++) {
 		env.nodeEditor.ExecuteCommand (CommandCode::Undo);
@@ -228,7 +231,9 @@ TEST (UndoTest)
 		while (indexString.length () < 2) {
 			indexString = L"0" + indexString;
 		}
-		ASSERT (env.CheckReference (L"UndoTest_Undo_" + indexString + L".svg"));
+		if (!env.CheckReference (L"UndoTest_Undo_" + indexString + L".svg")) {
+			return false;
+		}
 	}
 	for (int i = 1; i <= 11; i++) {
 		env.nodeEditor.ExecuteCommand (CommandCode::Redo);
@@ -236,8 +241,31 @@ TEST (UndoTest)
 		while (indexString.length () < 2) {
 			indexString = L"0" + indexString;
 		}
-		ASSERT (env.CheckReference (L"UndoTest_Redo_" + indexString + L".svg"));
+		if (!env.CheckReference (L"UndoTest_Redo_" + indexString + L".svg")) {
+			return false;
+		}
 	}
+	return true;
+}
+
+TEST (UndoTest)
+{
+	NodeEditorTestEnv env (GetDefaultSkinParams ());
+	ASSERT (UndoTestSequence (env));
+}
+
+TEST (UndoTestWithPackedHistory)
+{
+	NodeEditorTestEnv env (GetDefaultSkinParams ());
+	env.nodeEditor.SetUndoHistoryLimits (2, 1024);
+	ASSERT (UndoTestSequence (env));
+}
+
+TEST (UndoTestWithSpilledHistory)
+{
+	NodeEditorTestEnv env (GetDefaultSkinParams ());
+	env.nodeEditor.SetUndoHistoryLimits (0, 0);
+	ASSERT (UndoTestSequence (env));
 }
 
 TEST (ManualUpdateTest)
@@ -0,0 +1,150 @@
+#include "SimpleTest.hpp"
+#include "NE_NodeManager.hpp"
+#include "NE_NodeManagerFrozenCopy.hpp"
+#include "NE_Node.hpp"
+#include "NE_NodeGroup.hpp"
+#include "NE_InputSlot.hpp"
+#include "NE_OutputSlot.hpp"
+#include "NE_SingleValues.hpp"
+#include "TestNodes.hpp"
+
+using namespace NE;
+
+namespace NodeManagerFrozenCopyTest
+{
+
+class TestNode : public SerializableTestNode
+{
+public:
+	TestNode () :
+		SerializableTestNode ()
+	{
+
+	}
+
+	virtual void Initialize () override
+	{
+		RegisterInputSlot (InputSlotPtr (new InputSlot (SlotId ("in"), ValuePtr (new IntValue (0)), OutputSlotConnectionMode::Single)));
+		RegisterOutputSlot (OutputSlotPtr (new OutputSlot (SlotId ("out"))));
+	}
+
+	virtual ValueConstPtr Calculate (NE::EvaluationEnv&) const override
+	{
+		return ValueConstPtr (new IntValue (1));
+	}
+
+	virtual NodePtr CloneNode () const override
+	{
+		return NodePtr (new TestNode (*this));
+	}
+};
+
+class TestGroup : public NodeGroup
+{
+	DYNAMIC_SERIALIZABLE (TestGroup);
+
+public:
+	TestGroup () :
+		NodeGroup ()
+	{
+
+	}
+};
+
+DYNAMIC_SERIALIZATION_INFO (TestGroup, 1, "{0D6C3F2A-58E4-4B1D-A7C9-3E2F81B6D4A0}");
+
+TEST (NodeManagerFrozenCopyEmptyTest)
+{
+	NodeManager nodeManager;
+	NodeManagerFrozenCopy frozenCopy (nodeManager);
+	ASSERT (frozenCopy.IsEmpty ());
+
+	NodePtr node = nodeManager.AddNode (NodePtr (new TestNode ()));
+	ASSERT (!nodeManager.IsEmpty ());
+	ASSERT (frozenCopy.IsEmpty ());
+	ASSERT (!frozenCopy.ContainsNode (node->GetId ()));
+
+	NodeManagerFrozenCopy frozenCopy2 (nodeManager);
+	ASSERT (frozenCopy2.GetNodeCount () == 1);
+	ASSERT (frozenCopy2.GetNode (node->GetId ()) != node);
+	ASSERT (frozenCopy2.GetNode (node->GetId ())->GetId () == node->GetId ());
+}
+
+TEST (NodeManagerFrozenCopyIsFrozenTest)
+{
+	NodeManager nodeManager;
+	NodePtr node1 = nodeManager.AddNode (NodePtr (new TestNode ()));
+	NodePtr node2 = nodeManager.AddNode (NodePtr (new TestNode ()));
+	NodePtr node3 = nodeManager.AddNode (NodePtr (new TestNode ()));
+	ASSERT (nodeManager.ConnectOutputSlotToInputSlot (node1->GetOutputSlot (SlotId ("out")), node2->GetInputSlot (SlotId ("in"))));
+	NodeGroupPtr group = nodeManager.AddNodeGroup (NodeGroupPtr (new TestGroup ()));
+	nodeManager.AddNodeToGroup (group->GetId (), node1->GetId ());
+
+	NodeId node1Id = node1->GetId ();
+	NodeManagerFrozenCopy frozenCopy (nodeManager);
+	ASSERT (frozenCopy.GetNodeCount () == 3);
+	ASSERT (frozenCopy.GetConnectionCount () == 1);
+	ASSERT (frozenCopy.GetNodeGroupCount () == 1);
+
+	ASSERT (nodeManager.ConnectOutputSlotToInputSlot (node2->GetOutputSlot (SlotId ("out")), node3->GetInputSlot (SlotId ("in"))));
+	ASSERT (nodeManager.DisconnectOutputSlotFromInputSlot (node1->GetOutputSlot (SlotId ("out")), node2->GetInputSlot (SlotId ("in"))));
+	nodeManager.RemoveNodeFromGroup (node1Id);
+	nodeManager.DeleteAllNodeGroups ();
+	ASSERT (nodeManager.DeleteNode (node1Id));
+	nodeManager.AddNode (NodePtr (new TestNode ()));
+
+	ASSERT (nodeManager.GetNodeCount () == 3);
+	ASSERT (nodeManager.GetConnectionCount () == 1);
+	ASSERT (nodeManager.GetNodeGroupCount () == 0);
+	ASSERT (!nodeManager.ContainsNode (node1Id));
+
+	ASSERT (frozenCopy.GetNodeCount () == 3);
+	ASSERT (frozenCopy.ContainsNode (node1Id));
+	NodeConstPtr frozenNode1 = frozenCopy.GetNode (node1Id);
+	ASSERT (frozenNode1 != node1);
+	ASSERT (frozenNode1->GetId () == node1Id);
+	ASSERT (node1->GetId () == NullNodeId);
+	ASSERT (frozenCopy.GetConnectionCount () == 1);
+	ASSERT (frozenCopy.IsOutputSlotConnectedToInputSlot (frozenNode1->GetOutputSlot (SlotId ("out")), node2->GetInputSlot (SlotId ("in"))));
+	ASSERT (!frozenCopy.HasConnectedInputSlots (node2->GetOutputSlot (SlotId ("out"))));
+	ASSERT (frozenCopy.GetNodeGroupCount () == 1);
+	ASSERT (frozenCopy.ContainsNodeGroup (group->GetId ()));
+	ASSERT (frozenCopy.GetNodeGroup (node1Id)->GetId () == group->GetId ());
+	ASSERT (frozenCopy.GetGroupNodes (group->GetId ()).Contains (node1Id));
+
+	std::vector<NodeId> dependentNodes;
+	frozenCopy.EnumerateDependentNodesRecursive (frozenNode1, [&] (const NodeId& nodeId) {
+		dependentNodes.push_back (nodeId);
+	});
+	ASSERT (dependentNodes.size () == 1);
+	ASSERT (dependentNodes[0] == node2->GetId ());
+}
+
+TEST (NodeManagerFrozenCopyIsolatesNodeObjectsTest)
+{
+	NodeManager nodeManager;
+	NodePtr node1 = nodeManager.AddNode (NodePtr (new TestNode ()));
+	NodePtr node2 = nodeManager.AddNode (NodePtr (new TestNode ()));
+	ASSERT (nodeManager.ConnectOutputSlotToInputSlot (node1->GetOutputSlot (SlotId ("out")), node2->GetInputSlot (SlotId ("in"))));
+
+	NodeManagerFrozenCopy frozenCopy (nodeManager);
+	NodeId node2Id = node2->GetId ();
+
+	node1->SetInputSlotDefaultValue (SlotId ("in"), ValuePtr (new IntValue (5)));
+	nodeManager.GetNode (node2Id)->SetInputSlotDefaultValue (SlotId ("in"), ValuePtr (new IntValue (6)));
+	nodeManager.EnumerateNodes ([&] (const NodePtr& node) {
+		node->SetInputSlotDefaultValue (SlotId ("in"), ValuePtr (new IntValue (7)));
+		return true;
+	});
+	ASSERT (nodeManager.DeleteNode (node2));
+	ASSERT (node2->GetId () == NullNodeId);
+
+	NodeConstPtr frozenNode1 = frozenCopy.GetNode (node1->GetId ());
+	NodeConstPtr frozenNode2 = frozenCopy.GetNode (node2Id);
+	ASSERT (frozenNode2->GetId () == node2Id);
+	ASSERT (IntValue::Get (frozenNode1->GetInputSlotDefaultValue (SlotId ("in"))) == 0);
+	ASSERT (IntValue::Get (frozenNode2->GetInputSlotDefaultValue (SlotId ("in"))) == 0);
+	ASSERT (frozenCopy.IsOutputSlotConnectedToInputSlot (node1->GetOutputSlot (SlotId ("out")), frozenNode2->GetInputSlot (SlotId ("in"))));
+}
+
+}
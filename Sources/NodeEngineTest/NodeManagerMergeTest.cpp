@@ -6,6 +6,7 @@
 #include "NE_OutputSlot.hpp"
 #include "NE_SingleValues.hpp"
 #include "NE_MemoryStream.hpp"
+#include "BI_InputUINodes.hpp"
 
 using namespace NE;
 
@@ -131,6 +132,23 @@ static bool IsEqualNodeManagers (const NodeManager& source, const NodeManager& t
 static EmptyAppendEventHandler appendHandler;
 static EmptyUpdateEventHandler updateHandler;
 
+class CountingUpdateEventHandler : public UpdateEventHandler
+{
+public:
+	CountingUpdateEventHandler () :
+		deletedNodeCount (0)
+	{
+
+	}
+
+	virtual void BeforeNodeDelete (const NodeId&) override
+	{
+		deletedNodeCount++;
+	}
+
+	size_t deletedNodeCount;
+};
+
 TEST (MergeAllNodesTest)
 {
 	NodeManager source;
@@ -375,4 +393,105 @@ TEST (NodeManagerUpdateTest_DeleteConnection)
 	ASSERT (IsEqualNodeManagers (source, target));
 }
 
+TEST (NodeManagerRegionTest_DeleteNode)
+{
+	NodeManager source;
+	InitNodeManager (source);
+	NodeConstPtr node3 = FindNodesByName (source, L"3")[0];
+
+	NodeManager target;
+	NodeManager::Clone (source, target);
+
+	NodeManagerRegion region;
+	NodeManagerMerge::SaveRegion (source, NodeCollection ({ node3->GetId () }), NodeManagerRegion::GroupMode::Memberships, region);
+	ASSERT (region.GetNodes ().Count () == 1);
+
+	target.DeleteNode (node3->GetId ());
+	ASSERT (target.GetNodeCount () == 3);
+	ASSERT (target.GetConnectionCount () == 0);
+
+	ASSERT (NodeManagerMerge::RestoreRegion (region, target, updateHandler));
+	ASSERT (IsEqualNodeManagers (source, target));
+}
+
+TEST (NodeManagerRegionTest_AddNodeAndConnection)
+{
+	NodeManager source;
+	InitNodeManager (source);
+	NodeConstPtr node3 = FindNodesByName (source, L"3")[0];
+	NodeConstPtr node4 = FindNodesByName (source, L"4")[0];
+
+	NodeManager target;
+	NodeManager::Clone (source, target);
+	NodePtr node5 = source.AddNode (NodePtr (new TestNode (L"5")));
+	source.ConnectOutputSlotToInputSlot (node3->GetOutputSlot (SlotId ("out")), node5->GetInputSlot (SlotId ("a")));
+	source.ConnectOutputSlotToInputSlot (node5->GetOutputSlot (SlotId ("out")), node4->GetInputSlot (SlotId ("b")));
+
+	NodeCollection changedNodes ({ node3->GetId (), node4->GetId (), node5->GetId () });
+	NodeManagerRegion oldRegion;
+	NodeManagerRegion newRegion;
+	NodeManagerMerge::SaveRegion (target, changedNodes, NodeManagerRegion::GroupMode::Memberships, oldRegion);
+	NodeManagerMerge::SaveRegion (source, changedNodes, NodeManagerRegion::GroupMode::Memberships, newRegion);
+
+	NodeManager original;
+	NodeManager::Clone (target, original);
+
+	ASSERT (NodeManagerMerge::RestoreRegion (newRegion, target, updateHandler));
+	ASSERT (IsEqualNodeManagers (source, target));
+
+	ASSERT (NodeManagerMerge::RestoreRegion (oldRegion, target, updateHandler));
+	ASSERT (IsEqualNodeManagers (original, target));
+	ASSERT (!target.ContainsNode (node5->GetId ()));
+}
+
+TEST (NodeManagerUpdateTest_LargeDocumentSingleNodeChange)
+{
+	const size_t nodeCount = 5000;
+
+	NodeManager source;
+	std::vector<NodePtr> sourceNodes;
+	for (size_t i = 0; i < nodeCount; i++) {
+		sourceNodes.push_back (source.AddNode (NodePtr (new TestNode (std::to_wstring (i)))));
+		if (i > 0) {
+			source.ConnectOutputSlotToInputSlot (sourceNodes[i - 1]->GetOutputSlot (SlotId ("out")), sourceNodes[i]->GetInputSlot (SlotId ("a")));
+		}
+	}
+
+	NodeManager target;
+	NodeManager::Clone (source, target);
+	NodeId changedNodeId = sourceNodes[nodeCount / 2]->GetId ();
+	Node::Cast<TestNode> (target.GetNode (changedNodeId))->SetName (L"Changed");
+
+	CountingUpdateEventHandler countingHandler;
+	NodeManagerMerge::UpdateNodeManager (source, target, countingHandler);
+	ASSERT (countingHandler.deletedNodeCount == 1);
+	ASSERT (Node::Cast<TestNode> (target.GetNode (changedNodeId))->GetName () == std::to_wstring (nodeCount / 2));
+	ASSERT (target.GetConnectionCount () == nodeCount - 1);
+
+	countingHandler.deletedNodeCount = 0;
+	NodeManagerMerge::UpdateNodeManager (source, target, countingHandler);
+	ASSERT (countingHandler.deletedNodeCount == 0);
+	ASSERT (IsEqualNodeManagers (source, target));
+}
+
+TEST (NodeManagerUpdateTest_ModifyBuiltInNode)
+{
+	NodeManager source;
+	NodePtr sourceNode = source.AddNode (NodePtr (new BI::IntegerUpDownNode (LocString (L"Integer"), NUIE::Point (0.0, 0.0), 5, 1)));
+
+	NodeManager target;
+	NodeManager::Clone (source, target);
+	NodePtr targetNode = target.GetNode (sourceNode->GetId ());
+	ASSERT (Node::IsEqual (sourceNode, targetNode));
+
+	Node::Cast<BI::IntegerUpDownNode> (targetNode)->SetValue (10);
+	ASSERT (!Node::IsEqual (sourceNode, targetNode));
+	Node::Cast<BI::IntegerUpDownNode> (targetNode)->SetStep (2);
+
+	NodeManagerMerge::UpdateNodeManager (source, target, updateHandler);
+	ASSERT (IsEqualNodeManagers (source, target));
+	ASSERT (Node::Cast<BI::IntegerUpDownNode> (target.GetNode (sourceNode->GetId ()))->GetValue () == 5);
+	ASSERT (Node::Cast<BI::IntegerUpDownNode> (target.GetNode (sourceNode->GetId ()))->GetStep () == 1);
+}
+
 }
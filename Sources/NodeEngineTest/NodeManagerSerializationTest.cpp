@@ -110,8 +110,76 @@ private:
 	std::wstring name;
 };
 
+class DirectCloneTestNode : public TestNode
+{
+	DYNAMIC_SERIALIZABLE (DirectCloneTestNode);
+
+public:
+	DirectCloneTestNode () :
+		DirectCloneTestNode (0)
+	{
+
+	}
+
+	DirectCloneTestNode (int val) :
+		TestNode (val)
+	{
+
+	}
+
+	virtual NodePtr CloneNode () const override
+	{
+		return CopyDynamicObject<Node> (this);
+	}
+};
+
+class DerivedDirectCloneTestNode : public DirectCloneTestNode
+{
+	DYNAMIC_SERIALIZABLE (DerivedDirectCloneTestNode);
+
+public:
+	DerivedDirectCloneTestNode () :
+		DerivedDirectCloneTestNode (0, 0)
+	{
+
+	}
+
+	DerivedDirectCloneTestNode (int val, int extraVal) :
+		DirectCloneTestNode (val),
+		extraVal (extraVal)
+	{
+
+	}
+
+	int GetExtraVal () const
+	{
+		return extraVal;
+	}
+
+	virtual Stream::Status Read (InputStream& inputStream) override
+	{
+		ObjectHeader header (inputStream);
+		DirectCloneTestNode::Read (inputStream);
+		inputStream.Read (extraVal);
+		return inputStream.GetStatus ();
+	}
+
+	virtual Stream::Status Write (OutputStream& outputStream) const override
+	{
+		ObjectHeader header (outputStream, serializationInfo);
+		DirectCloneTestNode::Write (outputStream);
+		outputStream.Write (extraVal);
+		return outputStream.GetStatus ();
+	}
+
+private:
+	int extraVal;
+};
+
 DYNAMIC_SERIALIZATION_INFO (TestNode, 1, "{9E0304A4-3B92-4EFA-9846-F0372A633038}");
 DYNAMIC_SERIALIZATION_INFO (TestGroup, 1, "{66E68205-83BF-423F-B2B2-41C356B68125}");
+DYNAMIC_SERIALIZATION_INFO (DirectCloneTestNode, 1, "{4C1B2E53-4A0F-4F0B-9D44-6E3A1A5E8C21}");
+DYNAMIC_SERIALIZATION_INFO (DerivedDirectCloneTestNode, 1, "{B8E0D5B4-7F1C-4F43-8A3D-2C6B9E51F0A7}");
 
 TEST (EmptyNodeManagerSerializationTest)
 {
@@ -181,4 +249,118 @@ TEST (NodeGroupSerializationTest)
 	ASSERT (std::static_pointer_cast<const TestGroup> (target.GetNodeGroup (sourceNode2->GetId ()))->GetName () == L"Test");
 }
 
+TEST (LengthPrefixedSerializationTest)
+{
+	NodeManager source;
+	std::shared_ptr<TestNode> sourceNode1 (new TestNode (1));
+	std::shared_ptr<TestNode> sourceNode2 (new TestNode (2));
+	std::shared_ptr<TestNode> sourceNode3 (new TestNode (3));
+	source.AddNode (sourceNode1);
+	source.AddNode (sourceNode2);
+	source.AddNode (sourceNode3);
+	source.ConnectOutputSlotToInputSlot (sourceNode1->GetOutputSlot (SlotId ("c")), sourceNode3->GetInputSlot (SlotId ("a")));
+	source.ConnectOutputSlotToInputSlot (sourceNode2->GetOutputSlot (SlotId ("c")), sourceNode3->GetInputSlot (SlotId ("b")));
+	NodeGroupPtr testGroup (new TestGroup (L"Test"));
+	source.AddNodeGroup (testGroup);
+	source.AddNodeToGroup (testGroup->GetId (), sourceNode1->GetId ());
+
+	std::vector<char> buffer;
+	ASSERT (NodeManager::WriteToBuffer (source, buffer));
+
+	NodeManager target;
+	ASSERT (NodeManager::ReadFromBuffer (target, buffer));
+	ASSERT (target.GetNodeCount () == 3);
+	ASSERT (target.GetConnectionCount () == 2);
+	ASSERT (std::static_pointer_cast<const TestGroup> (target.GetNodeGroup (sourceNode1->GetId ()))->GetName () == L"Test");
+	ValueConstPtr targetValue = target.GetNode (sourceNode3->GetId ())->Evaluate (EmptyEvaluationEnv);
+	ASSERT (IntValue::Get (targetValue) == 6);
+}
+
+TEST (LengthPrefixedManyNodesSerializationTest)
+{
+	const int nodeCount = 5000;
+
+	NodeManager source;
+	std::vector<NodeId> nodeIds;
+	NodePtr prevNode = nullptr;
+	for (int i = 0; i < nodeCount; i++) {
+		NodePtr node = source.AddNode (NodePtr (new TestNode (1)));
+		if (prevNode != nullptr) {
+			source.ConnectOutputSlotToInputSlot (prevNode->GetOutputSlot (SlotId ("c")), node->GetInputSlot (SlotId ("a")));
+		}
+		nodeIds.push_back (node->GetId ());
+		prevNode = node;
+	}
+
+	MemoryOutputStream outputStream;
+	ASSERT (source.Write (outputStream, NodeManager::NodeRecordMode::LengthPrefixed) == Stream::Status::NoError);
+
+	NodeManager target;
+	MemoryInputStream inputStream (outputStream.GetBuffer ());
+	ASSERT (target.Read (inputStream) == Stream::Status::NoError);
+	ASSERT (target.GetNodeCount () == nodeCount);
+	ASSERT (target.GetConnectionCount () == nodeCount - 1);
+
+	size_t index = 0;
+	bool isOrderKept = true;
+	target.EnumerateNodes ([&] (NodeConstPtr node) {
+		if (node->GetId () != nodeIds[index++]) {
+			isOrderKept = false;
+		}
+		return isOrderKept;
+	});
+	ASSERT (isOrderKept);
+
+	std::shared_ptr<TestNode> lastNode = std::dynamic_pointer_cast<TestNode> (target.GetNode (nodeIds.back ()));
+	ASSERT (lastNode != nullptr);
+	ASSERT (lastNode->GetVal () == 1);
+}
+
+TEST (DirectCloneTest)
+{
+	NodeManager source;
+	NodePtr sourceNode1 = source.AddNode (NodePtr (new DirectCloneTestNode (1)));
+	NodePtr sourceNode2 = source.AddNode (NodePtr (new DirectCloneTestNode (2)));
+	NodePtr sourceNode3 = source.AddNode (NodePtr (new DirectCloneTestNode (3)));
+	source.ConnectOutputSlotToInputSlot (sourceNode1->GetOutputSlot (SlotId ("c")), sourceNode3->GetInputSlot (SlotId ("a")));
+	source.ConnectOutputSlotToInputSlot (sourceNode2->GetOutputSlot (SlotId ("c")), sourceNode3->GetInputSlot (SlotId ("b")));
+	NodeGroupPtr testGroup (new TestGroup (L"Test"));
+	source.AddNodeGroup (testGroup);
+	source.AddNodeToGroup (testGroup->GetId (), sourceNode1->GetId ());
+
+	NodeManager target;
+	ASSERT (NodeManager::Clone (source, target));
+	ASSERT (target.GetNodeCount () == 3);
+	ASSERT (target.GetConnectionCount () == 2);
+	ASSERT (target.GetNodeGroupCount () == 1);
+
+	NodePtr targetNode1 = target.GetNode (sourceNode1->GetId ());
+	NodePtr targetNode3 = target.GetNode (sourceNode3->GetId ());
+	ASSERT (Node::IsType<DirectCloneTestNode> (targetNode3));
+	ASSERT (targetNode3 != sourceNode3);
+	ASSERT (targetNode3->GetInputSlot (SlotId ("a")) != sourceNode3->GetInputSlot (SlotId ("a")));
+	ASSERT (targetNode3->GetInputSlot (SlotId ("a"))->GetOwnerNodeId () == targetNode3->GetId ());
+	ASSERT (target.IsOutputSlotConnectedToInputSlot (targetNode1->GetOutputSlot (SlotId ("c")), targetNode3->GetInputSlot (SlotId ("a"))));
+	ASSERT (!target.IsOutputSlotConnectedToInputSlot (sourceNode1->GetOutputSlot (SlotId ("c")), sourceNode3->GetInputSlot (SlotId ("a"))));
+	ASSERT (std::static_pointer_cast<const TestGroup> (target.GetNodeGroup (sourceNode1->GetId ()))->GetName () == L"Test");
+	ASSERT (IntValue::Get (targetNode3->Evaluate (EmptyEvaluationEnv)) == 6);
+
+	NodePtr newNode = target.AddNode (NodePtr (new DirectCloneTestNode (4)));
+	ASSERT (!source.ContainsNode (newNode->GetId ()));
+	ASSERT (newNode->GetId () != sourceNode1->GetId () && newNode->GetId () != sourceNode2->GetId () && newNode->GetId () != sourceNode3->GetId ());
+}
+
+TEST (DirectCloneDerivedNodeTest)
+{
+	NodeManager source;
+	NodePtr sourceNode = source.AddNode (NodePtr (new DerivedDirectCloneTestNode (1, 2)));
+
+	NodePtr clonedNode = Node::Clone (sourceNode);
+	ASSERT (clonedNode != nullptr);
+	std::shared_ptr<DerivedDirectCloneTestNode> typedClonedNode = Node::Cast<DerivedDirectCloneTestNode> (clonedNode);
+	ASSERT (typedClonedNode != nullptr);
+	ASSERT (typedClonedNode->GetVal () == 1);
+	ASSERT (typedClonedNode->GetExtraVal () == 2);
+}
+
 }
@@ -0,0 +1,279 @@
+#include "SimpleTest.hpp"
+#include "NE_SingleValues.hpp"
+#include "NUIE_SpatialIndex.hpp"
+#include "NUIE_NodeUIManager.hpp"
+#include "NUIE_NodeUIManagerCommands.hpp"
+#include "NUIE_UIItemFinder.hpp"
+#include "TestUtils.hpp"
+#include "TestNodes.hpp"
+
+using namespace NE;
+using namespace NUIE;
+
+namespace NodeSpatialIndexTest
+{
+
+static std::vector<NodeId> QueryNodes (const SpatialIndex<NodeId>& index, const Rect& rect)
+{
+	std::vector<NodeId> result;
+	index.Enumerate (rect, [&] (const NodeId& nodeId) {
+		result.push_back (nodeId);
+		return true;
+	});
+	return result;
+}
+
+static std::vector<NodeId> QueryNodes (const SpatialIndex<NodeId>& index, const Point& point)
+{
+	return QueryNodes (index, Rect::FromPositionAndSize (point, Size (0.0, 0.0)));
+}
+
+static UINodePtr FindNodeUnderPositionLinear (NodeUIManager& uiManager, NodeUIDrawingEnvironment& env, const Point& viewPosition)
+{
+	const ViewBox& viewBox = uiManager.GetViewBox ();
+	UINodePtr foundNode = nullptr;
+	uiManager.EnumerateNodes ([&] (UINodePtr uiNode) {
+		Rect nodeRect = viewBox.ModelToView (uiNode->GetRect (env));
+		if (nodeRect.Contains (viewPosition)) {
+			foundNode = uiNode;
+		}
+		return true;
+	});
+	return foundNode;
+}
+
+static bool HitTestLargeGrid (size_t rowCount)
+{
+	TestUIEnvironment env;
+	NodeUIManager uiManager (env);
+
+	std::vector<UINodePtr> nodes;
+	for (size_t i = 0; i < rowCount; i++) {
+		for (size_t j = 0; j < rowCount; j++) {
+			UINodePtr uiNode (new FixedRectTestUINode (Point (i * 150.0, j * 100.0)));
+			nodes.push_back (uiManager.AddNode (uiNode));
+		}
+	}
+
+	// overlapping node, it is above the first node in the drawing order
+	UINodePtr topNode = uiManager.AddNode (UINodePtr (new FixedRectTestUINode (Point (50.0, 25.0))));
+
+	std::vector<Point> testPoints = {
+		Point (10.0, 10.0),
+		Point (75.0, 40.0),
+		Point (100.0, 50.0),
+		Point (125.0, 20.0),
+		Point (160.0, 110.0),
+		Point (1010.0, 710.0),
+		Point (-10.0, -10.0),
+		Point (rowCount * 150.0 - 60.0, rowCount * 100.0 - 60.0)
+	};
+	for (const Point& point : testPoints) {
+		if (FindNodeUnderPosition (uiManager, env, point) != FindNodeUnderPositionLinear (uiManager, env, point)) {
+			return false;
+		}
+	}
+	if (FindNodeUnderPosition (uiManager, env, Point (75.0, 40.0)) != topNode) {
+		return false;
+	}
+
+	Rect selectionRect = Rect::FromPositionAndSize (Point (140.0, 90.0), Size (470.0, 270.0));
+	size_t nodesInRect = 0;
+	uiManager.EnumerateNodesInRect (env, selectionRect, [&] (const UINodeConstPtr& uiNode) {
+		if (selectionRect.Contains (uiNode->GetRect (env))) {
+			nodesInRect++;
+		}
+		return true;
+	});
+	if (nodesInRect != 9) {
+		return false;
+	}
+
+	UINodePtr lastNode = nodes.back ();
+	Point lastNodeCenter = lastNode->GetRect (env).GetCenter ();
+	UIInputSlotPtr inputSlot = FindInputSlotUnderPosition (uiManager, env, lastNodeCenter - Point (55.0, 0.0));
+	if (inputSlot == nullptr || inputSlot->GetOwnerNodeId () != lastNode->GetId ()) {
+		return false;
+	}
+
+	NodeCollection movedNodes ({ lastNode->GetId () });
+	MoveNodesCommand moveCommand (movedNodes, Point (1000.0, 0.0));
+	uiManager.ExecuteCommand (moveCommand, env);
+	if (FindNodeUnderPosition (uiManager, env, lastNodeCenter) != nullptr) {
+		return false;
+	}
+	if (FindNodeUnderPosition (uiManager, env, lastNodeCenter + Point (1000.0, 0.0)) != lastNode) {
+		return false;
+	}
+
+	UINodePtr firstNode = nodes.front ();
+	NodeId topNodeId = topNode->GetId ();
+	NodeCollection deletedNodes ({ topNodeId });
+	DeleteNodesCommand deleteCommand (env, deletedNodes);
+	uiManager.ExecuteCommand (deleteCommand, env);
+	if (FindNodeUnderPosition (uiManager, env, Point (75.0, 40.0)) != firstNode) {
+		return false;
+	}
+
+	uiManager.Undo (env.GetEvaluationEnv (), env);
+	UINodePtr foundNode = FindNodeUnderPosition (uiManager, env, Point (75.0, 40.0));
+	if (foundNode == nullptr || foundNode->GetId () != topNodeId) {
+		return false;
+	}
+
+	return true;
+}
+
+static std::vector<ConnectionInfo> QueryConnections (const NodeUIManager& uiManager, NodeUIDrawingEnvironment& env, const Rect& rect)
+{
+	std::vector<ConnectionInfo> result;
+	uiManager.EnumerateConnectionsInRect (env, rect, [&] (UIOutputSlotConstPtr outputSlot, UIInputSlotConstPtr inputSlot) {
+		result.push_back (ConnectionInfo (SlotInfo (outputSlot->GetOwnerNodeId (), outputSlot->GetId ()), SlotInfo (inputSlot->GetOwnerNodeId (), inputSlot->GetId ())));
+	});
+	return result;
+}
+
+static bool FindConnection (NodeUIManager& uiManager, NodeUIDrawingEnvironment& env, const Point& point, const UINodePtr& begNode, const UINodePtr& endNode)
+{
+	bool found = false;
+	FindConnectionUnderPosition (uiManager, env, point, [&] (const UIOutputSlotConstPtr& outputSlot, const UIInputSlotConstPtr& inputSlot) {
+		found = outputSlot->GetOwnerNodeId () == begNode->GetId () && inputSlot->GetOwnerNodeId () == endNode->GetId ();
+	});
+	return found;
+}
+
+static bool PickConnectionsInLargeGrid (size_t rowCount)
+{
+	TestUIEnvironment env;
+	NodeUIManager uiManager (env);
+
+	std::vector<std::vector<UINodePtr>> nodes (rowCount);
+	for (size_t i = 0; i < rowCount; i++) {
+		for (size_t j = 0; j < rowCount; j++) {
+			UINodePtr uiNode (new FixedRectTestUINode (Point (i * 150.0, j * 100.0)));
+			nodes[i].push_back (uiManager.AddNode (uiNode));
+		}
+	}
+	for (size_t i = 1; i < rowCount; i++) {
+		for (size_t j = 0; j < rowCount; j++) {
+			uiManager.ConnectOutputSlotToInputSlot (nodes[i - 1][j]->GetUIOutputSlot (SlotId ("out")), nodes[i][j]->GetUIInputSlot (SlotId ("in")));
+		}
+	}
+
+	// long connection across the whole grid
+	UINodePtr longBegNode = nodes[rowCount - 1][0];
+	UINodePtr longEndNode = nodes[0][rowCount - 1];
+	uiManager.ConnectOutputSlotToInputSlot (longBegNode->GetUIOutputSlot (SlotId ("out")), longEndNode->GetUIInputSlot (SlotId ("in")));
+
+	std::vector<ConnectionInfo> allConnections;
+	uiManager.EnumerateNodes ([&] (UINodeConstPtr uiNode) {
+		uiNode->EnumerateUIOutputSlots ([&] (UIOutputSlotConstPtr outputSlot) {
+			uiManager.EnumerateConnectedUIInputSlots (outputSlot, [&] (UIInputSlotConstPtr inputSlot) {
+				allConnections.push_back (ConnectionInfo (SlotInfo (uiNode->GetId (), outputSlot->GetId ()), SlotInfo (inputSlot->GetOwnerNodeId (), inputSlot->GetId ())));
+			});
+			return true;
+		});
+		return true;
+	});
+	if (allConnections.size () != rowCount * (rowCount - 1) + 1) {
+		return false;
+	}
+	Rect documentRect = Rect::FromPositionAndSize (Point (-1000.0, -1000.0), Size (rowCount * 150.0 + 2000.0, rowCount * 100.0 + 2000.0));
+	if (QueryConnections (uiManager, env, documentRect) != allConnections) {
+		return false;
+	}
+	std::vector<ConnectionInfo> nearConnections = QueryConnections (uiManager, env, Rect::FromCenterAndSize (Point (125.0, 25.0), Size (10.0, 10.0)));
+	if (nearConnections.size () > 5 || std::find (nearConnections.begin (), nearConnections.end (), allConnections.front ()) == nearConnections.end ()) {
+		return false;
+	}
+
+	if (!FindConnection (uiManager, env, Point (125.0, 25.0), nodes[0][0], nodes[1][0])) {
+		return false;
+	}
+	if (FindConnection (uiManager, env, Point (125.0, 60.0), nodes[0][0], nodes[1][0])) {
+		return false;
+	}
+	Point longMidPoint ((rowCount - 1) * 75.0 + 50.0, (rowCount - 1) * 50.0 + 25.0);
+	if (!FindConnection (uiManager, env, longMidPoint, longBegNode, longEndNode)) {
+		return false;
+	}
+
+	NodeCollection movedNodes ({ nodes[1][0]->GetId () });
+	MoveNodesCommand moveCommand (movedNodes, Point (0.0, 1050.0));
+	uiManager.ExecuteCommand (moveCommand, env);
+	if (!FindConnection (uiManager, env, Point (125.0, 550.0), nodes[0][0], nodes[1][0])) {
+		return false;
+	}
+	if (!FindConnection (uiManager, env, Point (275.0, 550.0), nodes[1][0], nodes[2][0])) {
+		return false;
+	}
+
+	uiManager.DisconnectOutputSlotFromInputSlot (nodes[0][0]->GetUIOutputSlot (SlotId ("out")), nodes[1][0]->GetUIInputSlot (SlotId ("in")));
+	if (FindConnection (uiManager, env, Point (125.0, 550.0), nodes[0][0], nodes[1][0])) {
+		return false;
+	}
+
+	NodeCollection deletedNodes ({ longEndNode->GetId () });
+	DeleteNodesCommand deleteCommand (env, deletedNodes);
+	uiManager.ExecuteCommand (deleteCommand, env);
+	if (FindConnection (uiManager, env, longMidPoint, longBegNode, longEndNode)) {
+		return false;
+	}
+	if (QueryConnections (uiManager, env, documentRect).size () != allConnections.size () - 3) {
+		return false;
+	}
+
+	return true;
+}
+
+TEST (NodeSpatialIndexQueryTest)
+{
+	SpatialIndex<NodeId> index;
+	index.Insert (NodeId (1), Rect::FromPositionAndSize (Point (0.0, 0.0), Size (100.0, 100.0)));
+	index.Insert (NodeId (2), Rect::FromPositionAndSize (Point (50.0, 50.0), Size (100.0, 100.0)));
+	index.Insert (NodeId (3), Rect::FromPositionAndSize (Point (1000.0, 1000.0), Size (10.0, 10.0)));
+	index.Insert (NodeId (4), Rect::FromPositionAndSize (Point (-600.0, -600.0), Size (100.0, 100.0)));
+	ASSERT (index.Count () == 4);
+
+	ASSERT (QueryNodes (index, Point (60.0, 60.0)) == std::vector<NodeId> ({ NodeId (1), NodeId (2) }));
+	ASSERT (QueryNodes (index, Point (100.0, 0.0)) == std::vector<NodeId> ({ NodeId (1) }));
+	ASSERT (QueryNodes (index, Point (-550.0, -550.0)) == std::vector<NodeId> ({ NodeId (4) }));
+	ASSERT (QueryNodes (index, Point (500.0, 500.0)).empty ());
+
+	index.Insert (NodeId (1), Rect::FromPositionAndSize (Point (2000.0, 2000.0), Size (100.0, 100.0)));
+	ASSERT (QueryNodes (index, Point (60.0, 60.0)) == std::vector<NodeId> ({ NodeId (2) }));
+	ASSERT (QueryNodes (index, Rect::FromPositionAndSize (Point (-1000.0, -1000.0), Size (5000.0, 5000.0))) == std::vector<NodeId> ({ NodeId (1), NodeId (2), NodeId (3), NodeId (4) }));
+
+	index.Erase (NodeId (2));
+	ASSERT (!index.Contains (NodeId (2)));
+	ASSERT (QueryNodes (index, Point (60.0, 60.0)).empty ());
+
+	index.Insert (NodeId (5), Rect::FromPositionAndSize (Point (-100000.0, -100000.0), Size (200000.0, 200000.0)));
+	ASSERT (QueryNodes (index, Point (60.0, 60.0)) == std::vector<NodeId> ({ NodeId (5) }));
+	ASSERT (QueryNodes (index, Rect::FromPositionAndSize (Point (900.0, 900.0), Size (1500.0, 1500.0))) == std::vector<NodeId> ({ NodeId (1), NodeId (3), NodeId (5) }));
+
+	std::vector<NodeId> withAdditionalNodes;
+	index.Enumerate (Rect::FromPositionAndSize (Point (60.0, 60.0), Size (0.0, 0.0)), { NodeId (5), NodeId (4) }, [&] (const NodeId& nodeId) {
+		withAdditionalNodes.push_back (nodeId);
+		return true;
+	});
+	ASSERT (withAdditionalNodes == std::vector<NodeId> ({ NodeId (4), NodeId (5) }));
+
+	index.Clear ();
+	ASSERT (index.IsEmpty ());
+	ASSERT (QueryNodes (index, Point (60.0, 60.0)).empty ());
+}
+
+TEST (NodeSpatialIndexLargeGridTest)
+{
+	ASSERT (HitTestLargeGrid (10));
+	ASSERT (HitTestLargeGrid (100));
+}
+
+TEST (ConnectionSpatialIndexLargeGridTest)
+{
+	ASSERT (PickConnectionsInLargeGrid (10));
+	ASSERT (PickConnectionsInLargeGrid (100));
+}
+
+}
@@ -24,6 +24,38 @@ static std::vector<std::string> GetEnumeratedValues (const OrderedMap<int, std::
 	return enumeratedValues;
 }
 
+static bool EnumerateAndLookupLargeMap (size_t count)
+{
+	OrderedMap<size_t, size_t> map;
+	for (size_t i = 0; i < count; i++) {
+		map.Insert (i, i * 2);
+	}
+	for (size_t i = 0; i < count; i += 2) {
+		map.Erase (i);
+	}
+
+	size_t expected = 1;
+	bool isOrdered = true;
+	map.Enumerate ([&] (const size_t& value) {
+		isOrdered = isOrdered && value == expected * 2;
+		expected += 2;
+		return true;
+	});
+	if (!isOrdered || map.Count () != count / 2) {
+		return false;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		if (map.Contains (i) != (i % 2 == 1)) {
+			return false;
+		}
+		if (i % 2 == 1 && map.GetValue (i) != i * 2) {
+			return false;
+		}
+	}
+	return true;
+}
+
 TEST (OrderedMapEmptyTest)
 {
 	OrderedMap<int, std::string> map;
@@ -229,4 +261,80 @@ TEST (OrderedMapMakeSortedTest)
 	ASSERT (GetEnumeratedValues (map) == std::vector<std::string> ({ "one", "two", "three", "four", "five" }));
 }
 
+TEST (OrderedMapEraseDuringEnumerationTest)
+{
+	OrderedMap<int, std::string> map;
+	ASSERT (map.Insert (1, "one"));
+	ASSERT (map.Insert (2, "two"));
+	ASSERT (map.Insert (3, "three"));
+	std::vector<std::string> enumeratedValues;
+	map.Enumerate ([&] (const std::string& value) {
+		enumeratedValues.push_back (value);
+		if (value == "one") {
+			map.Erase (2);
+		}
+		return true;
+	});
+	ASSERT (enumeratedValues == std::vector<std::string> ({ "one", "three" }));
+}
+
+TEST (OrderedMapEraseInsertDuringEnumerationTest)
+{
+	OrderedMap<int, std::string> map;
+	ASSERT (map.Insert (1, "one"));
+	ASSERT (map.Insert (2, "two"));
+	ASSERT (map.Insert (3, "three"));
+	ASSERT (map.Insert (4, "four"));
+	std::vector<std::string> enumeratedValues;
+	map.Enumerate ([&] (const std::string& value) {
+		enumeratedValues.push_back (value);
+		if (value == "three") {
+			// would trigger compaction without the running enumeration
+			map.Erase (1);
+			map.Erase (2);
+			map.Erase (3);
+			map.Insert (5, "five");
+		}
+		return true;
+	});
+	ASSERT (enumeratedValues == std::vector<std::string> ({ "one", "two", "three", "four", "five" }));
+	ASSERT (GetEnumeratedValues (map) == std::vector<std::string> ({ "four", "five" }));
+	ASSERT (map.Insert (6, "six"));
+	ASSERT (GetEnumeratedValues (map) == std::vector<std::string> ({ "four", "five", "six" }));
+	ASSERT (map.GetValue (4) == "four");
+	ASSERT (map.GetValue (5) == "five");
+	ASSERT (map.GetValue (6) == "six");
+}
+
+TEST (OrderedMapEraseInsertCompactionTest)
+{
+	OrderedMap<int, std::string> map;
+	ASSERT (map.Insert (1, "one"));
+	ASSERT (map.Insert (2, "two"));
+	ASSERT (map.Insert (3, "three"));
+	ASSERT (map.Insert (4, "four"));
+	ASSERT (map.Erase (1));
+	ASSERT (map.Erase (3));
+	ASSERT (map.Erase (4));
+	ASSERT (map.Insert (5, "five"));
+	ASSERT (map.InsertBefore (6, "six", 2));
+	ASSERT (map.InsertAfter (7, "seven", 2));
+	ASSERT (GetEnumeratedValues (map) == std::vector<std::string> ({ "six", "two", "seven", "five" }));
+	ASSERT (map.GetValue (2) == "two");
+	ASSERT (map.GetValue (5) == "five");
+	ASSERT (map.GetValue (6) == "six");
+	ASSERT (map.GetValue (7) == "seven");
+	ASSERT (map.Insert (1, "one"));
+	ASSERT (GetEnumeratedValues (map) == std::vector<std::string> ({ "six", "two", "seven", "five", "one" }));
+
+	OrderedMap<int, std::string> map2 = map;
+	map2.MakeSorted ();
+	ASSERT (GetEnumeratedValues (map2) == std::vector<std::string> ({ "one", "two", "five", "six", "seven" }));
+}
+
+TEST (OrderedMapLargeEnumerationAndLookupTest)
+{
+	ASSERT (EnumerateAndLookupLargeMap (1000));
+}
+
 }
@@ -0,0 +1,166 @@
+#include "SimpleTest.hpp"
+#include "NUIE_ParallelDrawingImageBuilder.hpp"
+#include "NUIE_NodeUIManager.hpp"
+#include "BI_InputUINodes.hpp"
+#include "BI_BinaryOperationNodes.hpp"
+#include "BI_ViewerUINodes.hpp"
+#include "TestUtils.hpp"
+
+#include <vector>
+
+using namespace NE;
+using namespace NUIE;
+using namespace BI;
+
+namespace ParallelDrawingImageTest
+{
+
+class SerialMeasureDrawingContext : public NullDrawingContext
+{
+public:
+	SerialMeasureDrawingContext () :
+		NullDrawingContext (),
+		measureCount (0)
+	{
+
+	}
+
+	virtual Size MeasureText (const Font& font, const std::wstring& text) override
+	{
+		measureCount++;
+		return Size (text.length () * font.GetSize () * 0.5, font.GetSize ());
+	}
+
+	virtual bool CanMeasureTextConcurrently () override
+	{
+		return false;
+	}
+
+	size_t measureCount;
+};
+
+class MeasureUIEnvironment : public TestUIEnvironment
+{
+public:
+	MeasureUIEnvironment () :
+		TestUIEnvironment (),
+		context ()
+	{
+
+	}
+
+	virtual DrawingContext& GetDrawingContext () override
+	{
+		return context;
+	}
+
+	SerialMeasureDrawingContext context;
+};
+
+static std::vector<UINodeConstPtr> AddNodes (NodeUIManager& uiManager, size_t count)
+{
+	std::vector<UINodeConstPtr> uiNodes;
+	for (size_t i = 0; i < count; i++) {
+		Point position ((i % 10) * 200.0, (i / 10) * 100.0);
+		UINodePtr uiNode = nullptr;
+		if (i % 3 == 0) {
+			uiNode = UINodePtr (new IntegerUpDownNode (LocString (L"Integer"), position, (int) i, 1));
+		} else if (i % 3 == 1) {
+			uiNode = UINodePtr (new AdditionNode (LocString (L"Addition"), position));
+		} else {
+			uiNode = UINodePtr (new ViewerNode (LocString (L"Viewer"), position));
+		}
+		uiNodes.push_back (uiManager.AddNode (uiNode));
+	}
+	return uiNodes;
+}
+
+static std::vector<Rect> GetNodeRects (NodeUIDrawingEnvironment& env, const std::vector<UINodeConstPtr>& uiNodes)
+{
+	std::vector<Rect> rects;
+	for (const UINodeConstPtr& uiNode : uiNodes) {
+		rects.push_back (uiNode->GetRect (env));
+	}
+	return rects;
+}
+
+TEST (ParallelDrawingImageBuildTest)
+{
+	MeasureUIEnvironment env;
+	NodeUIManager uiManager (env);
+	std::vector<UINodeConstPtr> uiNodes = AddNodes (uiManager, 300);
+	uiManager.Update (env);
+
+	env.context.measureCount = 0;
+	BuildNodeDrawingImages (env, uiNodes, 1);
+	size_t serialMeasureCount = env.context.measureCount;
+	std::vector<Rect> serialRects = GetNodeRects (env, uiNodes);
+	ASSERT (serialMeasureCount > 0);
+
+	uiManager.InvalidateAllNodesDrawing ();
+	for (const UINodeConstPtr& uiNode : uiNodes) {
+		ASSERT (!uiNode->HasDrawingImage ());
+	}
+
+	env.context.measureCount = 0;
+	BuildNodeDrawingImages (env, uiNodes, 4);
+	for (const UINodeConstPtr& uiNode : uiNodes) {
+		ASSERT (uiNode->HasDrawingImage ());
+	}
+	ASSERT (env.context.measureCount == serialMeasureCount);
+
+	std::vector<Rect> parallelRects = GetNodeRects (env, uiNodes);
+	ASSERT (env.context.measureCount == serialMeasureCount);
+	ASSERT (parallelRects.size () == serialRects.size ());
+	for (size_t i = 0; i < serialRects.size (); i++) {
+		ASSERT (parallelRects[i] == serialRects[i]);
+	}
+}
+
+TEST (DrawBuildsMissingDrawingImagesTest)
+{
+	MeasureUIEnvironment env;
+	NodeUIManager uiManager (env);
+	std::vector<UINodeConstPtr> uiNodes = AddNodes (uiManager, 20);
+	UINodePtr farNode = uiManager.AddNode (UINodePtr (new ViewerNode (LocString (L"Viewer"), Point (100000.0, 100000.0))));
+	uiManager.Update (env);
+	farNode->SetLocalRectsHint (Rect (0.0, 0.0, 100.0, 50.0), Rect (-5.0, 0.0, 110.0, 50.0));
+
+	EmptyDrawingModifier drawModifier;
+	uiManager.Draw (env, &drawModifier);
+	for (const UINodeConstPtr& uiNode : uiNodes) {
+		ASSERT (uiNode->HasDrawingImage ());
+	}
+	ASSERT (!farNode->HasDrawingImage ());
+}
+
+TEST (DrawBuildsOnlyChangedDrawingImagesTest)
+{
+	MeasureUIEnvironment env;
+	NodeUIManager uiManager (env);
+	std::vector<UINodeConstPtr> uiNodes = AddNodes (uiManager, 20);
+	uiManager.Update (env);
+
+	auto getOutdatedNodeCount = [&] () {
+		size_t count = 0;
+		uiManager.EnumerateNodesWithOutdatedRect ([&] (UINodeConstPtr) {
+			count++;
+			return true;
+		});
+		return count;
+	};
+
+	EmptyDrawingModifier drawModifier;
+	ASSERT (getOutdatedNodeCount () == uiNodes.size ());
+	uiManager.Draw (env, &drawModifier);
+	ASSERT (getOutdatedNodeCount () == 0);
+
+	uiManager.InvalidateNodeDrawing (uiNodes[2]->GetId ());
+	ASSERT (!uiNodes[2]->HasDrawingImage ());
+	ASSERT (getOutdatedNodeCount () == 1);
+	uiManager.Draw (env, &drawModifier);
+	ASSERT (uiNodes[2]->HasDrawingImage ());
+	ASSERT (getOutdatedNodeCount () == 0);
+}
+
+}
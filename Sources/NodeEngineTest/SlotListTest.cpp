@@ -1,5 +1,8 @@
 #include "SimpleTest.hpp"
 #include "NE_SlotList.hpp"
+#include "NE_MemoryStream.hpp"
+
+#include <thread>
 
 using namespace NE;
 
@@ -93,4 +96,74 @@ TEST (SlotListInsertAfterTestEnd)
 	ASSERT (slotIds == std::vector<NE::SlotId> ({ NE::SlotId ("a"), NE::SlotId ("b"), NE::SlotId ("c"), NE::SlotId ("d") }));
 }
 
+TEST (SlotIdInternTest)
+{
+	NE::SlotId a1 ("a");
+	NE::SlotId a2 (std::string ("a"));
+	NE::SlotId b ("b");
+	ASSERT (a1 == a2);
+	ASSERT (a1 != b);
+	ASSERT (a1.GenerateHashValue () == a2.GenerateHashValue ());
+	ASSERT (a1 < b);
+	ASSERT (b > a1);
+	ASSERT (NE::SlotId () == NE::NullSlotId);
+	ASSERT (NE::SlotId ("") == NE::NullSlotId);
+}
+
+TEST (SlotIdInternThreadTest)
+{
+	NE::SlotId mainSlotId ("thread");
+	NE::SlotId threadSlotId;
+	NE::SlotId threadOnlySlotId;
+	std::thread thread ([&] () {
+		threadSlotId = NE::SlotId ("thread");
+		threadOnlySlotId = NE::SlotId ("threadonly");
+	});
+	thread.join ();
+	ASSERT (threadSlotId == mainSlotId);
+	ASSERT (threadOnlySlotId == NE::SlotId ("threadonly"));
+	ASSERT (threadOnlySlotId != mainSlotId);
+}
+
+TEST (SlotIdInternManyThreadsTest)
+{
+	// enough ids to grow the atom table while the other threads read it
+	const size_t idCount = 2000;
+	std::vector<std::vector<NE::SlotId>> threadSlotIds (4);
+	std::vector<std::thread> threads;
+	for (std::vector<NE::SlotId>& slotIds : threadSlotIds) {
+		threads.push_back (std::thread ([&] () {
+			for (size_t i = 0; i < idCount; i++) {
+				slotIds.push_back (NE::SlotId ("many" + std::to_string (i)));
+			}
+		}));
+	}
+	for (std::thread& thread : threads) {
+		thread.join ();
+	}
+	for (size_t i = 0; i < idCount; i++) {
+		NE::SlotId slotId ("many" + std::to_string (i));
+		for (const std::vector<NE::SlotId>& slotIds : threadSlotIds) {
+			ASSERT (slotIds[i] == slotId);
+		}
+	}
+}
+
+TEST (SlotIdSerializationTest)
+{
+	MemoryOutputStream outputStream;
+	ASSERT (NE::SlotId ("slot").Write (outputStream) == Stream::Status::NoError);
+
+	MemoryInputStream inputStream (outputStream.GetBuffer ());
+	NE::SlotId readSlotId;
+	ASSERT (readSlotId.Read (inputStream) == Stream::Status::NoError);
+	ASSERT (readSlotId == NE::SlotId ("slot"));
+
+	MemoryInputStream stringInputStream (outputStream.GetBuffer ());
+	ObjectHeader header (stringInputStream);
+	std::string readString;
+	stringInputStream.Read (readString);
+	ASSERT (readString == "slot");
+}
+
 }
@@ -0,0 +1,187 @@
+#include "SimpleTest.hpp"
+#include "NUIE_SoftwareDrawingContext.hpp"
+#include "NUIE_NodeUIManager.hpp"
+#include "NUIE_SkinParams.hpp"
+#include "BI_InputUINodes.hpp"
+#include "BI_ViewerUINodes.hpp"
+#include "TestUtils.hpp"
+
+#include <string>
+
+using namespace NE;
+using namespace NUIE;
+using namespace BI;
+
+namespace SoftwareDrawingContextTest
+{
+
+static const Color White (255, 255, 255);
+static const Color Red (255, 0, 0);
+static const Color Blue (0, 0, 255);
+
+static size_t CountPixels (const SoftwareDrawingContext& context, const Color& color)
+{
+	size_t count = 0;
+	for (int y = 0; y < context.GetHeight (); y++) {
+		for (int x = 0; x < context.GetWidth (); x++) {
+			if (context.GetPixel (x, y) == color) {
+				count++;
+			}
+		}
+	}
+	return count;
+}
+
+class SoftwareUIEnvironment : public TestUIEnvironment
+{
+public:
+	SoftwareUIEnvironment () :
+		TestUIEnvironment (),
+		context (400, 300)
+	{
+
+	}
+
+	virtual DrawingContext& GetDrawingContext () override
+	{
+		return context;
+	}
+
+	SoftwareDrawingContext context;
+};
+
+TEST (SoftwareContextFillTest)
+{
+	SoftwareDrawingContext context (20, 10);
+	ASSERT (context.GetPixel (0, 0) == White);
+
+	context.FillRect (Rect (2.0, 3.0, 4.0, 5.0), Red);
+	ASSERT (CountPixels (context, Red) == 20);
+	ASSERT (context.GetPixel (2, 3) == Red);
+	ASSERT (context.GetPixel (5, 7) == Red);
+	ASSERT (context.GetPixel (6, 7) == White);
+	ASSERT (context.GetPixel (5, 8) == White);
+
+	context.FillRect (Rect (-100.0, -100.0, 1000.0, 1000.0), Blue);
+	ASSERT (CountPixels (context, Blue) == 200);
+
+	context.Resize (5, 5);
+	ASSERT (CountPixels (context, White) == 25);
+}
+
+TEST (SoftwareContextClipTest)
+{
+	SoftwareDrawingContext context (20, 10);
+	ASSERT (context.CanClip ());
+	context.SetClipRect (Rect (5.0, 0.0, 5.0, 10.0));
+	context.FillRect (Rect (0.0, 0.0, 20.0, 10.0), Red);
+	ASSERT (CountPixels (context, Red) == 50);
+	ASSERT (context.GetPixel (4, 0) == White);
+	ASSERT (context.GetPixel (10, 0) == White);
+
+	context.ResetClipRect ();
+	context.FillRect (Rect (0.0, 0.0, 20.0, 10.0), Blue);
+	ASSERT (CountPixels (context, Blue) == 200);
+}
+
+TEST (SoftwareContextShapesTest)
+{
+	SoftwareDrawingContext context (100, 100);
+	context.DrawLine (Point (10.0, 10.5), Point (20.0, 10.5), Pen (Red, 1.0));
+	ASSERT (context.GetPixel (10, 10) == Red);
+	ASSERT (context.GetPixel (15, 10) == Red);
+	ASSERT (context.GetPixel (15, 9) == White);
+	ASSERT (context.GetPixel (15, 11) == White);
+
+	context.Clear (White);
+	context.DrawLine (Point (10.0, 10.0), Point (90.0, 90.0), Pen (Red, 1.0));
+	for (int i = 12; i < 88; i++) {
+		ASSERT (context.GetPixel (i, i) == Red);
+	}
+	ASSERT (context.GetPixel (80, 20) == White);
+
+	context.Clear (White);
+	context.DrawBezier (Point (10.0, 50.0), Point (40.0, 50.0), Point (60.0, 50.0), Point (90.0, 50.0), Pen (Blue, 3.0));
+	ASSERT (context.GetPixel (50, 50) == Blue);
+	ASSERT (context.GetPixel (50, 48) == Blue);
+	ASSERT (context.GetPixel (50, 45) == White);
+
+	context.Clear (White);
+	context.FillEllipse (Rect (20.0, 20.0, 60.0, 60.0), Red);
+	ASSERT (context.GetPixel (50, 50) == Red);
+	ASSERT (context.GetPixel (21, 21) == White);
+	context.DrawEllipse (Rect (20.0, 20.0, 60.0, 60.0), Pen (Blue, 2.0));
+	ASSERT (context.GetPixel (50, 50) == Red);
+	ASSERT (context.GetPixel (50, 20) == Blue);
+
+	context.Clear (White);
+	context.DrawRect (Rect (20.0, 20.0, 60.0, 60.0), Pen (Blue, 2.0));
+	ASSERT (context.GetPixel (20, 50) == Blue);
+	ASSERT (context.GetPixel (79, 50) == Blue);
+	ASSERT (context.GetPixel (50, 50) == White);
+}
+
+TEST (SoftwareContextTextTest)
+{
+	SoftwareDrawingContext context (100, 40);
+	Font font (L"Arial", 16.0);
+	ASSERT (context.MeasureText (font, L"Text") == Size (48.0, 16.0));
+
+	Rect textRect (10.0, 10.0, 60.0, 20.0);
+	context.DrawFormattedText (textRect, font, L"Text", HorizontalAnchor::Center, VerticalAnchor::Center, Red);
+	ASSERT (CountPixels (context, Red) > 0);
+	for (int y = 0; y < context.GetHeight (); y++) {
+		for (int x = 0; x < context.GetWidth (); x++) {
+			if (context.GetPixel (x, y) == Red) {
+				ASSERT (textRect.Contains (Point (x + 0.5, y + 0.5)));
+			}
+		}
+	}
+
+	context.Clear (White);
+	context.DrawFormattedText (Rect (0.0, 0.0, 10.0, 10.0), font, L"Long text", HorizontalAnchor::Left, VerticalAnchor::Top, Red);
+	ASSERT (context.GetPixel (12, 2) == White);
+}
+
+TEST (SoftwareContextEncodeTest)
+{
+	SoftwareDrawingContext context (4, 3);
+	context.FillRect (Rect (0.0, 0.0, 1.0, 1.0), Red);
+
+	std::vector<char> ppm;
+	context.EncodePpm (ppm);
+	std::string ppmHeader = "P6\n4 3\n255\n";
+	ASSERT (ppm.size () == ppmHeader.length () + 4 * 3 * 3);
+	ASSERT (std::string (ppm.begin (), ppm.begin () + ppmHeader.length ()) == ppmHeader);
+	ASSERT ((unsigned char) ppm[ppmHeader.length ()] == 255);
+	ASSERT ((unsigned char) ppm[ppmHeader.length () + 1] == 0);
+
+	std::vector<char> png;
+	context.EncodePng (png);
+	ASSERT (png.size () > 8);
+	ASSERT ((unsigned char) png[0] == 0x89);
+	ASSERT (std::string (png.begin () + 1, png.begin () + 4) == "PNG");
+	ASSERT (std::string (png.begin () + 12, png.begin () + 16) == "IHDR");
+	ASSERT (png[19] == 4);
+	ASSERT (png[23] == 3);
+	ASSERT (std::string (png.end () - 8, png.end () - 4) == "IEND");
+}
+
+TEST (SoftwareContextNodeEditorTest)
+{
+	SoftwareUIEnvironment env;
+	NodeUIManager uiManager (env);
+	UINodePtr inputNode = uiManager.AddNode (UINodePtr (new IntegerUpDownNode (LocString (L"Integer"), Point (50.0, 50.0), 5, 1)));
+	UINodePtr viewerNode = uiManager.AddNode (UINodePtr (new MultiLineViewerNode (LocString (L"Viewer"), Point (250.0, 100.0), 5)));
+	uiManager.ConnectOutputSlotToInputSlot (inputNode->GetUIOutputSlot (SlotId ("out")), viewerNode->GetUIInputSlot (SlotId ("in")));
+	uiManager.Update (env);
+
+	EmptyDrawingModifier drawModifier;
+	uiManager.Draw (env, &drawModifier);
+	ASSERT (CountPixels (env.context, White) < 400 * 300);
+	ASSERT (!Rect::IsOverlapping (inputNode->GetRect (env), viewerNode->GetRect (env)));
+	Point inputCenter = inputNode->GetRect (env).GetCenter ();
+	ASSERT (env.context.GetPixel ((int) inputCenter.GetX (), (int) inputCenter.GetY ()) != env.GetSkinParams ().GetBackgroundColor ());
+}
+
+}
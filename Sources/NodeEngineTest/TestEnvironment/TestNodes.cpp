@@ -1,7 +1,9 @@
 #include "TestNodes.hpp"
+#include "NE_SingleValues.hpp"
 
 DYNAMIC_SERIALIZATION_INFO (SerializableTestNode, 1, "{73A78FBB-6563-4009-A1B2-7DF56900F522}");
 DYNAMIC_SERIALIZATION_INFO (SerializableTestUINode, 1, "{93A78362-DFD9-46CB-B9F3-2F2DA9E1F964}");
+DYNAMIC_SERIALIZATION_INFO (FixedRectTestUINode, 1, "{2E28A155-2B95-4284-92ED-E2D93DC14C11}");
 
 SerializableTestNode::SerializableTestNode () :
 	Node ()
@@ -71,3 +73,38 @@ Stream::Status SerializableTestUINode::Write (OutputStream& outputStream) const
 	UINode::Write (outputStream);
 	return Stream::Status::NoError;
 }
+
+FixedRectTestUINode::FixedRectTestUINode () :
+	FixedRectTestUINode (Point ())
+{
+
+}
+
+FixedRectTestUINode::FixedRectTestUINode (const Point& nodePosition) :
+	UINode (LocString (L"Test Node"), nodePosition)
+{
+
+}
+
+void FixedRectTestUINode::Initialize ()
+{
+	RegisterUIInputSlot (UIInputSlotPtr (new UIInputSlot (SlotId ("in"), LocString (L"Input"), ValuePtr (new IntValue (0)), OutputSlotConnectionMode::Single)));
+	RegisterUIOutputSlot (UIOutputSlotPtr (new UIOutputSlot (SlotId ("out"), LocString (L"Output"))));
+}
+
+ValueConstPtr FixedRectTestUINode::Calculate (NE::EvaluationEnv&) const
+{
+	return ValuePtr (new IntValue (0));
+}
+
+void FixedRectTestUINode::UpdateDrawingImage (NodeUIDrawingEnvironment&, NodeDrawingImage& drawingImage) const
+{
+	// the size does not depend on the environment, and the text is the only item hidden in preview
+	Rect nodeRect = Rect::FromPositionAndSize (Point (0.0, 0.0), Size (100.0, 50.0));
+	drawingImage.AddItem (DrawingItemConstPtr (new DrawingFillRect (nodeRect, Color (0, 0, 0))));
+	drawingImage.AddItem (DrawingItemConstPtr (new DrawingText (nodeRect, Font (L"Arial", 10.0), L"Test Node", HorizontalAnchor::Center, VerticalAnchor::Center, Color (0, 0, 0))), DrawingContext::ItemPreviewMode::HideInPreview);
+	drawingImage.SetNodeRect (nodeRect);
+	drawingImage.SetExtendedNodeRect (nodeRect.Expand (Size (20.0, 0.0)));
+	drawingImage.AddInputSlotConnPosition (SlotId ("in"), nodeRect.GetLeftCenter ());
+	drawingImage.AddOutputSlotConnPosition (SlotId ("out"), nodeRect.GetRightCenter ());
+}
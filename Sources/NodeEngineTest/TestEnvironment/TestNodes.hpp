@@ -36,4 +36,17 @@ public:
 	virtual NE::Stream::Status	Write (NE::OutputStream& outputStream) const override;
 };
 
+class FixedRectTestUINode : public UINode
+{
+	DYNAMIC_SERIALIZABLE (FixedRectTestUINode);
+
+public:
+	FixedRectTestUINode ();
+	FixedRectTestUINode (const Point& nodePosition);
+
+	virtual void				Initialize () override;
+	virtual ValueConstPtr		Calculate (NE::EvaluationEnv&) const override;
+	virtual void				UpdateDrawingImage (NodeUIDrawingEnvironment& env, NodeDrawingImage& drawingImage) const override;
+};
+
 #endif
@@ -92,3 +92,39 @@ void TestUIEnvironment::OnIncompatibleVersionPasted (const Version&)
 {
 
 }
+
+EmptyDrawingModifier::EmptyDrawingModifier () :
+	NodeDrawingModifier ()
+{
+
+}
+
+void EmptyDrawingModifier::EnumerateSelectionRectangles (const std::function<void (const Rect&)>&) const
+{
+
+}
+
+void EmptyDrawingModifier::EnumerateTemporaryConnections (const std::function<void (const Point&, const Point&, Direction)>&) const
+{
+
+}
+
+void EmptyDrawingModifier::EnumerateDuplicatedNodes (const std::function<void (const NE::NodeId&, const Point&)>&) const
+{
+
+}
+
+bool EmptyDrawingModifier::NeedToDrawConnection (const NE::NodeId&, const NE::SlotId&, const NE::NodeId&, const NE::SlotId&) const
+{
+	return true;
+}
+
+Point EmptyDrawingModifier::GetNodeOffset (const NE::NodeId&) const
+{
+	return Point (0.0, 0.0);
+}
+
+void EmptyDrawingModifier::EnumerateOffsetNodes (const std::function<void (const NE::NodeId&)>&) const
+{
+
+}
@@ -4,6 +4,7 @@
 #include "NUIE_EventHandler.hpp"
 #include "NUIE_ClipboardHandler.hpp"
 #include "NUIE_NodeUIEnvironment.hpp"
+#include "NUIE_NodeDrawingModifier.hpp"
 
 using namespace NE;
 using namespace NUIE;
@@ -38,4 +39,17 @@ private:
 	NUIE::MemoryClipboardHandler		clipboardHandler;
 };
 
+class EmptyDrawingModifier : public NodeDrawingModifier
+{
+public:
+	EmptyDrawingModifier ();
+
+	virtual void	EnumerateSelectionRectangles (const std::function<void (const Rect&)>& processor) const override;
+	virtual void	EnumerateTemporaryConnections (const std::function<void (const Point&, const Point&, Direction)>& processor) const override;
+	virtual void	EnumerateDuplicatedNodes (const std::function<void (const NE::NodeId&, const Point&)>& processor) const override;
+	virtual bool	NeedToDrawConnection (const NE::NodeId& outputNodeId, const NE::SlotId& outputSlotId, const NE::NodeId& inputNodeId, const NE::SlotId& inputSlotId) const override;
+	virtual Point	GetNodeOffset (const NE::NodeId& nodeId) const override;
+	virtual void	EnumerateOffsetNodes (const std::function<void (const NE::NodeId&)>& processor) const override;
+};
+
 #endif
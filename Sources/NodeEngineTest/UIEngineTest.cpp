@@ -9,6 +9,9 @@
 
 #include "NUIE_NodeUIManager.hpp"
 #include "NUIE_DrawingContext.hpp"
+#include "NUIE_NodeUIManagerCommands.hpp"
+#include "NUIE_UndoHandler.hpp"
+#include "BI_InputUINodes.hpp"
 
 using namespace NE;
 using namespace NUIE;
@@ -229,4 +232,194 @@ TEST (ViewBoxCenterTest)
 	}
 }
 
+class SetNodePositionCommand : public UndoableCommand
+{
+public:
+	SetNodePositionCommand (const UINodePtr& uiNode, const Point& position) :
+		UndoableCommand (),
+		uiNode (uiNode),
+		position (position)
+	{
+
+	}
+
+	virtual void Do (NodeUIManager& uiManager) override
+	{
+		uiNode->SetPosition (position);
+		uiManager.InvalidateNodePosition (uiNode);
+	}
+
+private:
+	UINodePtr	uiNode;
+	Point		position;
+};
+
+TEST (UndoNodePositionTest)
+{
+	TestUIEnvironment env;
+	NodeUIManager uiManager (env);
+
+	UINodePtr uiNode = uiManager.AddNode (UINodePtr (new BI::IntegerUpDownNode (LocString (L"Integer"), Point (100.0, 100.0), 0, 1)));
+	NodeId nodeId = uiNode->GetId ();
+	SetNodePositionCommand command (uiNode, Point (500.0, 300.0));
+	uiManager.ExecuteCommand (command, env);
+	ASSERT (uiManager.GetNode (nodeId)->GetPosition () == Point (500.0, 300.0));
+
+	uiManager.Undo (env.GetEvaluationEnv (), env);
+	ASSERT (uiManager.GetNode (nodeId)->GetPosition () == Point (100.0, 100.0));
+
+	uiManager.Redo (env.GetEvaluationEnv (), env);
+	ASSERT (uiManager.GetNode (nodeId)->GetPosition () == Point (500.0, 300.0));
+}
+
+class RenameCommand : public UndoableCommand
+{
+public:
+	RenameCommand (const UINodePtr& uiNode, const UINodeGroupPtr& group, const std::wstring& name) :
+		UndoableCommand (),
+		uiNode (uiNode),
+		group (group),
+		name (name)
+	{
+
+	}
+
+	virtual void Do (NodeUIManager&) override
+	{
+		// the changes are not reported to the manager, the objects report them
+		uiNode->SetName (name);
+		group->SetName (name);
+	}
+
+private:
+	UINodePtr		uiNode;
+	UINodeGroupPtr	group;
+	std::wstring	name;
+};
+
+TEST (UndoUnreportedChangeTest)
+{
+	TestUIEnvironment env;
+	NodeUIManager uiManager (env);
+
+	UINodePtr uiNode = uiManager.AddNode (UINodePtr (new BI::IntegerUpDownNode (LocString (L"Integer"), Point (100.0, 100.0), 0, 1)));
+	UINodeGroupPtr group = uiManager.AddNodeGroup (UINodeGroupPtr (new UINodeGroup (LocString (L"Group"))));
+	NodeId nodeId = uiNode->GetId ();
+	uiManager.AddNodesToGroup (group, NodeCollection ({ nodeId }));
+	RenameCommand command (uiNode, group, L"Renamed");
+	uiManager.ExecuteCommand (command, env);
+
+	uiManager.Undo (env.GetEvaluationEnv (), env);
+	ASSERT (uiManager.GetNode (nodeId)->GetName ().GetLocalized () == L"Integer");
+	ASSERT (uiManager.GetNodeGroup (nodeId)->GetName ().GetLocalized () == L"Group");
+
+	uiManager.Redo (env.GetEvaluationEnv (), env);
+	ASSERT (uiManager.GetNode (nodeId)->GetName ().GetLocalized () == L"Renamed");
+	ASSERT (uiManager.GetNodeGroup (nodeId)->GetName ().GetLocalized () == L"Renamed");
+}
+
+TEST (BatchRollbackGroupTest)
+{
+	TestUIEnvironment env;
+	NodeUIManager uiManager (env);
+
+	UINodePtr node1 = uiManager.AddNode (UINodePtr (new TestNode (Point (0.0, 0.0))));
+	UINodePtr node2 = uiManager.AddNode (UINodePtr (new TestNode (Point (200.0, 0.0))));
+	UINodeGroupPtr group = uiManager.AddNodeGroup (UINodeGroupPtr (new UINodeGroup (LocString (L"Group"))));
+	NodeId node1Id = node1->GetId ();
+	NodeId node2Id = node2->GetId ();
+	uiManager.AddNodesToGroup (group, NodeCollection ({ node1Id, node2Id }));
+	ASSERT (uiManager.ConnectOutputSlotToInputSlot (node1->GetUIOutputSlot (SlotId ("out")), node2->GetUIInputSlot (SlotId ("in1"))));
+
+	// the group is deleted with its last node, and the batch creates a cycle
+	uiManager.BeginBatch (env);
+	group->SetName (L"Renamed");
+	uiManager.RemoveNodesFromGroup (NodeCollection ({ node1Id, node2Id }));
+	ASSERT (uiManager.ConnectOutputSlotToInputSlot (node2->GetUIOutputSlot (SlotId ("out")), node1->GetUIInputSlot (SlotId ("in1"))));
+	ASSERT (!uiManager.EndBatch (env));
+
+	ASSERT (uiManager.GetNode (node1Id) == node1);
+	ASSERT (uiManager.GetNode (node2Id) == node2);
+	ASSERT (uiManager.GetNodeGroup (node1Id) == group);
+	ASSERT (uiManager.GetNodeGroup (node2Id) == group);
+	ASSERT (group->GetName ().GetLocalized () == L"Group");
+	ASSERT (uiManager.IsOutputSlotConnectedToInputSlot (node1->GetUIOutputSlot (SlotId ("out")), node2->GetUIInputSlot (SlotId ("in1"))));
+	ASSERT (!uiManager.HasConnectedOutputSlots (node1->GetUIInputSlot (SlotId ("in1"))));
+}
+
+TEST (UndoHistoryMemoryBudgetTest)
+{
+	NodeManager nodeManager;
+	UndoHandler undoHandler;
+	undoHandler.SetHistoryLimits (16, 0);
+
+	std::vector<NodeId> nodeIds;
+	for (size_t i = 0; i < 10; i++) {
+		undoHandler.AddUndoStep (nodeManager);
+		NodePtr node = nodeManager.AddNode (NodePtr (new BI::IntegerUpDownNode (LocString (L"Integer"), Point (i * 100.0, 0.0), (int) i, 1)));
+		undoHandler.AddChangedNode (node->GetId ());
+		nodeIds.push_back (node->GetId ());
+	}
+	undoHandler.AddUndoStep (nodeManager);
+	size_t mirrorSize = undoHandler.GetMemorySize ();
+	ASSERT (mirrorSize > 0);
+
+	// every step is spilled, only the copy of the document remains in memory
+	undoHandler.SetHistoryLimits (16, mirrorSize);
+	ASSERT (undoHandler.GetMemorySize () == mirrorSize);
+
+	undoHandler.SetHistoryLimits (16, 64 * 1024 * 1024);
+	EmptyUpdateEventHandler eventHandler;
+	while (undoHandler.CanUndo ()) {
+		ASSERT (undoHandler.Undo (nodeManager, eventHandler) == UndoHandler::ChangeResult::Changed);
+	}
+	ASSERT (nodeManager.GetNodeCount () == 0);
+
+	// the restored steps are live, but they are still limited by the budget
+	size_t liveMemorySize = undoHandler.GetMemorySize ();
+	undoHandler.SetHistoryLimits (16, 0);
+	ASSERT (undoHandler.GetMemorySize () < liveMemorySize);
+	while (undoHandler.CanRedo ()) {
+		ASSERT (undoHandler.Redo (nodeManager, eventHandler) == UndoHandler::ChangeResult::Changed);
+	}
+	ASSERT (nodeManager.GetNodeCount () == 10);
+	for (const NodeId& nodeId : nodeIds) {
+		ASSERT (nodeManager.ContainsNode (nodeId));
+	}
+}
+
+TEST (UndoHistorySpillReuseTest)
+{
+	NodeManager nodeManager;
+	UndoHandler undoHandler;
+	undoHandler.SetHistoryLimits (16, 0);
+
+	for (size_t i = 0; i < 10; i++) {
+		undoHandler.AddUndoStep (nodeManager);
+		NodePtr node = nodeManager.AddNode (NodePtr (new BI::IntegerUpDownNode (LocString (L"Integer"), Point (i * 100.0, 0.0), (int) i, 1)));
+		undoHandler.AddChangedNode (node->GetId ());
+	}
+
+	// restored steps are spilled again, and the dropped redo steps give back their space
+	EmptyUpdateEventHandler eventHandler;
+	for (size_t i = 0; i < 5; i++) {
+		ASSERT (undoHandler.Undo (nodeManager, eventHandler) == UndoHandler::ChangeResult::Changed);
+	}
+	ASSERT (nodeManager.GetNodeCount () == 5);
+	undoHandler.AddUndoStep (nodeManager);
+	NodeId lastNodeId = nodeManager.AddNode (NodePtr (new BI::IntegerUpDownNode (LocString (L"Integer"), Point (0.0, 100.0), 0, 1)))->GetId ();
+	undoHandler.AddChangedNode (lastNodeId);
+	ASSERT (!undoHandler.CanRedo ());
+
+	while (undoHandler.CanUndo ()) {
+		ASSERT (undoHandler.Undo (nodeManager, eventHandler) == UndoHandler::ChangeResult::Changed);
+	}
+	ASSERT (nodeManager.GetNodeCount () == 0);
+	while (undoHandler.CanRedo ()) {
+		ASSERT (undoHandler.Redo (nodeManager, eventHandler) == UndoHandler::ChangeResult::Changed);
+	}
+	ASSERT (nodeManager.GetNodeCount () == 6);
+	ASSERT (nodeManager.ContainsNode (lastNodeId));
+}
+
 }
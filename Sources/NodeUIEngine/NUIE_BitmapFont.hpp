@@ -0,0 +1,21 @@
+#ifndef NUIE_BITMAPFONT_HPP
+#define NUIE_BITMAPFONT_HPP
+
+#include <cstdint>
+
+namespace NUIE
+{
+
+// fixed 5x7 pixel font for printable ascii characters, other characters are drawn as question marks,
+// glyphs are placed in 6x8 cells to leave space between characters and lines
+static const int BitmapFontGlyphWidth = 5;
+static const int BitmapFontGlyphHeight = 7;
+static const int BitmapFontCellWidth = 6;
+static const int BitmapFontCellHeight = 8;
+
+// returns the rows of the glyph from top to bottom, the leftmost pixel is the highest bit
+const uint8_t*	GetBitmapFontGlyph (wchar_t character);
+
+}
+
+#endif
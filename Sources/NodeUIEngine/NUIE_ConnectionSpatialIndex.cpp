@@ -0,0 +1,110 @@
+#include "NUIE_ConnectionSpatialIndex.hpp"
+#include "NE_Debug.hpp"
+
+#include <algorithm>
+
+namespace NUIE
+{
+
+ConnectionSpatialIndex::ConnectionSpatialIndex () :
+	connections (),
+	nodeConnections ()
+{
+
+}
+
+ConnectionSpatialIndex::~ConnectionSpatialIndex ()
+{
+
+}
+
+bool ConnectionSpatialIndex::IsEmpty () const
+{
+	return connections.IsEmpty ();
+}
+
+size_t ConnectionSpatialIndex::Count () const
+{
+	return connections.Count ();
+}
+
+bool ConnectionSpatialIndex::Contains (const NE::ConnectionInfo& connection) const
+{
+	return connections.Contains (connection);
+}
+
+const Rect& ConnectionSpatialIndex::GetRect (const NE::ConnectionInfo& connection) const
+{
+	return connections.GetRect (connection);
+}
+
+void ConnectionSpatialIndex::Insert (const NE::ConnectionInfo& connection, const Rect& rect)
+{
+	if (!connections.Contains (connection)) {
+		nodeConnections[connection.GetOutputNodeId ()].push_back (connection);
+		if (connection.GetInputNodeId () != connection.GetOutputNodeId ()) {
+			nodeConnections[connection.GetInputNodeId ()].push_back (connection);
+		}
+	}
+	connections.Insert (connection, rect);
+}
+
+void ConnectionSpatialIndex::EraseNodeConnections (const NE::NodeId& nodeId)
+{
+	auto found = nodeConnections.find (nodeId);
+	if (found == nodeConnections.end ()) {
+		return;
+	}
+	for (const NE::ConnectionInfo& connection : found->second) {
+		connections.Erase (connection);
+		const NE::NodeId& otherNodeId = (connection.GetOutputNodeId () == nodeId ? connection.GetInputNodeId () : connection.GetOutputNodeId ());
+		if (otherNodeId != nodeId) {
+			EraseNodeConnection (otherNodeId, connection);
+		}
+	}
+	nodeConnections.erase (found);
+}
+
+void ConnectionSpatialIndex::Clear ()
+{
+	connections.Clear ();
+	nodeConnections.clear ();
+}
+
+void ConnectionSpatialIndex::EnumerateConnections (const Rect& rect, const std::function<bool (const NE::ConnectionInfo&)>& processor) const
+{
+	connections.Enumerate (rect, processor);
+}
+
+void ConnectionSpatialIndex::EnumerateNodeConnections (const NE::NodeId& nodeId, const std::function<bool (const NE::ConnectionInfo&)>& processor) const
+{
+	auto found = nodeConnections.find (nodeId);
+	if (found == nodeConnections.end ()) {
+		return;
+	}
+	for (const NE::ConnectionInfo& connection : found->second) {
+		if (!processor (connection)) {
+			break;
+		}
+	}
+}
+
+void ConnectionSpatialIndex::EraseNodeConnection (const NE::NodeId& nodeId, const NE::ConnectionInfo& connection)
+{
+	auto found = nodeConnections.find (nodeId);
+	if (DBGERROR (found == nodeConnections.end ())) {
+		return;
+	}
+	std::vector<NE::ConnectionInfo>& connectionList = found->second;
+	auto foundConnection = std::find (connectionList.begin (), connectionList.end (), connection);
+	if (DBGERROR (foundConnection == connectionList.end ())) {
+		return;
+	}
+	*foundConnection = connectionList.back ();
+	connectionList.pop_back ();
+	if (connectionList.empty ()) {
+		nodeConnections.erase (found);
+	}
+}
+
+}
@@ -0,0 +1,43 @@
+#ifndef NUIE_CONNECTIONSPATIALINDEX_HPP
+#define NUIE_CONNECTIONSPATIALINDEX_HPP
+
+#include "NE_ConnectionInfo.hpp"
+#include "NUIE_SpatialIndex.hpp"
+
+#include <vector>
+#include <unordered_map>
+#include <functional>
+
+namespace NUIE
+{
+
+// bounding rects of connections, the connections are also registered
+// for both of their nodes, so a changed node can drop all of its curves
+class ConnectionSpatialIndex
+{
+public:
+	ConnectionSpatialIndex ();
+	~ConnectionSpatialIndex ();
+
+	bool			IsEmpty () const;
+	size_t			Count () const;
+	bool			Contains (const NE::ConnectionInfo& connection) const;
+	const Rect&		GetRect (const NE::ConnectionInfo& connection) const;
+
+	void			Insert (const NE::ConnectionInfo& connection, const Rect& rect);
+	void			EraseNodeConnections (const NE::NodeId& nodeId);
+	void			Clear ();
+
+	void			EnumerateConnections (const Rect& rect, const std::function<bool (const NE::ConnectionInfo&)>& processor) const;
+	void			EnumerateNodeConnections (const NE::NodeId& nodeId, const std::function<bool (const NE::ConnectionInfo&)>& processor) const;
+
+private:
+	void			EraseNodeConnection (const NE::NodeId& nodeId, const NE::ConnectionInfo& connection);
+
+	SpatialIndex<NE::ConnectionInfo>											connections;
+	std::unordered_map<NE::NodeId, std::vector<NE::ConnectionInfo>>				nodeConnections;
+};
+
+}
+
+#endif
@@ -50,6 +50,61 @@ void ViewBoxContextDecorator::DrawIcon (const Rect& rect, const IconId& iconId)
 	decorated.DrawIcon (viewBox.ModelToView (rect), iconId);
 }
 
+void ViewBoxContextDecorator::DrawLines (const std::vector<Point>& points, const Pen& pen)
+{
+	decorated.DrawLines (ModelToView (points), viewBox.ModelToView (pen));
+}
+
+void ViewBoxContextDecorator::DrawBeziers (const std::vector<Point>& points, const Pen& pen)
+{
+	decorated.DrawBeziers (ModelToView (points), viewBox.ModelToView (pen));
+}
+
+void ViewBoxContextDecorator::DrawRects (const std::vector<Rect>& rects, const Pen& pen)
+{
+	decorated.DrawRects (ModelToView (rects), viewBox.ModelToView (pen));
+}
+
+void ViewBoxContextDecorator::FillRects (const std::vector<Rect>& rects, const Color& color)
+{
+	decorated.FillRects (ModelToView (rects), color);
+}
+
+void ViewBoxContextDecorator::DrawEllipses (const std::vector<Rect>& rects, const Pen& pen)
+{
+	decorated.DrawEllipses (ModelToView (rects), viewBox.ModelToView (pen));
+}
+
+void ViewBoxContextDecorator::FillEllipses (const std::vector<Rect>& rects, const Color& color)
+{
+	decorated.FillEllipses (ModelToView (rects), color);
+}
+
+void ViewBoxContextDecorator::SetClipRect (const Rect& rect)
+{
+	decorated.SetClipRect (viewBox.ModelToView (rect));
+}
+
+std::vector<Point> ViewBoxContextDecorator::ModelToView (const std::vector<Point>& points) const
+{
+	std::vector<Point> viewPoints;
+	viewPoints.reserve (points.size ());
+	for (const Point& point : points) {
+		viewPoints.push_back (viewBox.ModelToView (point));
+	}
+	return viewPoints;
+}
+
+std::vector<Rect> ViewBoxContextDecorator::ModelToView (const std::vector<Rect>& rects) const
+{
+	std::vector<Rect> viewRects;
+	viewRects.reserve (rects.size ());
+	for (const Rect& rect : rects) {
+		viewRects.push_back (viewBox.ModelToView (rect));
+	}
+	return viewRects;
+}
+
 ColorChangerContextDecorator::ColorChangerContextDecorator (DrawingContext& decorated) :
 	DrawingContextDecorator (decorated)
 {
@@ -96,6 +151,36 @@ void ColorChangerContextDecorator::DrawIcon (const Rect& rect, const IconId& ico
 	return decorated.DrawIcon (rect, iconId);
 }
 
+void ColorChangerContextDecorator::DrawLines (const std::vector<Point>& points, const Pen& pen)
+{
+	decorated.DrawLines (points, GetChangedPen (pen));
+}
+
+void ColorChangerContextDecorator::DrawBeziers (const std::vector<Point>& points, const Pen& pen)
+{
+	decorated.DrawBeziers (points, GetChangedPen (pen));
+}
+
+void ColorChangerContextDecorator::DrawRects (const std::vector<Rect>& rects, const Pen& pen)
+{
+	decorated.DrawRects (rects, GetChangedPen (pen));
+}
+
+void ColorChangerContextDecorator::FillRects (const std::vector<Rect>& rects, const Color& color)
+{
+	decorated.FillRects (rects, GetChangedColor (color));
+}
+
+void ColorChangerContextDecorator::DrawEllipses (const std::vector<Rect>& rects, const Pen& pen)
+{
+	decorated.DrawEllipses (rects, GetChangedPen (pen));
+}
+
+void ColorChangerContextDecorator::FillEllipses (const std::vector<Rect>& rects, const Color& color)
+{
+	decorated.FillEllipses (rects, GetChangedColor (color));
+}
+
 Pen ColorChangerContextDecorator::GetChangedPen (const Pen& origPen)
 {
 	return Pen (GetChangedColor (origPen.GetColor ()), origPen.GetThickness ());
@@ -135,4 +220,25 @@ bool PreviewContextDecorator::NeedToDraw (ItemPreviewMode mode)
 	return true;
 }
 
+SynchronizedMeasureContextDecorator::SynchronizedMeasureContextDecorator (DrawingContext& decorated) :
+	DrawingContextDecorator (decorated),
+	measureMutex ()
+{
+
+}
+
+Size SynchronizedMeasureContextDecorator::MeasureText (const Font& font, const std::wstring& text)
+{
+	if (decorated.CanMeasureTextConcurrently ()) {
+		return decorated.MeasureText (font, text);
+	}
+	std::lock_guard<std::mutex> lock (measureMutex);
+	return decorated.MeasureText (font, text);
+}
+
+bool SynchronizedMeasureContextDecorator::CanMeasureTextConcurrently ()
+{
+	return true;
+}
+
 }
@@ -5,6 +5,8 @@
 #include "NUIE_ViewBox.hpp"
 #include "NUIE_DrawingContext.hpp"
 #include <string>
+#include <vector>
+#include <mutex>
 
 namespace NUIE
 {
@@ -23,7 +25,19 @@ public:
 	virtual void	DrawFormattedText (const Rect& rect, const Font& font, const std::wstring& text, HorizontalAnchor hAnchor, VerticalAnchor vAnchor, const Color& textColor) override;
 	virtual void	DrawIcon (const Rect& rect, const IconId& iconId) override;
 
+	virtual void	DrawLines (const std::vector<Point>& points, const Pen& pen) override;
+	virtual void	DrawBeziers (const std::vector<Point>& points, const Pen& pen) override;
+	virtual void	DrawRects (const std::vector<Rect>& rects, const Pen& pen) override;
+	virtual void	FillRects (const std::vector<Rect>& rects, const Color& color) override;
+	virtual void	DrawEllipses (const std::vector<Rect>& rects, const Pen& pen) override;
+	virtual void	FillEllipses (const std::vector<Rect>& rects, const Color& color) override;
+
+	virtual void	SetClipRect (const Rect& rect) override;
+
 protected:
+	std::vector<Point>	ModelToView (const std::vector<Point>& points) const;
+	std::vector<Rect>	ModelToView (const std::vector<Rect>& rects) const;
+
 	const ViewBox& viewBox;
 };
 
@@ -41,6 +55,13 @@ public:
 	virtual void	DrawFormattedText (const Rect& rect, const Font& font, const std::wstring& text, HorizontalAnchor hAnchor, VerticalAnchor vAnchor, const Color& textColor) override;
 	virtual void	DrawIcon (const Rect& rect, const IconId& iconId) override;
 
+	virtual void	DrawLines (const std::vector<Point>& points, const Pen& pen) override;
+	virtual void	DrawBeziers (const std::vector<Point>& points, const Pen& pen) override;
+	virtual void	DrawRects (const std::vector<Rect>& rects, const Pen& pen) override;
+	virtual void	FillRects (const std::vector<Rect>& rects, const Color& color) override;
+	virtual void	DrawEllipses (const std::vector<Rect>& rects, const Pen& pen) override;
+	virtual void	FillEllipses (const std::vector<Rect>& rects, const Color& color) override;
+
 private:
 	virtual Color	GetChangedColor (const Color& origColor) = 0;
 	Pen				GetChangedPen (const Pen& origPen);
@@ -69,6 +90,18 @@ private:
 	bool isPreviewMode;
 };
 
+class SynchronizedMeasureContextDecorator : public DrawingContextDecorator
+{
+public:
+	SynchronizedMeasureContextDecorator (DrawingContext& decorated);
+
+	virtual Size	MeasureText (const Font& font, const std::wstring& text) override;
+	virtual bool	CanMeasureTextConcurrently () override;
+
+private:
+	std::mutex		measureMutex;
+};
+
 }
 
 #endif
@@ -0,0 +1,311 @@
+#include "NUIE_DisplayList.hpp"
+#include "NUIE_DrawingImage.hpp"
+#include "NE_Debug.hpp"
+
+#include <algorithm>
+
+namespace NUIE
+{
+
+class DisplayList::Recorder : public DrawingContext
+{
+public:
+	Recorder (DisplayList& displayList, DrawingContext::ItemPreviewMode mode) :
+		displayList (displayList),
+		mode (mode)
+	{
+
+	}
+
+	virtual void Resize (int, int) override
+	{
+		DBGBREAK ();
+	}
+
+	virtual int GetWidth () const override
+	{
+		return 0;
+	}
+
+	virtual int GetHeight () const override
+	{
+		return 0;
+	}
+
+	virtual void BeginDraw () override
+	{
+		DBGBREAK ();
+	}
+
+	virtual void EndDraw () override
+	{
+		DBGBREAK ();
+	}
+
+	virtual bool NeedToDraw (ItemPreviewMode) override
+	{
+		return true;
+	}
+
+	virtual void DrawLine (const Point& beg, const Point& end, const Pen& pen) override
+	{
+		std::vector<Point>& points = displayList.GetBatch (BatchType::Lines, mode, pen).points;
+		points.push_back (beg);
+		points.push_back (end);
+	}
+
+	virtual void DrawBezier (const Point& p1, const Point& p2, const Point& p3, const Point& p4, const Pen& pen) override
+	{
+		std::vector<Point>& points = displayList.GetBatch (BatchType::Beziers, mode, pen).points;
+		points.push_back (p1);
+		points.push_back (p2);
+		points.push_back (p3);
+		points.push_back (p4);
+	}
+
+	virtual void DrawRect (const Rect& rect, const Pen& pen) override
+	{
+		displayList.GetBatch (BatchType::Rects, mode, pen).rects.push_back (rect);
+	}
+
+	virtual void FillRect (const Rect& rect, const Color& color) override
+	{
+		displayList.GetBatch (BatchType::FillRects, mode, color).rects.push_back (rect);
+	}
+
+	virtual void DrawEllipse (const Rect& rect, const Pen& pen) override
+	{
+		displayList.GetBatch (BatchType::Ellipses, mode, pen).rects.push_back (rect);
+	}
+
+	virtual void FillEllipse (const Rect& rect, const Color& color) override
+	{
+		displayList.GetBatch (BatchType::FillEllipses, mode, color).rects.push_back (rect);
+	}
+
+	virtual void DrawFormattedText (const Rect& rect, const Font& font, const std::wstring& text, HorizontalAnchor hAnchor, VerticalAnchor vAnchor, const Color& textColor) override
+	{
+		AddItem (DrawingItemConstPtr (new DrawingText (rect, font, text, hAnchor, vAnchor, textColor)));
+	}
+
+	virtual Size MeasureText (const Font&, const std::wstring&) override
+	{
+		// drawing items are measured when the image is built, not when they are drawn
+		DBGBREAK ();
+		return Size (0.0, 0.0);
+	}
+
+	virtual bool CanDrawIcon () override
+	{
+		return true;
+	}
+
+	virtual void DrawIcon (const Rect& rect, const IconId& iconId) override
+	{
+		AddItem (DrawingItemConstPtr (new DrawingIcon (rect, iconId)));
+	}
+
+private:
+	void AddItem (const DrawingItemConstPtr& item)
+	{
+		displayList.batches.push_back (Batch (BatchType::Item, mode));
+		displayList.batches.back ().item = item;
+	}
+
+	DisplayList&						displayList;
+	DrawingContext::ItemPreviewMode		mode;
+};
+
+DisplayList::Batch::Batch (BatchType type, DrawingContext::ItemPreviewMode mode) :
+	type (type),
+	mode (mode),
+	pen (Color (), 0.0),
+	color (),
+	points (),
+	rects (),
+	item (nullptr)
+{
+
+}
+
+size_t DisplayList::Batch::GetElementCount () const
+{
+	switch (type) {
+		case BatchType::Lines:
+		case BatchType::Beziers:
+			return points.size ();
+		case BatchType::Rects:
+		case BatchType::FillRects:
+		case BatchType::Ellipses:
+		case BatchType::FillEllipses:
+			return rects.size ();
+		case BatchType::Item:
+			return item != nullptr ? 1 : 0;
+	}
+	DBGBREAK ();
+	return 0;
+}
+
+void DisplayList::Batch::EraseElements (size_t begin, size_t end)
+{
+	if (type == BatchType::Item) {
+		item = nullptr;
+	} else if (type == BatchType::Lines || type == BatchType::Beziers) {
+		points.erase (points.begin () + begin, points.begin () + end);
+	} else {
+		rects.erase (rects.begin () + begin, rects.begin () + end);
+	}
+}
+
+DisplayList::DisplayList () :
+	batches (),
+	itemRecords ()
+{
+
+}
+
+DisplayList::~DisplayList ()
+{
+
+}
+
+bool DisplayList::IsEmpty () const
+{
+	return batches.empty ();
+}
+
+size_t DisplayList::GetBatchCount () const
+{
+	return batches.size ();
+}
+
+size_t DisplayList::GetItemCount () const
+{
+	return itemRecords.size ();
+}
+
+void DisplayList::Clear ()
+{
+	batches.clear ();
+	itemRecords.clear ();
+}
+
+void DisplayList::AddItem (const DrawingItemConstPtr& item, DrawingContext::ItemPreviewMode mode)
+{
+	// the end of the last batch, the first primitive of the item is either merged into it, or starts the next batch
+	if (batches.empty ()) {
+		itemRecords.push_back ({ item, 0, 0 });
+	} else {
+		itemRecords.push_back ({ item, batches.size () - 1, batches.back ().GetElementCount () });
+	}
+	Recorder recorder (*this, mode);
+	item->Draw (recorder);
+}
+
+bool DisplayList::RemoveItem (const DrawingItemConstPtr& item)
+{
+	auto found = std::find_if (itemRecords.begin (), itemRecords.end (), [&] (const ItemRecord& record) {
+		return !record.item.owner_before (item) && !item.owner_before (record.item);
+	});
+	if (found == itemRecords.end ()) {
+		return false;
+	}
+
+	// the primitives of the item are between its position and the position of the next item,
+	// they may share their first and last batches with the neighbouring items
+	size_t beginBatch = found->batchIndex;
+	size_t beginElement = found->elementIndex;
+	size_t endBatch = batches.size ();
+	size_t endElement = 0;
+	auto next = found + 1;
+	if (next != itemRecords.end ()) {
+		endBatch = next->batchIndex;
+		endElement = next->elementIndex;
+	}
+
+	std::vector<size_t> newBatchIndices (batches.size () + 1);
+	std::vector<Batch> newBatches;
+	size_t erasedFromEndBatch = 0;
+	for (size_t i = 0; i < batches.size (); i++) {
+		newBatchIndices[i] = newBatches.size ();
+		Batch& batch = batches[i];
+		if (i >= beginBatch && i <= endBatch) {
+			size_t eraseBegin = (i == beginBatch) ? beginElement : 0;
+			size_t eraseEnd = (i == endBatch) ? endElement : batch.GetElementCount ();
+			if (eraseBegin < eraseEnd) {
+				batch.EraseElements (eraseBegin, eraseEnd);
+				if (i == endBatch) {
+					erasedFromEndBatch = eraseEnd - eraseBegin;
+				}
+			}
+		}
+		if (batch.GetElementCount () > 0) {
+			newBatches.push_back (std::move (batch));
+		}
+	}
+	newBatchIndices[batches.size ()] = newBatches.size ();
+	batches = std::move (newBatches);
+
+	// the following items start at or after the end of the removed range
+	for (auto it = next; it != itemRecords.end (); ++it) {
+		if (it->batchIndex == endBatch) {
+			it->elementIndex -= erasedFromEndBatch;
+		}
+		it->batchIndex = newBatchIndices[it->batchIndex];
+	}
+	itemRecords.erase (found);
+	return true;
+}
+
+void DisplayList::Draw (DrawingContext& context) const
+{
+	for (const Batch& batch : batches) {
+		if (!context.NeedToDraw (batch.mode)) {
+			continue;
+		}
+		switch (batch.type) {
+			case BatchType::Lines:
+				context.DrawLines (batch.points, batch.pen);
+				break;
+			case BatchType::Beziers:
+				context.DrawBeziers (batch.points, batch.pen);
+				break;
+			case BatchType::Rects:
+				context.DrawRects (batch.rects, batch.pen);
+				break;
+			case BatchType::FillRects:
+				context.FillRects (batch.rects, batch.color);
+				break;
+			case BatchType::Ellipses:
+				context.DrawEllipses (batch.rects, batch.pen);
+				break;
+			case BatchType::FillEllipses:
+				context.FillEllipses (batch.rects, batch.color);
+				break;
+			case BatchType::Item:
+				batch.item->Draw (context);
+				break;
+		}
+	}
+}
+
+DisplayList::Batch& DisplayList::GetBatch (BatchType type, DrawingContext::ItemPreviewMode mode, const Pen& pen)
+{
+	// only the last batch can be extended, otherwise the drawing order would change
+	if (batches.empty () || batches.back ().type != type || batches.back ().mode != mode || batches.back ().pen != pen) {
+		batches.push_back (Batch (type, mode));
+		batches.back ().pen = pen;
+	}
+	return batches.back ();
+}
+
+DisplayList::Batch& DisplayList::GetBatch (BatchType type, DrawingContext::ItemPreviewMode mode, const Color& color)
+{
+	if (batches.empty () || batches.back ().type != type || batches.back ().mode != mode || batches.back ().color != color) {
+		batches.push_back (Batch (type, mode));
+		batches.back ().color = color;
+	}
+	return batches.back ();
+}
+
+}
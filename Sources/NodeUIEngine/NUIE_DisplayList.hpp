@@ -0,0 +1,79 @@
+#ifndef NUIE_DISPLAYLIST_HPP
+#define NUIE_DISPLAYLIST_HPP
+
+#include "NUIE_DrawingContext.hpp"
+
+#include <vector>
+#include <memory>
+
+namespace NUIE
+{
+
+class DrawingItem;
+using DrawingItemConstPtr = std::shared_ptr<const DrawingItem>;
+
+// recorded primitives of drawing items, consecutive primitives of the same kind
+// with the same pen or color are merged, so they can be submitted in one call,
+// the items are not kept, only the position where their primitives start
+class DisplayList
+{
+public:
+	DisplayList ();
+	~DisplayList ();
+
+	bool	IsEmpty () const;
+	size_t	GetBatchCount () const;
+	size_t	GetItemCount () const;
+	void	Clear ();
+
+	void	AddItem (const DrawingItemConstPtr& item, DrawingContext::ItemPreviewMode mode);
+	bool	RemoveItem (const DrawingItemConstPtr& item);
+	void	Draw (DrawingContext& context) const;
+
+private:
+	enum class BatchType
+	{
+		Lines,
+		Beziers,
+		Rects,
+		FillRects,
+		Ellipses,
+		FillEllipses,
+		Item
+	};
+
+	struct Batch
+	{
+		Batch (BatchType type, DrawingContext::ItemPreviewMode mode);
+
+		size_t	GetElementCount () const;
+		void	EraseElements (size_t begin, size_t end);
+
+		BatchType							type;
+		DrawingContext::ItemPreviewMode		mode;
+		Pen									pen;
+		Color								color;
+		std::vector<Point>					points;
+		std::vector<Rect>					rects;
+		DrawingItemConstPtr					item;
+	};
+
+	struct ItemRecord
+	{
+		std::weak_ptr<const DrawingItem>	item;
+		size_t								batchIndex;
+		size_t								elementIndex;
+	};
+
+	class Recorder;
+
+	Batch&	GetBatch (BatchType type, DrawingContext::ItemPreviewMode mode, const Pen& pen);
+	Batch&	GetBatch (BatchType type, DrawingContext::ItemPreviewMode mode, const Color& color);
+
+	std::vector<Batch>			batches;
+	std::vector<ItemRecord>		itemRecords;
+};
+
+}
+
+#endif
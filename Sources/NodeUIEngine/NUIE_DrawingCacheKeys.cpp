@@ -81,4 +81,30 @@ bool FontCacheKey::operator!= (const FontCacheKey& rhs) const
 	return !operator== (rhs);
 }
 
+TextCacheKey::TextCacheKey () :
+	family (),
+	size (0.0),
+	text ()
+{
+
+}
+
+TextCacheKey::TextCacheKey (const Font& font, const std::wstring& text) :
+	family (font.GetFamily ()),
+	size (font.GetSize ()),
+	text (text)
+{
+
+}
+
+bool TextCacheKey::operator== (const TextCacheKey& rhs) const
+{
+	return family == rhs.family && size == rhs.size && text == rhs.text;
+}
+
+bool TextCacheKey::operator!= (const TextCacheKey& rhs) const
+{
+	return !operator== (rhs);
+}
+
 }
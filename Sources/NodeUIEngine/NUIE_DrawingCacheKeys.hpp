@@ -48,6 +48,20 @@ public:
 	int				size;
 };
 
+class TextCacheKey
+{
+public:
+	TextCacheKey ();
+	TextCacheKey (const Font& font, const std::wstring& text);
+
+	bool	operator== (const TextCacheKey& rhs) const;
+	bool	operator!= (const TextCacheKey& rhs) const;
+
+	std::wstring	family;
+	double			size;
+	std::wstring	text;
+};
+
 }
 
 namespace std
@@ -78,6 +92,15 @@ namespace std
 			return std::hash<std::wstring> {} (key.family) + 49157 * std::hash<int> {} (key.size);
 		}
 	};
+
+	template <>
+	struct hash<NUIE::TextCacheKey>
+	{
+		size_t operator() (const NUIE::TextCacheKey& key) const noexcept
+		{
+			return std::hash<std::wstring> {} (key.text) + 24593 * std::hash<std::wstring> {} (key.family) + 49157 * std::hash<double> {} (key.size);
+		}
+	};
 }
 
 #endif
@@ -1,4 +1,5 @@
 #include "NUIE_DrawingContext.hpp"
+#include "NE_Debug.hpp"
 
 namespace NUIE
 {
@@ -13,6 +14,70 @@ DrawingContext::~DrawingContext ()
 
 }
 
+void DrawingContext::DrawLines (const std::vector<Point>& points, const Pen& pen)
+{
+	DBGASSERT (points.size () % 2 == 0);
+	for (size_t i = 0; i + 1 < points.size (); i += 2) {
+		DrawLine (points[i], points[i + 1], pen);
+	}
+}
+
+void DrawingContext::DrawBeziers (const std::vector<Point>& points, const Pen& pen)
+{
+	DBGASSERT (points.size () % 4 == 0);
+	for (size_t i = 0; i + 3 < points.size (); i += 4) {
+		DrawBezier (points[i], points[i + 1], points[i + 2], points[i + 3], pen);
+	}
+}
+
+void DrawingContext::DrawRects (const std::vector<Rect>& rects, const Pen& pen)
+{
+	for (const Rect& rect : rects) {
+		DrawRect (rect, pen);
+	}
+}
+
+void DrawingContext::FillRects (const std::vector<Rect>& rects, const Color& color)
+{
+	for (const Rect& rect : rects) {
+		FillRect (rect, color);
+	}
+}
+
+void DrawingContext::DrawEllipses (const std::vector<Rect>& rects, const Pen& pen)
+{
+	for (const Rect& rect : rects) {
+		DrawEllipse (rect, pen);
+	}
+}
+
+void DrawingContext::FillEllipses (const std::vector<Rect>& rects, const Color& color)
+{
+	for (const Rect& rect : rects) {
+		FillEllipse (rect, color);
+	}
+}
+
+bool DrawingContext::CanClip ()
+{
+	return false;
+}
+
+void DrawingContext::SetClipRect (const Rect&)
+{
+
+}
+
+void DrawingContext::ResetClipRect ()
+{
+
+}
+
+bool DrawingContext::CanMeasureTextConcurrently ()
+{
+	return false;
+}
+
 DrawingContextDecorator::DrawingContextDecorator (DrawingContext& decorated) :
 	decorated (decorated)
 {
@@ -104,6 +169,56 @@ void DrawingContextDecorator::DrawIcon (const Rect& rect, const IconId& iconId)
 	decorated.DrawIcon (rect, iconId);
 }
 
+void DrawingContextDecorator::DrawLines (const std::vector<Point>& points, const Pen& pen)
+{
+	decorated.DrawLines (points, pen);
+}
+
+void DrawingContextDecorator::DrawBeziers (const std::vector<Point>& points, const Pen& pen)
+{
+	decorated.DrawBeziers (points, pen);
+}
+
+void DrawingContextDecorator::DrawRects (const std::vector<Rect>& rects, const Pen& pen)
+{
+	decorated.DrawRects (rects, pen);
+}
+
+void DrawingContextDecorator::FillRects (const std::vector<Rect>& rects, const Color& color)
+{
+	decorated.FillRects (rects, color);
+}
+
+void DrawingContextDecorator::DrawEllipses (const std::vector<Rect>& rects, const Pen& pen)
+{
+	decorated.DrawEllipses (rects, pen);
+}
+
+void DrawingContextDecorator::FillEllipses (const std::vector<Rect>& rects, const Color& color)
+{
+	decorated.FillEllipses (rects, color);
+}
+
+bool DrawingContextDecorator::CanClip ()
+{
+	return decorated.CanClip ();
+}
+
+void DrawingContextDecorator::SetClipRect (const Rect& rect)
+{
+	decorated.SetClipRect (rect);
+}
+
+void DrawingContextDecorator::ResetClipRect ()
+{
+	decorated.ResetClipRect ();
+}
+
+bool DrawingContextDecorator::CanMeasureTextConcurrently ()
+{
+	return decorated.CanMeasureTextConcurrently ();
+}
+
 void NullDrawingContext::Resize (int, int)
 {
 
@@ -184,4 +299,9 @@ void NullDrawingContext::DrawIcon (const Rect&, const IconId&)
 
 }
 
+bool NullDrawingContext::CanMeasureTextConcurrently ()
+{
+	return true;
+}
+
 }
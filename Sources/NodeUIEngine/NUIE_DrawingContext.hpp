@@ -5,6 +5,7 @@
 #include "NUIE_Geometry.hpp"
 #include "NUIE_Drawing.hpp"
 #include <string>
+#include <vector>
 #include <memory>
 
 namespace NUIE
@@ -46,6 +47,25 @@ public:
 
 	virtual bool	CanDrawIcon () = 0;
 	virtual void	DrawIcon (const Rect& rect, const IconId& iconId) = 0;
+
+	// batch versions of the primitives above, lines are stored as point pairs, beziers as point quadruples,
+	// the default implementations draw the items one by one, so a context overrides only what it can do faster
+	virtual void	DrawLines (const std::vector<Point>& points, const Pen& pen);
+	virtual void	DrawBeziers (const std::vector<Point>& points, const Pen& pen);
+	virtual void	DrawRects (const std::vector<Rect>& rects, const Pen& pen);
+	virtual void	FillRects (const std::vector<Rect>& rects, const Color& color);
+	virtual void	DrawEllipses (const std::vector<Rect>& rects, const Pen& pen);
+	virtual void	FillEllipses (const std::vector<Rect>& rects, const Color& color);
+
+	// optional clipping in context coordinates, a context that can clip must keep its content
+	// between two draws, because only the area inside the clip rect is drawn again
+	virtual bool	CanClip ();
+	virtual void	SetClipRect (const Rect& rect);
+	virtual void	ResetClipRect ();
+
+	// a context that returns true here can measure text from several threads at the same time,
+	// otherwise text measurement is serialized when drawing images are built in parallel
+	virtual bool	CanMeasureTextConcurrently ();
 };
 
 class DrawingContextDecorator : public DrawingContext
@@ -79,6 +99,19 @@ public:
 	virtual bool	CanDrawIcon () override;
 	virtual void	DrawIcon (const Rect& rect, const IconId& iconId) override;
 
+	virtual void	DrawLines (const std::vector<Point>& points, const Pen& pen) override;
+	virtual void	DrawBeziers (const std::vector<Point>& points, const Pen& pen) override;
+	virtual void	DrawRects (const std::vector<Rect>& rects, const Pen& pen) override;
+	virtual void	FillRects (const std::vector<Rect>& rects, const Color& color) override;
+	virtual void	DrawEllipses (const std::vector<Rect>& rects, const Pen& pen) override;
+	virtual void	FillEllipses (const std::vector<Rect>& rects, const Color& color) override;
+
+	virtual bool	CanClip () override;
+	virtual void	SetClipRect (const Rect& rect) override;
+	virtual void	ResetClipRect () override;
+
+	virtual bool	CanMeasureTextConcurrently () override;
+
 protected:
 	DrawingContext& decorated;
 };
@@ -110,6 +143,8 @@ public:
 
 	virtual bool	CanDrawIcon () override;
 	virtual void	DrawIcon (const Rect& rect, const IconId& iconId) override;
+
+	virtual bool	CanMeasureTextConcurrently () override;
 };
 
 class NativeDrawingContext : public DrawingContext
@@ -1,7 +1,5 @@
 #include "NUIE_DrawingImage.hpp"
 
-#include <algorithm>
-
 namespace NUIE
 {
 
@@ -181,7 +179,8 @@ void MultiDrawingItem::Draw (DrawingContext& context) const
 	}
 }
 
-DrawingImage::DrawingImage ()
+DrawingImage::DrawingImage () :
+	displayList ()
 {
 
 }
@@ -193,42 +192,39 @@ DrawingImage::~DrawingImage ()
 
 bool DrawingImage::IsEmpty () const
 {
-	return items.empty ();
+	return displayList.GetItemCount () == 0;
 }
 
 void DrawingImage::Clear ()
 {
-	items.clear ();
+	displayList.Clear ();
 }
 
 void DrawingImage::AddItem (const DrawingItemConstPtr& item)
 {
-	items.push_back ({ item, DrawingContext::ItemPreviewMode::ShowInPreview });
+	AddItem (item, DrawingContext::ItemPreviewMode::ShowInPreview);
 }
 
 void DrawingImage::AddItem (const DrawingItemConstPtr& item, DrawingContext::ItemPreviewMode mode)
 {
-	items.push_back ({ item, mode });
+	// only the recorded primitives are kept, so the geometry is not stored twice
+	displayList.AddItem (item, mode);
 }
 
 void DrawingImage::RemoveItem (const DrawingItemConstPtr& item)
 {
-	auto found = std::find_if (items.begin (), items.end (), [&] (const DrawingItemClass& actItem) {
-		return actItem.item == item;
-	});
-	if (found != items.end ()) {
-		items.erase (found);
-	}
+	displayList.RemoveItem (item);
 }
 
 void DrawingImage::Draw (DrawingContext& context) const
 {
-	for (const DrawingItemClass& item : items) {
-		if (!context.NeedToDraw (item.mode)) {
-			continue;
-		}
-		item.item->Draw (context);
-	}
+	// the image is drawn from its display list, so the primitives go through the decorators in batches
+	displayList.Draw (context);
+}
+
+const DisplayList& DrawingImage::GetDisplayList () const
+{
+	return displayList;
 }
 
 }
@@ -2,6 +2,7 @@
 #define NUIE_DRAWINGIMAGE_HPP
 
 #include "NUIE_DrawingContext.hpp"
+#include "NUIE_DisplayList.hpp"
 
 #include <string>
 #include <vector>
@@ -163,15 +164,10 @@ public:
 	void			RemoveItem (const DrawingItemConstPtr& item);
 	void			Draw (DrawingContext& context) const;
 
+	const DisplayList&	GetDisplayList () const;
+
 private:
-	class DrawingItemClass
-	{
-	public:
-		DrawingItemConstPtr					item;
-		DrawingContext::ItemPreviewMode		mode;
-	};
-
-	std::vector<DrawingItemClass> items;
+	DisplayList		displayList;
 };
 
 }
@@ -343,6 +343,18 @@ bool Rect::IsInBounds (const Rect& rect, double boundsWidth, double boundsHeight
 	return true;
 }
 
+bool Rect::IsOverlapping (const Rect& aRect, const Rect& bRect)
+{
+	// touching rects are overlapping, so an empty rect finds the rects on its boundary
+	if (aRect.GetRight () < bRect.GetLeft () || aRect.GetLeft () > bRect.GetRight ()) {
+		return false;
+	}
+	if (aRect.GetBottom () < bRect.GetTop () || aRect.GetTop () > bRect.GetBottom ()) {
+		return false;
+	}
+	return true;
+}
+
 IntPoint::IntPoint () :
 	x (0),
 	y (0)
@@ -479,6 +491,55 @@ const Rect& BoundingRect::GetRect () const
 	return boundingRect;
 }
 
+IncrementalBoundingRect::IncrementalBoundingRect () :
+	boundingRect (),
+	needToRecalculate (true)
+{
+}
+
+void IncrementalBoundingRect::AddRect (const Rect& rect)
+{
+	if (needToRecalculate) {
+		return;
+	}
+	boundingRect.AddRect (rect);
+}
+
+void IncrementalBoundingRect::RemoveRect (const Rect& rect)
+{
+	if (needToRecalculate || !boundingRect.IsValid ()) {
+		return;
+	}
+	const Rect& currRect = boundingRect.GetRect ();
+	if (rect.GetLeft () <= currRect.GetLeft () || rect.GetRight () >= currRect.GetRight () ||
+		rect.GetTop () <= currRect.GetTop () || rect.GetBottom () >= currRect.GetBottom ())
+	{
+		needToRecalculate = true;
+	}
+}
+
+bool IncrementalBoundingRect::NeedToRecalculate () const
+{
+	return needToRecalculate;
+}
+
+void IncrementalBoundingRect::Invalidate ()
+{
+	needToRecalculate = true;
+}
+
+void IncrementalBoundingRect::Reset ()
+{
+	boundingRect = BoundingRect ();
+	needToRecalculate = false;
+}
+
+const BoundingRect& IncrementalBoundingRect::GetBoundingRect () const
+{
+	DBGASSERT (!needToRecalculate);
+	return boundingRect;
+}
+
 NE::Stream::Status ReadPoint (NE::InputStream& inputStream, Point& point)
 {
 	double x = 0.0;
@@ -584,4 +645,12 @@ Rect GetBezierBoundingRect (const Point& p1, const Point& p2, const Point& p3, c
 	return boundingRect.GetRect ();
 }
 
+void GetConnectionBezierControlPoints (const Point& beg, const Point& end, Point& controlPoint1, Point& controlPoint2)
+{
+	double bezierOffsetVal = std::fabs (beg.GetX () - end.GetX ()) / 2.0;
+	Point bezierOffset (bezierOffsetVal, 0.0);
+	controlPoint1 = beg + bezierOffset;
+	controlPoint2 = end - bezierOffset;
+}
+
 }
@@ -110,6 +110,7 @@ public:
 	static Rect FromCenterAndSize (const Point& rectCenter, const Size& rectSize);
 	static Rect FromTwoPoints (const Point& p1, const Point& p2);
 	static bool IsInBounds (const Rect& rect, double boundsWidth, double boundsHeight);
+	static bool IsOverlapping (const Rect& aRect, const Rect& bRect);
 
 private:
 	Point	position;
@@ -171,6 +172,27 @@ private:
 	bool	isValid;
 };
 
+// bounding rect of a changing set of rects, it grows when a rect is added, but it needs
+// to be recalculated when a removed rect was on its boundary, because it may shrink
+class IncrementalBoundingRect
+{
+public:
+	IncrementalBoundingRect ();
+
+	void					AddRect (const Rect& rect);
+	void					RemoveRect (const Rect& rect);
+
+	bool					NeedToRecalculate () const;
+	void					Invalidate ();
+	void					Reset ();
+
+	const BoundingRect&		GetBoundingRect () const;
+
+private:
+	BoundingRect	boundingRect;
+	bool			needToRecalculate;
+};
+
 NE::Stream::Status ReadPoint (NE::InputStream& inputStream, Point& point);
 NE::Stream::Status ReadSize (NE::InputStream& inputStream, Size& size);
 NE::Stream::Status ReadRect (NE::InputStream& inputStream, Rect& rect);
@@ -189,6 +211,7 @@ bool IsEqual (const Rect& a, const Rect& b);
 
 std::vector<Point>	SegmentBezier (size_t segmentCount, const Point& p1, const Point& p2, const Point& p3, const Point& p4);
 Rect				GetBezierBoundingRect (const Point& p1, const Point& p2, const Point& p3, const Point& p4);
+void				GetConnectionBezierControlPoints (const Point& beg, const Point& end, Point& controlPoint1, Point& controlPoint2);
 
 }
 
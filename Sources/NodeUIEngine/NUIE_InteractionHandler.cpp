@@ -64,23 +64,20 @@ public:
 	{
 		const ViewBox& viewBox = uiManager.GetViewBox ();
 		Rect modelSelectionRect = viewBox.ViewToModel (selectionRect);
-		Selection selection = uiManager.GetSelection ();
-		if (!modifierKeys.Contains (ModifierKeyCode::Command)) {
-			selection.Clear ();
-		}
-		std::unordered_set<UINodePtr> nodesToSelect;
-		uiManager.EnumerateNodes ([&] (UINodePtr uiNode) {
-			const NE::NodeId& uiNodeId = uiNode->GetId ();
+		NE::NodeCollection nodesInRect;
+		uiManager.EnumerateNodesInRect (uiEnvironment, modelSelectionRect, [&] (const UINodeConstPtr& uiNode) {
 			Rect nodeRect = uiNode->GetRect (uiEnvironment);
 			if (modelSelectionRect.Contains (nodeRect)) {
-				if (selection.ContainsNode (uiNodeId)) {
-					selection.DeleteNode (uiNodeId);
-				} else {
-					selection.AddNode (uiNodeId);
-				}
+				nodesInRect.Insert (uiNode->GetId ());
 			}
 			return true;
 		});
+		Selection selection = uiManager.GetSelection ();
+		if (modifierKeys.Contains (ModifierKeyCode::Command)) {
+			selection.ToggleNodes (nodesInRect);
+		} else {
+			selection.SetNodes (nodesInRect);
+		}
 		uiManager.SetSelection (selection, uiEnvironment);
 	}
 
@@ -157,6 +154,14 @@ public:
 		return Point (0.0, 0.0);
 	}
 
+	virtual void EnumerateOffsetNodes (const std::function<void (const NE::NodeId&)>& processor) const override
+	{
+		relevantNodes.Enumerate ([&] (const NE::NodeId& nodeId) {
+			processor (nodeId);
+			return true;
+		});
+	}
+
 private:
 	void RequestRedraw ()
 	{
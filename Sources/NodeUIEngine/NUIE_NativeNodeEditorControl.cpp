@@ -24,4 +24,9 @@ void NativeNodeEditorControl::EnableInputHandling (bool enabled)
 	inputHandlingEnabled = enabled;
 }
 
+void NativeNodeEditorControl::InvalidateViewRect (const Rect&)
+{
+	Invalidate ();
+}
+
 }
@@ -21,6 +21,7 @@ public:
 
 	virtual void				Resize (int x, int y, int width, int height) = 0;
 	virtual void				Invalidate () = 0;
+	virtual void				InvalidateViewRect (const Rect& viewRect);
 	virtual void				Draw () = 0;
 
 	virtual DrawingContext&		GetDrawingContext () = 0;
@@ -502,6 +502,7 @@ void SetGroupParametersMenuCommand::DoModification ()
 
 		virtual void ApplyChanges (NodeUIManager& uiManager, NE::EvaluationEnv&) override
 		{
+			uiManager.InvalidateNodeGroupDrawing (currentGroup);
 			for (const auto& it : changedParameterValues) {
 				switch (it.first) {
 				case 0:
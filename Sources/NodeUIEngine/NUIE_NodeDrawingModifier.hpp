@@ -27,6 +27,7 @@ public:
 	virtual void	EnumerateDuplicatedNodes (const std::function<void (const NE::NodeId&, const Point&)>& processor) const = 0;
 	virtual bool	NeedToDrawConnection (const NE::NodeId& outputNodeId, const NE::SlotId& outputSlotId, const NE::NodeId& inputNodeId, const NE::SlotId& inputSlotId) const = 0;
 	virtual Point	GetNodeOffset (const NE::NodeId& nodeId) const = 0;
+	virtual void	EnumerateOffsetNodes (const std::function<void (const NE::NodeId&)>& processor) const = 0;
 };
 
 }
@@ -103,13 +103,13 @@ void NodeEditor::SetUpdateMode (UpdateMode newUpdateMode)
 
 void NodeEditor::Update ()
 {
-	uiManager.Update (uiEnvironment);
+	uiManager.Update (uiEnvironment, uiEnvironment);
 }
 
 void NodeEditor::ManualUpdate ()
 {
 	uiManager.RequestRecalculateAndRedraw ();
-	uiManager.ManualUpdate (uiEnvironment);
+	uiManager.ManualUpdate (uiEnvironment, uiEnvironment);
 }
 
 void NodeEditor::Draw ()
@@ -117,6 +117,23 @@ void NodeEditor::Draw ()
 	uiManager.Draw (uiEnvironment, interactionHandler.GetDrawingModifier ());
 }
 
+void NodeEditor::Draw (const Rect& dirtyViewRect)
+{
+	uiManager.Draw (uiEnvironment, interactionHandler.GetDrawingModifier (), dirtyViewRect);
+}
+
+void NodeEditor::BeginBatch ()
+{
+	uiManager.BeginBatch (uiEnvironment);
+}
+
+bool NodeEditor::EndBatch ()
+{
+	bool success = uiManager.EndBatch (uiEnvironment);
+	Update ();
+	return success;
+}
+
 void NodeEditor::AddNode (const UINodePtr& uiNode)
 {
 	AddNodeCommand command (uiNode);
@@ -232,7 +249,7 @@ bool NodeEditor::Open (NE::InputStream& inputStream)
 bool NodeEditor::Save (const std::wstring& fileName)
 {
 	NE::MemoryOutputStream outputStream;
-	if (DBGERROR (!Save (outputStream))) {
+	if (DBGERROR (!Save (outputStream, NE::NodeManager::NodeRecordMode::LengthPrefixed))) {
 		return false;
 	}
 
@@ -245,11 +262,16 @@ bool NodeEditor::Save (const std::wstring& fileName)
 }
 
 bool NodeEditor::Save (NE::OutputStream& outputStream)
+{
+	return Save (outputStream, NE::NodeManager::NodeRecordMode::Inline);
+}
+
+bool NodeEditor::Save (NE::OutputStream& outputStream, NE::NodeManager::NodeRecordMode recordMode)
 {
 	const Version& currentVersion = GetCurrentEngineVersion ();
 	outputStream.Write (NodeEditorFileMarker);
 	currentVersion.Write (outputStream);
-	if (DBGERROR (!uiManager.Save (outputStream))) {
+	if (DBGERROR (!uiManager.Save (outputStream, recordMode))) {
 		return false;
 	}
 	return true;
@@ -293,6 +315,11 @@ void NodeEditor::Redo ()
 	Update ();
 }
 
+void NodeEditor::SetUndoHistoryLimits (size_t liveStepCount, size_t memoryBudget)
+{
+	uiManager.SetUndoHistoryLimits (liveStepCount, memoryBudget);
+}
+
 NodeEditorInfo NodeEditor::GetInfo () const
 {
 	NodeEditorInfo info;
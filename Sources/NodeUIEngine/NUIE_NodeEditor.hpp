@@ -41,6 +41,10 @@ public:
 
 	void							Update ();
 	void							Draw ();
+	void							Draw (const Rect& dirtyViewRect);
+
+	void							BeginBatch ();
+	bool							EndBatch ();
 
 	void							AddNode (const UINodePtr& uiNode);
 	std::vector<UINodeConstPtr>		FindNodes (const UINodeFilter& nodeFilter) const;
@@ -64,6 +68,7 @@ public:
 	bool							Open (NE::InputStream& inputStream);
 	bool							Save (const std::wstring& fileName);
 	bool							Save (NE::OutputStream& outputStream);
+	bool							Save (NE::OutputStream& outputStream, NE::NodeManager::NodeRecordMode recordMode);
 	bool							NeedToSave () const;
 
 	void							ExecuteCommand (CommandCode command);
@@ -72,6 +77,7 @@ public:
 
 	void							Undo ();
 	void							Redo ();
+	void							SetUndoHistoryLimits (size_t liveStepCount, size_t memoryBudget);
 
 	NodeEditorInfo					GetInfo () const;
 
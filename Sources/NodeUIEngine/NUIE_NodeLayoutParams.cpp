@@ -0,0 +1,99 @@
+#include "NUIE_NodeLayoutParams.hpp"
+#include "NUIE_SkinParams.hpp"
+#include "NUIE_DrawingContext.hpp"
+
+namespace NUIE
+{
+
+// the measured size of this text reflects the fonts available for the drawing context
+static const std::wstring ReferenceText = L"Node Layout 0123456789";
+
+NodeLayoutParams::NodeLayoutParams () :
+	nodePadding (0.0),
+	nodeBorderThickness (0.0),
+	headerFontFamily (),
+	headerFontSize (0.0),
+	headerTextSize (),
+	contentFontFamily (),
+	contentFontSize (0.0),
+	contentTextSize (),
+	slotMarker (0),
+	hiddenSlotMarker (0),
+	slotMarkerSize ()
+{
+
+}
+
+NodeLayoutParams::NodeLayoutParams (NodeUIDrawingEnvironment& drawingEnv) :
+	NodeLayoutParams ()
+{
+	const SkinParams& skinParams = drawingEnv.GetSkinParams ();
+	DrawingContext& drawingContext = drawingEnv.GetDrawingContext ();
+	const Font& headerFont = skinParams.GetNodeHeaderTextFont ();
+	const Font& contentFont = skinParams.GetNodeContentTextFont ();
+	nodePadding = skinParams.GetNodePadding ();
+	nodeBorderThickness = skinParams.GetNodeBorderPen ().GetThickness ();
+	headerFontFamily = headerFont.GetFamily ();
+	headerFontSize = headerFont.GetSize ();
+	headerTextSize = drawingContext.MeasureText (headerFont, ReferenceText);
+	contentFontFamily = contentFont.GetFamily ();
+	contentFontSize = contentFont.GetSize ();
+	contentTextSize = drawingContext.MeasureText (contentFont, ReferenceText);
+	slotMarker = (int) skinParams.GetSlotMarker ();
+	hiddenSlotMarker = (int) skinParams.GetHiddenSlotMarker ();
+	slotMarkerSize = skinParams.GetSlotMarkerSize ();
+}
+
+bool NodeLayoutParams::operator== (const NodeLayoutParams& rhs) const
+{
+	return	IsEqual (nodePadding, rhs.nodePadding) &&
+			IsEqual (nodeBorderThickness, rhs.nodeBorderThickness) &&
+			headerFontFamily == rhs.headerFontFamily &&
+			IsEqual (headerFontSize, rhs.headerFontSize) &&
+			IsEqual (headerTextSize, rhs.headerTextSize) &&
+			contentFontFamily == rhs.contentFontFamily &&
+			IsEqual (contentFontSize, rhs.contentFontSize) &&
+			IsEqual (contentTextSize, rhs.contentTextSize) &&
+			slotMarker == rhs.slotMarker &&
+			hiddenSlotMarker == rhs.hiddenSlotMarker &&
+			IsEqual (slotMarkerSize, rhs.slotMarkerSize);
+}
+
+bool NodeLayoutParams::operator!= (const NodeLayoutParams& rhs) const
+{
+	return !operator== (rhs);
+}
+
+NE::Stream::Status NodeLayoutParams::Read (NE::InputStream& inputStream)
+{
+	inputStream.Read (nodePadding);
+	inputStream.Read (nodeBorderThickness);
+	inputStream.Read (headerFontFamily);
+	inputStream.Read (headerFontSize);
+	ReadSize (inputStream, headerTextSize);
+	inputStream.Read (contentFontFamily);
+	inputStream.Read (contentFontSize);
+	ReadSize (inputStream, contentTextSize);
+	inputStream.Read (slotMarker);
+	inputStream.Read (hiddenSlotMarker);
+	ReadSize (inputStream, slotMarkerSize);
+	return inputStream.GetStatus ();
+}
+
+NE::Stream::Status NodeLayoutParams::Write (NE::OutputStream& outputStream) const
+{
+	outputStream.Write (nodePadding);
+	outputStream.Write (nodeBorderThickness);
+	outputStream.Write (headerFontFamily);
+	outputStream.Write (headerFontSize);
+	WriteSize (outputStream, headerTextSize);
+	outputStream.Write (contentFontFamily);
+	outputStream.Write (contentFontSize);
+	WriteSize (outputStream, contentTextSize);
+	outputStream.Write (slotMarker);
+	outputStream.Write (hiddenSlotMarker);
+	WriteSize (outputStream, slotMarkerSize);
+	return outputStream.GetStatus ();
+}
+
+}
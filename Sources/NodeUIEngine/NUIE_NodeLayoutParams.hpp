@@ -0,0 +1,43 @@
+#ifndef NUIE_NODELAYOUTPARAMS_HPP
+#define NUIE_NODELAYOUTPARAMS_HPP
+
+#include "NE_Stream.hpp"
+#include "NUIE_Geometry.hpp"
+#include "NUIE_NodeUIEnvironment.hpp"
+
+#include <string>
+
+namespace NUIE
+{
+
+// the parameters of a drawing environment that affect the size of node drawings,
+// rects calculated with different parameters are not valid in the other environment
+class NodeLayoutParams
+{
+public:
+	NodeLayoutParams ();
+	NodeLayoutParams (NodeUIDrawingEnvironment& drawingEnv);
+
+	bool				operator== (const NodeLayoutParams& rhs) const;
+	bool				operator!= (const NodeLayoutParams& rhs) const;
+
+	NE::Stream::Status	Read (NE::InputStream& inputStream);
+	NE::Stream::Status	Write (NE::OutputStream& outputStream) const;
+
+private:
+	double				nodePadding;
+	double				nodeBorderThickness;
+	std::wstring		headerFontFamily;
+	double				headerFontSize;
+	Size				headerTextSize;
+	std::wstring		contentFontFamily;
+	double				contentFontSize;
+	Size				contentTextSize;
+	int					slotMarker;
+	int					hiddenSlotMarker;
+	Size				slotMarkerSize;
+};
+
+}
+
+#endif
@@ -23,6 +23,12 @@ NodeUICalculationEnvironment::~NodeUICalculationEnvironment ()
 
 }
 
+void NodeUICalculationEnvironment::OnPartialRedrawRequested (const Rect&)
+{
+	// an environment that can't redraw only a part of the window redraws everything
+	OnRedrawRequested ();
+}
+
 NodeUIInteractionEnvironment::NodeUIInteractionEnvironment ()
 {
 
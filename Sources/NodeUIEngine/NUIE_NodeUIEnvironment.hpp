@@ -7,6 +7,7 @@
 #include "NUIE_Selection.hpp"
 #include "NUIE_UndoState.hpp"
 #include "NUIE_ClipboardState.hpp"
+#include "NUIE_Geometry.hpp"
 
 #include <memory>
 
@@ -41,6 +42,7 @@ public:
 	virtual void				OnEvaluationEnd () = 0;
 	virtual void				OnValuesRecalculated () = 0;
 	virtual void				OnRedrawRequested () = 0;
+	virtual void				OnPartialRedrawRequested (const Rect& dirtyViewRect);
 };
 
 class NodeUIInteractionEnvironment
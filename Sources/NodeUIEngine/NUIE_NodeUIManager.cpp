@@ -6,10 +6,13 @@
 #include "NUIE_NodeUIManagerDrawer.hpp"
 #include "NUIE_SkinParams.hpp"
 
+#include <unordered_set>
+#include <algorithm>
+
 namespace NUIE
 {
 
-SERIALIZATION_INFO (NodeUIManager, 1);
+SERIALIZATION_INFO (NodeUIManager, 2);
 
 class NodeUIManagerUpdateEventHandler : public NE::UpdateEventHandler
 {
@@ -49,6 +52,7 @@ private:
 NodeUIManager::Status::Status () :
 	needToRecalculate (false),
 	needToRedraw (false),
+	needToRedrawAll (false),
 	needToSave (false)
 {
 	Reset ();
@@ -58,6 +62,7 @@ void NodeUIManager::Status::Reset ()
 {
 	needToRecalculate = false;
 	needToRedraw = false;
+	needToRedrawAll = false;
 	needToSave = false;
 }
 
@@ -77,6 +82,12 @@ bool NodeUIManager::Status::NeedToRecalculate () const
 }
 
 void NodeUIManager::Status::RequestRedraw ()
+{
+	needToRedraw = true;
+	needToRedrawAll = true;
+}
+
+void NodeUIManager::Status::RequestPartialRedraw ()
 {
 	needToRedraw = true;
 }
@@ -84,6 +95,7 @@ void NodeUIManager::Status::RequestRedraw ()
 void NodeUIManager::Status::ResetRedraw ()
 {
 	needToRedraw = false;
+	needToRedrawAll = false;
 }
 
 bool NodeUIManager::Status::NeedToRedraw () const
@@ -91,6 +103,11 @@ bool NodeUIManager::Status::NeedToRedraw () const
 	return needToRedraw;
 }
 
+bool NodeUIManager::Status::NeedToRedrawAll () const
+{
+	return needToRedrawAll;
+}
+
 void NodeUIManager::Status::RequestSave ()
 {
 	needToSave = true;
@@ -157,7 +174,7 @@ NodeUIManagerNodeRectGetter::NodeUIManagerNodeRectGetter (const NodeUIManager& u
 Rect NodeUIManagerNodeRectGetter::GetNodeRect (const NE::NodeId& nodeId) const
 {
 	UINodeConstPtr uiNode = uiManager.GetNode (nodeId);
-	return uiNode->GetRect (drawingEnv);
+	return uiNode->GetEstimatedRect (drawingEnv);
 }
 
 UINodeFilter::UINodeFilter ()
@@ -197,14 +214,67 @@ NodeUIManager::NodeUIManager (NodeUIEnvironment& uiEnvironment) :
 	undoHandler (),
 	selection (),
 	viewBox (),
-	status ()
-{
+	status (),
+	batchInvalidatedNodes (),
+	layoutParams (),
+	nodeSpatialIndex (),
+	connectionSpatialIndex (),
+	spatialIndexChanges (),
+	isSpatialIndexValid (false),
+	nodesBoundingRect (),
+	groupsBoundingRect (),
+	changedGroups (),
+	dirtyModelRect (),
+	dirtyNodes ()
+{
+	nodeManager.SetChangeHandler (&undoHandler);
 	New (uiEnvironment);
 }
 
 NodeUIManager::~NodeUIManager ()
 {
+	nodeManager.SetChangeHandler (nullptr);
+}
 
+void NodeUIManager::BeginBatch (NodeUIInteractionEnvironment& interactionEnv)
+{
+	// the whole batch is one undo step, commands inside it don't add their own
+	if (!nodeManager.IsInBatch ()) {
+		UndoHandler::ChangeResult result = undoHandler.AddUndoStep (nodeManager);
+		HandleUndoStateChanged (result, interactionEnv);
+	}
+	nodeManager.BeginBatch ();
+}
+
+bool NodeUIManager::EndBatch (NodeUIInteractionEnvironment& interactionEnv)
+{
+	bool success = nodeManager.EndBatch ();
+	if (!success) {
+		// the changes of the batch are undone, so it leaves nothing to undo,
+		// and the nodes added in it are deleted, so they can't remain selected
+		UndoHandler::ChangeResult undoResult = undoHandler.DropUndoStep ();
+		HandleUndoStateChanged (undoResult, interactionEnv);
+
+		NE::NodeCollection deletedNodes;
+		selection.GetNodes ().Enumerate ([&] (const NE::NodeId& nodeId) {
+			if (!nodeManager.ContainsNode (nodeId)) {
+				deletedNodes.Insert (nodeId);
+			}
+			return true;
+		});
+		Selection::ChangeResult selResult = selection.DeleteNodes (deletedNodes);
+		HandleSelectionChanged (selResult, interactionEnv);
+	}
+	if (!nodeManager.IsInBatch ()) {
+		InvalidateBatchNodeDrawings ();
+		RequestRecalculateAndRedraw ();
+	}
+	return success;
+}
+
+bool NodeUIManager::IsInBatch () const
+{
+	return nodeManager.IsInBatch ();
 }
 
 UINodePtr NodeUIManager::AddNode (const UINodePtr& uiNode)
@@ -218,6 +288,8 @@ UINodePtr NodeUIManager::AddNode (const UINodePtr& uiNode)
 		return nullptr;
 	}
 
+	undoHandler.AddChangedNode (resultNode->GetId ());
+	InvalidateSpatialIndices (resultNode->GetId ());
 	RequestRecalculateAndRedraw ();
 	return uiNode;
 }
@@ -234,6 +306,8 @@ bool NodeUIManager::DeleteNode (const UINodePtr& uiNode, NE::EvaluationEnv& eval
 	HandleSelectionChanged (selResult, interactionEnv);
 	
 	InvalidateNodeDrawing (uiNode);
+	undoHandler.AddChangedNode (uiNode->GetId ());
+	InvalidateSpatialIndices (uiNode->GetId ());
 	if (!nodeManager.DeleteNode (uiNode)) {
 		return false;
 	}
@@ -290,8 +364,10 @@ bool NodeUIManager::CanConnectOutputSlotToInputSlots (const UIOutputSlotConstPtr
 
 bool NodeUIManager::ConnectOutputSlotToInputSlot (const UIOutputSlotConstPtr& outputSlot, const UIInputSlotConstPtr& inputSlot)
 {
-	DBGASSERT (CanConnectOutputSlotToInputSlot (outputSlot, inputSlot));
+	// cycles are checked only at the end of the batch
+	DBGASSERT (nodeManager.IsInBatch () || CanConnectOutputSlotToInputSlot (outputSlot, inputSlot));
 	bool success = nodeManager.ConnectOutputSlotToInputSlot (outputSlot, inputSlot);
+	undoHandler.AddChangedNode (outputSlot->GetOwnerNodeId ());
 	InvalidateNodeDrawing (inputSlot->GetOwnerNodeId ());
 	RequestRecalculateAndRedraw ();
 	return success;
@@ -301,6 +377,7 @@ bool NodeUIManager::ConnectOutputSlotsToInputSlot (const UIOutputSlotList& outpu
 {
 	DBGASSERT (CanConnectOutputSlotsToInputSlot (outputSlots, inputSlot));
 	bool success = nodeManager.ConnectOutputSlotsToInputSlot (outputSlots, inputSlot);
+	AddChangedNodes (outputSlots);
 	InvalidateNodeDrawing (inputSlot->GetOwnerNodeId ());
 	RequestRecalculateAndRedraw ();
 	return success;
@@ -310,6 +387,7 @@ bool NodeUIManager::ConnectOutputSlotToInputSlots (const UIOutputSlotConstPtr& o
 {
 	DBGASSERT (CanConnectOutputSlotToInputSlots (outputSlot, inputSlots));
 	bool success = nodeManager.ConnectOutputSlotToInputSlots (outputSlot, inputSlots);
+	undoHandler.AddChangedNode (outputSlot->GetOwnerNodeId ());
 	inputSlots.Enumerate ([&] (const NE::InputSlotConstPtr& inputSlot) {
 		InvalidateNodeDrawing (inputSlot->GetOwnerNodeId ());
 		return true;
@@ -321,6 +399,7 @@ bool NodeUIManager::ConnectOutputSlotToInputSlots (const UIOutputSlotConstPtr& o
 bool NodeUIManager::DisconnectOutputSlotFromInputSlot (const UIOutputSlotConstPtr& outputSlot, const UIInputSlotConstPtr& inputSlot)
 {
 	bool success = nodeManager.DisconnectOutputSlotFromInputSlot (outputSlot, inputSlot);
+	undoHandler.AddChangedNode (outputSlot->GetOwnerNodeId ());
 	InvalidateNodeDrawing (inputSlot->GetOwnerNodeId ());
 	RequestRecalculateAndRedraw ();
 	return success;
@@ -329,6 +408,7 @@ bool NodeUIManager::DisconnectOutputSlotFromInputSlot (const UIOutputSlotConstPt
 bool NodeUIManager::DisconnectOutputSlotsFromInputSlot (const UIOutputSlotList& outputSlots, const UIInputSlotConstPtr& inputSlot)
 {
 	bool success = nodeManager.DisconnectOutputSlotsFromInputSlot (outputSlots, inputSlot);
+	AddChangedNodes (outputSlots);
 	InvalidateNodeDrawing (inputSlot->GetOwnerNodeId ());
 	RequestRecalculateAndRedraw ();
 	return success;
@@ -337,6 +417,7 @@ bool NodeUIManager::DisconnectOutputSlotsFromInputSlot (const UIOutputSlotList&
 bool NodeUIManager::DisconnectOutputSlotFromInputSlots (const UIOutputSlotConstPtr& outputSlot, const UIInputSlotList& inputSlots)
 {
 	bool success = nodeManager.DisconnectOutputSlotFromInputSlots (outputSlot, inputSlots);
+	undoHandler.AddChangedNode (outputSlot->GetOwnerNodeId ());
 	inputSlots.Enumerate ([&] (const NE::InputSlotConstPtr& inputSlot) {
 		InvalidateNodeDrawing (inputSlot->GetOwnerNodeId ());
 		return true;
@@ -347,6 +428,9 @@ bool NodeUIManager::DisconnectOutputSlotFromInputSlots (const UIOutputSlotConstP
 
 bool NodeUIManager::DisconnectAllInputSlotsFromOutputSlot (const UIOutputSlotConstPtr& outputSlot)
 {
+	nodeManager.EnumerateConnectedInputSlots (outputSlot, [&] (const NE::InputSlotConstPtr& inputSlot) {
+		undoHandler.AddChangedNode (inputSlot->GetOwnerNodeId ());
+	});
 	bool success = nodeManager.DisconnectAllInputSlotsFromOutputSlot (outputSlot);
 	InvalidateNodeDrawing (outputSlot->GetOwnerNodeId ());
 	RequestRecalculateAndRedraw ();
@@ -355,6 +439,9 @@ bool NodeUIManager::DisconnectAllInputSlotsFromOutputSlot (const UIOutputSlotCon
 
 bool NodeUIManager::DisconnectAllOutputSlotsFromInputSlot (const UIInputSlotConstPtr& inputSlot)
 {
+	nodeManager.EnumerateConnectedOutputSlots (inputSlot, [&] (const NE::OutputSlotConstPtr& outputSlot) {
+		undoHandler.AddChangedNode (outputSlot->GetOwnerNodeId ());
+	});
 	bool success = nodeManager.DisconnectAllOutputSlotsFromInputSlot (inputSlot);
 	InvalidateNodeDrawing (inputSlot->GetOwnerNodeId ());
 	RequestRecalculateAndRedraw ();
@@ -383,9 +470,7 @@ size_t NodeUIManager::GetConnectedOutputSlotCount (const UIInputSlotConstPtr& in
 
 void NodeUIManager::EnumerateConnectedUIInputSlots (const UIOutputSlotConstPtr& outputSlot, const std::function<void (UIInputSlotConstPtr)>& processor) const
 {
-	nodeManager.EnumerateConnectedInputSlots (outputSlot, [&] (const NE::InputSlotConstPtr& inputSlot) {
-		processor (std::dynamic_pointer_cast<const UIInputSlot> (inputSlot));
-	});
+	EnumerateConnectedUIInputSlots<std::function<void (UIInputSlotConstPtr)>> (outputSlot, processor);
 }
 
 void NodeUIManager::EnumerateConnectedUIOutputSlots (const UIInputSlotConstPtr& inputSlot, const std::function<void (UIOutputSlotConstPtr)>& processor) const
@@ -446,18 +531,97 @@ UINodeConstPtr NodeUIManager::GetNode (const NE::NodeId& nodeId) const
 
 void NodeUIManager::EnumerateNodes (const std::function<bool (UINodePtr)>& processor)
 {
-	nodeManager.EnumerateNodes ([&] (NE::NodePtr node) {
-		return processor (std::static_pointer_cast<UINode> (node));
-	});
+	EnumerateNodes<std::function<bool (UINodePtr)>> (processor);
 }
 
 void NodeUIManager::EnumerateNodes (const std::function<bool (UINodeConstPtr)>& processor) const
 {
-	nodeManager.EnumerateNodes ([&] (NE::NodeConstPtr node) {
-		return processor (std::static_pointer_cast<const UINode> (node));
+	EnumerateNodes<std::function<bool (UINodeConstPtr)>> (processor);
+}
+
+void NodeUIManager::EnumerateNodesInRect (NodeUIDrawingEnvironment& drawingEnv, const Rect& modelRect, const std::function<bool (UINodePtr)>& processor)
+{
+	UpdateSpatialIndices (drawingEnv);
+	nodeSpatialIndex.Enumerate (modelRect, [&] (const NE::NodeId& nodeId) {
+		return processor (GetNode (nodeId));
+	});
+}
+
+void NodeUIManager::EnumerateNodesInRect (NodeUIDrawingEnvironment& drawingEnv, const Rect& modelRect, const std::function<bool (UINodeConstPtr)>& processor) const
+{
+	EnumerateNodesInRect (drawingEnv, modelRect, NE::EmptyNodeCollection, processor);
+}
+
+void NodeUIManager::EnumerateNodesInRect (NodeUIDrawingEnvironment& drawingEnv, const Rect& modelRect, const NE::NodeCollection& additionalNodes, const std::function<bool (UINodeConstPtr)>& processor) const
+{
+	UpdateSpatialIndices (drawingEnv);
+	std::vector<NE::NodeId> additionalNodeIds;
+	additionalNodes.Enumerate ([&] (const NE::NodeId& nodeId) {
+		additionalNodeIds.push_back (nodeId);
+		return true;
+	});
+	nodeSpatialIndex.Enumerate (modelRect, additionalNodeIds, [&] (const NE::NodeId& nodeId) {
+		return processor (GetNode (nodeId));
+	});
+}
+
+void NodeUIManager::EnumerateNodesWithOutdatedRect (const std::function<bool (UINodeConstPtr)>& processor) const
+{
+	// these are the nodes the next spatial index update has to measure
+	if (!isSpatialIndexValid) {
+		EnumerateNodes (processor);
+		return;
+	}
+	spatialIndexChanges.Enumerate ([&] (const NE::NodeId& nodeId) {
+		if (!nodeManager.ContainsNode (nodeId)) {
+			return true;
+		}
+		return processor (GetNode (nodeId));
 	});
 }
 
+void NodeUIManager::EnumerateConnectionsInRect (NodeUIDrawingEnvironment& drawingEnv, const Rect& modelRect, const std::function<void (UIOutputSlotConstPtr, UIInputSlotConstPtr)>& processor) const
+{
+	EnumerateConnectionsInRect (drawingEnv, modelRect, NE::EmptyNodeCollection, processor);
+}
+
+void NodeUIManager::EnumerateConnectionsInRect (NodeUIDrawingEnvironment& drawingEnv, const Rect& modelRect, const NE::NodeCollection& additionalNodes, const std::function<void (UIOutputSlotConstPtr, UIInputSlotConstPtr)>& processor) const
+{
+	UpdateSpatialIndices (drawingEnv);
+	std::unordered_set<NE::ConnectionInfo> foundConnections;
+	std::vector<NE::NodeId> outputNodeIds;
+	auto addConnection = [&] (const NE::ConnectionInfo& connection) {
+		if (foundConnections.insert (connection).second) {
+			outputNodeIds.push_back (connection.GetOutputNodeId ());
+		}
+		return true;
+	};
+	connectionSpatialIndex.EnumerateConnections (modelRect, addConnection);
+	additionalNodes.Enumerate ([&] (const NE::NodeId& nodeId) {
+		connectionSpatialIndex.EnumerateNodeConnections (nodeId, addConnection);
+		return true;
+	});
+
+	// the connections are reported in the same order as the full enumeration of the nodes would do
+	std::sort (outputNodeIds.begin (), outputNodeIds.end (), [&] (const NE::NodeId& a, const NE::NodeId& b) {
+		return nodeSpatialIndex.GetOrder (a) < nodeSpatialIndex.GetOrder (b);
+	});
+	outputNodeIds.erase (std::unique (outputNodeIds.begin (), outputNodeIds.end ()), outputNodeIds.end ());
+	for (const NE::NodeId& outputNodeId : outputNodeIds) {
+		UINodeConstPtr outputNode = GetNode (outputNodeId);
+		outputNode->EnumerateUIOutputSlots ([&] (const UIOutputSlotConstPtr& outputSlot) {
+			NE::SlotInfo outputSlotInfo (outputNodeId, outputSlot->GetId ());
+			EnumerateConnectedUIInputSlots (outputSlot, [&] (const UIInputSlotConstPtr& inputSlot) {
+				NE::ConnectionInfo connection (outputSlotInfo, NE::SlotInfo (inputSlot->GetOwnerNodeId (), inputSlot->GetId ()));
+				if (foundConnections.find (connection) != foundConnections.end ()) {
+					processor (outputSlot, inputSlot);
+				}
+			});
+			return true;
+		});
+	}
+}
+
 void NodeUIManager::RequestRecalculateAndRedraw ()
 {
 	status.RequestRecalculate ();
@@ -486,6 +650,7 @@ void NodeUIManager::InvalidateAllNodesDrawing ()
 		uiNode->InvalidateDrawing ();
 		return true;
 	});
+	InvalidateSpatialIndices ();
 	RequestRedraw ();
 }
 
@@ -495,6 +660,8 @@ void NodeUIManager::InvalidateAllNodeGroupsDrawing ()
 		group->InvalidateGroupDrawing ();
 		return true;
 	});
+	groupsBoundingRect.Invalidate ();
+	changedGroups.clear ();
 	RequestRedraw ();
 }
 
@@ -506,8 +673,10 @@ void NodeUIManager::InvalidateNodeValue (const NE::NodeId& nodeId)
 
 void NodeUIManager::InvalidateNodeValue (const UINodePtr& uiNode)
 {
+	undoHandler.AddChangedNode (uiNode->GetId ());
 	uiNode->InvalidateValue ();
-	RequestRecalculateAndRedraw ();
+	status.RequestRecalculate ();
+	status.RequestPartialRedraw ();
 }
 
 void NodeUIManager::InvalidateNodeDrawing (const NE::NodeId& nodeId)
@@ -518,25 +687,61 @@ void NodeUIManager::InvalidateNodeDrawing (const NE::NodeId& nodeId)
 
 void NodeUIManager::InvalidateNodeDrawing (const UINodePtr& uiNode)
 {
-	uiNode->InvalidateDrawing ();
-	InvalidateNodeGroupDrawing (uiNode);
-	nodeManager.EnumerateDependentNodes (uiNode, [&] (const NE::NodeId& dependentNodeId) {
-		UINodePtr dependentNode = GetNode (dependentNodeId);
-		InvalidateNodeDrawing (dependentNode);
-	});
-	status.RequestRedraw ();
+	undoHandler.AddChangedNode (uiNode->GetId ());
+	if (nodeManager.IsInBatch ()) {
+		// dependents are collected now, because the node may be deleted until the end of the batch
+		auto addInvalidatedNode = [&] (const NE::NodeId& nodeId) {
+			if (!batchInvalidatedNodes.Contains (nodeId)) {
+				batchInvalidatedNodes.Insert (nodeId);
+			}
+		};
+		addInvalidatedNode (uiNode->GetId ());
+		nodeManager.EnumerateDependentNodes (uiNode, [&] (const NE::NodeId& dependentNodeId) {
+			addInvalidatedNode (dependentNodeId);
+		});
+		return;
+	}
+	std::unordered_set<NE::NodeId> visitedNodes;
+	InvalidateNodeDrawingRecursive (uiNode, visitedNodes);
 }
 
 void NodeUIManager::InvalidateNodeGroupDrawing (const NE::NodeId& nodeid)
+{
+	undoHandler.AddChangedNode (nodeid);
+	InvalidateNodeGroupDrawingInternal (nodeid);
+}
+
+void NodeUIManager::InvalidateNodeGroupDrawingInternal (const NE::NodeId& nodeid)
 {
 	NE::NodeGroupConstPtr group = nodeManager.GetNodeGroup (nodeid);
 	if (group == nullptr) {
 		return;
 	}
 
-	UINodeGroupConstPtr uiGroup = std::static_pointer_cast<const UINodeGroup> (group);
-	uiGroup->InvalidateGroupDrawing ();
-	RequestRedraw ();
+	InvalidateNodeGroupDrawingInternal (std::static_pointer_cast<const UINodeGroup> (group));
+	dirtyNodes.Insert (nodeid);
+}
+
+void NodeUIManager::InvalidateNodeGroupDrawingInternal (const UINodeGroupConstPtr& group)
+{
+	// the old rect is removed from the bounding rect now, the new one is added when it is needed,
+	// without a cached rect the old one is unknown, unless the group has already been invalidated
+	Rect groupRect;
+	if (group->GetCachedRect (groupRect)) {
+		dirtyModelRect.AddRect (groupRect);
+		groupsBoundingRect.RemoveRect (groupRect);
+	} else if (changedGroups.find (group->GetId ()) == changedGroups.end ()) {
+		groupsBoundingRect.Invalidate ();
+	}
+	changedGroups.insert ({ group->GetId (), group });
+
+	// one member is enough to report the new rect of the group with the dirty region
+	GetGroupNodes (group).Enumerate ([&] (const NE::NodeId& nodeId) {
+		dirtyNodes.Insert (nodeId);
+		return false;
+	});
+	group->InvalidateGroupDrawing ();
+	status.RequestPartialRedraw ();
 }
 
 void NodeUIManager::InvalidateNodeGroupDrawing (const UINodePtr& uiNode)
@@ -544,23 +749,54 @@ void NodeUIManager::InvalidateNodeGroupDrawing (const UINodePtr& uiNode)
 	InvalidateNodeGroupDrawing (uiNode->GetId ());
 }
 
+void NodeUIManager::InvalidateNodeGroupDrawing (const UINodeGroupConstPtr& group)
+{
+	InvalidateNodeGroupDrawingInternal (group);
+}
+
+void NodeUIManager::InvalidateNodePosition (const UINodePtr& uiNode)
+{
+	undoHandler.AddChangedNode (uiNode->GetId ());
+	InvalidateSpatialIndices (uiNode->GetId ());
+	status.RequestPartialRedraw ();
+}
+
 void NodeUIManager::Update (NodeUICalculationEnvironment& calcEnv)
 {
-	UpdateInternal (calcEnv, InternalUpdateMode::Normal);
+	UpdateInternal (calcEnv, nullptr, InternalUpdateMode::Normal);
+}
+
+void NodeUIManager::Update (NodeUICalculationEnvironment& calcEnv, NodeUIDrawingEnvironment& drawingEnv)
+{
+	UpdateInternal (calcEnv, &drawingEnv, InternalUpdateMode::Normal);
 }
 
 void NodeUIManager::ManualUpdate (NodeUICalculationEnvironment& calcEnv)
 {
 	InvalidateDrawingsForInvalidatedNodes ();
-	UpdateInternal (calcEnv, InternalUpdateMode::Manual);
+	UpdateInternal (calcEnv, nullptr, InternalUpdateMode::Manual);
+}
+
+void NodeUIManager::ManualUpdate (NodeUICalculationEnvironment& calcEnv, NodeUIDrawingEnvironment& drawingEnv)
+{
+	InvalidateDrawingsForInvalidatedNodes ();
+	UpdateInternal (calcEnv, &drawingEnv, InternalUpdateMode::Manual);
 }
 
 void NodeUIManager::Draw (NodeUIDrawingEnvironment& drawingEnv, const NodeDrawingModifier* drawingModifier)
 {
+	UpdateLayoutParams (drawingEnv);
 	NodeUIManagerDrawer drawer (*this);
 	drawer.Draw (drawingEnv, drawingModifier);
 }
 
+void NodeUIManager::Draw (NodeUIDrawingEnvironment& drawingEnv, const NodeDrawingModifier* drawingModifier, const Rect& dirtyViewRect)
+{
+	UpdateLayoutParams (drawingEnv);
+	NodeUIManagerDrawer drawer (*this, dirtyViewRect);
+	drawer.Draw (drawingEnv, drawingModifier);
+}
+
 void NodeUIManager::ResizeContext (NodeUIDrawingEnvironment& drawingEnv, int newWidth, int newHeight)
 {
 	drawingEnv.GetDrawingContext ().Resize (newWidth, newHeight);
@@ -569,19 +805,14 @@ void NodeUIManager::ResizeContext (NodeUIDrawingEnvironment& drawingEnv, int new
 
 bool NodeUIManager::GetBoundingRect (NodeUIDrawingEnvironment& drawingEnv, Rect& rect) const
 {
-	BoundingRect boundingRect;
-	EnumerateNodes ([&] (UINodeConstPtr uiNode) {
-		Rect nodeRect = uiNode->GetExtendedRect (drawingEnv);
-		boundingRect.AddRect (nodeRect);
-		return true;
-	});
+	UpdateSpatialIndices (drawingEnv);
+	UpdateGroupsBoundingRect (drawingEnv);
 
-	NodeUIManagerNodeRectGetter nodeRectGetter (*this, drawingEnv);
-	EnumerateNodeGroups ([&] (UINodeGroupConstPtr uiGroup) {
-		Rect groupRect = uiGroup->GetRect (drawingEnv, nodeRectGetter, GetGroupNodes (uiGroup));
-		boundingRect.AddRect (groupRect);
-		return true;
-	});
+	BoundingRect boundingRect = nodesBoundingRect.GetBoundingRect ();
+	const BoundingRect& groupsRect = groupsBoundingRect.GetBoundingRect ();
+	if (groupsRect.IsValid ()) {
+		boundingRect.AddRect (groupsRect.GetRect ());
+	}
 
 	if (!boundingRect.IsValid ()) {
 		return false;
@@ -653,6 +884,17 @@ bool NodeUIManager::IsPreviewMode () const
 	return viewBox.GetScale () < 0.3;
 }
 
+NodeDetailLevel NodeUIManager::GetDetailLevel () const
+{
+	double scale = viewBox.GetScale ();
+	if (scale < 0.05) {
+		return NodeDetailLevel::Minimal;
+	} else if (scale < 0.15) {
+		return NodeDetailLevel::Simplified;
+	}
+	return NodeDetailLevel::Full;
+}
+
 NodeUIManager::UpdateMode NodeUIManager::GetUpdateMode () const
 {
 	switch (nodeManager.GetUpdateMode ()) {
@@ -683,12 +925,14 @@ void NodeUIManager::SetUpdateMode (UpdateMode newUpdateMode)
 void NodeUIManager::New (NodeUIEnvironment& uiEnvironment)
 {
 	Clear (uiEnvironment);
+	layoutParams = NodeLayoutParams (uiEnvironment);
 	RequestRecalculateAndRedraw ();
 }
 
 bool NodeUIManager::Open (NodeUIEnvironment& uiEnvironment, NE::InputStream& inputStream)
 {
 	Clear (uiEnvironment);
+	layoutParams = NodeLayoutParams (uiEnvironment);
 	Read (inputStream);
 	RequestRecalculateAndRedraw ();
 	return inputStream.GetStatus () == NE::Stream::Status::NoError;
@@ -696,7 +940,12 @@ bool NodeUIManager::Open (NodeUIEnvironment& uiEnvironment, NE::InputStream& inp
 
 bool NodeUIManager::Save (NE::OutputStream& outputStream)
 {
-	Write (outputStream);
+	return Save (outputStream, NE::NodeManager::NodeRecordMode::Inline);
+}
+
+bool NodeUIManager::Save (NE::OutputStream& outputStream, NE::NodeManager::NodeRecordMode recordMode)
+{
+	Write (outputStream, recordMode);
 	status.ResetSave ();
 	return outputStream.GetStatus () == NE::Stream::Status::NoError;
 }
@@ -720,8 +969,14 @@ NE::NodeCollection NodeUIManager::Paste (const NE::NodeManager& source)
 	if (DBGERROR (!NE::NodeManagerMerge::AppendNodeManager (source, nodeManager, allNodesFilter, eventHandler))) {
 		return NE::EmptyNodeCollection;
 	}
+	const NE::NodeCollection& addedNodes = eventHandler.GetAddedTargetNodes ();
+	addedNodes.Enumerate ([&] (const NE::NodeId& nodeId) {
+		undoHandler.AddChangedNode (nodeId);
+		InvalidateSpatialIndices (nodeId);
+		return true;
+	});
 	RequestRecalculateAndRedraw ();
-	return eventHandler.GetAddedTargetNodes ();
+	return addedNodes;
 }
 
 NE::NodeCollection NodeUIManager::Duplicate (const NE::NodeCollection& nodeCollection)
@@ -746,6 +1001,7 @@ void NodeUIManager::Undo (NE::EvaluationEnv& evalEnv, NodeUIInteractionEnvironme
 	NodeUIManagerUpdateEventHandler eventHandler (*this, interactionEnv, evalEnv);
 	UndoHandler::ChangeResult undoResult = undoHandler.Undo (nodeManager, eventHandler);
 	HandleUndoStateChanged (undoResult, interactionEnv);
+	InvalidateSpatialIndices ();
 	InvalidateDrawingsForInvalidatedNodes ();
 	RequestRecalculateAndRedraw ();
 }
@@ -755,42 +1011,54 @@ void NodeUIManager::Redo (NE::EvaluationEnv& evalEnv, NodeUIInteractionEnvironme
 	NodeUIManagerUpdateEventHandler eventHandler (*this, interactionEnv, evalEnv);
 	UndoHandler::ChangeResult undoResult = undoHandler.Redo (nodeManager, eventHandler);
 	HandleUndoStateChanged (undoResult, interactionEnv);
+	InvalidateSpatialIndices ();
 	InvalidateDrawingsForInvalidatedNodes ();
 	RequestRecalculateAndRedraw ();
 }
 
+void NodeUIManager::SetUndoHistoryLimits (size_t liveStepCount, size_t memoryBudget)
+{
+	undoHandler.SetHistoryLimits (liveStepCount, memoryBudget);
+}
+
 UINodeGroupPtr NodeUIManager::AddNodeGroup (const UINodeGroupPtr& group)
 {
 	NE::NodeGroupPtr resultGroup = nodeManager.AddNodeGroup (group);
 	if (resultGroup == nullptr) {
 		return nullptr;
 	}
-	InvalidateAllNodeGroupsDrawing ();
+	// a new group is not in the bounding rect yet, so its rect only has to be added
+	group->InvalidateGroupDrawing ();
+	changedGroups.insert ({ group->GetId (), group });
+	status.RequestPartialRedraw ();
 	return group;
 }
 
 void NodeUIManager::DeleteNodeGroup (const UINodeGroupPtr& group)
 {
+	InvalidateNodeGroupDrawingInternal (group);
 	nodeManager.DeleteNodeGroup (group->GetId ());
-	RequestRedraw ();
 }
 
 void NodeUIManager::AddNodesToGroup (const UINodeGroupPtr& group, const NE::NodeCollection& nodeCollection)
 {
+	// only the target group and the previous groups of the nodes are changed
+	InvalidateNodeGroupDrawingInternal (group);
 	nodeCollection.Enumerate ([&] (const NE::NodeId& nodeId) {
+		InvalidateNodeGroupDrawingInternal (nodeId);
 		nodeManager.AddNodeToGroup (group->GetId (), nodeId);
+		dirtyNodes.Insert (nodeId);
 		return true;
 	});
-	InvalidateAllNodeGroupsDrawing ();
 }
 
 bool NodeUIManager::RemoveNodesFromGroup (const NE::NodeCollection& nodeCollection)
 {
 	nodeCollection.Enumerate ([&] (const NE::NodeId& nodeId) {
+		InvalidateNodeGroupDrawingInternal (nodeId);
 		nodeManager.RemoveNodeFromGroup (nodeId);
 		return true;	
 	});
-	InvalidateAllNodeGroupsDrawing ();
 	return true;
 }
 
@@ -820,7 +1088,7 @@ void NodeUIManager::EnumerateNodeGroups (const std::function<bool (UINodeGroupPt
 
 void NodeUIManager::ExecuteCommand (NodeUIManagerCommand& command, NodeUIInteractionEnvironment& interactionEnv)
 {
-	if (command.IsUndoable ()) {
+	if (command.IsUndoable () && !nodeManager.IsInBatch ()) {
 		UndoHandler::ChangeResult result = undoHandler.AddUndoStep (nodeManager);
 		HandleUndoStateChanged (result, interactionEnv);
 	}
@@ -847,9 +1115,11 @@ void NodeUIManager::Clear (NodeUIEnvironment& uiEnvironment)
 	HandleUndoStateChanged (undoResult, uiEnvironment);
 
 	nodeManager.Clear ();
+	InvalidateSpatialIndices ();
 
 	viewBox.Set (Point (0.0, 0.0), windowScale);
 	status.Reset ();
+	ResetDirtyRegion ();
 }
 
 void NodeUIManager::InvalidateDrawingsForInvalidatedNodes ()
@@ -862,14 +1132,267 @@ void NodeUIManager::InvalidateDrawingsForInvalidatedNodes ()
 		}
 		return true;
 	});
+	// nodes are reachable on several paths, so every node is invalidated only once
+	std::unordered_set<NE::NodeId> visitedNodes;
 	for (const UINodePtr& uiNode : nodesToInvalidate) {
-		InvalidateNodeDrawing (uiNode);
+		InvalidateNodeDrawingRecursive (uiNode, visitedNodes);
+	}
+	status.RequestRedraw ();
+}
+
+void NodeUIManager::InvalidateBatchNodeDrawings ()
+{
+	// every node is invalidated only once, even if it is reachable on several paths
+	std::unordered_set<NE::NodeId> visitedNodes;
+	std::vector<NE::NodeId> nodesToInvalidate;
+	batchInvalidatedNodes.Enumerate ([&] (const NE::NodeId& nodeId) {
+		if (nodeManager.ContainsNode (nodeId)) {
+			nodesToInvalidate.push_back (nodeId);
+		}
+		return true;
+	});
+	batchInvalidatedNodes.Clear ();
+
+	while (!nodesToInvalidate.empty ()) {
+		NE::NodeId nodeId = nodesToInvalidate.back ();
+		nodesToInvalidate.pop_back ();
+		if (visitedNodes.find (nodeId) != visitedNodes.end ()) {
+			continue;
+		}
+		visitedNodes.insert (nodeId);
+		UINodePtr uiNode = GetNode (nodeId);
+		uiNode->InvalidateDrawing ();
+		InvalidateSpatialIndices (nodeId);
+		InvalidateNodeGroupDrawingInternal (nodeId);
+		nodeManager.EnumerateDependentNodes (uiNode, [&] (const NE::NodeId& dependentNodeId) {
+			nodesToInvalidate.push_back (dependentNodeId);
+		});
+	}
+	status.RequestPartialRedraw ();
+}
+
+void NodeUIManager::InvalidateNodeDrawingRecursive (const UINodePtr& uiNode, std::unordered_set<NE::NodeId>& visitedNodes)
+{
+	// dependent nodes are redrawn because of their input values, they are not changed
+	if (!visitedNodes.insert (uiNode->GetId ()).second) {
+		return;
 	}
+	uiNode->InvalidateDrawing ();
+	InvalidateSpatialIndices (uiNode->GetId ());
+	InvalidateNodeGroupDrawingInternal (uiNode->GetId ());
+	nodeManager.EnumerateDependentNodes (uiNode, [&] (const NE::NodeId& dependentNodeId) {
+		UINodePtr dependentNode = GetNode (dependentNodeId);
+		InvalidateNodeDrawingRecursive (dependentNode, visitedNodes);
+	});
+	status.RequestPartialRedraw ();
+}
+
+void NodeUIManager::AddChangedNodes (const UIOutputSlotList& outputSlots)
+{
+	outputSlots.Enumerate ([&] (const NE::OutputSlotConstPtr& outputSlot) {
+		undoHandler.AddChangedNode (outputSlot->GetOwnerNodeId ());
+		return true;
+	});
+}
+
+void NodeUIManager::InvalidateSpatialIndices ()
+{
+	// the old rects are lost, so the next redraw can't be limited to the changed area
+	isSpatialIndexValid = false;
+	spatialIndexChanges.Clear ();
+	nodesBoundingRect.Invalidate ();
+	groupsBoundingRect.Invalidate ();
+	changedGroups.clear ();
 	status.RequestRedraw ();
 }
 
-void NodeUIManager::UpdateInternal (NodeUICalculationEnvironment& calcEnv, InternalUpdateMode mode)
+void NodeUIManager::InvalidateSpatialIndices (const NE::NodeId& nodeId)
+{
+	// the rect of the group depends on the rects of its nodes
+	AddDirtyNode (nodeId);
+	InvalidateNodeGroupDrawingInternal (nodeId);
+	if (isSpatialIndexValid) {
+		spatialIndexChanges.Insert (nodeId);
+	}
+}
+
+void NodeUIManager::UpdateSpatialIndices (NodeUIDrawingEnvironment& drawingEnv) const
+{
+	// the indices store the same estimated rects that are used for culling during drawing
+	if (!isSpatialIndexValid) {
+		nodeSpatialIndex.Clear ();
+		connectionSpatialIndex.Clear ();
+		nodesBoundingRect.Reset ();
+		EnumerateNodes ([&] (const UINodeConstPtr& uiNode) {
+			Rect nodeRect = uiNode->GetEstimatedExtendedRect (drawingEnv);
+			nodeSpatialIndex.Insert (uiNode->GetId (), nodeRect);
+			nodesBoundingRect.AddRect (nodeRect);
+			return true;
+		});
+		EnumerateNodes ([&] (const UINodeConstPtr& uiNode) {
+			InsertNodeConnectionsToSpatialIndex (uiNode);
+			return true;
+		});
+		spatialIndexChanges.Clear ();
+		isSpatialIndexValid = true;
+		return;
+	}
+
+	// a connection of a changed node is dropped even if its other node has also changed,
+	// so the connections are inserted back only after every node rect is up to date
+	spatialIndexChanges.Enumerate ([&] (const NE::NodeId& nodeId) {
+		connectionSpatialIndex.EraseNodeConnections (nodeId);
+		if (nodeSpatialIndex.Contains (nodeId)) {
+			nodesBoundingRect.RemoveRect (nodeSpatialIndex.GetRect (nodeId));
+		}
+		if (nodeManager.ContainsNode (nodeId)) {
+			UINodeConstPtr uiNode = GetNode (nodeId);
+			Rect nodeRect = uiNode->GetEstimatedExtendedRect (drawingEnv);
+			nodeSpatialIndex.Insert (nodeId, nodeRect);
+			nodesBoundingRect.AddRect (nodeRect);
+		} else if (nodeSpatialIndex.Contains (nodeId)) {
+			nodeSpatialIndex.Erase (nodeId);
+		}
+		return true;
+	});
+	spatialIndexChanges.Enumerate ([&] (const NE::NodeId& nodeId) {
+		if (nodeManager.ContainsNode (nodeId)) {
+			InsertNodeConnectionsToSpatialIndex (GetNode (nodeId));
+		}
+		return true;
+	});
+	spatialIndexChanges.Clear ();
+
+	// a removed rect was on the boundary, so the bounding rect may have shrunk
+	if (nodesBoundingRect.NeedToRecalculate ()) {
+		nodesBoundingRect.Reset ();
+		EnumerateNodes ([&] (const UINodeConstPtr& uiNode) {
+			nodesBoundingRect.AddRect (nodeSpatialIndex.GetRect (uiNode->GetId ()));
+			return true;
+		});
+	}
+}
+
+void NodeUIManager::UpdateLayoutParams (NodeUIDrawingEnvironment& drawingEnv)
+{
+	// the skin is changed together with invalidating every drawing, which invalidates the spatial index, too
+	if (!isSpatialIndexValid) {
+		layoutParams = NodeLayoutParams (drawingEnv);
+	}
+}
+
+void NodeUIManager::UpdateGroupsBoundingRect (NodeUIDrawingEnvironment& drawingEnv) const
+{
+	NodeUIManagerNodeRectGetter nodeRectGetter (*this, drawingEnv);
+	auto addGroupRect = [&] (const UINodeGroupConstPtr& uiGroup) {
+		groupsBoundingRect.AddRect (uiGroup->GetRect (drawingEnv, nodeRectGetter, GetGroupNodes (uiGroup)));
+	};
+
+	if (groupsBoundingRect.NeedToRecalculate ()) {
+		groupsBoundingRect.Reset ();
+		EnumerateNodeGroups ([&] (UINodeGroupConstPtr uiGroup) {
+			addGroupRect (uiGroup);
+			return true;
+		});
+	} else {
+		for (const auto& it : changedGroups) {
+			if (nodeManager.ContainsNodeGroup (it.first)) {
+				addGroupRect (it.second);
+			}
+		}
+	}
+	changedGroups.clear ();
+}
+
+void NodeUIManager::InsertNodeConnectionsToSpatialIndex (const UINodeConstPtr& uiNode) const
+{
+	// the curve can leave the bounding rect of its nodes only horizontally, at most by half of its width
+	auto insertConnection = [&] (const UIOutputSlotConstPtr& outputSlot, const UIInputSlotConstPtr& inputSlot) {
+		NE::SlotInfo outputSlotInfo (outputSlot->GetOwnerNodeId (), outputSlot->GetId ());
+		NE::SlotInfo inputSlotInfo (inputSlot->GetOwnerNodeId (), inputSlot->GetId ());
+		BoundingRect nodesBoundingRect;
+		nodesBoundingRect.AddRect (nodeSpatialIndex.GetRect (outputSlotInfo.GetNodeId ()));
+		nodesBoundingRect.AddRect (nodeSpatialIndex.GetRect (inputSlotInfo.GetNodeId ()));
+		Rect nodesRect = nodesBoundingRect.GetRect ();
+		connectionSpatialIndex.Insert (NE::ConnectionInfo (outputSlotInfo, inputSlotInfo), nodesRect.Expand (Size (nodesRect.GetWidth (), 0.0)));
+	};
+	uiNode->EnumerateUIOutputSlots ([&] (const UIOutputSlotConstPtr& outputSlot) {
+		EnumerateConnectedUIInputSlots (outputSlot, [&] (const UIInputSlotConstPtr& inputSlot) {
+			insertConnection (outputSlot, inputSlot);
+		});
+		return true;
+	});
+	uiNode->EnumerateUIInputSlots ([&] (const UIInputSlotConstPtr& inputSlot) {
+		EnumerateConnectedUIOutputSlots (inputSlot, [&] (const UIOutputSlotConstPtr& outputSlot) {
+			insertConnection (outputSlot, inputSlot);
+		});
+		return true;
+	});
+}
+
+void NodeUIManager::AddDirtyNode (const NE::NodeId& nodeId)
+{
+	// the old rects are still in the spatial indices, the new ones are added when the redraw is reported
+	if (!isSpatialIndexValid) {
+		status.RequestRedraw ();
+		return;
+	}
+	if (nodeSpatialIndex.Contains (nodeId)) {
+		dirtyModelRect.AddRect (nodeSpatialIndex.GetRect (nodeId));
+		connectionSpatialIndex.EnumerateNodeConnections (nodeId, [&] (const NE::ConnectionInfo& connection) {
+			dirtyModelRect.AddRect (connectionSpatialIndex.GetRect (connection));
+			return true;
+		});
+	}
+	dirtyNodes.Insert (nodeId);
+}
+
+bool NodeUIManager::GetDirtyViewRect (NodeUIDrawingEnvironment& drawingEnv, Rect& dirtyViewRect) const
+{
+	UpdateSpatialIndices (drawingEnv);
+
+	BoundingRect modelRect = dirtyModelRect;
+	NodeUIManagerNodeRectGetter rectGetter (*this, drawingEnv);
+	dirtyNodes.Enumerate ([&] (const NE::NodeId& nodeId) {
+		if (!nodeManager.ContainsNode (nodeId)) {
+			return true;
+		}
+		modelRect.AddRect (nodeSpatialIndex.GetRect (nodeId));
+		connectionSpatialIndex.EnumerateNodeConnections (nodeId, [&] (const NE::ConnectionInfo& connection) {
+			modelRect.AddRect (connectionSpatialIndex.GetRect (connection));
+			return true;
+		});
+		UINodeGroupConstPtr group = GetNodeGroup (nodeId);
+		if (group != nullptr) {
+			modelRect.AddRect (group->GetRect (drawingEnv, rectGetter, GetGroupNodes (group)));
+		}
+		return true;
+	});
+	if (!modelRect.IsValid ()) {
+		return false;
+	}
+
+	// the selection rect around a node has a fixed thickness in view coordinates,
+	// and a few more pixels are needed for pens and antialiasing on the boundary
+	SelectionParams selectionParams (*this, drawingEnv.GetSkinParams ());
+	double selectionThickness = selectionParams.GetThickness ();
+	Rect selectionRect = modelRect.GetRect ().Expand (Size (selectionThickness * 2.0, selectionThickness * 2.0));
+	dirtyViewRect = viewBox.ModelToView (selectionRect).Expand (Size (4.0, 4.0));
+	return true;
+}
+
+void NodeUIManager::ResetDirtyRegion ()
+{
+	dirtyModelRect = BoundingRect ();
+	dirtyNodes.Clear ();
+}
+
+void NodeUIManager::UpdateInternal (NodeUICalculationEnvironment& calcEnv, NodeUIDrawingEnvironment* drawingEnv, InternalUpdateMode mode)
 {
+	// the graph is not validated inside a batch, so it is updated only at the end
+	if (nodeManager.IsInBatch ()) {
+		return;
+	}
 	if (status.NeedToRecalculate ()) {
 		calcEnv.OnEvaluationBegin ();
 		if (mode == InternalUpdateMode::Normal) {
@@ -883,8 +1406,14 @@ void NodeUIManager::UpdateInternal (NodeUICalculationEnvironment& calcEnv, Inter
 		status.ResetRecalculate ();
 	}
 	if (status.NeedToRedraw ()) {
-		calcEnv.OnRedrawRequested ();
+		Rect dirtyViewRect;
+		if (drawingEnv != nullptr && !status.NeedToRedrawAll () && GetDirtyViewRect (*drawingEnv, dirtyViewRect)) {
+			calcEnv.OnPartialRedrawRequested (dirtyViewRect);
+		} else {
+			calcEnv.OnRedrawRequested ();
+		}
 		status.ResetRedraw ();
+		ResetDirtyRegion ();
 	}
 }
 
@@ -906,14 +1435,75 @@ void NodeUIManager::HandleUndoStateChanged (UndoHandler::ChangeResult changeResu
 NE::Stream::Status NodeUIManager::Read (NE::InputStream& inputStream)
 {
 	NE::ObjectHeader header (inputStream);
-	nodeManager.Read (inputStream);
+	if (nodeManager.Read (inputStream) != NE::Stream::Status::NoError) {
+		return inputStream.GetStatus ();
+	}
+	if (header.GetVersion () >= 2) {
+		NodeLayoutParams rectLayoutParams;
+		rectLayoutParams.Read (inputStream);
+		ReadNodeRectIndex (inputStream, rectLayoutParams == layoutParams);
+	}
 	return inputStream.GetStatus ();
 }
 
-NE::Stream::Status NodeUIManager::Write (NE::OutputStream& outputStream) const
+NE::Stream::Status NodeUIManager::Write (NE::OutputStream& outputStream, NE::NodeManager::NodeRecordMode recordMode) const
 {
 	NE::ObjectHeader header (outputStream, serializationInfo);
-	nodeManager.Write (outputStream);
+	nodeManager.Write (outputStream, recordMode);
+	layoutParams.Write (outputStream);
+	WriteNodeRectIndex (outputStream);
+	return outputStream.GetStatus ();
+}
+
+NE::Stream::Status NodeUIManager::ReadNodeRectIndex (NE::InputStream& inputStream, bool useRects)
+{
+	// rects calculated with other skin or fonts would place the nodes wrong in the spatial index
+	size_t nodeCount = 0;
+	inputStream.Read (nodeCount);
+	for (size_t i = 0; i < nodeCount; i++) {
+		NE::NodeId nodeId;
+		Rect nodeRect;
+		Rect extendedNodeRect;
+		nodeId.Read (inputStream);
+		ReadRect (inputStream, nodeRect);
+		ReadRect (inputStream, extendedNodeRect);
+		if (inputStream.GetStatus () != NE::Stream::Status::NoError) {
+			return inputStream.GetStatus ();
+		}
+		if (!useRects) {
+			continue;
+		}
+		UINodePtr uiNode = GetNode (nodeId);
+		if (DBGERROR (uiNode == nullptr)) {
+			return NE::Stream::Status::Error;
+		}
+		uiNode->SetLocalRectsHint (nodeRect, extendedNodeRect);
+	}
+	return inputStream.GetStatus ();
+}
+
+NE::Stream::Status NodeUIManager::WriteNodeRectIndex (NE::OutputStream& outputStream) const
+{
+	// only nodes with known rects are written, so saving never needs a drawing environment
+	Rect nodeRect;
+	Rect extendedNodeRect;
+	size_t nodeCount = 0;
+	EnumerateNodes ([&] (UINodeConstPtr uiNode) {
+		if (uiNode->GetLocalRects (nodeRect, extendedNodeRect)) {
+			nodeCount++;
+		}
+		return true;
+	});
+
+	outputStream.Write (nodeCount);
+	EnumerateNodes ([&] (UINodeConstPtr uiNode) {
+		if (uiNode->GetLocalRects (nodeRect, extendedNodeRect)) {
+			uiNode->GetId ().Write (outputStream);
+			WriteRect (outputStream, nodeRect);
+			WriteRect (outputStream, extendedNodeRect);
+		}
+		return true;
+	});
 	return outputStream.GetStatus ();
 }
 
@@ -10,6 +10,9 @@
 #include "NUIE_UndoHandler.hpp"
 #include "NUIE_Selection.hpp"
 #include "NUIE_ViewBox.hpp"
+#include "NUIE_SpatialIndex.hpp"
+#include "NUIE_ConnectionSpatialIndex.hpp"
+#include "NUIE_NodeLayoutParams.hpp"
 
 #include <unordered_map>
 #include <unordered_set>
@@ -104,6 +107,10 @@ public:
 	NodeUIManager&					operator= (const NodeUIManager& rhs) = delete;
 	NodeUIManager&					operator= (NodeUIManager&& rhs) = delete;
 
+	void							BeginBatch (NodeUIInteractionEnvironment& interactionEnv);
+	bool							EndBatch (NodeUIInteractionEnvironment& interactionEnv);
+	bool							IsInBatch () const;
+
 	UINodePtr						AddNode (const UINodePtr& uiNode);
 	bool							DeleteNode (const UINodePtr& uiNode, NE::EvaluationEnv& evalEnv, NodeUIInteractionEnvironment& interactionEnv);
 	bool							DeleteNode (const NE::NodeId& nodeId, NE::EvaluationEnv& evalEnv, NodeUIInteractionEnvironment& interactionEnv);
@@ -138,6 +145,9 @@ public:
 	void							EnumerateUIConnections (const std::function<void (UIOutputSlotConstPtr, UIInputSlotConstPtr)>& processor) const;
 	void							EnumerateUIConnections (const NE::NodeCollection& nodes, const std::function<void (UIOutputSlotConstPtr, UIInputSlotConstPtr)>& processor) const;
 
+	template <class Processor>
+	void							EnumerateConnectedUIInputSlots (const UIOutputSlotConstPtr& outputSlot, const Processor& processor) const;
+
 	bool							ContainsNode (const NE::NodeId& nodeId) const;
 	std::vector<UINodeConstPtr>		FindNodes (const UINodeFilter& nodeFilter) const;
 	UINodePtr						GetNode (const NE::NodeId& nodeId);
@@ -146,6 +156,19 @@ public:
 	void							EnumerateNodes (const std::function<bool (UINodePtr)>& processor);
 	void							EnumerateNodes (const std::function<bool (UINodeConstPtr)>& processor) const;
 
+	template <class Processor>
+	void							EnumerateNodes (const Processor& processor);
+
+	template <class Processor>
+	void							EnumerateNodes (const Processor& processor) const;
+
+	void							EnumerateNodesInRect (NodeUIDrawingEnvironment& drawingEnv, const Rect& modelRect, const std::function<bool (UINodePtr)>& processor);
+	void							EnumerateNodesInRect (NodeUIDrawingEnvironment& drawingEnv, const Rect& modelRect, const std::function<bool (UINodeConstPtr)>& processor) const;
+	void							EnumerateNodesInRect (NodeUIDrawingEnvironment& drawingEnv, const Rect& modelRect, const NE::NodeCollection& additionalNodes, const std::function<bool (UINodeConstPtr)>& processor) const;
+	void							EnumerateNodesWithOutdatedRect (const std::function<bool (UINodeConstPtr)>& processor) const;
+	void							EnumerateConnectionsInRect (NodeUIDrawingEnvironment& drawingEnv, const Rect& modelRect, const std::function<void (UIOutputSlotConstPtr, UIInputSlotConstPtr)>& processor) const;
+	void							EnumerateConnectionsInRect (NodeUIDrawingEnvironment& drawingEnv, const Rect& modelRect, const NE::NodeCollection& additionalNodes, const std::function<void (UIOutputSlotConstPtr, UIInputSlotConstPtr)>& processor) const;
+
 	void							RequestRecalculateAndRedraw ();
 	void							RequestRecalculate ();
 	void							RequestRedraw ();
@@ -159,10 +182,15 @@ public:
 	void							InvalidateNodeDrawing (const UINodePtr& uiNode);
 	void							InvalidateNodeGroupDrawing (const NE::NodeId& nodeId);
 	void							InvalidateNodeGroupDrawing (const UINodePtr& uiNode);
+	void							InvalidateNodeGroupDrawing (const UINodeGroupConstPtr& group);
+	void							InvalidateNodePosition (const UINodePtr& uiNode);
 
 	void							Update (NodeUICalculationEnvironment& calcEnv);
+	void							Update (NodeUICalculationEnvironment& calcEnv, NodeUIDrawingEnvironment& drawingEnv);
 	void							ManualUpdate (NodeUICalculationEnvironment& calcEnv);
+	void							ManualUpdate (NodeUICalculationEnvironment& calcEnv, NodeUIDrawingEnvironment& drawingEnv);
 	void							Draw (NodeUIDrawingEnvironment& drawingEnv, const NodeDrawingModifier* drawingModifier);
+	void							Draw (NodeUIDrawingEnvironment& drawingEnv, const NodeDrawingModifier* drawingModifier, const Rect& dirtyViewRect);
 	void							ResizeContext (NodeUIDrawingEnvironment& drawingEnv, int newWidth, int newHeight);
 
 	bool							GetBoundingRect (NodeUIDrawingEnvironment& drawingEnv, Rect& rect) const;
@@ -173,6 +201,7 @@ public:
 	const ViewBox&					GetViewBox () const;
 	void							SetViewBox (const ViewBox& newViewBox);
 	bool							IsPreviewMode () const;
+	NodeDetailLevel					GetDetailLevel () const;
 
 	UpdateMode						GetUpdateMode () const;
 	void							SetUpdateMode (UpdateMode newUpdateMode);
@@ -180,6 +209,7 @@ public:
 	void							New (NodeUIEnvironment& uiEnvironment);
 	bool							Open (NodeUIEnvironment& uiEnvironment, NE::InputStream& inputStream);
 	bool							Save (NE::OutputStream& outputStream);
+	bool							Save (NE::OutputStream& outputStream, NE::NodeManager::NodeRecordMode recordMode);
 	bool							NeedToSave () const;
 
 	bool							Copy (const NE::NodeCollection& nodeCollection, NE::NodeManager& result) const;
@@ -190,6 +220,7 @@ public:
 	bool							CanRedo () const;
 	void							Undo (NE::EvaluationEnv& evalEnv, NodeUIInteractionEnvironment& interactionEnv);
 	void							Redo (NE::EvaluationEnv& evalEnv, NodeUIInteractionEnvironment& interactionEnv);
+	void							SetUndoHistoryLimits (size_t liveStepCount, size_t memoryBudget);
 
 	UINodeGroupPtr					AddNodeGroup (const UINodeGroupPtr& group);
 	void							DeleteNodeGroup (const UINodeGroupPtr& group);
@@ -218,8 +249,10 @@ private:
 		bool	NeedToRecalculate () const;
 
 		void	RequestRedraw ();
+		void	RequestPartialRedraw ();
 		void	ResetRedraw ();
 		bool	NeedToRedraw () const;
+		bool	NeedToRedrawAll () const;
 
 		void	RequestSave ();
 		void	ResetSave ();
@@ -228,6 +261,7 @@ private:
 	private:
 		bool	needToRecalculate;
 		bool	needToRedraw;
+		bool	needToRedrawAll;
 		bool	needToSave;
 	};
 
@@ -239,20 +273,72 @@ private:
 
 	void				Clear (NodeUIEnvironment& uiEnvironment);
 	void				InvalidateDrawingsForInvalidatedNodes ();
-	void				UpdateInternal (NodeUICalculationEnvironment& calcEnv, InternalUpdateMode mode);
+	void				InvalidateNodeDrawingRecursive (const UINodePtr& uiNode, std::unordered_set<NE::NodeId>& visitedNodes);
+	void				InvalidateBatchNodeDrawings ();
+	void				InvalidateNodeGroupDrawingInternal (const NE::NodeId& nodeId);
+	void				InvalidateNodeGroupDrawingInternal (const UINodeGroupConstPtr& group);
+	void				AddChangedNodes (const UIOutputSlotList& outputSlots);
+	void				InvalidateSpatialIndices ();
+	void				InvalidateSpatialIndices (const NE::NodeId& nodeId);
+	void				UpdateSpatialIndices (NodeUIDrawingEnvironment& drawingEnv) const;
+	void				UpdateLayoutParams (NodeUIDrawingEnvironment& drawingEnv);
+	void				UpdateGroupsBoundingRect (NodeUIDrawingEnvironment& drawingEnv) const;
+	void				InsertNodeConnectionsToSpatialIndex (const UINodeConstPtr& uiNode) const;
+	void				AddDirtyNode (const NE::NodeId& nodeId);
+	bool				GetDirtyViewRect (NodeUIDrawingEnvironment& drawingEnv, Rect& dirtyViewRect) const;
+	void				ResetDirtyRegion ();
+	void				UpdateInternal (NodeUICalculationEnvironment& calcEnv, NodeUIDrawingEnvironment* drawingEnv, InternalUpdateMode mode);
 	void				HandleSelectionChanged (Selection::ChangeResult changeResult, NodeUIInteractionEnvironment& interactionEnv);
 	void				HandleUndoStateChanged (UndoHandler::ChangeResult changeResult, NodeUIInteractionEnvironment& interactionEnv);
 
 	NE::Stream::Status	Read (NE::InputStream& inputStream);
-	NE::Stream::Status	Write (NE::OutputStream& outputStream) const;
-
-	NE::NodeManager		nodeManager;
-	UndoHandler			undoHandler;
-	Selection			selection;
-	ViewBox				viewBox;
-	Status				status;
+	NE::Stream::Status	Write (NE::OutputStream& outputStream, NE::NodeManager::NodeRecordMode recordMode) const;
+	NE::Stream::Status	ReadNodeRectIndex (NE::InputStream& inputStream, bool useRects);
+	NE::Stream::Status	WriteNodeRectIndex (NE::OutputStream& outputStream) const;
+
+	NE::NodeManager				nodeManager;
+	UndoHandler					undoHandler;
+	Selection					selection;
+	ViewBox						viewBox;
+	Status						status;
+	NE::NodeCollection			batchInvalidatedNodes;
+	NodeLayoutParams			layoutParams;
+
+	mutable SpatialIndex<NE::NodeId>	nodeSpatialIndex;
+	mutable ConnectionSpatialIndex		connectionSpatialIndex;
+	mutable NE::NodeCollection			spatialIndexChanges;
+	mutable bool						isSpatialIndexValid;
+	mutable IncrementalBoundingRect		nodesBoundingRect;
+	mutable IncrementalBoundingRect		groupsBoundingRect;
+	mutable std::unordered_map<NE::NodeGroupId, UINodeGroupConstPtr>	changedGroups;
+	BoundingRect						dirtyModelRect;
+	NE::NodeCollection					dirtyNodes;
 };
 
+template <class Processor>
+void NodeUIManager::EnumerateConnectedUIInputSlots (const UIOutputSlotConstPtr& outputSlot, const Processor& processor) const
+{
+	nodeManager.EnumerateConnectedInputSlots (outputSlot, [&] (const NE::InputSlotConstPtr& inputSlot) {
+		processor (std::dynamic_pointer_cast<const UIInputSlot> (inputSlot));
+	});
+}
+
+template <class Processor>
+void NodeUIManager::EnumerateNodes (const Processor& processor)
+{
+	nodeManager.EnumerateNodes ([&] (const NE::NodePtr& node) {
+		return processor (std::static_pointer_cast<UINode> (node));
+	});
+}
+
+template <class Processor>
+void NodeUIManager::EnumerateNodes (const Processor& processor) const
+{
+	nodeManager.EnumerateNodes ([&] (const NE::NodeConstPtr& node) {
+		return processor (std::static_pointer_cast<const UINode> (node));
+	});
+}
+
 }
 
 #endif
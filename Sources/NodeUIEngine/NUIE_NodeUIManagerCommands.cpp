@@ -72,13 +72,13 @@ MoveNodesCommand::MoveNodesCommand (const NE::NodeCollection& nodes, const Point
 
 void MoveNodesCommand::Do (NodeUIManager& uiManager)
 {
-	for (size_t i = 0; i < nodes.Count (); i++) {
-		const NE::NodeId& nodeId = nodes.Get (i);
+	nodes.Enumerate ([&] (const NE::NodeId& nodeId) {
 		UINodePtr uiNode = uiManager.GetNode (nodeId);
 		uiNode->SetPosition (uiNode->GetPosition () + offset);
+		uiManager.InvalidateNodePosition (uiNode);
 		uiManager.InvalidateNodeGroupDrawing (uiNode);
-	}
-	uiManager.RequestRedraw ();
+		return true;
+	});
 }
 
 MoveNodesWithOffsetsCommand::MoveNodesWithOffsetsCommand (const std::unordered_map<NE::NodeId, Point>& offsets) :
@@ -94,9 +94,9 @@ void MoveNodesWithOffsetsCommand::Do (NodeUIManager& uiManager)
 		const Point& offset = nodeOffset.second;
 		UINodePtr uiNode = uiManager.GetNode (nodeId);
 		uiNode->SetPosition (uiNode->GetPosition () + offset);
+		uiManager.InvalidateNodePosition (uiNode);
 		uiManager.InvalidateNodeGroupDrawing (uiNode);
 	}
-	uiManager.RequestRedraw ();
 }
 
 CopyMoveNodesCommand::CopyMoveNodesCommand (NodeUIEnvironment& uiEnvironment, const NE::NodeCollection& nodes, const Point& offset) :
@@ -113,6 +113,7 @@ void CopyMoveNodesCommand::Do (NodeUIManager& uiManager)
 	duplicatedNodes.Enumerate ([&] (const NE::NodeId& nodeId) {
 		UINodePtr uiNode = uiManager.GetNode (nodeId);
 		uiNode->SetPosition (uiNode->GetPosition () + offset);
+		uiManager.InvalidateNodePosition (uiNode);
 		return true;
 	});
 	Selection newSelection;
@@ -322,6 +323,7 @@ void PasteNodesCommand::Do (NodeUIManager& uiManager)
 	for (UINodePtr& uiNode : newNodes) {
 		Point nodePosition = uiNode->GetPosition ();
 		uiNode->SetPosition (nodePosition + nodeOffset);
+		uiManager.InvalidateNodePosition (uiNode);
 		newSelection.AddNode (uiNode->GetId ());
 	}
 
@@ -2,20 +2,11 @@
 #include "NUIE_ContextDecorators.hpp"
 #include "NUIE_EnvironmentDecorators.hpp"
 #include "NUIE_SkinParams.hpp"
-
-#include <cmath>
+#include "NUIE_ParallelDrawingImageBuilder.hpp"
 
 namespace NUIE
 {
 
-static void GetBezierControlPoints (const Point& beg, const Point& end, Point& controlPoint1, Point& controlPoint2)
-{
-	double bezierOffsetVal = std::fabs (beg.GetX () - end.GetX ()) / 2.0;
-	Point bezierOffset (bezierOffsetVal, 0.0);
-	controlPoint1 = beg + bezierOffset;
-	controlPoint2 = end - bezierOffset;
-}
-
 SelectionParams::SelectionParams (const NodeUIManager& uiManager, const SkinParams& skinParams) :
 	thickness (0.0)
 {
@@ -32,16 +23,30 @@ double SelectionParams::GetThickness () const
 }
 
 NodeUIManagerDrawer::NodeUIManagerDrawer (const NodeUIManager& uiManager) :
-	uiManager (uiManager)
+	uiManager (uiManager),
+	hasDirtyViewRect (false),
+	dirtyViewRect ()
 {
 	
 }
-	
+
+NodeUIManagerDrawer::NodeUIManagerDrawer (const NodeUIManager& uiManager, const Rect& dirtyViewRect) :
+	uiManager (uiManager),
+	hasDirtyViewRect (true),
+	dirtyViewRect (dirtyViewRect)
+{
+
+}
+
 void NodeUIManagerDrawer::Draw (NodeUIDrawingEnvironment& drawingEnv, const NodeDrawingModifier* drawModifier) const
 {
 	DrawingContext& drawingContext = drawingEnv.GetDrawingContext ();
-	
+	BuildMissingDrawingImages (drawingEnv);
+
 	drawingContext.BeginDraw ();
+	if (IsClipped (drawingEnv)) {
+		drawingContext.SetClipRect (dirtyViewRect);
+	}
 	DrawBackground (drawingEnv);
 
 	{
@@ -56,9 +61,41 @@ void NodeUIManagerDrawer::Draw (NodeUIDrawingEnvironment& drawingEnv, const Node
 	}
 
 	DrawSelectionRect (drawingEnv, drawModifier);
+	if (IsClipped (drawingEnv)) {
+		drawingContext.ResetClipRect ();
+	}
 	drawingContext.EndDraw ();
 }
 
+void NodeUIManagerDrawer::BuildMissingDrawingImages (NodeUIDrawingEnvironment& drawingEnv) const
+{
+	// a node without rect hint needs its drawing image to get its rect, such a node always waits for a spatial index
+	// update, other nodes need it only if they are visible in full detail, and they are found in the spatial index,
+	// everything else that turns out to be needed is still built lazily while drawing
+	std::vector<UINodeConstPtr> uiNodes;
+	uiManager.EnumerateNodesWithOutdatedRect ([&] (UINodeConstPtr uiNode) {
+		Rect nodeRect;
+		Rect extendedNodeRect;
+		if (!uiNode->GetLocalRects (nodeRect, extendedNodeRect)) {
+			uiNodes.push_back (uiNode);
+		}
+		return true;
+	});
+	BuildNodeDrawingImages (drawingEnv, uiNodes);
+
+	if (uiManager.GetDetailLevel () == NodeDetailLevel::Minimal) {
+		return;
+	}
+	uiNodes.clear ();
+	uiManager.EnumerateNodesInRect (drawingEnv, GetVisibleModelRect (drawingEnv), [&] (UINodeConstPtr uiNode) {
+		if (!uiNode->HasDrawingImage ()) {
+			uiNodes.push_back (uiNode);
+		}
+		return true;
+	});
+	BuildNodeDrawingImages (drawingEnv, uiNodes);
+}
+
 void NodeUIManagerDrawer::DrawBackground (NodeUIDrawingEnvironment& drawingEnv) const
 {
 	DrawingContext& drawingContext = drawingEnv.GetDrawingContext ();
@@ -105,40 +142,47 @@ void NodeUIManagerDrawer::DrawGroups (NodeUIDrawingEnvironment& drawingEnv, cons
 
 void NodeUIManagerDrawer::DrawConnections (NodeUIDrawingEnvironment& drawingEnv, const SelectionParams& selectionParams, const NodeDrawingModifier* drawModifier) const
 {
+	if (uiManager.GetDetailLevel () == NodeDetailLevel::Minimal) {
+		DrawMinimalConnections (drawingEnv, selectionParams, drawModifier);
+		return;
+	}
+
 	const SkinParams& skinParams = drawingEnv.GetSkinParams ();
 	const Pen& normalPen = skinParams.GetConnectionLinePen ();
 	Pen selectionPen (skinParams.GetNodeSelectionRectPen ().GetColor (), selectionParams.GetThickness ());
 
 	const Selection& selection = uiManager.GetSelection ();
 	const NE::NodeCollection& selectedNodes = selection.GetNodes ();
-	uiManager.EnumerateNodes ([&] (UINodeConstPtr begNode) {
+	NE::NodeCollection offsetNodes = GetOffsetNodes (drawModifier);
+	Rect modelRect = GetVisibleModelRect (drawingEnv);
+	uiManager.EnumerateConnectionsInRect (drawingEnv, modelRect, offsetNodes, [&] (UIOutputSlotConstPtr outputSlot, UIInputSlotConstPtr inputSlot) {
+		UINodeConstPtr begNode = uiManager.GetNode (outputSlot->GetOwnerNodeId ());
+		UINodeConstPtr endNode = uiManager.GetNode (inputSlot->GetOwnerNodeId ());
+		if (DBGERROR (begNode == nullptr || endNode == nullptr)) {
+			return;
+		}
+		if (!drawModifier->NeedToDrawConnection (begNode->GetId (), outputSlot->GetId (), endNode->GetId (), inputSlot->GetId ())) {
+			return;
+		}
+		Rect begNodeRect = GetExtendedNodeRect (drawingEnv, drawModifier, begNode);
+		Rect endNodeRect = GetExtendedNodeRect (drawingEnv, drawModifier, endNode);
+		if (!IsConnectionVisible (drawingEnv, begNodeRect, endNodeRect)) {
+			return;
+		}
 		bool begSelected = selectedNodes.Contains (begNode->GetId ());
-		begNode->EnumerateUIOutputSlots ([&] (UIOutputSlotConstPtr outputSlot) {
-			Point beg = GetOutputSlotConnPosition (drawingEnv, drawModifier, begNode, outputSlot->GetId ());
-			uiManager.EnumerateConnectedUIInputSlots (outputSlot, [&] (UIInputSlotConstPtr inputSlot) {
-				UINodeConstPtr endNode = uiManager.GetNode (inputSlot->GetOwnerNodeId ());
-				if (DBGERROR (endNode == nullptr)) {
-					return;
-				}
-				if (!drawModifier->NeedToDrawConnection (begNode->GetId (), outputSlot->GetId (), endNode->GetId (), inputSlot->GetId ())) {
-					return;
-				}
-				bool endSelected = selectedNodes.Contains (endNode->GetId ());
-				Point end = GetInputSlotConnPosition (drawingEnv, drawModifier, endNode, inputSlot->GetId ());
-				if (!IsConnectionVisible (drawingEnv, beg, end)) {
-					return;
-				}
-				if (begSelected || endSelected) {
-					DrawConnection (drawingEnv, selectionPen, beg, end);
-				} else {
-					if (inputSlot->GetConnectionDisplayMode () == ConnectionDisplayMode::Normal) {
-						DrawConnection (drawingEnv, normalPen, beg, end);
-					}
-				}
-			});
-			return true;
-		});
-		return true;
+		bool endSelected = selectedNodes.Contains (endNode->GetId ());
+		Point beg = GetOutputSlotConnPosition (drawingEnv, drawModifier, begNode, outputSlot->GetId ());
+		Point end = GetInputSlotConnPosition (drawingEnv, drawModifier, endNode, inputSlot->GetId ());
+		if (!IsConnectionVisible (drawingEnv, beg, end)) {
+			return;
+		}
+		if (begSelected || endSelected) {
+			DrawConnection (drawingEnv, selectionPen, beg, end);
+		} else {
+			if (inputSlot->GetConnectionDisplayMode () == ConnectionDisplayMode::Normal) {
+				DrawConnection (drawingEnv, normalPen, beg, end);
+			}
+		}
 	});
 
 	if (drawModifier != nullptr) {
@@ -154,10 +198,59 @@ void NodeUIManagerDrawer::DrawConnection (NodeUIDrawingEnvironment& drawingEnv,
 {
 	DrawingContext& context = drawingEnv.GetDrawingContext ();
 	Point controlPoint1, controlPoint2;
-	GetBezierControlPoints (beg, end, controlPoint1, controlPoint2);
+	GetConnectionBezierControlPoints (beg, end, controlPoint1, controlPoint2);
 	context.DrawBezier (beg, controlPoint1, controlPoint2, end, pen);
 }
 
+void NodeUIManagerDrawer::DrawMinimalConnections (NodeUIDrawingEnvironment& drawingEnv, const SelectionParams& selectionParams, const NodeDrawingModifier* drawModifier) const
+{
+	// straight lines between node rects, so slot positions and curves are not needed at all
+	const SkinParams& skinParams = drawingEnv.GetSkinParams ();
+	const Pen& normalPen = skinParams.GetConnectionLinePen ();
+	Pen selectionPen (skinParams.GetNodeSelectionRectPen ().GetColor (), selectionParams.GetThickness ());
+
+	const NE::NodeCollection& selectedNodes = uiManager.GetSelection ().GetNodes ();
+	NE::NodeCollection offsetNodes = GetOffsetNodes (drawModifier);
+	Rect modelRect = GetVisibleModelRect (drawingEnv);
+	std::vector<Point> normalLines;
+	std::vector<Point> selectedLines;
+	uiManager.EnumerateConnectionsInRect (drawingEnv, modelRect, offsetNodes, [&] (UIOutputSlotConstPtr outputSlot, UIInputSlotConstPtr inputSlot) {
+		UINodeConstPtr begNode = uiManager.GetNode (outputSlot->GetOwnerNodeId ());
+		UINodeConstPtr endNode = uiManager.GetNode (inputSlot->GetOwnerNodeId ());
+		if (DBGERROR (begNode == nullptr || endNode == nullptr)) {
+			return;
+		}
+		if (!drawModifier->NeedToDrawConnection (begNode->GetId (), outputSlot->GetId (), endNode->GetId (), inputSlot->GetId ())) {
+			return;
+		}
+		Rect begNodeRect = GetNodeRect (drawingEnv, drawModifier, begNode);
+		Rect endNodeRect = GetNodeRect (drawingEnv, drawModifier, endNode);
+		Point beg (begNodeRect.GetRight (), begNodeRect.GetCenter ().GetY ());
+		Point end (endNodeRect.GetLeft (), endNodeRect.GetCenter ().GetY ());
+		BoundingRect lineRect;
+		lineRect.AddPoint (beg);
+		lineRect.AddPoint (end);
+		if (!IsRectVisible (drawingEnv, lineRect.GetRect ())) {
+			return;
+		}
+		if (selectedNodes.Contains (begNode->GetId ()) || selectedNodes.Contains (endNode->GetId ())) {
+			selectedLines.push_back (beg);
+			selectedLines.push_back (end);
+		} else if (inputSlot->GetConnectionDisplayMode () == ConnectionDisplayMode::Normal) {
+			normalLines.push_back (beg);
+			normalLines.push_back (end);
+		}
+	});
+
+	DrawingContext& context = drawingEnv.GetDrawingContext ();
+	if (!normalLines.empty ()) {
+		context.DrawLines (normalLines, normalPen);
+	}
+	if (!selectedLines.empty ()) {
+		context.DrawLines (selectedLines, selectionPen);
+	}
+}
+
 void NodeUIManagerDrawer::DrawTemporaryConnection (NodeUIDrawingEnvironment& drawingEnv, const Pen& pen, const Point& beg, const Point& end, NodeDrawingModifier::Direction dir) const
 {
 	const SkinParams& skinParams = drawingEnv.GetSkinParams ();
@@ -180,7 +273,10 @@ void NodeUIManagerDrawer::DrawTemporaryConnection (NodeUIDrawingEnvironment& dra
 
 void NodeUIManagerDrawer::DrawNodes (NodeUIDrawingEnvironment& drawingEnv, const SelectionParams& selectionParams, const NodeDrawingModifier* drawModifier) const
 {
-	uiManager.EnumerateNodes ([&] (UINodeConstPtr uiNode) {
+	NE::NodeCollection offsetNodes = GetOffsetNodes (drawModifier);
+	double selectionThickness = selectionParams.GetThickness ();
+	Rect modelRect = GetVisibleModelRect (drawingEnv).Expand (Size (selectionThickness * 2.0, selectionThickness * 2.0));
+	uiManager.EnumerateNodesInRect (drawingEnv, modelRect, offsetNodes, [&] (UINodeConstPtr uiNode) {
 		if (!IsNodeVisible (drawingEnv, selectionParams, drawModifier, uiNode)) {
 			return true;
 		}
@@ -218,6 +314,7 @@ void NodeUIManagerDrawer::DrawNode (NodeUIDrawingEnvironment& drawingEnv, const
 
 void NodeUIManagerDrawer::DrawNode (NodeUIDrawingEnvironment& drawingEnv, const SelectionParams& selectionParams, SelectionMode selectionMode, const UINodeConstPtr& uiNode) const
 {
+	NodeDetailLevel detailLevel = uiManager.GetDetailLevel ();
 	if (selectionMode == SelectionMode::Selected) {
 		Rect nodeRect = uiNode->GetRect (drawingEnv);
 		double selectionThickness = selectionParams.GetThickness ();
@@ -225,9 +322,9 @@ void NodeUIManagerDrawer::DrawNode (NodeUIDrawingEnvironment& drawingEnv, const
 		drawingEnv.GetDrawingContext ().FillRect (selectionRect, drawingEnv.GetSkinParams ().GetNodeSelectionRectPen ().GetColor ());
 		ColorBlenderContextDecorator selectionContext (drawingEnv.GetDrawingContext (), drawingEnv.GetSkinParams ().GetSelectionBlendColor ());
 		DrawingEnvironmentContextDecorator selectionEnv (drawingEnv, selectionContext);
-		uiNode->Draw (selectionEnv);
+		uiNode->Draw (selectionEnv, detailLevel);
 	} else {
-		uiNode->Draw (drawingEnv);
+		uiNode->Draw (drawingEnv, detailLevel);
 	}
 }
 
@@ -243,11 +340,21 @@ void NodeUIManagerDrawer::DrawSelectionRect (NodeUIDrawingEnvironment& drawingEn
 bool NodeUIManagerDrawer::IsConnectionVisible (NodeUIDrawingEnvironment& drawingEnv, const Point& beg, const Point& end) const
 {
 	Point controlPoint1, controlPoint2;
-	GetBezierControlPoints (beg, end, controlPoint1, controlPoint2);
+	GetConnectionBezierControlPoints (beg, end, controlPoint1, controlPoint2);
 	Rect boundingRect = GetBezierBoundingRect (beg, controlPoint1, controlPoint2, end);
 	return IsRectVisible (drawingEnv, boundingRect);
 }
 
+bool NodeUIManagerDrawer::IsConnectionVisible (NodeUIDrawingEnvironment& drawingEnv, const Rect& begNodeRect, const Rect& endNodeRect) const
+{
+	// the curve can leave the bounding rect of its nodes only horizontally, at most by half of its width
+	BoundingRect nodesBoundingRect;
+	nodesBoundingRect.AddRect (begNodeRect);
+	nodesBoundingRect.AddRect (endNodeRect);
+	Rect nodesRect = nodesBoundingRect.GetRect ();
+	return IsRectVisible (drawingEnv, nodesRect.Expand (Size (nodesRect.GetWidth (), 0.0)));
+}
+
 bool NodeUIManagerDrawer::IsNodeVisible (NodeUIDrawingEnvironment& drawingEnv, const SelectionParams& selectionParams, const NodeDrawingModifier* drawModifier, const UINodeConstPtr& uiNode) const
 {
 	Rect boundingRect = GetExtendedNodeRect (drawingEnv, drawModifier, uiNode);
@@ -262,18 +369,51 @@ bool NodeUIManagerDrawer::IsRectVisible (NodeUIDrawingEnvironment& drawingEnv, c
 {
 	const ViewBox& viewBox = uiManager.GetViewBox ();
 	const DrawingContext& context = drawingEnv.GetDrawingContext ();
-	return Rect::IsInBounds (viewBox.ModelToView (rect), context.GetWidth (), context.GetHeight ());
+	Rect viewRect = viewBox.ModelToView (rect);
+	if (!Rect::IsInBounds (viewRect, context.GetWidth (), context.GetHeight ())) {
+		return false;
+	}
+	if (IsClipped (drawingEnv)) {
+		return Rect::IsOverlapping (viewRect, dirtyViewRect);
+	}
+	return true;
+}
+
+bool NodeUIManagerDrawer::IsClipped (NodeUIDrawingEnvironment& drawingEnv) const
+{
+	// a context that can't clip draws everything, so nothing can be skipped
+	return hasDirtyViewRect && drawingEnv.GetDrawingContext ().CanClip ();
+}
+
+Rect NodeUIManagerDrawer::GetVisibleModelRect (NodeUIDrawingEnvironment& drawingEnv) const
+{
+	const DrawingContext& context = drawingEnv.GetDrawingContext ();
+	Rect viewRect = Rect::FromPositionAndSize (Point (0.0, 0.0), Size (context.GetWidth (), context.GetHeight ()));
+	if (IsClipped (drawingEnv)) {
+		viewRect = dirtyViewRect;
+	}
+	return uiManager.GetViewBox ().ViewToModel (viewRect);
+}
+
+NE::NodeCollection NodeUIManagerDrawer::GetOffsetNodes (const NodeDrawingModifier* drawModifier) const
+{
+	// offset nodes are drawn at a different position, so they are checked regardless of their model rect
+	NE::NodeCollection offsetNodes;
+	drawModifier->EnumerateOffsetNodes ([&] (const NE::NodeId& nodeId) {
+		offsetNodes.Insert (nodeId);
+	});
+	return offsetNodes;
 }
 
 Rect NodeUIManagerDrawer::GetNodeRect (NodeUIDrawingEnvironment& drawingEnv, const NodeDrawingModifier* drawModifier, const UINodeConstPtr& uiNode) const
 {
-	Rect nodeRect = uiNode->GetRect (drawingEnv);
+	Rect nodeRect = uiNode->GetEstimatedRect (drawingEnv);
 	return nodeRect.Offset (drawModifier->GetNodeOffset (uiNode->GetId ()));
 }
 
 Rect NodeUIManagerDrawer::GetExtendedNodeRect (NodeUIDrawingEnvironment& drawingEnv, const NodeDrawingModifier* drawModifier, const UINodeConstPtr& uiNode) const
 {
-	Rect nodeRect = uiNode->GetExtendedRect (drawingEnv);
+	Rect nodeRect = uiNode->GetEstimatedExtendedRect (drawingEnv);
 	return nodeRect.Offset (drawModifier->GetNodeOffset (uiNode->GetId ()));
 }
 
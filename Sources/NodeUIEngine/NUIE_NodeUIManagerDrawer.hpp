@@ -22,7 +22,8 @@ class NodeUIManagerDrawer
 {
 public:
 	NodeUIManagerDrawer (const NodeUIManager& uiManager);
-	
+	NodeUIManagerDrawer (const NodeUIManager& uiManager, const Rect& dirtyViewRect);
+
 	void Draw (NodeUIDrawingEnvironment& drawingEnv, const NodeDrawingModifier* drawModifier) const;
 
 private:
@@ -32,10 +33,12 @@ private:
 		NotSelected
 	};
 
+	void	BuildMissingDrawingImages (NodeUIDrawingEnvironment& drawingEnv) const;
 	void	DrawBackground (NodeUIDrawingEnvironment& drawingEnv) const;
 	void	DrawGroups (NodeUIDrawingEnvironment& drawingEnv, const NodeDrawingModifier* drawModifier) const;
 	void	DrawConnections (NodeUIDrawingEnvironment& drawingEnv, const SelectionParams& selectionParams, const NodeDrawingModifier* drawModifier) const;
 	void	DrawConnection (NodeUIDrawingEnvironment& drawingEnv, const Pen& pen, const Point& beg, const Point& end) const;
+	void	DrawMinimalConnections (NodeUIDrawingEnvironment& drawingEnv, const SelectionParams& selectionParams, const NodeDrawingModifier* drawModifier) const;
 	void	DrawTemporaryConnection (NodeUIDrawingEnvironment& drawingEnv, const Pen& pen, const Point& beg, const Point& end, NodeDrawingModifier::Direction dir) const;
 	void	DrawNodes (NodeUIDrawingEnvironment& drawingEnv, const SelectionParams& selectionParams, const NodeDrawingModifier* drawModifier) const;
 	void	DrawNode (NodeUIDrawingEnvironment& drawingEnv, const SelectionParams& selectionParams, const Point& offset, SelectionMode selectionMode, const UINodeConstPtr& uiNode) const;
@@ -43,15 +46,21 @@ private:
 	void	DrawSelectionRect (NodeUIDrawingEnvironment& drawingEnv, const NodeDrawingModifier* drawModifier) const;
 
 	bool	IsConnectionVisible (NodeUIDrawingEnvironment& drawingEnv, const Point& beg, const Point& end) const;
+	bool	IsConnectionVisible (NodeUIDrawingEnvironment& drawingEnv, const Rect& begNodeRect, const Rect& endNodeRect) const;
 	bool	IsNodeVisible (NodeUIDrawingEnvironment& drawingEnv, const SelectionParams& selectionParams, const NodeDrawingModifier* drawModifier, const UINodeConstPtr& uiNode) const;
 	bool	IsRectVisible (NodeUIDrawingEnvironment& drawingEnv, const Rect& rect) const;
+	bool	IsClipped (NodeUIDrawingEnvironment& drawingEnv) const;
 
+	Rect	GetVisibleModelRect (NodeUIDrawingEnvironment& drawingEnv) const;
+	NE::NodeCollection	GetOffsetNodes (const NodeDrawingModifier* drawModifier) const;
 	Rect	GetNodeRect (NodeUIDrawingEnvironment& drawingEnv, const NodeDrawingModifier* drawModifier, const UINodeConstPtr& uiNode) const;
 	Rect	GetExtendedNodeRect (NodeUIDrawingEnvironment& drawingEnv, const NodeDrawingModifier* drawModifier, const UINodeConstPtr& uiNode) const;
 	Point	GetOutputSlotConnPosition (NodeUIDrawingEnvironment& drawingEnv, const NodeDrawingModifier* drawModifier, const UINodeConstPtr& uiNode, const NE::SlotId& slotId) const;
 	Point	GetInputSlotConnPosition (NodeUIDrawingEnvironment& drawingEnv, const NodeDrawingModifier* drawModifier, const UINodeConstPtr& uiNode, const NE::SlotId& slotId) const;
 
 	const NodeUIManager&	uiManager;
+	bool					hasDirtyViewRect;
+	Rect					dirtyViewRect;
 };
 
 }
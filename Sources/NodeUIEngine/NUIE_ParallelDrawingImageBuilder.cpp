@@ -0,0 +1,53 @@
+#include "NUIE_ParallelDrawingImageBuilder.hpp"
+#include "NUIE_ContextDecorators.hpp"
+#include "NUIE_EnvironmentDecorators.hpp"
+
+#include <thread>
+#include <algorithm>
+
+namespace NUIE
+{
+
+static const size_t MinNodesPerThread = 64;
+
+static void BuildNodeDrawingImagesInRange (NodeUIDrawingEnvironment& drawingEnv, const std::vector<UINodeConstPtr>& uiNodes, size_t beginIndex, size_t endIndex)
+{
+	for (size_t i = beginIndex; i < endIndex; i++) {
+		uiNodes[i]->BuildDrawingImage (drawingEnv);
+	}
+}
+
+void BuildNodeDrawingImages (NodeUIDrawingEnvironment& drawingEnv, const std::vector<UINodeConstPtr>& uiNodes)
+{
+	size_t threadCount = std::thread::hardware_concurrency ();
+	threadCount = std::min (threadCount, uiNodes.size () / MinNodesPerThread);
+	BuildNodeDrawingImages (drawingEnv, uiNodes, threadCount);
+}
+
+void BuildNodeDrawingImages (NodeUIDrawingEnvironment& drawingEnv, const std::vector<UINodeConstPtr>& uiNodes, size_t threadCount)
+{
+	size_t nodeCount = uiNodes.size ();
+	threadCount = std::min (threadCount, nodeCount);
+	if (threadCount < 2) {
+		BuildNodeDrawingImagesInRange (drawingEnv, uiNodes, 0, nodeCount);
+		return;
+	}
+
+	// every node is built by exactly one thread, and the threads share only the environment,
+	// so the drawing context is the only thing that needs synchronization
+	SynchronizedMeasureContextDecorator measureContext (drawingEnv.GetDrawingContext ());
+	DrawingEnvironmentContextDecorator threadDrawingEnv (drawingEnv, measureContext);
+
+	std::vector<std::thread> threads;
+	size_t nodesPerThread = nodeCount / threadCount;
+	for (size_t i = 0; i < threadCount; i++) {
+		size_t beginIndex = i * nodesPerThread;
+		size_t endIndex = (i == threadCount - 1) ? nodeCount : beginIndex + nodesPerThread;
+		threads.push_back (std::thread (BuildNodeDrawingImagesInRange, std::ref (threadDrawingEnv), std::cref (uiNodes), beginIndex, endIndex));
+	}
+	for (std::thread& thread : threads) {
+		thread.join ();
+	}
+}
+
+}
@@ -0,0 +1,20 @@
+#ifndef NUIE_PARALLELDRAWINGIMAGEBUILDER_HPP
+#define NUIE_PARALLELDRAWINGIMAGEBUILDER_HPP
+
+#include "NUIE_UINode.hpp"
+#include "NUIE_NodeUIEnvironment.hpp"
+
+#include <vector>
+
+namespace NUIE
+{
+
+// builds the missing drawing images of the given nodes on several threads, the nodes and
+// the values they show must not change while the images are built, text measurement
+// is serialized if the drawing context can't measure text concurrently
+void	BuildNodeDrawingImages (NodeUIDrawingEnvironment& drawingEnv, const std::vector<UINodeConstPtr>& uiNodes);
+void	BuildNodeDrawingImages (NodeUIDrawingEnvironment& drawingEnv, const std::vector<UINodeConstPtr>& uiNodes, size_t threadCount);
+
+}
+
+#endif
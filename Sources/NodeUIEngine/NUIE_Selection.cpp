@@ -69,6 +69,26 @@ Selection::ChangeResult Selection::DeleteNode (const NE::NodeId& nodeId)
 	return result;
 }
 
+Selection::ChangeResult Selection::AddNodes (const NE::NodeCollection& nodesToAdd)
+{
+	size_t oldCount = nodes.Count ();
+	nodes.Union (nodesToAdd);
+	return nodes.Count () != oldCount ? ChangeResult::Changed : ChangeResult::NotChanged;
+}
+
+Selection::ChangeResult Selection::DeleteNodes (const NE::NodeCollection& nodesToDelete)
+{
+	size_t oldCount = nodes.Count ();
+	nodes.Difference (nodesToDelete);
+	return nodes.Count () != oldCount ? ChangeResult::Changed : ChangeResult::NotChanged;
+}
+
+Selection::ChangeResult Selection::ToggleNodes (const NE::NodeCollection& nodesToToggle)
+{
+	nodes.SymmetricDifference (nodesToToggle);
+	return nodesToToggle.IsEmpty () ? ChangeResult::NotChanged : ChangeResult::Changed;
+}
+
 Selection::ChangeResult Selection::Clear ()
 {
 	ChangeResult result = ChangeResult::NotChanged;
@@ -29,6 +29,10 @@ public:
 	ChangeResult				AddNode (const NE::NodeId& nodeId);
 	ChangeResult				DeleteNode (const NE::NodeId& nodeId);
 
+	ChangeResult				AddNodes (const NE::NodeCollection& nodesToAdd);
+	ChangeResult				DeleteNodes (const NE::NodeCollection& nodesToDelete);
+	ChangeResult				ToggleNodes (const NE::NodeCollection& nodesToToggle);
+
 	ChangeResult				Clear ();
 
 private:
@@ -0,0 +1,529 @@
+#include "NUIE_SoftwareDrawingContext.hpp"
+#include "NUIE_BitmapFont.hpp"
+#include "NE_Debug.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <algorithm>
+
+namespace NUIE
+{
+
+static const Color DefaultBackgroundColor (255, 255, 255);
+static const double MaxPixelCoordinate = 1.0e7;
+static const double BezierSegmentLength = 8.0;
+static const size_t MaxBezierSegmentCount = 128;
+static const size_t MaxStoredDeflateBlockSize = 65535;
+
+static void AppendUInt32 (std::vector<char>& buffer, uint32_t value)
+{
+	buffer.push_back ((char) ((value >> 24) & 0xFF));
+	buffer.push_back ((char) ((value >> 16) & 0xFF));
+	buffer.push_back ((char) ((value >> 8) & 0xFF));
+	buffer.push_back ((char) (value & 0xFF));
+}
+
+static std::vector<uint32_t> CreateCrc32Table ()
+{
+	std::vector<uint32_t> crcTable (256);
+	for (uint32_t i = 0; i < 256; i++) {
+		uint32_t crc = i;
+		for (int j = 0; j < 8; j++) {
+			crc = (crc & 1) ? (0xEDB88320 ^ (crc >> 1)) : (crc >> 1);
+		}
+		crcTable[i] = crc;
+	}
+	return crcTable;
+}
+
+static uint32_t CalculateCrc32 (const char* data, size_t size)
+{
+	static const std::vector<uint32_t> crcTable = CreateCrc32Table ();
+	uint32_t crc = 0xFFFFFFFF;
+	for (size_t i = 0; i < size; i++) {
+		crc = crcTable[(crc ^ (uint8_t) data[i]) & 0xFF] ^ (crc >> 8);
+	}
+	return crc ^ 0xFFFFFFFF;
+}
+
+static uint32_t CalculateAdler32 (const std::vector<char>& data)
+{
+	uint32_t a = 1;
+	uint32_t b = 0;
+	for (char byte : data) {
+		a = (a + (uint8_t) byte) % 65521;
+		b = (b + a) % 65521;
+	}
+	return (b << 16) | a;
+}
+
+static void AppendPngChunk (std::vector<char>& buffer, const char* chunkType, const std::vector<char>& chunkData)
+{
+	AppendUInt32 (buffer, (uint32_t) chunkData.size ());
+	size_t crcStart = buffer.size ();
+	buffer.insert (buffer.end (), chunkType, chunkType + 4);
+	buffer.insert (buffer.end (), chunkData.begin (), chunkData.end ());
+	AppendUInt32 (buffer, CalculateCrc32 (buffer.data () + crcStart, buffer.size () - crcStart));
+}
+
+static void AppendZlibStream (std::vector<char>& buffer, const std::vector<char>& data)
+{
+	// the image is stored without compression, so no external library is needed
+	buffer.push_back ((char) 0x78);
+	buffer.push_back ((char) 0x01);
+	size_t offset = 0;
+	do {
+		size_t blockSize = std::min (data.size () - offset, MaxStoredDeflateBlockSize);
+		bool isLastBlock = (offset + blockSize == data.size ());
+		buffer.push_back ((char) (isLastBlock ? 1 : 0));
+		buffer.push_back ((char) (blockSize & 0xFF));
+		buffer.push_back ((char) ((blockSize >> 8) & 0xFF));
+		buffer.push_back ((char) (~blockSize & 0xFF));
+		buffer.push_back ((char) ((~blockSize >> 8) & 0xFF));
+		buffer.insert (buffer.end (), data.begin () + offset, data.begin () + offset + blockSize);
+		offset += blockSize;
+	} while (offset < data.size ());
+	AppendUInt32 (buffer, CalculateAdler32 (data));
+}
+
+SoftwareDrawingContext::SoftwareDrawingContext () :
+	SoftwareDrawingContext (0, 0)
+{
+
+}
+
+SoftwareDrawingContext::SoftwareDrawingContext (int width, int height) :
+	DrawingContext (),
+	width (0),
+	height (0),
+	pixels (),
+	clipRect ()
+{
+	Resize (width, height);
+}
+
+SoftwareDrawingContext::~SoftwareDrawingContext ()
+{
+
+}
+
+void SoftwareDrawingContext::Clear (const Color& color)
+{
+	std::fill (pixels.begin (), pixels.end (), ColorToPixel (color));
+}
+
+Color SoftwareDrawingContext::GetPixel (int x, int y) const
+{
+	if (DBGERROR (x < 0 || x >= width || y < 0 || y >= height)) {
+		return Color ();
+	}
+	unsigned char bytes[4];
+	std::memcpy (bytes, &pixels[(size_t) y * width + x], 4);
+	return Color (bytes[0], bytes[1], bytes[2]);
+}
+
+void SoftwareDrawingContext::EncodePpm (std::vector<char>& buffer) const
+{
+	std::string header = "P6\n" + std::to_string (width) + " " + std::to_string (height) + "\n255\n";
+	buffer.clear ();
+	buffer.reserve (header.length () + pixels.size () * 3);
+	buffer.insert (buffer.end (), header.begin (), header.end ());
+	for (uint32_t pixel : pixels) {
+		char bytes[4];
+		std::memcpy (bytes, &pixel, 4);
+		buffer.insert (buffer.end (), bytes, bytes + 3);
+	}
+}
+
+void SoftwareDrawingContext::EncodePng (std::vector<char>& buffer) const
+{
+	static const char PngSignature[8] = { (char) 0x89, 'P', 'N', 'G', '\r', '\n', (char) 0x1A, '\n' };
+	buffer.clear ();
+	buffer.insert (buffer.end (), PngSignature, PngSignature + 8);
+
+	std::vector<char> headerData;
+	AppendUInt32 (headerData, (uint32_t) width);
+	AppendUInt32 (headerData, (uint32_t) height);
+	headerData.push_back (8); // bit depth
+	headerData.push_back (2); // rgb color type
+	headerData.push_back (0); // compression
+	headerData.push_back (0); // filter
+	headerData.push_back (0); // interlace
+	AppendPngChunk (buffer, "IHDR", headerData);
+
+	std::vector<char> rowData;
+	rowData.reserve ((size_t) height * (1 + (size_t) width * 3));
+	for (int y = 0; y < height; y++) {
+		rowData.push_back (0);
+		for (int x = 0; x < width; x++) {
+			char bytes[4];
+			std::memcpy (bytes, &pixels[(size_t) y * width + x], 4);
+			rowData.insert (rowData.end (), bytes, bytes + 3);
+		}
+	}
+	std::vector<char> imageData;
+	AppendZlibStream (imageData, rowData);
+	AppendPngChunk (buffer, "IDAT", imageData);
+	AppendPngChunk (buffer, "IEND", {});
+}
+
+void SoftwareDrawingContext::Resize (int newWidth, int newHeight)
+{
+	width = std::max (newWidth, 0);
+	height = std::max (newHeight, 0);
+	pixels.assign ((size_t) width * height, ColorToPixel (DefaultBackgroundColor));
+	ResetClipRect ();
+}
+
+int SoftwareDrawingContext::GetWidth () const
+{
+	return width;
+}
+
+int SoftwareDrawingContext::GetHeight () const
+{
+	return height;
+}
+
+void SoftwareDrawingContext::BeginDraw ()
+{
+
+}
+
+void SoftwareDrawingContext::EndDraw ()
+{
+
+}
+
+bool SoftwareDrawingContext::NeedToDraw (ItemPreviewMode)
+{
+	return true;
+}
+
+void SoftwareDrawingContext::DrawLine (const Point& beg, const Point& end, const Pen& pen)
+{
+	DrawThickLine (beg, end, pen.GetThickness (), ColorToPixel (pen.GetColor ()));
+}
+
+void SoftwareDrawingContext::DrawBezier (const Point& p1, const Point& p2, const Point& p3, const Point& p4, const Pen& pen)
+{
+	double controlLength = Point::Distance (p1, p2) + Point::Distance (p2, p3) + Point::Distance (p3, p4);
+	size_t segmentCount = (size_t) std::ceil (std::min (controlLength / BezierSegmentLength, (double) MaxBezierSegmentCount));
+	segmentCount = std::max (segmentCount, (size_t) 1);
+
+	uint32_t pixel = ColorToPixel (pen.GetColor ());
+	Point prevPoint = p1;
+	for (size_t i = 1; i <= segmentCount; i++) {
+		double t = (double) i / (double) segmentCount;
+		double u = 1.0 - t;
+		Point point = p1 * (u * u * u) + p2 * (3.0 * u * u * t) + p3 * (3.0 * u * t * t) + p4 * (t * t * t);
+		DrawThickLine (prevPoint, point, pen.GetThickness (), pixel);
+		prevPoint = point;
+	}
+}
+
+void SoftwareDrawingContext::DrawRect (const Rect& rect, const Pen& pen)
+{
+	// the border is centered on the edges of the rect
+	double halfThickness = std::max (pen.GetThickness (), 1.0) / 2.0;
+	double left = rect.GetLeft () - halfThickness;
+	double right = rect.GetRight () + halfThickness;
+	double innerTop = rect.GetTop () + halfThickness;
+	double innerBottom = rect.GetBottom () - halfThickness;
+	uint32_t pixel = ColorToPixel (pen.GetColor ());
+	FillPixelRect (Rect (left, rect.GetTop () - halfThickness, right - left, 2.0 * halfThickness), pixel);
+	FillPixelRect (Rect (left, rect.GetBottom () - halfThickness, right - left, 2.0 * halfThickness), pixel);
+	if (innerTop < innerBottom) {
+		FillPixelRect (Rect (left, innerTop, 2.0 * halfThickness, innerBottom - innerTop), pixel);
+		FillPixelRect (Rect (rect.GetRight () - halfThickness, innerTop, 2.0 * halfThickness, innerBottom - innerTop), pixel);
+	}
+}
+
+void SoftwareDrawingContext::FillRect (const Rect& rect, const Color& color)
+{
+	FillPixelRect (rect, ColorToPixel (color));
+}
+
+void SoftwareDrawingContext::DrawEllipse (const Rect& rect, const Pen& pen)
+{
+	FillEllipseRing (rect, std::max (pen.GetThickness (), 1.0), ColorToPixel (pen.GetColor ()));
+}
+
+void SoftwareDrawingContext::FillEllipse (const Rect& rect, const Color& color)
+{
+	FillEllipseRing (rect, 0.0, ColorToPixel (color));
+}
+
+void SoftwareDrawingContext::DrawFormattedText (const Rect& rect, const Font& font, const std::wstring& text, HorizontalAnchor hAnchor, VerticalAnchor vAnchor, const Color& textColor)
+{
+	double scale = GetTextScale (font);
+	if (scale <= 0.0) {
+		return;
+	}
+
+	Size textSize = MeasureText (font, text);
+	Point position = rect.GetTopLeft ();
+	switch (hAnchor) {
+		case HorizontalAnchor::Left:
+			break;
+		case HorizontalAnchor::Center:
+			position.SetX (rect.GetCenter ().GetX () - textSize.GetWidth () / 2.0);
+			break;
+		case HorizontalAnchor::Right:
+			position.SetX (rect.GetRight () - textSize.GetWidth ());
+			break;
+	}
+	switch (vAnchor) {
+		case VerticalAnchor::Top:
+			break;
+		case VerticalAnchor::Center:
+			position.SetY (rect.GetCenter ().GetY () - textSize.GetHeight () / 2.0);
+			break;
+		case VerticalAnchor::Bottom:
+			position.SetY (rect.GetBottom () - textSize.GetHeight ());
+			break;
+	}
+
+	// text is clipped to its rect like on the native contexts
+	PixelRect oldClipRect = clipRect;
+	clipRect.left = std::max (clipRect.left, GetFirstPixel (rect.GetLeft ()));
+	clipRect.top = std::max (clipRect.top, GetFirstPixel (rect.GetTop ()));
+	clipRect.right = std::min (clipRect.right, GetFirstPixel (rect.GetRight ()));
+	clipRect.bottom = std::min (clipRect.bottom, GetFirstPixel (rect.GetBottom ()));
+
+	uint32_t pixel = ColorToPixel (textColor);
+	for (size_t i = 0; i < text.length (); i++) {
+		Point glyphPosition (position.GetX () + i * BitmapFontCellWidth * scale, position.GetY ());
+		DrawGlyph (glyphPosition, scale, text[i], pixel);
+	}
+	clipRect = oldClipRect;
+}
+
+Size SoftwareDrawingContext::MeasureText (const Font& font, const std::wstring& text)
+{
+	double scale = GetTextScale (font);
+	return Size (text.length () * BitmapFontCellWidth * scale, BitmapFontCellHeight * scale);
+}
+
+bool SoftwareDrawingContext::CanDrawIcon ()
+{
+	return false;
+}
+
+void SoftwareDrawingContext::DrawIcon (const Rect&, const IconId&)
+{
+	DBGBREAK ();
+}
+
+void SoftwareDrawingContext::DrawLines (const std::vector<Point>& points, const Pen& pen)
+{
+	DBGASSERT (points.size () % 2 == 0);
+	uint32_t pixel = ColorToPixel (pen.GetColor ());
+	for (size_t i = 0; i + 1 < points.size (); i += 2) {
+		DrawThickLine (points[i], points[i + 1], pen.GetThickness (), pixel);
+	}
+}
+
+void SoftwareDrawingContext::FillRects (const std::vector<Rect>& rects, const Color& color)
+{
+	uint32_t pixel = ColorToPixel (color);
+	for (const Rect& rect : rects) {
+		FillPixelRect (rect, pixel);
+	}
+}
+
+bool SoftwareDrawingContext::CanClip ()
+{
+	return true;
+}
+
+void SoftwareDrawingContext::SetClipRect (const Rect& rect)
+{
+	clipRect.left = std::max (GetFirstPixel (rect.GetLeft ()), 0);
+	clipRect.top = std::max (GetFirstPixel (rect.GetTop ()), 0);
+	clipRect.right = std::min (GetFirstPixel (rect.GetRight ()), width);
+	clipRect.bottom = std::min (GetFirstPixel (rect.GetBottom ()), height);
+}
+
+void SoftwareDrawingContext::ResetClipRect ()
+{
+	clipRect.left = 0;
+	clipRect.top = 0;
+	clipRect.right = width;
+	clipRect.bottom = height;
+}
+
+bool SoftwareDrawingContext::CanMeasureTextConcurrently ()
+{
+	// text size depends only on the font and the text length
+	return true;
+}
+
+uint32_t SoftwareDrawingContext::ColorToPixel (const Color& color)
+{
+	// pixels are stored in rgba byte order regardless of the endianness of the machine
+	unsigned char bytes[4] = { color.GetR (), color.GetG (), color.GetB (), 255 };
+	uint32_t pixel = 0;
+	std::memcpy (&pixel, bytes, 4);
+	return pixel;
+}
+
+double SoftwareDrawingContext::GetTextScale (const Font& font)
+{
+	return font.GetSize () / BitmapFontCellHeight;
+}
+
+int SoftwareDrawingContext::GetFirstPixel (double coordinate)
+{
+	// index of the first pixel whose center is not less than the coordinate
+	double pixel = std::ceil (coordinate - 0.5);
+	if (std::isnan (pixel)) {
+		return 0;
+	}
+	pixel = std::max (pixel, -MaxPixelCoordinate);
+	pixel = std::min (pixel, MaxPixelCoordinate);
+	return (int) pixel;
+}
+
+void SoftwareDrawingContext::FillSpan (int y, double left, double right, uint32_t pixel)
+{
+	if (y < clipRect.top || y >= clipRect.bottom) {
+		return;
+	}
+	int beg = std::max (GetFirstPixel (left), clipRect.left);
+	int end = std::min (GetFirstPixel (right), clipRect.right);
+	if (beg >= end) {
+		return;
+	}
+	std::fill_n (pixels.begin () + (size_t) y * width + beg, end - beg, pixel);
+}
+
+void SoftwareDrawingContext::FillPixelRect (const Rect& rect, uint32_t pixel)
+{
+	int top = std::max (GetFirstPixel (rect.GetTop ()), clipRect.top);
+	int bottom = std::min (GetFirstPixel (rect.GetBottom ()), clipRect.bottom);
+	for (int y = top; y < bottom; y++) {
+		FillSpan (y, rect.GetLeft (), rect.GetRight (), pixel);
+	}
+}
+
+void SoftwareDrawingContext::FillConvexPolygon (const Point* points, size_t pointCount, uint32_t pixel)
+{
+	double minY = points[0].GetY ();
+	double maxY = points[0].GetY ();
+	for (size_t i = 1; i < pointCount; i++) {
+		minY = std::min (minY, points[i].GetY ());
+		maxY = std::max (maxY, points[i].GetY ());
+	}
+
+	int top = std::max (GetFirstPixel (minY), clipRect.top);
+	int bottom = std::min (GetFirstPixel (maxY), clipRect.bottom);
+	for (int y = top; y < bottom; y++) {
+		// the polygon is convex, so every scanline crosses it in a single span
+		double scanY = y + 0.5;
+		double left = MaxPixelCoordinate;
+		double right = -MaxPixelCoordinate;
+		for (size_t i = 0; i < pointCount; i++) {
+			const Point& a = points[i];
+			const Point& b = points[(i + 1) % pointCount];
+			if ((a.GetY () <= scanY && scanY < b.GetY ()) || (b.GetY () <= scanY && scanY < a.GetY ())) {
+				double x = a.GetX () + (scanY - a.GetY ()) * (b.GetX () - a.GetX ()) / (b.GetY () - a.GetY ());
+				left = std::min (left, x);
+				right = std::max (right, x);
+			}
+		}
+		if (left < right) {
+			FillSpan (y, left, right, pixel);
+		}
+	}
+}
+
+void SoftwareDrawingContext::FillEllipseRing (const Rect& rect, double thickness, uint32_t pixel)
+{
+	// zero thickness means a filled ellipse, otherwise the ring is centered on the ellipse
+	Point center = rect.GetCenter ();
+	double halfThickness = thickness / 2.0;
+	double outerRadiusX = rect.GetWidth () / 2.0 + halfThickness;
+	double outerRadiusY = rect.GetHeight () / 2.0 + halfThickness;
+	double innerRadiusX = rect.GetWidth () / 2.0 - halfThickness;
+	double innerRadiusY = rect.GetHeight () / 2.0 - halfThickness;
+	bool hasInnerEllipse = thickness > 0.0 && innerRadiusX > 0.0 && innerRadiusY > 0.0;
+	if (outerRadiusX <= 0.0 || outerRadiusY <= 0.0) {
+		return;
+	}
+
+	int top = std::max (GetFirstPixel (center.GetY () - outerRadiusY), clipRect.top);
+	int bottom = std::min (GetFirstPixel (center.GetY () + outerRadiusY), clipRect.bottom);
+	for (int y = top; y < bottom; y++) {
+		double scanY = y + 0.5 - center.GetY ();
+		double outerRatio = scanY / outerRadiusY;
+		if (outerRatio * outerRatio >= 1.0) {
+			continue;
+		}
+		double outerHalfWidth = outerRadiusX * std::sqrt (1.0 - outerRatio * outerRatio);
+		double innerRatio = hasInnerEllipse ? scanY / innerRadiusY : 1.0;
+		if (hasInnerEllipse && innerRatio * innerRatio < 1.0) {
+			double innerHalfWidth = innerRadiusX * std::sqrt (1.0 - innerRatio * innerRatio);
+			FillSpan (y, center.GetX () - outerHalfWidth, center.GetX () - innerHalfWidth, pixel);
+			FillSpan (y, center.GetX () + innerHalfWidth, center.GetX () + outerHalfWidth, pixel);
+		} else {
+			FillSpan (y, center.GetX () - outerHalfWidth, center.GetX () + outerHalfWidth, pixel);
+		}
+	}
+}
+
+void SoftwareDrawingContext::DrawThickLine (const Point& beg, const Point& end, double thickness, uint32_t pixel)
+{
+	// lines are drawn as rectangles with square caps, thinner lines are widened to one pixel
+	double halfThickness = std::max (thickness, 1.0) / 2.0;
+	double length = Point::Distance (beg, end);
+	if (IsEqual (length, 0.0)) {
+		FillPixelRect (Rect::FromCenterAndSize (beg, Size (2.0 * halfThickness, 2.0 * halfThickness)), pixel);
+		return;
+	}
+
+	Point direction = (end - beg) / length * halfThickness;
+	Point normal (-direction.GetY (), direction.GetX ());
+	Point corners[4] = {
+		beg - direction + normal,
+		end + direction + normal,
+		end + direction - normal,
+		beg - direction - normal
+	};
+	FillConvexPolygon (corners, 4, pixel);
+}
+
+void SoftwareDrawingContext::DrawGlyph (const Point& position, double scale, wchar_t character, uint32_t pixel)
+{
+	const uint8_t* glyphRows = GetBitmapFontGlyph (character);
+	for (int row = 0; row < BitmapFontGlyphHeight; row++) {
+		uint8_t rowBits = glyphRows[row];
+		if (rowBits == 0) {
+			continue;
+		}
+		double rowTop = position.GetY () + row * scale;
+		int top = std::max (GetFirstPixel (rowTop), clipRect.top);
+		int bottom = std::min (GetFirstPixel (rowTop + scale), clipRect.bottom);
+		int column = 0;
+		while (column < BitmapFontGlyphWidth) {
+			// consecutive set pixels of the glyph row are filled as one span
+			if ((rowBits & (1 << (BitmapFontGlyphWidth - 1 - column))) == 0) {
+				column++;
+				continue;
+			}
+			int runEnd = column;
+			while (runEnd < BitmapFontGlyphWidth && (rowBits & (1 << (BitmapFontGlyphWidth - 1 - runEnd))) != 0) {
+				runEnd++;
+			}
+			double left = position.GetX () + column * scale;
+			double right = position.GetX () + runEnd * scale;
+			for (int y = top; y < bottom; y++) {
+				FillSpan (y, left, right, pixel);
+			}
+			column = runEnd;
+		}
+	}
+}
+
+}
@@ -0,0 +1,92 @@
+#ifndef NUIE_SOFTWAREDRAWINGCONTEXT_HPP
+#define NUIE_SOFTWAREDRAWINGCONTEXT_HPP
+
+#include "NUIE_DrawingContext.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace NUIE
+{
+
+// platform independent context that rasterizes into an in-memory framebuffer, it doesn't need
+// any windowing system, so it can render previews and benchmarks on headless machines
+class SoftwareDrawingContext : public DrawingContext
+{
+public:
+	SoftwareDrawingContext ();
+	SoftwareDrawingContext (int width, int height);
+	SoftwareDrawingContext (const SoftwareDrawingContext& rhs) = delete;
+	virtual ~SoftwareDrawingContext ();
+
+	SoftwareDrawingContext&	operator= (const SoftwareDrawingContext& rhs) = delete;
+
+	void					Clear (const Color& color);
+	Color					GetPixel (int x, int y) const;
+
+	void					EncodePpm (std::vector<char>& buffer) const;
+	void					EncodePng (std::vector<char>& buffer) const;
+
+	virtual void			Resize (int newWidth, int newHeight) override;
+
+	virtual int				GetWidth () const override;
+	virtual int				GetHeight () const override;
+
+	virtual void			BeginDraw () override;
+	virtual void			EndDraw () override;
+
+	virtual bool			NeedToDraw (ItemPreviewMode mode) override;
+
+	virtual void			DrawLine (const Point& beg, const Point& end, const Pen& pen) override;
+	virtual void			DrawBezier (const Point& p1, const Point& p2, const Point& p3, const Point& p4, const Pen& pen) override;
+
+	virtual void			DrawRect (const Rect& rect, const Pen& pen) override;
+	virtual void			FillRect (const Rect& rect, const Color& color) override;
+
+	virtual void			DrawEllipse (const Rect& rect, const Pen& pen) override;
+	virtual void			FillEllipse (const Rect& rect, const Color& color) override;
+
+	virtual void			DrawFormattedText (const Rect& rect, const Font& font, const std::wstring& text, HorizontalAnchor hAnchor, VerticalAnchor vAnchor, const Color& textColor) override;
+	virtual Size			MeasureText (const Font& font, const std::wstring& text) override;
+
+	virtual bool			CanDrawIcon () override;
+	virtual void			DrawIcon (const Rect& rect, const IconId& iconId) override;
+
+	virtual void			DrawLines (const std::vector<Point>& points, const Pen& pen) override;
+	virtual void			FillRects (const std::vector<Rect>& rects, const Color& color) override;
+
+	virtual bool			CanClip () override;
+	virtual void			SetClipRect (const Rect& rect) override;
+	virtual void			ResetClipRect () override;
+
+	virtual bool			CanMeasureTextConcurrently () override;
+
+private:
+	struct PixelRect
+	{
+		int		left;
+		int		top;
+		int		right;
+		int		bottom;
+	};
+
+	static uint32_t			ColorToPixel (const Color& color);
+	static double			GetTextScale (const Font& font);
+	static int				GetFirstPixel (double coordinate);
+
+	void					FillSpan (int y, double left, double right, uint32_t pixel);
+	void					FillPixelRect (const Rect& rect, uint32_t pixel);
+	void					FillConvexPolygon (const Point* points, size_t pointCount, uint32_t pixel);
+	void					FillEllipseRing (const Rect& rect, double thickness, uint32_t pixel);
+	void					DrawThickLine (const Point& beg, const Point& end, double thickness, uint32_t pixel);
+	void					DrawGlyph (const Point& position, double scale, wchar_t character, uint32_t pixel);
+
+	int						width;
+	int						height;
+	std::vector<uint32_t>	pixels;
+	PixelRect				clipRect;
+};
+
+}
+
+#endif
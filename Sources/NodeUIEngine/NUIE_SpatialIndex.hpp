@@ -0,0 +1,320 @@
+#ifndef NUIE_SPATIALINDEX_HPP
+#define NUIE_SPATIALINDEX_HPP
+
+#include "NE_Debug.hpp"
+#include "NUIE_Geometry.hpp"
+
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <functional>
+#include <algorithm>
+
+namespace NUIE
+{
+
+// uniform grid of rects in model space, every key is registered in all of
+// the cells it overlaps, query results are reported in insertion order
+template <typename Key>
+class SpatialIndex
+{
+public:
+	SpatialIndex ();
+	SpatialIndex (double cellSize);
+	~SpatialIndex ();
+
+	bool			IsEmpty () const;
+	size_t			Count () const;
+	bool			Contains (const Key& key) const;
+	const Rect&		GetRect (const Key& key) const;
+	size_t			GetOrder (const Key& key) const;
+
+	void			Insert (const Key& key, const Rect& rect);
+	void			Erase (const Key& key);
+	void			Clear ();
+
+	void			Enumerate (const Rect& rect, const std::function<bool (const Key&)>& processor) const;
+	void			Enumerate (const Rect& rect, const std::vector<Key>& additionalKeys, const std::function<bool (const Key&)>& processor) const;
+
+private:
+	struct Entry
+	{
+		Rect	rect;
+		size_t	order;
+		bool	isOversized;
+	};
+
+	struct CellRange
+	{
+		int		minX;
+		int		minY;
+		int		maxX;
+		int		maxY;
+
+		int64_t	GetCellCount () const;
+	};
+
+	static uint64_t	GetCellKey (int x, int y);
+
+	CellRange		GetCellRange (const Rect& rect) const;
+	int				GetCellCoordinate (double coordinate) const;
+	void			AddToCells (const Key& key, const Entry& entry);
+	void			RemoveFromCells (const Key& key, const Entry& entry);
+
+	double											cellSize;
+	std::unordered_map<Key, Entry>					entries;
+	std::unordered_map<uint64_t, std::vector<Key>>	cells;
+	std::vector<Key>								oversizedKeys;
+	size_t											nextOrder;
+};
+
+static const double SpatialIndexDefaultCellSize = 256.0;
+static const int64_t SpatialIndexMaxCellsPerKey = 64;
+static const double SpatialIndexMaxCellCoordinate = 1.0e9;
+
+template <typename Key>
+SpatialIndex<Key>::SpatialIndex () :
+	SpatialIndex (SpatialIndexDefaultCellSize)
+{
+
+}
+
+template <typename Key>
+SpatialIndex<Key>::SpatialIndex (double cellSize) :
+	cellSize (cellSize),
+	entries (),
+	cells (),
+	oversizedKeys (),
+	nextOrder (0)
+{
+	DBGASSERT (cellSize > 0.0);
+}
+
+template <typename Key>
+SpatialIndex<Key>::~SpatialIndex ()
+{
+
+}
+
+template <typename Key>
+bool SpatialIndex<Key>::IsEmpty () const
+{
+	return entries.empty ();
+}
+
+template <typename Key>
+size_t SpatialIndex<Key>::Count () const
+{
+	return entries.size ();
+}
+
+template <typename Key>
+bool SpatialIndex<Key>::Contains (const Key& key) const
+{
+	return entries.find (key) != entries.end ();
+}
+
+template <typename Key>
+const Rect& SpatialIndex<Key>::GetRect (const Key& key) const
+{
+	return entries.at (key).rect;
+}
+
+template <typename Key>
+size_t SpatialIndex<Key>::GetOrder (const Key& key) const
+{
+	return entries.at (key).order;
+}
+
+template <typename Key>
+void SpatialIndex<Key>::Insert (const Key& key, const Rect& rect)
+{
+	// an already indexed key keeps its order, so moving a node doesn't change the drawing order
+	size_t order = nextOrder;
+	auto found = entries.find (key);
+	if (found != entries.end ()) {
+		if (found->second.rect == rect) {
+			return;
+		}
+		order = found->second.order;
+		RemoveFromCells (key, found->second);
+		entries.erase (found);
+	} else {
+		nextOrder++;
+	}
+
+	Entry entry;
+	entry.rect = rect;
+	entry.order = order;
+	entry.isOversized = GetCellRange (rect).GetCellCount () > SpatialIndexMaxCellsPerKey;
+	AddToCells (key, entry);
+	entries.insert ({ key, entry });
+}
+
+template <typename Key>
+void SpatialIndex<Key>::Erase (const Key& key)
+{
+	auto found = entries.find (key);
+	if (DBGERROR (found == entries.end ())) {
+		return;
+	}
+	RemoveFromCells (key, found->second);
+	entries.erase (found);
+}
+
+template <typename Key>
+void SpatialIndex<Key>::Clear ()
+{
+	entries.clear ();
+	cells.clear ();
+	oversizedKeys.clear ();
+	nextOrder = 0;
+}
+
+template <typename Key>
+void SpatialIndex<Key>::Enumerate (const Rect& rect, const std::function<bool (const Key&)>& processor) const
+{
+	Enumerate (rect, {}, processor);
+}
+
+template <typename Key>
+void SpatialIndex<Key>::Enumerate (const Rect& rect, const std::vector<Key>& additionalKeys, const std::function<bool (const Key&)>& processor) const
+{
+	// additional keys are reported regardless of their rect, but only once and in order
+	std::unordered_set<Key> reportedKeys;
+	std::vector<std::pair<size_t, Key>> foundKeys;
+	auto addIfOverlapping = [&] (const Key& key, const Entry& entry) {
+		if (Rect::IsOverlapping (entry.rect, rect) && reportedKeys.find (key) == reportedKeys.end ()) {
+			foundKeys.push_back ({ entry.order, key });
+		}
+	};
+	for (const Key& key : additionalKeys) {
+		auto found = entries.find (key);
+		if (found != entries.end () && reportedKeys.insert (key).second) {
+			foundKeys.push_back ({ found->second.order, key });
+		}
+	}
+
+	CellRange range = GetCellRange (rect);
+	if (range.GetCellCount () > (int64_t) entries.size ()) {
+		// the query covers more cells than the number of keys, so checking every key is cheaper
+		for (const auto& it : entries) {
+			addIfOverlapping (it.first, it.second);
+		}
+	} else {
+		for (int x = range.minX; x <= range.maxX; x++) {
+			for (int y = range.minY; y <= range.maxY; y++) {
+				auto foundCell = cells.find (GetCellKey (x, y));
+				if (foundCell == cells.end ()) {
+					continue;
+				}
+				for (const Key& key : foundCell->second) {
+					// a key is reported only in the cell of the top left corner of its overlap with the query
+					const Entry& entry = entries.at (key);
+					int overlapX = GetCellCoordinate (std::max (entry.rect.GetLeft (), rect.GetLeft ()));
+					int overlapY = GetCellCoordinate (std::max (entry.rect.GetTop (), rect.GetTop ()));
+					if (overlapX != x || overlapY != y) {
+						continue;
+					}
+					addIfOverlapping (key, entry);
+				}
+			}
+		}
+		for (const Key& key : oversizedKeys) {
+			addIfOverlapping (key, entries.at (key));
+		}
+	}
+
+	std::sort (foundKeys.begin (), foundKeys.end (), [] (const std::pair<size_t, Key>& a, const std::pair<size_t, Key>& b) {
+		return a.first < b.first;
+	});
+	for (const auto& foundKey : foundKeys) {
+		if (!processor (foundKey.second)) {
+			break;
+		}
+	}
+}
+
+template <typename Key>
+int64_t SpatialIndex<Key>::CellRange::GetCellCount () const
+{
+	return ((int64_t) maxX - minX + 1) * ((int64_t) maxY - minY + 1);
+}
+
+template <typename Key>
+uint64_t SpatialIndex<Key>::GetCellKey (int x, int y)
+{
+	return ((uint64_t) (uint32_t) x << 32) | (uint64_t) (uint32_t) y;
+}
+
+template <typename Key>
+typename SpatialIndex<Key>::CellRange SpatialIndex<Key>::GetCellRange (const Rect& rect) const
+{
+	CellRange range;
+	range.minX = GetCellCoordinate (rect.GetLeft ());
+	range.minY = GetCellCoordinate (rect.GetTop ());
+	range.maxX = GetCellCoordinate (rect.GetRight ());
+	range.maxY = GetCellCoordinate (rect.GetBottom ());
+	return range;
+}
+
+template <typename Key>
+int SpatialIndex<Key>::GetCellCoordinate (double coordinate) const
+{
+	double cellCoordinate = std::floor (coordinate / cellSize);
+	if (std::isnan (cellCoordinate)) {
+		return 0;
+	}
+	cellCoordinate = std::max (cellCoordinate, -SpatialIndexMaxCellCoordinate);
+	cellCoordinate = std::min (cellCoordinate, SpatialIndexMaxCellCoordinate);
+	return (int) cellCoordinate;
+}
+
+template <typename Key>
+void SpatialIndex<Key>::AddToCells (const Key& key, const Entry& entry)
+{
+	if (entry.isOversized) {
+		oversizedKeys.push_back (key);
+		return;
+	}
+	CellRange range = GetCellRange (entry.rect);
+	for (int x = range.minX; x <= range.maxX; x++) {
+		for (int y = range.minY; y <= range.maxY; y++) {
+			cells[GetCellKey (x, y)].push_back (key);
+		}
+	}
+}
+
+template <typename Key>
+void SpatialIndex<Key>::RemoveFromCells (const Key& key, const Entry& entry)
+{
+	if (entry.isOversized) {
+		oversizedKeys.erase (std::find (oversizedKeys.begin (), oversizedKeys.end (), key));
+		return;
+	}
+	CellRange range = GetCellRange (entry.rect);
+	for (int x = range.minX; x <= range.maxX; x++) {
+		for (int y = range.minY; y <= range.maxY; y++) {
+			auto foundCell = cells.find (GetCellKey (x, y));
+			if (DBGERROR (foundCell == cells.end ())) {
+				continue;
+			}
+			std::vector<Key>& cellKeys = foundCell->second;
+			auto foundKey = std::find (cellKeys.begin (), cellKeys.end (), key);
+			if (DBGERROR (foundKey == cellKeys.end ())) {
+				continue;
+			}
+			*foundKey = cellKeys.back ();
+			cellKeys.pop_back ();
+			if (cellKeys.empty ()) {
+				cells.erase (foundCell);
+			}
+		}
+	}
+}
+
+}
+
+#endif
@@ -0,0 +1,71 @@
+#include "NUIE_TextMeasureCache.hpp"
+
+namespace NUIE
+{
+
+static const size_t TextMeasureCacheDefaultSize = 4096;
+
+TextMeasureCache::TextMeasureCache () :
+	TextMeasureCache (TextMeasureCacheDefaultSize)
+{
+
+}
+
+TextMeasureCache::TextMeasureCache (size_t maxSize) :
+	cache (maxSize),
+	hitCount (0),
+	missCount (0)
+{
+
+}
+
+TextMeasureCache::~TextMeasureCache ()
+{
+
+}
+
+Size TextMeasureCache::Measure (const Font& font, const std::wstring& text, const Measurer& measurer)
+{
+	TextCacheKey key (font, text);
+	if (cache.Contains (key)) {
+		hitCount++;
+		return cache.Get (key);
+	}
+	missCount++;
+	Size size = measurer (font, text);
+	cache.Add (key, size);
+	return size;
+}
+
+void TextMeasureCache::Clear ()
+{
+	cache.Clear ();
+	ResetCounters ();
+}
+
+size_t TextMeasureCache::GetHitCount () const
+{
+	return hitCount;
+}
+
+size_t TextMeasureCache::GetMissCount () const
+{
+	return missCount;
+}
+
+double TextMeasureCache::GetHitRate () const
+{
+	size_t allCount = hitCount + missCount;
+	if (allCount == 0) {
+		return 0.0;
+	}
+	return (double) hitCount / (double) allCount;
+}
+
+void TextMeasureCache::ResetCounters ()
+{
+	hitCount = 0;
+	missCount = 0;
+}
+
+}
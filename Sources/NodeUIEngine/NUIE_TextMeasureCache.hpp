@@ -0,0 +1,43 @@
+#ifndef NUIE_TEXTMEASURECACHE_HPP
+#define NUIE_TEXTMEASURECACHE_HPP
+
+#include "NE_Cache.hpp"
+#include "NUIE_Geometry.hpp"
+#include "NUIE_Drawing.hpp"
+#include "NUIE_DrawingCacheKeys.hpp"
+
+#include <functional>
+
+namespace NUIE
+{
+
+// least recently used cache of text sizes for drawing contexts with expensive text measurement
+class TextMeasureCache
+{
+public:
+	using Measurer = std::function<Size (const Font&, const std::wstring&)>;
+
+	TextMeasureCache ();
+	TextMeasureCache (size_t maxSize);
+	TextMeasureCache (const TextMeasureCache& rhs) = delete;
+	~TextMeasureCache ();
+
+	TextMeasureCache&	operator= (const TextMeasureCache& rhs) = delete;
+
+	Size		Measure (const Font& font, const std::wstring& text, const Measurer& measurer);
+	void		Clear ();
+
+	size_t		GetHitCount () const;
+	size_t		GetMissCount () const;
+	double		GetHitRate () const;
+	void		ResetCounters ();
+
+private:
+	NE::Cache<TextCacheKey, Size>	cache;
+	size_t							hitCount;
+	size_t							missCount;
+};
+
+}
+
+#endif
@@ -40,6 +40,11 @@ NE::ValueConstPtr UIDispatcherOutputSlot::Evaluate (NE::EvaluationEnv& env) cons
 	return listValue->GetValue (listIndex);
 }
 
+NE::OutputSlotPtr UIDispatcherOutputSlot::Clone () const
+{
+	return NE::CopyDynamicObject<NE::OutputSlot> (this);
+}
+
 NE::Stream::Status UIDispatcherOutputSlot::Read (NE::InputStream& inputStream)
 {
 	NE::ObjectHeader header (inputStream);
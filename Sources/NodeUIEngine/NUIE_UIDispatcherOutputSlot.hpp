@@ -16,6 +16,7 @@ public:
 	~UIDispatcherOutputSlot ();
 
 	virtual NE::ValueConstPtr	Evaluate (NE::EvaluationEnv& env) const override;
+	virtual NE::OutputSlotPtr	Clone () const override;
 
 	virtual NE::Stream::Status	Read (NE::InputStream& inputStream) override;
 	virtual NE::Stream::Status	Write (NE::OutputStream& outputStream) const override;
@@ -90,6 +90,11 @@ Point MouseMoveHandler::GetNodeOffset (const NE::NodeId&) const
 	return Point (0.0, 0.0);
 }
 
+void MouseMoveHandler::EnumerateOffsetNodes (const std::function<void (const NE::NodeId&)>&) const
+{
+
+}
+
 MultiMouseMoveHandler::MultiMouseMoveHandler () :
 	handlers ()
 {
@@ -197,4 +202,11 @@ Point MultiMouseMoveHandler::GetNodeOffset (const NE::NodeId& nodeId) const
 	return offset;
 }
 
+void MultiMouseMoveHandler::EnumerateOffsetNodes (const std::function<void (const NE::NodeId&)>& processor) const
+{
+	for (const auto& it : handlers) {
+		it.second->EnumerateOffsetNodes (processor);
+	}
+}
+
 }
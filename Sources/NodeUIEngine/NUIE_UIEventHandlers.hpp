@@ -30,6 +30,7 @@ public:
 	virtual void	EnumerateDuplicatedNodes (const std::function<void (const NE::NodeId&, const Point&)>& processor) const override;
 	virtual bool	NeedToDrawConnection (const NE::NodeId& outputNodeId, const NE::SlotId& outputSlotId, const NE::NodeId& inputNodeId, const NE::SlotId& inputSlotId) const override;
 	virtual Point	GetNodeOffset (const NE::NodeId& nodeId) const override;
+	virtual void	EnumerateOffsetNodes (const std::function<void (const NE::NodeId&)>& processor) const override;
 
 protected:
 	virtual void	HandleMouseDown (NodeUIEnvironment& env, const ModifierKeys& modifierKeys, const Point& position);
@@ -64,6 +65,7 @@ public:
 	virtual void						EnumerateDuplicatedNodes (const std::function<void (const NE::NodeId&, const Point&)>& processor) const override;
 	virtual bool						NeedToDrawConnection (const NE::NodeId& outputNodeId, const NE::SlotId& outputSlotId, const NE::NodeId& inputNodeId, const NE::SlotId& inputSlotId) const override;
 	virtual Point						GetNodeOffset (const NE::NodeId& nodeId) const override;
+	virtual void						EnumerateOffsetNodes (const std::function<void (const NE::NodeId&)>& processor) const override;
 
 private:
 	std::unordered_map<MouseButton, std::shared_ptr<MouseMoveHandler>, EnumHash> handlers;
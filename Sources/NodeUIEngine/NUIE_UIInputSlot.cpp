@@ -34,6 +34,9 @@ const NE::LocString& UIInputSlot::GetName () const
 
 void UIInputSlot::SetName (const std::wstring& newName)
 {
+	if (ownerNode != nullptr) {
+		ownerNode->BeforeChange ();
+	}
 	name.SetCustom (newName);
 }
 
@@ -44,6 +47,9 @@ NUIE::ConnectionDisplayMode UIInputSlot::GetConnectionDisplayMode () const
 
 void UIInputSlot::SetConnectionDisplayMode (ConnectionDisplayMode newConnectionDisplayMode)
 {
+	if (ownerNode != nullptr) {
+		ownerNode->BeforeChange ();
+	}
 	connDisplayMode = newConnectionDisplayMode;
 }
 
@@ -77,6 +83,11 @@ void UIInputSlot::RegisterCommands (InputSlotCommandRegistrator& commandRegistra
 	}
 }
 
+NE::InputSlotPtr UIInputSlot::Clone () const
+{
+	return NE::CopyDynamicObject<NE::InputSlot> (this);
+}
+
 NE::Stream::Status UIInputSlot::Read (NE::InputStream& inputStream)
 {
 	NE::ObjectHeader header (inputStream);
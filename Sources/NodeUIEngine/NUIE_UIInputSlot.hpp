@@ -31,6 +31,7 @@ public:
 	void						SetConnectionDisplayMode (ConnectionDisplayMode newConnectionDisplayMode);
 
 	virtual void				RegisterCommands (InputSlotCommandRegistrator& commandRegistrator) const;
+	virtual NE::InputSlotPtr	Clone () const override;
 	
 	virtual NE::Stream::Status	Read (NE::InputStream& inputStream) override;
 	virtual NE::Stream::Status	Write (NE::OutputStream& outputStream) const override;
@@ -1,9 +1,13 @@
 #include "NUIE_UIItemFinder.hpp"
 
+#include <algorithm>
+
 namespace NUIE
 {
 
 static const double SlotSnappingDistanceInPixel = 20.0;
+static const double ConnectionSnappingDistanceInPixel = 5.0;
+static const size_t ConnectionSegmentCount = 20;
 
 template <class SlotType>
 Point GetSlotConnPosition (const UINodePtr& uiNode, const NE::SlotId& slotId, NodeUIDrawingEnvironment& env);
@@ -87,10 +91,13 @@ static SlotType FindSlotInNode (const UINodePtr& uiNode, const NodeUIManager& ui
 template <class SlotType>
 static SlotType FindSlotByConnPosition (NodeUIManager& uiManager, NodeUIDrawingEnvironment& env, const Point& viewPosition)
 {
+	// the snapping distance is the same in model space, so only the nodes around the position are checked
 	SlotType foundSlot = nullptr;
 	double minDistance = INF;
 	const ViewBox& viewBox = uiManager.GetViewBox ();
-	uiManager.EnumerateNodes ([&] (UINodePtr uiNode) {
+	Point modelPosition = viewBox.ViewToModel (viewPosition);
+	Rect modelSearchRect = Rect::FromCenterAndSize (modelPosition, Size (SlotSnappingDistanceInPixel * 2.0, SlotSnappingDistanceInPixel * 2.0));
+	uiManager.EnumerateNodesInRect (env, modelSearchRect, [&] (UINodePtr uiNode) {
 		EnumerateUISlots<SlotType> (uiNode, [&] (SlotType currentSlot) {
 			Point slotModelConnPosition = GetSlotConnPosition<SlotType> (uiNode, currentSlot->GetId (), env);
 			Point slotConnPosition = viewBox.ModelToView (slotModelConnPosition);
@@ -131,6 +138,31 @@ static UIOutputSlotPtr FindOutputSlotUnderPosition (const UINodePtr& nodeToFindI
 	return foundOutputSlot;
 }
 
+static double GetSegmentDistance (const Point& beg, const Point& end, const Point& point)
+{
+	Point direction = end - beg;
+	double lengthSquare = direction.GetX () * direction.GetX () + direction.GetY () * direction.GetY ();
+	if (IsEqual (lengthSquare, 0.0)) {
+		return Point::Distance (beg, point);
+	}
+	Point offset = point - beg;
+	double t = (offset.GetX () * direction.GetX () + offset.GetY () * direction.GetY ()) / lengthSquare;
+	t = std::max (0.0, std::min (1.0, t));
+	return Point::Distance (beg + direction * t, point);
+}
+
+static double GetConnectionDistance (const Point& beg, const Point& end, const Point& point)
+{
+	Point controlPoint1, controlPoint2;
+	GetConnectionBezierControlPoints (beg, end, controlPoint1, controlPoint2);
+	std::vector<Point> points = SegmentBezier (ConnectionSegmentCount, beg, controlPoint1, controlPoint2, end);
+	double minDistance = INF;
+	for (size_t i = 1; i < points.size (); i++) {
+		minDistance = std::min (minDistance, GetSegmentDistance (points[i - 1], points[i], point));
+	}
+	return minDistance;
+}
+
 static bool NeedToFindSlots (const NodeUIManager& uiManager)
 {
 	return !uiManager.IsPreviewMode ();
@@ -139,8 +171,9 @@ static bool NeedToFindSlots (const NodeUIManager& uiManager)
 UINodePtr FindNodeUnderPosition (NodeUIManager& uiManager, NodeUIDrawingEnvironment& env, const Point& viewPosition)
 {
 	const ViewBox& viewBox = uiManager.GetViewBox ();
+	Rect modelPositionRect = Rect::FromPositionAndSize (viewBox.ViewToModel (viewPosition), Size (0.0, 0.0));
 	UINodePtr foundNode = nullptr;
-	uiManager.EnumerateNodes ([&] (UINodePtr uiNode) {
+	uiManager.EnumerateNodesInRect (env, modelPositionRect, [&] (UINodePtr uiNode) {
 		Rect nodeRect = viewBox.ModelToView (uiNode->GetRect (env));
 		if (nodeRect.Contains (viewPosition)) {
 			foundNode = uiNode;
@@ -183,6 +216,36 @@ UIOutputSlotPtr FindOutputSlotUnderPosition (NodeUIManager& uiManager, NodeUIDra
 	return FindOutputSlotUnderPosition (foundNode, uiManager, env, viewPosition);
 }
 
+bool FindConnectionUnderPosition (NodeUIManager& uiManager, NodeUIDrawingEnvironment& env, const Point& viewPosition,
+								  const std::function<void (const UIOutputSlotConstPtr&, const UIInputSlotConstPtr&)>& connectionFound)
+{
+	// only the connections with a bounding rect around the position are checked against the curve
+	const ViewBox& viewBox = uiManager.GetViewBox ();
+	double modelSnappingDistance = ConnectionSnappingDistanceInPixel / viewBox.GetScale ();
+	Point modelPosition = viewBox.ViewToModel (viewPosition);
+	Rect modelSearchRect = Rect::FromCenterAndSize (modelPosition, Size (modelSnappingDistance * 2.0, modelSnappingDistance * 2.0));
+	UIOutputSlotConstPtr foundOutputSlot = nullptr;
+	UIInputSlotConstPtr foundInputSlot = nullptr;
+	double minDistance = INF;
+	uiManager.EnumerateConnectionsInRect (env, modelSearchRect, [&] (UIOutputSlotConstPtr outputSlot, UIInputSlotConstPtr inputSlot) {
+		UINodeConstPtr begNode = uiManager.GetNode (outputSlot->GetOwnerNodeId ());
+		UINodeConstPtr endNode = uiManager.GetNode (inputSlot->GetOwnerNodeId ());
+		Point beg = begNode->GetOutputSlotConnPosition (env, outputSlot->GetId ());
+		Point end = endNode->GetInputSlotConnPosition (env, inputSlot->GetId ());
+		double distance = GetConnectionDistance (beg, end, modelPosition);
+		if (distance <= minDistance) {
+			foundOutputSlot = outputSlot;
+			foundInputSlot = inputSlot;
+			minDistance = distance;
+		}
+	});
+	if (foundOutputSlot == nullptr || minDistance > modelSnappingDistance) {
+		return false;
+	}
+	connectionFound (foundOutputSlot, foundInputSlot);
+	return true;
+}
+
 bool FindItemUnderPosition (NodeUIManager& uiManager, NodeUIDrawingEnvironment& env, const Point& viewPosition,
 							const std::function<void (const UIInputSlotPtr&)>& inputSlotFound,
 							const std::function<void (const UIOutputSlotPtr&)>& outputSlotFound,
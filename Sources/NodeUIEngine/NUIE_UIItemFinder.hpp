@@ -11,6 +11,9 @@ UINodeGroupPtr		FindNodeGroupUnderPosition (NodeUIManager& uiManager, NodeUIDraw
 UIInputSlotPtr		FindInputSlotUnderPosition (NodeUIManager& uiManager, NodeUIDrawingEnvironment& env, const Point& viewPosition);
 UIOutputSlotPtr		FindOutputSlotUnderPosition (NodeUIManager& uiManager, NodeUIDrawingEnvironment& env, const Point& viewPosition);
 
+bool FindConnectionUnderPosition (NodeUIManager& uiManager, NodeUIDrawingEnvironment& env, const Point& viewPosition,
+								  const std::function<void (const UIOutputSlotConstPtr&, const UIInputSlotConstPtr&)>& connectionFound);
+
 bool FindItemUnderPosition (NodeUIManager& uiManager, NodeUIDrawingEnvironment& env, const Point& viewPosition,
 							const std::function<void (const UIInputSlotPtr&)>& inputSlotFound,
 							const std::function<void (const UIOutputSlotPtr&)>& outputSlotFound,
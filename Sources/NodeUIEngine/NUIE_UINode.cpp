@@ -10,6 +10,9 @@
 #include "NUIE_NodeMenuCommands.hpp"
 #include "NUIE_NodeUIManager.hpp"
 #include "NUIE_NodeUIEnvironment.hpp"
+#include "NUIE_SkinParams.hpp"
+
+#include <algorithm>
 
 namespace NUIE
 {
@@ -35,7 +38,27 @@ UINode::UINode () :
 UINode::UINode (const NE::LocString& nodeName, const Point& nodePosition) :
 	Node (),
 	nodeName (nodeName),
-	nodePosition (nodePosition)
+	nodePosition (nodePosition),
+	nodeDrawingImage (),
+	simplifiedDrawingImage (),
+	minimalDrawingImage (),
+	hasLocalRectsHint (false),
+	nodeRectHint (),
+	extendedNodeRectHint ()
+{
+
+}
+
+UINode::UINode (const UINode& src) :
+	Node (src),
+	nodeName (src.nodeName),
+	nodePosition (src.nodePosition),
+	nodeDrawingImage (),
+	simplifiedDrawingImage (),
+	minimalDrawingImage (),
+	hasLocalRectsHint (src.hasLocalRectsHint),
+	nodeRectHint (src.nodeRectHint),
+	extendedNodeRectHint (src.extendedNodeRectHint)
 {
 
 }
@@ -52,6 +75,7 @@ const NE::LocString& UINode::GetName () const
 
 void UINode::SetName (const std::wstring& newNodeName)
 {
+	BeforeChange ();
 	nodeName.SetCustom (newNodeName);
 }
 
@@ -62,15 +86,31 @@ const Point& UINode::GetPosition () const
 
 void UINode::SetPosition (const Point& newPosition)
 {
+	BeforeChange ();
 	nodePosition = newPosition;
 }
 
 void UINode::Draw (NodeUIDrawingEnvironment& env) const
+{
+	Draw (env, NodeDetailLevel::Full);
+}
+
+void UINode::Draw (NodeUIDrawingEnvironment& env, NodeDetailLevel detailLevel) const
 {
 	ViewBox nodeViewBox (nodePosition, 1.0);
 	ViewBoxContextDecorator nodeContext (env.GetDrawingContext (), nodeViewBox);
 	DrawingEnvironmentContextDecorator nodeEnv (env, nodeContext);
-	DrawInplace (nodeEnv);
+	switch (detailLevel) {
+		case NodeDetailLevel::Full:
+			DrawInplace (nodeEnv);
+			break;
+		case NodeDetailLevel::Simplified:
+			GetSimplifiedDrawingImage (nodeEnv).Draw (nodeContext);
+			break;
+		case NodeDetailLevel::Minimal:
+			GetMinimalDrawingImage (nodeEnv).Draw (nodeContext);
+			break;
+	}
 }
 
 Rect UINode::GetRect (NodeUIDrawingEnvironment& env) const
@@ -90,6 +130,61 @@ Rect UINode::GetExtendedRect (NodeUIDrawingEnvironment& env) const
 void UINode::InvalidateDrawing () const
 {
 	nodeDrawingImage.Reset ();
+	simplifiedDrawingImage.Clear ();
+	minimalDrawingImage.Clear ();
+	hasLocalRectsHint = false;
+}
+
+bool UINode::HasDrawingImage () const
+{
+	return !nodeDrawingImage.IsEmpty ();
+}
+
+void UINode::BuildDrawingImage (NodeUIDrawingEnvironment& env) const
+{
+	GetDrawingImage (env);
+}
+
+Rect UINode::GetEstimatedRect (NodeUIDrawingEnvironment& env) const
+{
+	Rect nodeRect;
+	Rect extendedNodeRect;
+	if (!GetLocalRects (nodeRect, extendedNodeRect)) {
+		return GetRect (env);
+	}
+	return nodeRect.Offset (nodePosition);
+}
+
+Rect UINode::GetEstimatedExtendedRect (NodeUIDrawingEnvironment& env) const
+{
+	Rect nodeRect;
+	Rect extendedNodeRect;
+	if (!GetLocalRects (nodeRect, extendedNodeRect)) {
+		return GetExtendedRect (env);
+	}
+	return extendedNodeRect.Offset (nodePosition);
+}
+
+bool UINode::GetLocalRects (Rect& nodeRect, Rect& extendedNodeRect) const
+{
+	if (!nodeDrawingImage.IsEmpty ()) {
+		nodeRect = nodeDrawingImage.GetNodeRect ();
+		extendedNodeRect = nodeDrawingImage.GetExtendedNodeRect ();
+		return true;
+	}
+	if (hasLocalRectsHint) {
+		nodeRect = nodeRectHint;
+		extendedNodeRect = extendedNodeRectHint;
+		return true;
+	}
+	return false;
+}
+
+void UINode::SetLocalRectsHint (const Rect& nodeRect, const Rect& extendedNodeRect)
+{
+	hasLocalRectsHint = true;
+	nodeRectHint = nodeRect;
+	extendedNodeRectHint = extendedNodeRect;
 }
 
 Point UINode::GetInputSlotConnPosition (NodeUIDrawingEnvironment& env, const NE::SlotId& slotId) const
@@ -159,46 +254,22 @@ UIOutputSlotConstPtr UINode::GetUIOutputSlot (const NE::SlotId& slotId) const
 
 void UINode::EnumerateUIInputSlots (const std::function<bool (UIInputSlotPtr)>& processor)
 {
-	EnumerateInputSlots ([&] (NE::InputSlotPtr inputSlot) {
-		UIInputSlotPtr uiInputSlot = std::dynamic_pointer_cast<UIInputSlot> (inputSlot);
-		if (DBGERROR (uiInputSlot == nullptr)) {
-			return false;
-		}
-		return processor (uiInputSlot);
-	});
+	EnumerateUIInputSlots<std::function<bool (UIInputSlotPtr)>> (processor);
 }
 
 void UINode::EnumerateUIOutputSlots (const std::function<bool (UIOutputSlotPtr)>& processor)
 {
-	EnumerateOutputSlots ([&] (NE::OutputSlotPtr outputSlot) {
-		UIOutputSlotPtr uiOutputSlot = std::dynamic_pointer_cast<UIOutputSlot> (outputSlot);
-		if (DBGERROR (uiOutputSlot == nullptr)) {
-			return false;
-		}
-		return processor (uiOutputSlot);
-	});
+	EnumerateUIOutputSlots<std::function<bool (UIOutputSlotPtr)>> (processor);
 }
 
 void UINode::EnumerateUIInputSlots (const std::function<bool (UIInputSlotConstPtr)>& processor) const
 {
-	EnumerateInputSlots ([&] (NE::InputSlotConstPtr inputSlot) {
-		UIInputSlotConstPtr uiInputSlot = std::dynamic_pointer_cast<const UIInputSlot> (inputSlot);
-		if (DBGERROR (uiInputSlot == nullptr)) {
-			return false;
-		}
-		return processor (uiInputSlot);
-	});
+	EnumerateUIInputSlots<std::function<bool (UIInputSlotConstPtr)>> (processor);
 }
 
 void UINode::EnumerateUIOutputSlots (const std::function<bool (UIOutputSlotConstPtr)>& processor) const
 {
-	EnumerateOutputSlots ([&] (NE::OutputSlotConstPtr outputSlot) {
-		UIOutputSlotConstPtr uiOutputSlot = std::dynamic_pointer_cast<const UIOutputSlot> (outputSlot);
-		if (DBGERROR (uiOutputSlot == nullptr)) {
-			return false;
-		}
-		return processor (uiOutputSlot);
-	});
+	EnumerateUIOutputSlots<std::function<bool (UIOutputSlotConstPtr)>> (processor);
 }
 
 EventHandlerResult UINode::HandleMouseClick (NodeUIEnvironment&, const ModifierKeys&, MouseButton, const Point&, UINodeCommandInterface&)
@@ -296,4 +367,47 @@ const NodeDrawingImage& UINode::GetDrawingImage (NodeUIDrawingEnvironment& env)
 	return nodeDrawingImage;
 }
 
+const DrawingImage& UINode::GetSimplifiedDrawingImage (NodeUIDrawingEnvironment& env) const
+{
+	if (!simplifiedDrawingImage.IsEmpty ()) {
+		return simplifiedDrawingImage;
+	}
+
+	// a box with the node name only, the name is scaled up to remain readable when zoomed out
+	const SkinParams& skinParams = env.GetSkinParams ();
+	Rect nodeRect = GetLocalRect (env);
+	simplifiedDrawingImage.AddItem (DrawingItemPtr (new DrawingFillRect (nodeRect, skinParams.GetNodeContentBackgroundColor ())));
+	simplifiedDrawingImage.AddItem (DrawingItemPtr (new DrawingRect (nodeRect, skinParams.GetNodeBorderPen ())));
+
+	std::wstring nodeNameText = nodeName.GetLocalized ();
+	const Font& headerFont = skinParams.GetNodeHeaderTextFont ();
+	Size textSize = env.GetDrawingContext ().MeasureText (headerFont, nodeNameText);
+	double textScale = 1.0;
+	if (textSize.GetWidth () > 0.0 && textSize.GetHeight () > 0.0) {
+		textScale = std::min (nodeRect.GetWidth () * 0.9 / textSize.GetWidth (), nodeRect.GetHeight () * 0.5 / textSize.GetHeight ());
+	}
+	Font nameFont (headerFont.GetFamily (), headerFont.GetSize () * textScale);
+	simplifiedDrawingImage.AddItem (DrawingItemPtr (new DrawingText (nodeRect, nameFont, nodeNameText, HorizontalAnchor::Center, VerticalAnchor::Center, skinParams.GetNodeHeaderTextColor ())));
+	return simplifiedDrawingImage;
+}
+
+const DrawingImage& UINode::GetMinimalDrawingImage (NodeUIDrawingEnvironment& env) const
+{
+	if (minimalDrawingImage.IsEmpty ()) {
+		const SkinParams& skinParams = env.GetSkinParams ();
+		minimalDrawingImage.AddItem (DrawingItemPtr (new DrawingFillRect (GetLocalRect (env), skinParams.GetNodeHeaderBackgroundColor ())));
+	}
+	return minimalDrawingImage;
+}
+
+Rect UINode::GetLocalRect (NodeUIDrawingEnvironment& env) const
+{
+	Rect nodeRect;
+	Rect extendedNodeRect;
+	if (!GetLocalRects (nodeRect, extendedNodeRect)) {
+		return GetDrawingImage (env).GetNodeRect ();
+	}
+	return nodeRect;
+}
+
 }
@@ -26,6 +26,13 @@ public:
 	virtual void RunUndoableCommand (const std::function<void ()>& func) = 0;
 };
 
+enum class NodeDetailLevel
+{
+	Full,
+	Simplified,
+	Minimal
+};
+
 class UINode : public NE::Node
 {
 	SERIALIZABLE;
@@ -42,10 +49,18 @@ public:
 	void						SetPosition (const Point& newPosition);
 
 	void						Draw (NodeUIDrawingEnvironment& env) const;
+	void						Draw (NodeUIDrawingEnvironment& env, NodeDetailLevel detailLevel) const;
 
 	Rect						GetRect (NodeUIDrawingEnvironment& env) const;
 	Rect						GetExtendedRect (NodeUIDrawingEnvironment& env) const;
 	void						InvalidateDrawing () const;
+	bool						HasDrawingImage () const;
+	void						BuildDrawingImage (NodeUIDrawingEnvironment& env) const;
+
+	Rect						GetEstimatedRect (NodeUIDrawingEnvironment& env) const;
+	Rect						GetEstimatedExtendedRect (NodeUIDrawingEnvironment& env) const;
+	bool						GetLocalRects (Rect& nodeRect, Rect& extendedNodeRect) const;
+	void						SetLocalRectsHint (const Rect& nodeRect, const Rect& extendedNodeRect);
 
 	Point						GetInputSlotConnPosition (NodeUIDrawingEnvironment& env, const NE::SlotId& slotId) const;
 	Point						GetOutputSlotConnPosition (NodeUIDrawingEnvironment& env, const NE::SlotId& slotId) const;
@@ -68,6 +83,18 @@ public:
 	void						EnumerateUIInputSlots (const std::function<bool (UIInputSlotConstPtr)>& processor) const;
 	void						EnumerateUIOutputSlots (const std::function<bool (UIOutputSlotConstPtr)>& processor) const;
 
+	template <class Processor>
+	void						EnumerateUIInputSlots (const Processor& processor);
+
+	template <class Processor>
+	void						EnumerateUIOutputSlots (const Processor& processor);
+
+	template <class Processor>
+	void						EnumerateUIInputSlots (const Processor& processor) const;
+
+	template <class Processor>
+	void						EnumerateUIOutputSlots (const Processor& processor) const;
+
 	virtual EventHandlerResult	HandleMouseClick (NodeUIEnvironment& env, const ModifierKeys& modifierKeys, MouseButton mouseButton, const Point& position, UINodeCommandInterface& commandInterface);
 	virtual EventHandlerResult	HandleMouseDoubleClick (NodeUIEnvironment& env, const ModifierKeys& modifierKeys, MouseButton mouseButton, const Point& position, UINodeCommandInterface& commandInterface);
 
@@ -80,6 +107,8 @@ public:
 	virtual NE::Stream::Status	Write (NE::OutputStream& outputStream) const override;
 
 protected:
+	UINode (const UINode& src);
+
 	bool						RegisterUIInputSlot (const UIInputSlotPtr& newInputSlot);
 	bool						RegisterUIOutputSlot (const UIOutputSlotPtr& newOutputSlot);
 
@@ -87,16 +116,72 @@ protected:
 
 private:
 	const NodeDrawingImage&		GetDrawingImage (NodeUIDrawingEnvironment& env) const;
+	const DrawingImage&			GetSimplifiedDrawingImage (NodeUIDrawingEnvironment& env) const;
+	const DrawingImage&			GetMinimalDrawingImage (NodeUIDrawingEnvironment& env) const;
+	Rect						GetLocalRect (NodeUIDrawingEnvironment& env) const;
 	virtual void				UpdateDrawingImage (NodeUIDrawingEnvironment& env, NodeDrawingImage& drawingImage) const = 0;
 
 	NE::LocString				nodeName;
 	Point						nodePosition;
 	mutable NodeDrawingImage	nodeDrawingImage;
+	mutable DrawingImage		simplifiedDrawingImage;
+	mutable DrawingImage		minimalDrawingImage;
+	mutable bool				hasLocalRectsHint;
+	Rect						nodeRectHint;
+	Rect						extendedNodeRectHint;
 };
 
 using UINodePtr = std::shared_ptr<UINode>;
 using UINodeConstPtr = std::shared_ptr<const UINode>;
 
+template <class Processor>
+void UINode::EnumerateUIInputSlots (const Processor& processor)
+{
+	EnumerateInputSlots ([&] (const NE::InputSlotPtr& inputSlot) {
+		UIInputSlotPtr uiInputSlot = std::dynamic_pointer_cast<UIInputSlot> (inputSlot);
+		if (DBGERROR (uiInputSlot == nullptr)) {
+			return false;
+		}
+		return processor (uiInputSlot);
+	});
+}
+
+template <class Processor>
+void UINode::EnumerateUIOutputSlots (const Processor& processor)
+{
+	EnumerateOutputSlots ([&] (const NE::OutputSlotPtr& outputSlot) {
+		UIOutputSlotPtr uiOutputSlot = std::dynamic_pointer_cast<UIOutputSlot> (outputSlot);
+		if (DBGERROR (uiOutputSlot == nullptr)) {
+			return false;
+		}
+		return processor (uiOutputSlot);
+	});
+}
+
+template <class Processor>
+void UINode::EnumerateUIInputSlots (const Processor& processor) const
+{
+	EnumerateInputSlots ([&] (const NE::InputSlotConstPtr& inputSlot) {
+		UIInputSlotConstPtr uiInputSlot = std::dynamic_pointer_cast<const UIInputSlot> (inputSlot);
+		if (DBGERROR (uiInputSlot == nullptr)) {
+			return false;
+		}
+		return processor (uiInputSlot);
+	});
+}
+
+template <class Processor>
+void UINode::EnumerateUIOutputSlots (const Processor& processor) const
+{
+	EnumerateOutputSlots ([&] (const NE::OutputSlotConstPtr& outputSlot) {
+		UIOutputSlotConstPtr uiOutputSlot = std::dynamic_pointer_cast<const UIOutputSlot> (outputSlot);
+		if (DBGERROR (uiOutputSlot == nullptr)) {
+			return false;
+		}
+		return processor (uiOutputSlot);
+	});
+}
+
 }
 
 #endif
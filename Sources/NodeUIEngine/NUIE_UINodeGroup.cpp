@@ -58,6 +58,15 @@ UINodeGroup::UINodeGroup (const NE::LocString& name) :
 
 }
 
+UINodeGroup::UINodeGroup (const UINodeGroup& src) :
+	NE::NodeGroup (src),
+	name (src.name),
+	backgroundColorIndex (src.backgroundColorIndex),
+	drawingImage ()
+{
+
+}
+
 UINodeGroup::~UINodeGroup ()
 {
 
@@ -70,6 +79,7 @@ const NE::LocString& UINodeGroup::GetName () const
 
 void UINodeGroup::SetName (const std::wstring& newName)
 {
+	BeforeChange ();
 	name.SetCustom (newName);
 	InvalidateGroupDrawing ();
 }
@@ -81,6 +91,7 @@ size_t UINodeGroup::GetBackgroundColorIndex () const
 
 void UINodeGroup::SetBackgroundColorIndex (size_t newColorIndex)
 {
+	BeforeChange ();
 	backgroundColorIndex = newColorIndex;
 	InvalidateGroupDrawing ();
 }
@@ -101,6 +112,15 @@ void UINodeGroup::InvalidateGroupDrawing () const
 	drawingImage.Reset ();
 }
 
+bool UINodeGroup::GetCachedRect (Rect& rect) const
+{
+	if (drawingImage.IsEmpty ()) {
+		return false;
+	}
+	rect = drawingImage.GetRect ();
+	return true;
+}
+
 NE::Stream::Status UINodeGroup::Read (NE::InputStream& inputStream)
 {
 	NE::ObjectHeader header (inputStream);
@@ -119,6 +139,11 @@ NE::Stream::Status UINodeGroup::Write (NE::OutputStream& outputStream) const
 	return outputStream.GetStatus ();
 }
 
+NE::NodeGroupPtr UINodeGroup::CloneGroup () const
+{
+	return NE::CopyDynamicObject<NE::NodeGroup> (this);
+}
+
 const GroupDrawingImage& UINodeGroup::GetDrawingImage (NodeUIDrawingEnvironment& env, const NodeRectGetter& rectGetter, const NE::NodeCollection& nodes) const
 {
 	if (drawingImage.IsEmpty ()) {
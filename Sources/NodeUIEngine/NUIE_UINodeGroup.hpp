@@ -39,6 +39,7 @@ class UINodeGroup : public NE::NodeGroup
 public:
 	UINodeGroup ();
 	UINodeGroup (const NE::LocString& name);
+	UINodeGroup (const UINodeGroup& src);
 	~UINodeGroup ();
 
 	const NE::LocString&		GetName () const;
@@ -50,9 +51,11 @@ public:
 	Rect						GetRect (NodeUIDrawingEnvironment& env, const NodeRectGetter& rectGetter, const NE::NodeCollection& nodes) const;
 	void						Draw (NodeUIDrawingEnvironment& env, const NodeRectGetter& rectGetter, const NE::NodeCollection& nodes) const;
 	void						InvalidateGroupDrawing () const;
+	bool						GetCachedRect (Rect& rect) const;
 
 	virtual NE::Stream::Status	Read (NE::InputStream& inputStream) override;
 	virtual NE::Stream::Status	Write (NE::OutputStream& outputStream) const override;
+	virtual NE::NodeGroupPtr	CloneGroup () const override;
 
 private:
 	const GroupDrawingImage&	GetDrawingImage (NodeUIDrawingEnvironment& env, const NodeRectGetter& rectGetter, const NE::NodeCollection& nodes) const;
@@ -1,4 +1,5 @@
 #include "NUIE_UIOutputSlot.hpp"
+#include "NE_Node.hpp"
 
 namespace NUIE
 {
@@ -30,6 +31,9 @@ const NE::LocString& UIOutputSlot::GetName () const
 
 void UIOutputSlot::SetName (const std::wstring& newName)
 {
+	if (ownerNode != nullptr) {
+		ownerNode->BeforeChange ();
+	}
 	name.SetCustom (newName);
 }
 
@@ -38,6 +42,11 @@ void UIOutputSlot::RegisterCommands (OutputSlotCommandRegistrator&) const
 
 }
 
+NE::OutputSlotPtr UIOutputSlot::Clone () const
+{
+	return NE::CopyDynamicObject<NE::OutputSlot> (this);
+}
+
 NE::Stream::Status UIOutputSlot::Read (NE::InputStream& inputStream)
 {
 	NE::ObjectHeader header (inputStream);
@@ -22,6 +22,7 @@ public:
 	void						SetName (const std::wstring& newName);
 
 	virtual void				RegisterCommands (OutputSlotCommandRegistrator& commandRegistrator) const;
+	virtual NE::OutputSlotPtr	Clone () const override;
 
 	virtual NE::Stream::Status	Read (NE::InputStream& inputStream) override;
 	virtual NE::Stream::Status	Write (NE::OutputStream& outputStream) const override;
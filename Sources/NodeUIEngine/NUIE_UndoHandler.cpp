@@ -1,24 +1,79 @@
 #include "NUIE_UndoHandler.hpp"
+#include "NE_MemoryStream.hpp"
 #include "NE_Debug.hpp"
 
+#include <iterator>
+
 namespace NUIE
 {
 
-static void AddStateToStack (const NE::NodeManager& nodeManager, std::vector<std::shared_ptr<NE::NodeManager>>& stack)
+static const size_t DefaultLiveStepCount = 16;
+static const size_t DefaultMemoryBudget = 64 * 1024 * 1024;
+static const size_t DefaultObjectSize = 512;
+
+UndoHandler::UndoStep::UndoStep () :
+	storage (Storage::Live),
+	oldState (),
+	newState (),
+	objectCount (0),
+	packedData (),
+	spillOffset (0),
+	spillSize (0)
+{
+
+}
+
+UndoHandler::UndoHandler () :
+	NE::NodeManagerChangeHandler (),
+	currentState (),
+	hasCurrentState (false),
+	isStepOpen (false),
+	changedNodes (),
+	hasChangedGroups (false),
+	undoStack (),
+	redoStack (),
+	liveStepCount (DefaultLiveStepCount),
+	memoryBudget (DefaultMemoryBudget),
+	packedObjectCount (0),
+	packedByteCount (0),
+	spillFile (nullptr),
+	spilledStepCount (0),
+	freeSpillRanges ()
 {
-	std::shared_ptr<NE::NodeManager> undoState (new NE::NodeManager ());
-	NE::NodeManager::Clone (nodeManager, *undoState.get ());
-	stack.push_back (undoState);
+
 }
 
-UndoHandler::UndoHandler ()
+UndoHandler::~UndoHandler ()
 {
+	CloseSpillFile ();
+}
 
+void UndoHandler::SetHistoryLimits (size_t newLiveStepCount, size_t newMemoryBudget)
+{
+	liveStepCount = newLiveStepCount;
+	memoryBudget = newMemoryBudget;
+	CompactHistory ();
+}
+
+size_t UndoHandler::GetMemorySize () const
+{
+	// the copy of the document is part of the history, too
+	size_t result = 0;
+	if (hasCurrentState) {
+		result += EstimateSize (currentState.GetNodeCount () + currentState.GetNodeGroupCount ());
+	}
+	for (const UndoStepPtr& step : undoStack) {
+		result += GetStepMemorySize (*step);
+	}
+	for (const UndoStepPtr& step : redoStack) {
+		result += GetStepMemorySize (*step);
+	}
+	return result;
 }
 
 bool UndoHandler::CanUndo () const
 {
-	return !undoStack.empty ();
+	return isStepOpen || !undoStack.empty ();
 }
 
 bool UndoHandler::CanRedo () const
@@ -26,29 +81,69 @@ bool UndoHandler::CanRedo () const
 	return !redoStack.empty ();
 }
 
+void UndoHandler::AddChangedNode (const NE::NodeId& nodeId)
+{
+	if (!hasCurrentState || changedNodes.Contains (nodeId)) {
+		return;
+	}
+	changedNodes.Insert (nodeId);
+}
+
+void UndoHandler::AddChangedNodeGroup (const NE::NodeGroupId&)
+{
+	// groups are small, so a changed group saves all of them
+	if (!hasCurrentState) {
+		return;
+	}
+	hasChangedGroups = true;
+}
+
 UndoHandler::ChangeResult UndoHandler::AddUndoStep (const NE::NodeManager& nodeManager)
 {
-	redoStack.clear ();
-	AddStateToStack (nodeManager, undoStack);
+	ClearStack (redoStack);
+	FinishCurrentStep (nodeManager);
+	isStepOpen = true;
 	return UndoHandler::ChangeResult::Changed;
 }
 
+UndoHandler::ChangeResult UndoHandler::DropUndoStep ()
+{
+	// the changes of the open step are already reverted by the caller,
+	// so the current state is still the state of the document
+	if (!isStepOpen) {
+		return ChangeResult::NotChanged;
+	}
+	changedNodes.Clear ();
+	hasChangedGroups = false;
+	isStepOpen = false;
+	return ChangeResult::Changed;
+}
+
 UndoHandler::ChangeResult UndoHandler::Undo (NE::NodeManager& targetNodeManager, NE::UpdateEventHandler& eventHandler)
 {
 	if (!CanUndo ()) {
 		return ChangeResult::NotChanged;
 	}
 
-	AddStateToStack (targetNodeManager, redoStack);
+	FinishCurrentStep (targetNodeManager);
 
-	std::shared_ptr<NE::NodeManager> undoState = undoStack.back ();
-	undoStack.pop_back ();
+	// the step is removed only when it is restored, so a failure doesn't lose it
+	UndoStepPtr undoStep = undoStack.back ();
+	if (DBGERROR (!UnpackStep (*undoStep))) {
+		return ChangeResult::NotChanged;
+	}
 
-	bool success = NE::NodeManagerMerge::UpdateNodeManager (*undoState.get (), targetNodeManager, eventHandler);
+	bool success = NE::NodeManagerMerge::RestoreRegion (undoStep->oldState, targetNodeManager, eventHandler);
 	if (DBGERROR (!success)) {
 		return ChangeResult::NotChanged;
 	}
 
+	NE::EmptyUpdateEventHandler stateEventHandler;
+	NE::NodeManagerMerge::RestoreRegion (undoStep->oldState, currentState, stateEventHandler);
+	undoStack.pop_back ();
+	redoStack.push_back (undoStep);
+	CompactHistory ();
+
 	return ChangeResult::Changed;
 }
 
@@ -58,28 +153,344 @@ UndoHandler::ChangeResult UndoHandler::Redo (NE::NodeManager& targetNodeManager,
 		return ChangeResult::NotChanged;
 	}
 
-	AddStateToStack (targetNodeManager, undoStack);
+	FinishCurrentStep (targetNodeManager);
 
-	std::shared_ptr<NE::NodeManager> redoState = redoStack.back ();
-	redoStack.pop_back ();
+	UndoStepPtr redoStep = redoStack.back ();
+	if (DBGERROR (!UnpackStep (*redoStep))) {
+		return ChangeResult::NotChanged;
+	}
 
-	bool success = NE::NodeManagerMerge::UpdateNodeManager (*redoState.get (), targetNodeManager, eventHandler);
+	bool success = NE::NodeManagerMerge::RestoreRegion (redoStep->newState, targetNodeManager, eventHandler);
 	if (DBGERROR (!success)) {
 		return ChangeResult::NotChanged;
 	}
 
+	NE::EmptyUpdateEventHandler stateEventHandler;
+	NE::NodeManagerMerge::RestoreRegion (redoStep->newState, currentState, stateEventHandler);
+	redoStack.pop_back ();
+	undoStack.push_back (redoStep);
+	CompactHistory ();
+
 	return ChangeResult::Changed;
 }
 
 UndoHandler::ChangeResult UndoHandler::Clear ()
 {
 	ChangeResult result = ChangeResult::NotChanged;
-	if (!undoStack.empty () || !redoStack.empty ()) {
-		undoStack.clear ();
-		redoStack.clear ();
+	if (CanUndo () || CanRedo ()) {
 		result = ChangeResult::Changed;
 	}
+	ClearStack (undoStack);
+	ClearStack (redoStack);
+	currentState.Clear ();
+	hasCurrentState = false;
+	isStepOpen = false;
+	changedNodes.Clear ();
+	hasChangedGroups = false;
+	CloseSpillFile ();
 	return result;
 }
 
+void UndoHandler::BeforeNodeChange (const NE::NodeId& nodeId)
+{
+	AddChangedNode (nodeId);
+}
+
+void UndoHandler::BeforeNodeGroupChange (const NE::NodeGroupId& groupId)
+{
+	AddChangedNodeGroup (groupId);
+}
+
+void UndoHandler::FinishCurrentStep (const NE::NodeManager& nodeManager)
+{
+	// the current state is a copy of the document as it was after the last finished step,
+	// steps store only the changed nodes before and after the change
+	if (!hasCurrentState) {
+		NE::NodeManager::Clone (nodeManager, currentState);
+		hasCurrentState = true;
+		changedNodes.Clear ();
+		hasChangedGroups = false;
+		return;
+	}
+
+	NE::NodeManagerRegion::GroupMode groupMode = NE::NodeManagerRegion::GroupMode::Memberships;
+	if (hasChangedGroups) {
+		groupMode = NE::NodeManagerRegion::GroupMode::AllGroups;
+	}
+
+	NE::EmptyUpdateEventHandler stateEventHandler;
+	if (isStepOpen) {
+		UndoStepPtr undoStep (new UndoStep ());
+		NE::NodeManagerMerge::SaveRegion (currentState, changedNodes, groupMode, undoStep->oldState);
+		NE::NodeManagerMerge::SaveRegion (nodeManager, changedNodes, groupMode, undoStep->newState);
+		NE::NodeManagerMerge::RestoreRegion (undoStep->newState, currentState, stateEventHandler);
+		undoStep->objectCount = undoStep->oldState.GetObjectCount () + undoStep->newState.GetObjectCount ();
+		undoStack.push_back (undoStep);
+		CompactHistory ();
+	} else if (!changedNodes.IsEmpty () || groupMode == NE::NodeManagerRegion::GroupMode::AllGroups) {
+		NE::NodeManagerRegion changedRegion;
+		NE::NodeManagerMerge::SaveRegion (nodeManager, changedNodes, groupMode, changedRegion);
+		NE::NodeManagerMerge::RestoreRegion (changedRegion, currentState, stateEventHandler);
+	}
+
+	changedNodes.Clear ();
+	hasChangedGroups = false;
+	isStepOpen = false;
+	DBGASSERT (IsCurrentStateValid (nodeManager));
+}
+
+size_t UndoHandler::EstimateSize (size_t objectCount) const
+{
+	// live objects are not serialized just to measure them,
+	// their size is estimated from the measured size of packed steps
+	size_t objectSize = DefaultObjectSize;
+	if (packedObjectCount > 0) {
+		objectSize = packedByteCount / packedObjectCount;
+	}
+	return objectCount * objectSize;
+}
+
+size_t UndoHandler::GetStepMemorySize (const UndoStep& step) const
+{
+	switch (step.storage) {
+		case UndoStep::Storage::Live:
+			return EstimateSize (step.objectCount);
+		case UndoStep::Storage::Packed:
+			return step.packedData.size ();
+		case UndoStep::Storage::Spilled:
+			return 0;
+	}
+	return 0;
+}
+
+void UndoHandler::CompactHistory ()
+{
+	// only the most recent steps are kept as live objects, older steps are serialized,
+	// and the oldest serialized steps are moved to a temporary file over the memory budget
+	auto packOldSteps = [&] (std::vector<UndoStepPtr>& stack) {
+		if (stack.size () <= liveStepCount) {
+			return;
+		}
+		size_t packCount = stack.size () - liveStepCount;
+		for (size_t i = 0; i < packCount; i++) {
+			if (stack[i]->storage == UndoStep::Storage::Live) {
+				PackStep (*stack[i]);
+			}
+		}
+	};
+
+	packOldSteps (undoStack);
+	packOldSteps (redoStack);
+
+	// the budget limits the whole history in memory, so even live steps are spilled over it
+	size_t memorySize = GetMemorySize ();
+	auto spillOldSteps = [&] (std::vector<UndoStepPtr>& stack) {
+		for (UndoStepPtr& step : stack) {
+			if (memorySize <= memoryBudget) {
+				return;
+			}
+			size_t stepSize = GetStepMemorySize (*step);
+			if (step->storage == UndoStep::Storage::Live) {
+				PackStep (*step);
+			}
+			if (step->storage == UndoStep::Storage::Packed) {
+				SpillStep (*step);
+			}
+			if (step->storage == UndoStep::Storage::Spilled) {
+				memorySize -= stepSize;
+			}
+		}
+	};
+
+	spillOldSteps (undoStack);
+	spillOldSteps (redoStack);
+}
+
+void UndoHandler::ClearStack (std::vector<UndoStepPtr>& stack)
+{
+	for (UndoStepPtr& step : stack) {
+		ReleaseSpillRange (*step);
+	}
+	stack.clear ();
+}
+
+void UndoHandler::PackStep (UndoStep& step)
+{
+	DBGASSERT (step.storage == UndoStep::Storage::Live);
+	NE::MemoryOutputStream outputStream;
+	step.oldState.Write (outputStream);
+	step.newState.Write (outputStream);
+	if (DBGERROR (outputStream.GetStatus () != NE::Stream::Status::NoError)) {
+		return;
+	}
+
+	step.packedData = outputStream.GetBuffer ();
+	if (step.objectCount > 0) {
+		packedObjectCount += step.objectCount;
+		packedByteCount += step.packedData.size ();
+	}
+	step.oldState = NE::NodeManagerRegion ();
+	step.newState = NE::NodeManagerRegion ();
+	step.storage = UndoStep::Storage::Packed;
+}
+
+void UndoHandler::SpillStep (UndoStep& step)
+{
+	DBGASSERT (step.storage == UndoStep::Storage::Packed);
+	if (spillFile == nullptr) {
+		spillFile = std::tmpfile ();
+		if (spillFile == nullptr) {
+			return;
+		}
+	}
+
+	size_t size = step.packedData.size ();
+	long offset = AllocateSpillRange (size);
+	if (offset == -1L) {
+		return;
+	}
+	if (std::fseek (spillFile, offset, SEEK_SET) != 0) {
+		return;
+	}
+	if (std::fwrite (step.packedData.data (), 1, size, spillFile) != size) {
+		return;
+	}
+
+	step.spillOffset = offset;
+	step.spillSize = size;
+	std::vector<char> ().swap (step.packedData);
+	step.storage = UndoStep::Storage::Spilled;
+	spilledStepCount++;
+}
+
+bool UndoHandler::UnpackStep (UndoStep& step)
+{
+	if (step.storage == UndoStep::Storage::Live) {
+		return true;
+	}
+
+	if (step.storage == UndoStep::Storage::Spilled) {
+		if (DBGERROR (spillFile == nullptr)) {
+			return false;
+		}
+		step.packedData.resize (step.spillSize);
+		if (std::fseek (spillFile, step.spillOffset, SEEK_SET) != 0) {
+			return false;
+		}
+		if (std::fread (step.packedData.data (), 1, step.spillSize, spillFile) != step.spillSize) {
+			return false;
+		}
+		ReleaseSpillRange (step);
+		step.storage = UndoStep::Storage::Packed;
+	}
+
+	NE::MemoryInputStream inputStream (step.packedData);
+	step.oldState.Read (inputStream);
+	step.newState.Read (inputStream);
+	if (DBGERROR (inputStream.GetStatus () != NE::Stream::Status::NoError)) {
+		return false;
+	}
+
+	std::vector<char> ().swap (step.packedData);
+	step.storage = UndoStep::Storage::Live;
+	return true;
+}
+
+long UndoHandler::AllocateSpillRange (size_t size)
+{
+	// the ranges of restored and dropped steps are reused before the file grows
+	for (auto it = freeSpillRanges.begin (); it != freeSpillRanges.end (); ++it) {
+		if (it->second < size) {
+			continue;
+		}
+		long offset = it->first;
+		size_t remainingSize = it->second - size;
+		freeSpillRanges.erase (it);
+		if (remainingSize > 0) {
+			freeSpillRanges.insert ({ offset + (long) size, remainingSize });
+		}
+		return offset;
+	}
+
+	if (std::fseek (spillFile, 0, SEEK_END) != 0) {
+		return -1L;
+	}
+	return std::ftell (spillFile);
+}
+
+void UndoHandler::ReleaseSpillRange (UndoStep& step)
+{
+	if (step.storage != UndoStep::Storage::Spilled) {
+		return;
+	}
+
+	long offset = step.spillOffset;
+	size_t size = step.spillSize;
+	auto next = freeSpillRanges.lower_bound (offset);
+	if (next != freeSpillRanges.end () && offset + (long) size == next->first) {
+		size += next->second;
+		next = freeSpillRanges.erase (next);
+	}
+	if (next != freeSpillRanges.begin ()) {
+		auto prev = std::prev (next);
+		if (prev->first + (long) prev->second == offset) {
+			offset = prev->first;
+			size += prev->second;
+			freeSpillRanges.erase (prev);
+		}
+	}
+	freeSpillRanges.insert ({ offset, size });
+
+	step.spillOffset = 0;
+	step.spillSize = 0;
+	DBGASSERT (spilledStepCount > 0);
+	spilledStepCount--;
+	if (spilledStepCount == 0) {
+		// nothing is left in the file, so its space is given back
+		CloseSpillFile ();
+	}
+}
+
+void UndoHandler::CloseSpillFile ()
+{
+	if (spillFile != nullptr) {
+		std::fclose (spillFile);
+		spillFile = nullptr;
+	}
+	spilledStepCount = 0;
+	freeSpillRanges.clear ();
+}
+
+#ifdef DEBUG
+bool UndoHandler::IsCurrentStateValid (const NE::NodeManager& nodeManager) const
+{
+	// a change that is not reported would be missing from the undo history
+	if (currentState.GetNodeCount () != nodeManager.GetNodeCount () || currentState.GetConnectionCount () != nodeManager.GetConnectionCount ()) {
+		return false;
+	}
+	bool isValid = true;
+	nodeManager.EnumerateNodes ([&] (NE::NodeConstPtr node) {
+		NE::NodeConstPtr stateNode = currentState.GetNode (node->GetId ());
+		if (stateNode == nullptr || !NE::Node::IsEqual (stateNode, node)) {
+			isValid = false;
+		}
+		return isValid;
+	});
+	nodeManager.EnumerateConnections ([&] (const NE::OutputSlotConstPtr& outputSlot, const NE::InputSlotConstPtr& inputSlot) {
+		NE::NodeConstPtr outputNode = currentState.GetNode (outputSlot->GetOwnerNodeId ());
+		NE::NodeConstPtr inputNode = currentState.GetNode (inputSlot->GetOwnerNodeId ());
+		if (outputNode == nullptr || inputNode == nullptr) {
+			isValid = false;
+			return;
+		}
+		NE::OutputSlotConstPtr stateOutputSlot = outputNode->GetOutputSlot (outputSlot->GetId ());
+		NE::InputSlotConstPtr stateInputSlot = inputNode->GetInputSlot (inputSlot->GetId ());
+		if (stateOutputSlot == nullptr || stateInputSlot == nullptr || !currentState.IsOutputSlotConnectedToInputSlot (stateOutputSlot, stateInputSlot)) {
+			isValid = false;
+		}
+	});
+	return isValid && NE::NodeManagerMerge::IsEqualNodeGroups (currentState, nodeManager);
+}
+#endif
+
 }
@@ -5,11 +5,15 @@
 #include "NE_NodeManagerMerge.hpp"
 
 #include <vector>
+#include <map>
+#include <cstdio>
 
 namespace NUIE
 {
 
-class UndoHandler
+// nodes and groups of the document report their changes to the undo handler,
+// so a step stores only the changed objects
+class UndoHandler : public NE::NodeManagerChangeHandler
 {
 public:
 	enum class ChangeResult
@@ -19,20 +23,86 @@ public:
 	};
 
 	UndoHandler ();
+	UndoHandler (const UndoHandler& src) = delete;
+	UndoHandler (UndoHandler&& src) = delete;
+	virtual ~UndoHandler ();
+
+	UndoHandler&	operator= (const UndoHandler& rhs) = delete;
+	UndoHandler&	operator= (UndoHandler&& rhs) = delete;
+
+	void			SetHistoryLimits (size_t newLiveStepCount, size_t newMemoryBudget);
+	size_t			GetMemorySize () const;
 
 	bool			CanUndo () const;
 	bool			CanRedo () const;
 
+	void			AddChangedNode (const NE::NodeId& nodeId);
+	void			AddChangedNodeGroup (const NE::NodeGroupId& groupId);
 	ChangeResult	AddUndoStep (const NE::NodeManager& nodeManager);
+	ChangeResult	DropUndoStep ();
 
 	ChangeResult	Undo (NE::NodeManager& targetNodeManager, NE::UpdateEventHandler& eventHandler);
 	ChangeResult	Redo (NE::NodeManager& targetNodeManager, NE::UpdateEventHandler& eventHandler);
 
 	ChangeResult	Clear ();
 
+	virtual void	BeforeNodeChange (const NE::NodeId& nodeId) override;
+	virtual void	BeforeNodeGroupChange (const NE::NodeGroupId& groupId) override;
+
 private:
-	std::vector<std::shared_ptr<NE::NodeManager>>	undoStack;
-	std::vector<std::shared_ptr<NE::NodeManager>>	redoStack;
+	class UndoStep
+	{
+	public:
+		enum class Storage
+		{
+			Live,
+			Packed,
+			Spilled
+		};
+
+		UndoStep ();
+
+		Storage					storage;
+		NE::NodeManagerRegion	oldState;
+		NE::NodeManagerRegion	newState;
+		size_t					objectCount;
+		std::vector<char>		packedData;
+		long					spillOffset;
+		size_t					spillSize;
+	};
+
+	using UndoStepPtr = std::shared_ptr<UndoStep>;
+
+	void						FinishCurrentStep (const NE::NodeManager& nodeManager);
+	size_t						EstimateSize (size_t objectCount) const;
+	size_t						GetStepMemorySize (const UndoStep& step) const;
+	void						CompactHistory ();
+	void						ClearStack (std::vector<UndoStepPtr>& stack);
+	void						PackStep (UndoStep& step);
+	void						SpillStep (UndoStep& step);
+	bool						UnpackStep (UndoStep& step);
+	long						AllocateSpillRange (size_t size);
+	void						ReleaseSpillRange (UndoStep& step);
+	void						CloseSpillFile ();
+#ifdef DEBUG
+	bool						IsCurrentStateValid (const NE::NodeManager& nodeManager) const;
+#endif
+
+	NE::NodeManager				currentState;
+	bool						hasCurrentState;
+	bool						isStepOpen;
+	NE::NodeCollection			changedNodes;
+	bool						hasChangedGroups;
+	std::vector<UndoStepPtr>	undoStack;
+	std::vector<UndoStepPtr>	redoStack;
+
+	size_t						liveStepCount;
+	size_t						memoryBudget;
+	size_t						packedObjectCount;
+	size_t						packedByteCount;
+	std::FILE*					spillFile;
+	size_t						spilledStepCount;
+	std::map<long, size_t>		freeSpillRanges;
 };
 
 }
@@ -134,7 +134,8 @@ Direct2DContextBase::Direct2DContextBase (const Direct2DImageLoaderPtr& imageLoa
 	width (0),
 	height (0),
 	imageLoader (imageLoader),
-	renderTarget (nullptr)
+	renderTarget (nullptr),
+	textMeasureCache ()
 {
 
 }
@@ -285,14 +286,16 @@ void Direct2DContextBase::DrawFormattedText (const NUIE::Rect& rect, const NUIE:
 
 NUIE::Size Direct2DContextBase::MeasureText (const NUIE::Font& font, const std::wstring& text)
 {
-	IDWriteTextLayout* textLayout = nullptr;
-	IDWriteTextFormat* textFormat = CreateTextFormat (direct2DHandler.directWriteFactory, renderTarget, font);
-	direct2DHandler.directWriteFactory->CreateTextLayout (text.c_str (), (UINT32) text.length (), textFormat, FLT_MAX, FLT_MAX, &textLayout);
-	DWRITE_TEXT_METRICS metrics;
-	textLayout->GetMetrics (&metrics);
-	SafeRelease (&textLayout);
-	SafeRelease (&textFormat);
-	return NUIE::Size (metrics.width * SafetyTextRatio, metrics.height * SafetyTextRatio);
+	return textMeasureCache.Measure (font, text, [&] (const NUIE::Font& measuredFont, const std::wstring& measuredText) {
+		IDWriteTextLayout* textLayout = nullptr;
+		IDWriteTextFormat* textFormat = CreateTextFormat (direct2DHandler.directWriteFactory, renderTarget, measuredFont);
+		direct2DHandler.directWriteFactory->CreateTextLayout (measuredText.c_str (), (UINT32) measuredText.length (), textFormat, FLT_MAX, FLT_MAX, &textLayout);
+		DWRITE_TEXT_METRICS metrics;
+		textLayout->GetMetrics (&metrics);
+		SafeRelease (&textLayout);
+		SafeRelease (&textFormat);
+		return NUIE::Size (metrics.width * SafetyTextRatio, metrics.height * SafetyTextRatio);
+	});
 }
 
 bool Direct2DContextBase::CanDrawIcon ()
@@ -312,4 +315,36 @@ void Direct2DContextBase::DrawIcon (const NUIE::Rect& rect, const NUIE::IconId&
 	}
 }
 
+void Direct2DContextBase::DrawLines (const std::vector<NUIE::Point>& points, const NUIE::Pen& pen)
+{
+	Direct2DAntialiasGuard antialiasGuard (renderTarget, D2D1_ANTIALIAS_MODE_PER_PRIMITIVE);
+	ID2D1SolidColorBrush* d2Brush = CreateBrush (renderTarget, pen.GetColor ());
+	ID2D1StrokeStyle* d2StrokeStyle = CreateStrokeStyle (direct2DHandler.direct2DFactory);
+	for (size_t i = 0; i + 1 < points.size (); i += 2) {
+		renderTarget->DrawLine (CreatePoint (points[i]), CreatePoint (points[i + 1]), d2Brush, GetPenThickness (pen), d2StrokeStyle);
+	}
+	SafeRelease (&d2StrokeStyle);
+	SafeRelease (&d2Brush);
+}
+
+void Direct2DContextBase::DrawRects (const std::vector<NUIE::Rect>& rects, const NUIE::Pen& pen)
+{
+	ID2D1SolidColorBrush* d2Brush = CreateBrush (renderTarget, pen.GetColor ());
+	for (const NUIE::Rect& rect : rects) {
+		D2D1_RECT_F d2Rect = CreateRect (rect);
+		renderTarget->DrawRectangle (&d2Rect, d2Brush, GetPenThickness (pen));
+	}
+	SafeRelease (&d2Brush);
+}
+
+void Direct2DContextBase::FillRects (const std::vector<NUIE::Rect>& rects, const NUIE::Color& color)
+{
+	ID2D1SolidColorBrush* d2Brush = CreateBrush (renderTarget, color);
+	for (const NUIE::Rect& rect : rects) {
+		D2D1_RECT_F d2Rect = CreateRect (rect);
+		renderTarget->FillRectangle (&d2Rect, d2Brush);
+	}
+	SafeRelease (&d2Brush);
+}
+
 }
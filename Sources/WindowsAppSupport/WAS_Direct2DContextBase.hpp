@@ -7,6 +7,7 @@
 #include <unordered_map>
 
 #include "NUIE_DrawingContext.hpp"
+#include "NUIE_TextMeasureCache.hpp"
 #include "WAS_IncludeWindowsHeaders.hpp"
 #include "WAS_Direct2DImageLoader.hpp"
 
@@ -54,6 +55,10 @@ public:
 	virtual bool				CanDrawIcon () override;
 	virtual void				DrawIcon (const NUIE::Rect& rect, const NUIE::IconId& iconId) override;
 
+	virtual void				DrawLines (const std::vector<NUIE::Point>& points, const NUIE::Pen& pen) override;
+	virtual void				DrawRects (const std::vector<NUIE::Rect>& rects, const NUIE::Pen& pen) override;
+	virtual void				FillRects (const std::vector<NUIE::Rect>& rects, const NUIE::Color& color) override;
+
 protected:
 	virtual void				InitRenderTarget () = 0;
 
@@ -63,6 +68,7 @@ protected:
 	Direct2DHandler				direct2DHandler;
 	Direct2DImageLoaderPtr		imageLoader;
 	ID2D1RenderTarget*			renderTarget;
+	NUIE::TextMeasureCache		textMeasureCache;
 };
 
 }
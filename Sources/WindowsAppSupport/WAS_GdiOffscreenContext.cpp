@@ -23,7 +23,11 @@ GdiOffscreenContext::GdiOffscreenContext () :
 	NUIE::NativeDrawingContext (),
 	width (0),
 	height (0),
-	bitmap ()
+	bitmap (),
+	penCache (),
+	brushCache (),
+	fontCache (),
+	textMeasureCache ()
 {
 
 }
@@ -191,11 +195,13 @@ void GdiOffscreenContext::DrawFormattedText (const NUIE::Rect& rect, const NUIE:
 
 NUIE::Size GdiOffscreenContext::MeasureText (const NUIE::Font& font, const std::wstring& text)
 {
-	SelectBitmapGuard selectGuard (bitmap);
-	bitmap.SelectOtherObject (fontCache.Get (font));
-	RECT gdiRect = { 0, 0, 0, 0 };
-	::DrawText (bitmap.GetContext (), text.c_str (), (int) text.length (), &gdiRect, DT_CALCRECT);
-	return NUIE::Size (gdiRect.right - gdiRect.left + 5, gdiRect.bottom - gdiRect.top);
+	return textMeasureCache.Measure (font, text, [&] (const NUIE::Font& measuredFont, const std::wstring& measuredText) {
+		SelectBitmapGuard selectGuard (bitmap);
+		bitmap.SelectOtherObject (fontCache.Get (measuredFont));
+		RECT gdiRect = { 0, 0, 0, 0 };
+		::DrawText (bitmap.GetContext (), measuredText.c_str (), (int) measuredText.length (), &gdiRect, DT_CALCRECT);
+		return NUIE::Size (gdiRect.right - gdiRect.left + 5, gdiRect.bottom - gdiRect.top);
+	});
 }
 
 bool GdiOffscreenContext::CanDrawIcon ()
@@ -208,6 +214,24 @@ void GdiOffscreenContext::DrawIcon (const NUIE::Rect&, const NUIE::IconId&)
 	DBGBREAK ();
 }
 
+bool GdiOffscreenContext::CanClip ()
+{
+	return true;
+}
+
+void GdiOffscreenContext::SetClipRect (const NUIE::Rect& rect)
+{
+	RECT gdiRect = CreateRect (rect);
+	HRGN clipRegion = ::CreateRectRgn (gdiRect.left, gdiRect.top, gdiRect.right, gdiRect.bottom);
+	::SelectClipRgn (bitmap.GetContext (), clipRegion);
+	::DeleteObject (clipRegion);
+}
+
+void GdiOffscreenContext::ResetClipRect ()
+{
+	::SelectClipRgn (bitmap.GetContext (), NULL);
+}
+
 void GdiOffscreenContext::CreateOffscreenContext ()
 {
 	bitmap.Init (width, height);
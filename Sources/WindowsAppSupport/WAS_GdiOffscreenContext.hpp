@@ -6,6 +6,7 @@
 #include "NUIE_DrawingContext.hpp"
 #include "NUIE_Drawing.hpp"
 #include "NUIE_DrawingCacheKeys.hpp"
+#include "NUIE_TextMeasureCache.hpp"
 #include "WAS_IncludeWindowsHeaders.hpp"
 #include "WAS_OffscreenBitmap.hpp"
 
@@ -83,6 +84,10 @@ public:
 	virtual bool				CanDrawIcon () override;
 	virtual void				DrawIcon (const NUIE::Rect& rect, const NUIE::IconId& iconId) override;
 
+	virtual bool				CanClip () override;
+	virtual void				SetClipRect (const NUIE::Rect& rect) override;
+	virtual void				ResetClipRect () override;
+
 private:
 	void						CreateOffscreenContext ();
 	POINT						CreatePoint (const NUIE::Point& point) const;
@@ -96,6 +101,7 @@ private:
 	HandleCache<NUIE::PenCacheKey>		penCache;
 	HandleCache<NUIE::ColorCacheKey>	brushCache;
 	HandleCache<NUIE::FontCacheKey>		fontCache;
+	NUIE::TextMeasureCache				textMeasureCache;
 };
 
 }
@@ -51,7 +51,8 @@ GdiplusOffscreenContext::GdiplusOffscreenContext () :
 	width (0),
 	height (0),
 	bitmap (new Gdiplus::Bitmap (width, height)),
-	graphics (new Gdiplus::Graphics (bitmap.get ()))
+	graphics (new Gdiplus::Graphics (bitmap.get ())),
+	textMeasureCache ()
 {
 	
 }
@@ -215,15 +216,17 @@ void GdiplusOffscreenContext::DrawFormattedText (const NUIE::Rect& rect, const N
 
 NUIE::Size GdiplusOffscreenContext::MeasureText (const NUIE::Font& font, const std::wstring & text)
 {
-	Gdiplus::Font gdiFont (font.GetFamily ().c_str (), (Gdiplus::REAL) font.GetSize ());
-	Gdiplus::RectF textRect (0, 0, 0, 0);
+	return textMeasureCache.Measure (font, text, [&] (const NUIE::Font& measuredFont, const std::wstring& measuredText) {
+		Gdiplus::Font gdiFont (measuredFont.GetFamily ().c_str (), (Gdiplus::REAL) measuredFont.GetSize ());
+		Gdiplus::RectF textRect (0, 0, 0, 0);
 
-	if (graphics->MeasureString (text.c_str (), (int) text.length (), &gdiFont, textRect, NULL, &textRect) != Gdiplus::Status::Ok) {
-		DBGBREAK ();
-		return NUIE::Size (100, 20);
-	}
+		if (graphics->MeasureString (measuredText.c_str (), (int) measuredText.length (), &gdiFont, textRect, NULL, &textRect) != Gdiplus::Status::Ok) {
+			DBGBREAK ();
+			return NUIE::Size (100, 20);
+		}
 
-	return NUIE::Size (textRect.Width, textRect.Height);
+		return NUIE::Size (textRect.Width, textRect.Height);
+	});
 }
 
 bool GdiplusOffscreenContext::CanDrawIcon ()
@@ -236,6 +239,21 @@ void GdiplusOffscreenContext::DrawIcon (const NUIE::Rect&, const NUIE::IconId&)
 	DBGBREAK ();
 }
 
+bool GdiplusOffscreenContext::CanClip ()
+{
+	return true;
+}
+
+void GdiplusOffscreenContext::SetClipRect (const NUIE::Rect& rect)
+{
+	graphics->SetClip (CreateRectF (rect));
+}
+
+void GdiplusOffscreenContext::ResetClipRect ()
+{
+	graphics->ResetClip ();
+}
+
 void GdiplusOffscreenContext::InitGraphics ()
 {
 	bitmap.reset (new Gdiplus::Bitmap (width, height));
@@ -6,6 +6,7 @@
 #include "WAS_IncludeWindowsHeaders.hpp"
 #include "WAS_GdiplusUtils.hpp"
 #include "NUIE_DrawingContext.hpp"
+#include "NUIE_TextMeasureCache.hpp"
 
 namespace WAS
 {
@@ -45,6 +46,10 @@ public:
 	virtual bool		CanDrawIcon () override;
 	virtual void		DrawIcon (const NUIE::Rect& rect, const NUIE::IconId& iconId) override;
 
+	virtual bool		CanClip () override;
+	virtual void		SetClipRect (const NUIE::Rect& rect) override;
+	virtual void		ResetClipRect () override;
+
 private:
 	void				InitGraphics ();
 
@@ -53,6 +58,7 @@ private:
 	int									height;
 	std::unique_ptr<Gdiplus::Bitmap>	bitmap;
 	std::unique_ptr<Gdiplus::Graphics>	graphics;
+	NUIE::TextMeasureCache				textMeasureCache;
 };
 
 }
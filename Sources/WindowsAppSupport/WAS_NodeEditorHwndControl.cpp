@@ -2,6 +2,8 @@
 #include "WAS_WindowsAppUtils.hpp"
 #include "NE_Debug.hpp"
 
+#include <cmath>
+
 namespace WAS
 {
 
@@ -192,7 +194,9 @@ NodeEditorHwndControl::NodeEditorHwndControl (const NUIE::NativeDrawingContextPt
 	NativeNodeEditorControl (),
 	nodeEditor (nullptr),
 	nativeContext (nativeContext),
-	control ()
+	control (),
+	needToDrawAll (true),
+	dirtyViewRect ()
 {
 
 }
@@ -260,9 +264,26 @@ void NodeEditorHwndControl::Invalidate ()
 	if (hwnd == NULL) {
 		return;
 	}
+	needToDrawAll = true;
 	InvalidateRect (hwnd, NULL, FALSE);
 }
 
+void NodeEditorHwndControl::InvalidateViewRect (const NUIE::Rect& viewRect)
+{
+	HWND hwnd = control.GetWindowHandle ();
+	if (hwnd == NULL) {
+		return;
+	}
+	dirtyViewRect.AddRect (viewRect);
+	RECT dirtyRect = {
+		(LONG) std::floor (viewRect.GetLeft ()),
+		(LONG) std::floor (viewRect.GetTop ()),
+		(LONG) std::ceil (viewRect.GetRight ()),
+		(LONG) std::ceil (viewRect.GetBottom ())
+	};
+	InvalidateRect (hwnd, &dirtyRect, FALSE);
+}
+
 void NodeEditorHwndControl::Draw ()
 {
 	HWND hwnd = control.GetWindowHandle ();
@@ -270,8 +291,15 @@ void NodeEditorHwndControl::Draw ()
 		return;
 	}
 	if (nodeEditor != nullptr) {
-		nodeEditor->Draw ();
+		// the offscreen context keeps its content, so only the dirty area is drawn again
+		if (needToDrawAll || !dirtyViewRect.IsValid ()) {
+			nodeEditor->Draw ();
+		} else {
+			nodeEditor->Draw (dirtyViewRect.GetRect ());
+		}
 	}
+	needToDrawAll = false;
+	dirtyViewRect = NUIE::BoundingRect ();
 	nativeContext->BlitToWindow (hwnd);
 }
 
@@ -22,6 +22,7 @@ public:
 
 	virtual void					Resize (int x, int y, int width, int height) override;
 	virtual void					Invalidate () override;
+	virtual void					InvalidateViewRect (const NUIE::Rect& viewRect) override;
 	virtual void					Draw () override;
 
 	virtual NUIE::DrawingContext&	GetDrawingContext () override;
@@ -31,6 +32,8 @@ private:
 	NUIE::NodeEditor*				nodeEditor;
 	NUIE::NativeDrawingContextPtr	nativeContext;
 	CustomControl					control;
+	bool							needToDrawAll;
+	NUIE::BoundingRect				dirtyViewRect;
 };
 
 }
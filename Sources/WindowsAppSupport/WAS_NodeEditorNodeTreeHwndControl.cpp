@@ -151,6 +151,11 @@ void NodeEditorNodeTreeHwndControl::Invalidate ()
 	nodeEditorControl.Invalidate ();
 }
 
+void NodeEditorNodeTreeHwndControl::InvalidateViewRect (const NUIE::Rect& viewRect)
+{
+	nodeEditorControl.InvalidateViewRect (viewRect);
+}
+
 void NodeEditorNodeTreeHwndControl::Draw ()
 {
 	nodeEditorControl.Draw ();
@@ -43,6 +43,7 @@ public:
 
 	virtual void					Resize (int x, int y, int width, int height) override;
 	virtual void					Invalidate () override;
+	virtual void					InvalidateViewRect (const NUIE::Rect& viewRect) override;
 	virtual void					Draw () override;
 	
 	virtual NUIE::DrawingContext&	GetDrawingContext () override;
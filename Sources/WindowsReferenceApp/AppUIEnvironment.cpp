@@ -275,6 +275,11 @@ void AppUIEnvironment::OnRedrawRequested ()
 	nodeEditorControl.Invalidate ();
 }
 
+void AppUIEnvironment::OnPartialRedrawRequested (const NUIE::Rect& dirtyViewRect)
+{
+	nodeEditorControl.InvalidateViewRect (dirtyViewRect);
+}
+
 NUIE::EventHandler& AppUIEnvironment::GetEventHandler ()
 {
 	return eventHandler;
@@ -29,6 +29,7 @@ public:
 
 	virtual void						OnValuesRecalculated () override;
 	virtual void						OnRedrawRequested () override;
+	virtual void						OnPartialRedrawRequested (const NUIE::Rect& dirtyViewRect) override;
 	virtual NUIE::EventHandler&			GetEventHandler () override;
 	virtual NUIE::ClipboardHandler&		GetClipboardHandler () override;
 	